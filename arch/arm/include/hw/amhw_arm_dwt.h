@@ -0,0 +1,112 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ݹ۲ٵԪ(DWT) ڼӿ
+ *
+ * 1. 32 λںʱӼ
+ * 2.  Cortex-M3/M4/M7  ARMv7-M ںṩCortex-M0/M0+ ûڼ
+ *
+ * ڼ׼Կܣam_bench_init()кʱͳ
+ * ʱ
+ * \code
+ * amhw_arm_dwt_cyccnt_enable();
+ * am_bench_init(amhw_arm_dwt_cyccnt_get, SystemCoreClock);
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AMHW_ARM_DWT_H
+#define __AMHW_ARM_DWT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "am_types.h"
+
+/**
+ * \addtogroup amhw_arm_if_dwt
+ * \copydoc amhw_arm_dwt.h
+ * @{
+ */
+
+/**
+ * \brief DWT Ĵṹ壨ڼصļĴ
+ */
+typedef struct amhw_arm_dwt {
+    __IO uint32_t ctrl;       /**< \brief DWT ƼĴ */
+    __IO uint32_t cyccnt;     /**< \brief ڼĴ */
+} amhw_arm_dwt_t;
+
+#ifndef AMHW_ARM_DWT
+#define AMHW_ARM_DWT  ((amhw_arm_dwt_t *)0xE0001000UL)    /**< DWT ַ */
+#endif
+
+#ifndef AMHW_ARM_DEMCR
+#define AMHW_ARM_DEMCR  (*(volatile uint32_t *)0xE000EDFCUL) /**< 쳣ؿƼĴ */
+#endif
+
+/** \brief DEMCR еĸʹλ */
+#define AMHW_ARM_DEMCR_TRCENA          (1ul << 24)
+
+/** \brief DWT ƼĴеڼʹλ */
+#define AMHW_ARM_DWT_CTRL_CYCCNTENA    (1ul << 0)
+
+/**
+ * \brief ʹڼ
+ * \return 
+ */
+am_static_inline
+void amhw_arm_dwt_cyccnt_enable (void)
+{
+    AMHW_ARM_DEMCR       |= AMHW_ARM_DEMCR_TRCENA;
+    AMHW_ARM_DWT->cyccnt  = 0;
+    AMHW_ARM_DWT->ctrl   |= AMHW_ARM_DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * \brief ڼ
+ * \return 
+ */
+am_static_inline
+void amhw_arm_dwt_cyccnt_disable (void)
+{
+    AMHW_ARM_DWT->ctrl &= ~AMHW_ARM_DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * \brief ȡڼֵ
+ * \return ڼֵ
+ */
+am_static_inline
+uint32_t amhw_arm_dwt_cyccnt_get (void)
+{
+    return AMHW_ARM_DWT->cyccnt;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AMHW_ARM_DWT_H */
+
+/* end of file */
@@ -0,0 +1,175 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX л׼
+ *
+ * ÷
+ * \code
+ * am_posix_bench [-f ǰ׺] [-r ظ] [-m ̲ʱms]
+ *                [-b ׼.csv] [-t ֵ%]
+ *
+ * ./am_posix_bench > baseline.csv              # ׼
+ * ./am_posix_bench -b baseline.csv -t 10       # ׼߱Ƚ
+ * \endcode
+ *
+ * ׼ļǰÿβֵȻ׼ӳֵ
+ * Ĭ 10%ʱ status Ϊ "REGRESSION"˳Ϊ 1
+ *
+ * ϵͳδsoftimer  tick ֻܶʱ̸߳š
+ * am_posix_bench_wheel 뱾ͬʹʱʵֵʱĵһ
+ * עͱʱʵ֡
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-16  ljy, print the softimer implementation.
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_bench.h"
+#include "am_vdebug.h"
+#include "am_softimer.h"
+#include "am_posix_int.h"
+#include "am_posix_console.h"
+#include "am_posix_timestamp.h"
+#include "demo_bench_entries.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** \brief ׼ļļ¼ */
+#define __BASELINE_MAX     256
+
+/** \brief Ĭϵ˻ֵ% */
+#define __THRESHOLD_DEF    10
+
+static am_bench_baseline_t __g_baseline[__BASELINE_MAX];
+static char                __g_baseline_names[__BASELINE_MAX][64];
+
+/*  "123.45" ʽĶ */
+static uint32_t __fixed_x100_parse (const char *p_str)
+{
+    return (uint32_t)(strtod(p_str, NULL) * 100.0 + 0.5);
+}
+
+/* ȡ׼ļؼ¼ʧܷ -1 */
+static int __baseline_load (const char *p_path)
+{
+    FILE *p_file;
+    char  line[256];
+    char *p_field[4];
+    char *p;
+    int   num = 0;
+    int   i;
+
+    p_file = fopen(p_path, "r");
+    if (p_file == NULL) {
+        return -1;
+    }
+
+    while ((num < __BASELINE_MAX) && fgets(line, sizeof(line), p_file)) {
+
+        /* עͺͱͷ */
+        if ((line[0] == '#') || (strncmp(line, "name,", 5) == 0)) {
+            continue;
+        }
+
+        /* name,size,ops,counts_per_op */
+        for (p = line, i = 0; i < 4; i++) {
+            p_field[i] = p;
+            p = strchr(p, ',');
+            if (p == NULL) {
+                break;
+            }
+            *p++ = '\0';
+        }
+        if ((i < 4) || (p_field[3][0] == '\0')) {
+            continue;                           /*  */
+        }
+
+        strncpy(__g_baseline_names[num],
+                p_field[0],
+                sizeof(__g_baseline_names[num]) - 1);
+
+        __g_baseline[num].p_name             = __g_baseline_names[num];
+        __g_baseline[num].size               = strtoul(p_field[1], NULL, 10);
+        __g_baseline[num].counts_per_op_x100 = __fixed_x100_parse(p_field[3]);
+        num++;
+    }
+
+    fclose(p_file);
+
+    return num;
+}
+
+int main (int argc, char *argv[])
+{
+    const char   *p_filter    = NULL;
+    const char   *p_baseline  = NULL;
+    unsigned int  threshold   = __THRESHOLD_DEF;
+    unsigned int  repeat      = 0;
+    unsigned int  min_time_ms = 0;
+    int           num;
+    int           ret;
+    int           opt;
+
+    while ((opt = getopt(argc, argv, "f:b:t:r:m:")) != -1) {
+        switch (opt) {
+        case 'f': p_filter    = optarg;                     break;
+        case 'b': p_baseline  = optarg;                     break;
+        case 't': threshold   = strtoul(optarg, NULL, 10); break;
+        case 'r': repeat      = strtoul(optarg, NULL, 10); break;
+        case 'm': min_time_ms = strtoul(optarg, NULL, 10); break;
+        default:
+            fprintf(stderr,
+                    "usage: %s [-f prefix] [-r repeat] [-m min_time_ms] "
+                    "[-b baseline.csv] [-t threshold_pct]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    am_posix_int_init();
+    am_posix_console_init(STDOUT_FILENO);
+    am_softimer_module_init(1000);
+
+    am_bench_init(am_posix_timestamp_get, AM_POSIX_TIMESTAMP_HZ);
+    am_bench_config(repeat, min_time_ms);
+
+    if (p_baseline != NULL) {
+        num = __baseline_load(p_baseline);
+        if (num < 0) {
+            fprintf(stderr, "cannot open baseline %s\n", p_baseline);
+            return 2;
+        }
+        am_bench_baseline_set(__g_baseline, num, threshold);
+    }
+
+#ifdef AM_SOFTIMER_WHEEL
+    am_kprintf("# softimer=wheel\n");
+#else
+    am_kprintf("# softimer=list\n");
+#endif
+
+    ret = demo_bench_entry(p_filter);
+    if (ret < 0) {
+        return 2;
+    }
+
+    return (ret > 0) ? 1 : 0;
+}
+
+/* end of file */
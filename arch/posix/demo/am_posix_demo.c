@@ -0,0 +1,98 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ֲ
+ *
+ * - ʵ
+ *   1. ʱÿ 100ms һμֵ 5 Σ
+ *   2. ȴ 300ms ʱϵͳδ
+ *   3. жӳɵȴʾϢ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_vdebug.h"
+#include "am_delay.h"
+#include "am_wait.h"
+#include "am_system.h"
+#include "am_softimer.h"
+#include "am_isr_defer.h"
+#include "am_posix_int.h"
+#include "am_posix_tick.h"
+#include "am_posix_console.h"
+#include "am_posix_isr_defer.h"
+#include <unistd.h>
+
+static am_softimer_t       __g_timer;
+static am_wait_t           __g_wait;
+static am_isr_defer_job_t  __g_job;
+static volatile int        __g_count = 0;
+
+/* ʱصڵδжִУ */
+static void __timer_callback (void *p_arg)
+{
+    am_kprintf("timer %d\n", ++__g_count);
+
+    if (__g_count >= 5) {
+        am_softimer_stop(&__g_timer);
+        am_wait_done(&__g_wait);
+    }
+}
+
+/* жӳ */
+static void __job_callback (void *p_arg)
+{
+    am_wait_done((am_wait_t *)p_arg);
+}
+
+int main (void)
+{
+    am_posix_int_init();
+    am_posix_console_init(STDOUT_FILENO);
+    am_posix_isr_defer_init();
+    am_posix_tick_init(1000);
+
+    am_wait_strategy_set(&am_wait_strategy_posix);
+
+    /* 1. ʱ */
+    am_wait_init(&__g_wait);
+    am_softimer_init(&__g_timer, __timer_callback, NULL);
+    am_softimer_start(&__g_timer, 100);
+    am_wait_on(&__g_wait);
+
+    /* 2. ȴʱ */
+    am_wait_init(&__g_wait);
+    if (am_wait_on_timeout(&__g_wait, 300) == -AM_ETIME) {
+        am_kprintf("timeout at tick %d\n", (int)am_sys_tick_get());
+    }
+
+    /* 3. жӳ */
+    am_wait_init(&__g_wait);
+    am_isr_defer_job_init(&__g_job, __job_callback, &__g_wait, 1);
+    am_isr_defer_job_add(&__g_job);
+    am_wait_on(&__g_wait);
+    am_kprintf("isr defer job done\n");
+
+    am_mdelay(10);
+
+    am_posix_tick_deinit();
+
+    return 0;
+}
+
+/* end of file */
@@ -0,0 +1,334 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief I2C 첽дߵ
+ *
+ * ģ I2C ߣam_posix_i2c400kHzϹ 8 0x40 ~ 0x47ÿ
+ *  6 ֽڣ 1  RTC0x68ÿζ 7 ֽڣȽϣ
+ *  1. ͬȡam_i2c_read()ѯ
+ *  2. 첽ȡam_i2c_read_async()ֱύȽȳ
+ *     RTC Ŷӳ٣ύɻصʱ䣩
+ *  3. am_i2c_sched_init()ύRTC ʹøȼʱŶӳ٣
+ *  4. ǷȷڵĴӻǷ񷵻 -AM_ENODEV
+ *
+ * - ʵ
+ *   1. ÿַʽϢʡʺ RTC ӳ٣
+ *   2. ÿһ "ok"  "FAIL"ȫͨʱ 0
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_vdebug.h"
+#include "am_i2c.h"
+#include "am_wait.h"
+#include "am_posix_int.h"
+#include "am_posix_i2c.h"
+#include "am_posix_console.h"
+#include "am_posix_timestamp.h"
+#include <string.h>
+#include <unistd.h>
+
+#define __BUS_HZ          400000
+#define __I2C_INUM        1              /* ģ I2C ʹõжϺ */
+
+#define __SENSOR_NUM      8
+#define __SENSOR_ADDR     0x40
+#define __SENSOR_BYTES    6
+#define __RTC_ADDR        0x68
+#define __RTC_BYTES       7
+#define __MEM_SIZE        16
+
+#define __ROUNDS          200
+
+static am_posix_i2c_dev_t    __g_i2c;
+static am_i2c_sched_t        __g_sched;
+
+static uint8_t               __g_mem[__SENSOR_NUM + 1][__MEM_SIZE];
+static am_posix_i2c_slave_t  __g_slaves[__SENSOR_NUM + 1];
+
+static am_i2c_device_t       __g_sensor[__SENSOR_NUM];
+static am_i2c_device_t       __g_rtc;
+static am_i2c_async_t        __g_req[__SENSOR_NUM + 1];
+static uint8_t               __g_buf[__SENSOR_NUM + 1][__MEM_SIZE];
+
+static am_wait_t             __g_wait;
+static int                   __g_left;          /* δɵ */
+static int                   __g_nerr;          /* ״̬ */
+static int                   __g_nfail;
+
+static uint32_t              __g_rtc_submit;    /* RTC ύʱ */
+static uint32_t              __g_rtc_max;       /* RTC ӳ٣룩 */
+static uint64_t              __g_rtc_sum;       /* RTC ӳ֮ͣ룩 */
+
+static void __check (const char *p_name, int val, int expect)
+{
+    am_kprintf("%s : %s (%d, expect %d)\n",
+               p_name,
+               (val == expect) ? "ok" : "FAIL",
+               val,
+               expect);
+
+    if (val != expect) {
+        __g_nfail++;
+    }
+}
+
+/* ݣشĻ */
+static int __data_check (void)
+{
+    int i;
+    int nbad = 0;
+
+    for (i = 0; i < __SENSOR_NUM; i++) {
+        if (memcmp(__g_buf[i], &__g_mem[i][2], __SENSOR_BYTES) != 0) {
+            nbad++;
+        }
+    }
+    if (memcmp(__g_buf[__SENSOR_NUM],
+               __g_mem[__SENSOR_NUM],
+               __RTC_BYTES) != 0) {
+        nbad++;
+    }
+
+    memset(__g_buf, 0, sizeof(__g_buf));
+
+    return nbad;
+}
+
+/* ɻصжִУ */
+static void __req_complete (void *p_arg, int status)
+{
+    if (status != AM_OK) {
+        __g_nerr++;
+    }
+
+    if (--__g_left == 0) {
+        am_wait_done(&__g_wait);
+    }
+}
+
+/* RTC ɻص¼Ŷӳ */
+static void __rtc_complete (void *p_arg, int status)
+{
+    uint32_t lat = am_posix_timestamp_get() - __g_rtc_submit;
+
+    if (lat > __g_rtc_max) {
+        __g_rtc_max = lat;
+    }
+    __g_rtc_sum += lat;
+
+    __req_complete(p_arg, status);
+}
+
+static void __report (const char *p_name,
+                      int         nmsg,
+                      uint32_t    ns,
+                      uint64_t    bus_ns)
+{
+    am_kprintf("%s : %6u msg/s, bus busy %3u%%\n",
+               p_name,
+               (unsigned)((uint64_t)nmsg * 1000000000ull / ns),
+               (unsigned)(bus_ns * 100 / ns));
+}
+
+/* 1. ͬȡ */
+static void __test_sync (void)
+{
+    uint32_t t0;
+    uint64_t bus_ns = __g_i2c.bus_ns;
+    int      nbad   = 0;
+    int      r, i;
+
+    t0 = am_posix_timestamp_get();
+
+    for (r = 0; r < __ROUNDS; r++) {
+        for (i = 0; i < __SENSOR_NUM; i++) {
+            if (am_i2c_read(&__g_sensor[i], 2, __g_buf[i], __SENSOR_BYTES) !=
+                AM_OK) {
+                __g_nerr++;
+            }
+        }
+        am_i2c_read(&__g_rtc, 0, __g_buf[__SENSOR_NUM], __RTC_BYTES);
+        nbad += __data_check();
+    }
+
+    __report("sync",
+             __ROUNDS * (__SENSOR_NUM + 1),
+             am_posix_timestamp_get() - t0,
+             __g_i2c.bus_ns - bus_ns);
+    __check("sync: data", nbad, 0);
+}
+
+/* 2/3. 첽ȡÿύȫȴ */
+static void __test_async (const char *p_name, am_i2c_handle_t handle)
+{
+    uint32_t t0;
+    uint64_t bus_ns = __g_i2c.bus_ns;
+    int      nbad   = 0;
+    int      r, i;
+
+    for (i = 0; i < __SENSOR_NUM; i++) {
+        __g_sensor[i].handle = handle;
+    }
+    __g_rtc.handle = handle;
+
+    __g_rtc_max = 0;
+    __g_rtc_sum = 0;
+    __g_nerr    = 0;
+
+    t0 = am_posix_timestamp_get();
+
+    for (r = 0; r < __ROUNDS; r++) {
+
+        am_wait_init(&__g_wait);
+        __g_left = __SENSOR_NUM + 1;
+
+        for (i = 0; i < __SENSOR_NUM; i++) {
+            am_i2c_read_async(&__g_sensor[i],
+                              2,
+                              __g_buf[i],
+                              __SENSOR_BYTES,
+                              &__g_req[i]);
+        }
+
+        /* RTC ύȽȳȫ֮ */
+        __g_rtc_submit = am_posix_timestamp_get();
+        am_i2c_read_async(&__g_rtc,
+                          0,
+                          __g_buf[__SENSOR_NUM],
+                          __RTC_BYTES,
+                          &__g_req[__SENSOR_NUM]);
+
+        am_wait_on(&__g_wait);
+
+        nbad += __data_check();
+    }
+
+    __report(p_name,
+             __ROUNDS * (__SENSOR_NUM + 1),
+             am_posix_timestamp_get() - t0,
+             __g_i2c.bus_ns - bus_ns);
+
+    am_kprintf("%s : avg %u us, max %u us\n",
+               "  rtc latency",
+               (unsigned)(__g_rtc_sum / __ROUNDS / 1000),
+               (unsigned)(__g_rtc_max / 1000));
+
+    __check("  status", __g_nerr, 0);
+    __check("  data", nbad, 0);
+}
+
+/* 4. ڵĴӻ */
+static void __test_nodev (am_i2c_handle_t handle)
+{
+    am_i2c_device_t dev;
+    uint8_t         buf[2];
+
+    am_i2c_mkdev(&dev, handle, 0x50, AM_I2C_ADDR_7BIT | AM_I2C_SUBADDR_1BYTE);
+
+    __check("nodev: sync", am_i2c_read(&dev, 0, buf, 2), -AM_ENODEV);
+
+    am_wait_init(&__g_wait);
+    __g_left = 1;
+    __g_nerr = 0;
+    am_i2c_mkasync(&__g_req[0], __req_complete, NULL, AM_I2C_PRIO_NORMAL);
+    am_i2c_read_async(&dev, 0, buf, 2, &__g_req[0]);
+    am_wait_on(&__g_wait);
+
+    __check("nodev: async", __g_req[0].msg.status, -AM_ENODEV);
+}
+
+int main (void)
+{
+    am_i2c_handle_t bus;
+    am_i2c_handle_t sched;
+    int             i, j;
+
+    am_posix_int_init();
+    am_posix_console_init(STDOUT_FILENO);
+    am_wait_strategy_set(&am_wait_strategy_posix);
+
+    for (i = 0; i <= __SENSOR_NUM; i++) {
+        for (j = 0; j < __MEM_SIZE; j++) {
+            __g_mem[i][j] = (uint8_t)(i * 31 + j * 7 + 1);
+        }
+        __g_slaves[i].addr  = (i < __SENSOR_NUM) ? (__SENSOR_ADDR + i) :
+                                                   __RTC_ADDR;
+        __g_slaves[i].p_mem = __g_mem[i];
+        __g_slaves[i].size  = __MEM_SIZE;
+    }
+
+    bus = am_posix_i2c_init(&__g_i2c,
+                            __I2C_INUM,
+                            __BUS_HZ,
+                            __g_slaves,
+                            __SENSOR_NUM + 1);
+    if (bus == NULL) {
+        am_kprintf("i2c init failed\n");
+        return 1;
+    }
+
+    sched = am_i2c_sched_init(&__g_sched, bus);
+
+    for (i = 0; i < __SENSOR_NUM; i++) {
+        am_i2c_mkdev(&__g_sensor[i],
+                     bus,
+                     __SENSOR_ADDR + i,
+                     AM_I2C_ADDR_7BIT | AM_I2C_SUBADDR_1BYTE);
+        am_i2c_mkasync(&__g_req[i], __req_complete, NULL, AM_I2C_PRIO_NORMAL);
+    }
+    am_i2c_mkdev(&__g_rtc,
+                 bus,
+                 __RTC_ADDR,
+                 AM_I2C_ADDR_7BIT | AM_I2C_SUBADDR_1BYTE);
+
+    /* ʱЧ */
+    am_i2c_mkasync(&__g_req[__SENSOR_NUM],
+                   __rtc_complete,
+                   NULL,
+                   AM_I2C_PRIO_HIGH);
+
+    am_kprintf("%d sensors x %d bytes + rtc x %d bytes @ %d Hz, %d rounds\n",
+               __SENSOR_NUM,
+               __SENSOR_BYTES,
+               __RTC_BYTES,
+               __BUS_HZ,
+               __ROUNDS);
+
+    __g_nerr = 0;
+    __test_sync();
+    __check("sync: status", __g_nerr, 0);
+
+    __test_async("async fifo", bus);
+    __test_async("async sched", sched);
+
+    __test_nodev(bus);
+    __test_nodev(sched);
+
+    am_kprintf("%u messages, %u us bus time\n",
+               (unsigned)__g_i2c.msg_count,
+               (unsigned)(__g_i2c.bus_ns / 1000));
+
+    am_posix_i2c_deinit(&__g_i2c);
+
+    am_kprintf("%s\n", (__g_nfail == 0) ? "all passed" : "FAILED");
+
+    return (__g_nfail == 0) ? 0 : 1;
+}
+
+/* end of file */
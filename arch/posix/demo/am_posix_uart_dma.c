@@ -0,0 +1,253 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief UARTring bufferDMA ģʽ
+ *
+ * ʹģ UART am_posix_uart am_uart_rngbuf עݣ飺
+ *  1. жģʽÿֽڴһνջص
+ *  2. DMA ģʽֻнտлдһ롢ĩβʱύݣÿֻ
+ *     һνջص
+ *  3. дλÿԽĩβʱ
+ *  4. ǡдһȦͶθδʱܼ⵽ȡµݣ
+ *     ʧֽȷ
+ *  5. գûнտУʱձ߶ݲʧ
+ *  6. DMA ģʽջԼлжģʽա
+ *
+ * - ʵ
+ *   1. ÿһ "ok"  "FAIL"ȫͨʱ 0
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-16  ljy, add continuous stream check
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_vdebug.h"
+#include "am_uart_rngbuf.h"
+#include "am_posix_int.h"
+#include "am_posix_uart.h"
+#include "am_posix_console.h"
+#include <unistd.h>
+
+#define __RX_BUF_SIZE    64
+#define __STREAM_CHUNK   11         /* ʱÿעֽ */
+#define __STREAM_CHUNKS  100
+
+static am_posix_uart_dev_t  __g_uart;
+static am_uart_rngbuf_dev_t __g_rngbuf;
+static uint8_t              __g_rxbuf[__RX_BUF_SIZE];
+static uint8_t              __g_txbuf[__RX_BUF_SIZE];
+
+static uint8_t              __g_seq;           /* һעֽ */
+static uint8_t              __g_expect;        /* һӦֽ */
+static int                  __g_rx_calls;      /* ջص */
+static int                  __g_nfail;
+
+static void __rx_callback (void *p_arg)
+{
+    __g_rx_calls++;
+}
+
+/* ע len ֽ */
+static void __inject (uint32_t len)
+{
+    uint8_t buf[256];
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        buf[i] = __g_seq++;
+    }
+    am_posix_uart_rx_inject(&__g_uart, buf, len);
+}
+
+/* ȡȫݣǷ */
+static void __check_read (const char *p_name, int expect_len)
+{
+    uint8_t buf[256];
+    int     len;
+    int     i;
+    int     ok;
+
+    len = am_uart_rngbuf_receive(&__g_rngbuf, buf, sizeof(buf));
+    ok  = (len == expect_len);
+
+    for (i = 0; ok && (i < len); i++) {
+        ok = (buf[i] == __g_expect++);
+    }
+
+    am_kprintf("%s : %s (read %d, expect %d)\n",
+               p_name, ok ? "ok" : "FAIL", len, expect_len);
+
+    if (!ok) {
+        __g_nfail++;
+    }
+}
+
+static void __check (const char *p_name, int value, int expect)
+{
+    am_kprintf("%s : %s (%d, expect %d)\n",
+               p_name, (value == expect) ? "ok" : "FAIL", value, expect);
+
+    if (value != expect) {
+        __g_nfail++;
+    }
+}
+
+/* ȡǰɶȫݣǷضȡֽ */
+static int __read_avail (int *p_nbad)
+{
+    uint8_t buf[256];
+    int     len;
+    int     i;
+
+    len = am_uart_rngbuf_receive(&__g_rngbuf, buf, sizeof(buf));
+
+    for (i = 0; i < len; i++) {
+        if (buf[i] != __g_expect++) {
+            (*p_nbad)++;
+        }
+    }
+
+    return (len > 0) ? len : 0;
+}
+
+static int __nread (void)
+{
+    int n = 0;
+
+    am_uart_rngbuf_ioctl(&__g_rngbuf, AM_UART_RNGBUF_NREAD, (void *)&n);
+
+    return n;
+}
+
+static int __lost (void)
+{
+    uint32_t n = 0;
+
+    am_uart_rngbuf_ioctl(&__g_rngbuf, AM_UART_RNGBUF_RX_LOST, (void *)&n);
+
+    return (int)n;
+}
+
+int main (void)
+{
+    am_uart_handle_t handle;
+    int              ret;
+    int              lost;
+    int              total;
+    int              nbad;
+    int              i;
+
+    am_posix_int_init();
+    am_posix_console_init(STDOUT_FILENO);
+
+    handle = am_posix_uart_init(&__g_uart, -1);
+    am_uart_rngbuf_init(&__g_rngbuf,
+                        handle,
+                        __g_rxbuf,
+                        sizeof(__g_rxbuf),
+                        __g_txbuf,
+                        sizeof(__g_txbuf));
+
+    am_uart_rngbuf_ioctl(&__g_rngbuf, AM_UART_RNGBUF_TIMEOUT, (void *)AM_NO_WAIT);
+    am_uart_rngbuf_rx_trigger_cfg(&__g_rngbuf, 1, __rx_callback, NULL);
+    am_uart_rngbuf_rx_trigger_enable(&__g_rngbuf);
+
+    /* 1. жģʽֽڻص */
+    __g_rx_calls = 0;
+    __inject(20);
+    __check("int: callbacks", __g_rx_calls, 20);
+    __check_read("int: read", 20);
+
+    /* 2. DMA ģʽʱһύ */
+    ret = am_uart_rngbuf_ioctl(&__g_rngbuf,
+                               AM_UART_RNGBUF_RX_DMA_SET,
+                               (void *)AM_TRUE);
+    __check("dma: enable", ret, AM_OK);
+
+    __g_rx_calls = 0;
+    __inject(20);
+    __check("dma: before idle", __nread(), 0);
+    am_posix_uart_rx_idle(&__g_uart);
+    __check("dma: after idle", __nread(), 20);
+    __check("dma: callbacks", __g_rx_calls, 1);
+    __check_read("dma: read", 20);
+
+    /* 3. Խĩβдλ 20 -> 60 -> ĩβ -> 16 */
+    __inject(40);
+    am_posix_uart_rx_idle(&__g_uart);
+    __check_read("wrap: read 40", 40);
+    __g_rx_calls = 0;
+    __inject(20);
+    __check("wrap: end published", __nread(), 4);
+    am_posix_uart_rx_idle(&__g_uart);
+    __check("wrap: callbacks", __g_rx_calls, 2);
+    __check_read("wrap: read 20", 20);
+
+    /* 4.1 ǡдһȦµ size - 1 ֽ */
+    __inject(48);                                   /* дλûصʼλ */
+    am_posix_uart_rx_idle(&__g_uart);
+    __check_read("lap: align", 48);
+    __inject(__RX_BUF_SIZE);
+    am_posix_uart_rx_idle(&__g_uart);
+    __check("lap: lost", __lost(), 1);
+    __g_expect++;
+    __check_read("lap: read", __RX_BUF_SIZE - 1);
+
+    /* 4.2 ύ֮串δ */
+    __inject(30);
+    am_posix_uart_rx_idle(&__g_uart);
+    __inject(30);
+    am_posix_uart_rx_idle(&__g_uart);
+    __inject(30);
+    am_posix_uart_rx_idle(&__g_uart);
+    __check("overrun: lost", __lost(), 1 + 90 - (__RX_BUF_SIZE - 1));
+    __g_expect += 90 - (__RX_BUF_SIZE - 1);
+    __check_read("overrun: read", __RX_BUF_SIZE - 1);
+
+    /* 5. գûнտУÿύһΣձ߶ */
+    lost  = __lost();
+    total = 0;
+    nbad  = 0;
+    for (i = 0; i < __STREAM_CHUNKS; i++) {
+        __inject(__STREAM_CHUNK);
+        total += __read_avail(&nbad);
+    }
+    am_posix_uart_rx_idle(&__g_uart);
+    total += __read_avail(&nbad);
+    __check("stream: lost", __lost() - lost, 0);
+    __check("stream: data", nbad, 0);
+    __check("stream: read", total, __STREAM_CHUNKS * __STREAM_CHUNK);
+
+    /* 6. պлжģʽ */
+    __inject(10);
+    am_posix_uart_rx_idle(&__g_uart);
+    am_uart_rngbuf_ioctl(&__g_rngbuf, AM_UART_RNGBUF_RFLUSH, NULL);
+    __g_expect += 10;
+    __inject(5);
+    ret = am_uart_rngbuf_ioctl(&__g_rngbuf,
+                               AM_UART_RNGBUF_RX_DMA_SET,
+                               (void *)AM_FALSE);
+    __check("int: disable dma", ret, AM_OK);
+    __inject(5);
+    __check_read("int: read after dma", 10);
+
+    am_kprintf("%s\n", (__g_nfail == 0) ? "all passed" : "FAILED");
+
+    return (__g_nfail == 0) ? 0 : 1;
+}
+
+/* end of file */
@@ -0,0 +1,58 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵϢ
+ *
+ * am_kprintf() ȵʹ write() дָļ׼ж
+ * еá
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_POSIX_CONSOLE_H
+#define __AM_POSIX_CONSOLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_posix_if_console
+ * \copydoc am_posix_console.h
+ * @{
+ */
+
+/**
+ * \brief Ϣָļ
+ *
+ * \param[in] fd : ļ STDOUT_FILENO
+ *
+ * \return 
+ */
+void am_posix_console_init (int fd);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_POSIX_CONSOLE_H */
+
+/* end of file */
@@ -0,0 +1,122 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵģ I2C ߣ I2C ׼ӿ
+ *
+ * Ŀϵ I2C ͬϢȽȳ˳Ŷӣжһ
+ * ϢÿϢʱ䰴λ㣺ÿʼظʼ 1 λַ
+ * ÿֽ 9 λӦλֹͣ 1 λʡʱ߳
+ * ʱ䵽жϣжϷԴӻִд䲢Ϣɻص
+ *
+ * ӻΪ򵥵ļĴļʼдĵһֽΪĴַ֮д
+ * ݴӸõַʼַԶСʱơڵĴӻַӦϢ
+ * ״̬Ϊ -AM_ENODEV
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_POSIX_I2C_H
+#define __AM_POSIX_I2C_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "am_i2c.h"
+#include "am_list.h"
+#include <pthread.h>
+
+/**
+ * \addtogroup am_posix_if_i2c
+ * \copydoc am_posix_i2c.h
+ * @{
+ */
+
+/**
+ * \brief ģ I2C ӻĴļ
+ */
+typedef struct am_posix_i2c_slave {
+    uint16_t    addr;       /**< \brief ӻַ7-bit */
+    uint8_t    *p_mem;      /**< \brief Ĵ洢ռ */
+    uint32_t    size;       /**< \brief Ĵ洢ռС */
+    uint32_t    ptr;        /**< \brief ǰĴַ */
+} am_posix_i2c_slave_t;
+
+/**
+ * \brief ģ I2C 豸ṹ
+ */
+typedef struct am_posix_i2c_dev {
+
+    am_i2c_serv_t          i2c_serv;    /**< \brief ׼I2C */
+
+    struct am_list_head    msg_list;    /**< \brief ȴϢ */
+    am_i2c_message_t      *p_cur_msg;   /**< \brief ڴϢ */
+
+    am_posix_i2c_slave_t  *p_slaves;    /**< \brief ϵĴӻ */
+    int                    slave_num;   /**< \brief ӻĿ */
+
+    uint32_t               bus_hz;      /**< \brief  */
+    int                    inum;        /**< \brief ģжϺ */
+    int                    timer_fd;    /**< \brief ʱ䶨ʱ */
+    pthread_t              thread;      /**< \brief ʱ߳ */
+
+    uint32_t               msg_count;   /**< \brief ɵϢ */
+    uint64_t               bus_ns;      /**< \brief ۼƵʱ䣨룩 */
+
+} am_posix_i2c_dev_t;
+
+/**
+ * \brief ʼģ I2C 
+ *
+ * \param[in] p_dev     : ָģ I2C 豸ָ
+ * \param[in] inum      : ʹõжϺţģͬ
+ * \param[in] bus_hz    : ʣ 100000400000
+ * \param[in] p_slaves  : ϵĴӻ
+ * \param[in] slave_num : ӻĿ
+ *
+ * \return I2C׼Ϊ NULL ʾʼʧ
+ *
+ * \note  CPU ߳еãǰӦѵ am_posix_int_init()
+ */
+am_i2c_handle_t am_posix_i2c_init (am_posix_i2c_dev_t   *p_dev,
+                                   int                   inum,
+                                   uint32_t              bus_hz,
+                                   am_posix_i2c_slave_t *p_slaves,
+                                   int                   slave_num);
+
+/**
+ * \brief ģ I2C ߳ʼ
+ *
+ * \param[in] p_dev : ָģ I2C 豸ָ
+ *
+ * \return 
+ *
+ * \note ǰӦȴȫϢ
+ */
+void am_posix_i2c_deinit (am_posix_i2c_dev_t *p_dev);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_POSIX_I2C_H */
+
+/* end of file */
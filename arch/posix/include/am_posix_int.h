@@ -0,0 +1,108 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵжģ⣬жϱ׼ӿ
+ *
+ *      am_posix_int_init() ߳Ϊ "CPU"AMetal ĴӦڸ߳
+ * ִСжʹźţAM_POSIX_INT_SIGģ⣺̣߳綨ʱ̡߳ģ
+ * Ĳ̣߳ am_posix_int_pend() һжϺ CPU ̷߳źţ
+ * źŴажϺŴСжϺԽСȼԽߣʹжϵ
+ * жϷ
+ *
+ *     am_int_cpu_lock()  CPU ߳θźţĿϹرжͬǶ
+ * ʹáȴ am_wait_strategy_posix ʹ sigsuspend() ڽεͬʱȴ
+ * źţжִ WFI ͬѡ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_POSIX_INT_H
+#define __AM_POSIX_INT_H
+
+#include "am_common.h"
+#include "am_wait.h"
+#include <signal.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_posix_if_int
+ * \copydoc am_posix_int.h
+ * @{
+ */
+
+/** \brief ģжϵź */
+#ifndef AM_POSIX_INT_SIG
+#define AM_POSIX_INT_SIG       SIGUSR1
+#endif
+
+/** \brief ģжĿжϺΪ 0 ~ AM_POSIX_INT_NUM - 1 */
+#define AM_POSIX_INT_NUM       32
+
+/** \brief ϵͳδʱжϺţam_posix_tick_init() ʹã */
+#define AM_POSIX_INUM_TICK     0
+
+/** \brief жӳٴʹõжϺţȼͣ */
+#define AM_POSIX_INUM_PENDSV   (AM_POSIX_INT_NUM - 1)
+
+/**
+ * \brief ȴԣжϵͬʱ˯ߣsigsuspend()ֱжϷ
+ *        ̻߳
+ */
+extern const am_wait_strategy_t am_wait_strategy_posix;
+
+/**
+ * \brief ʼжģ⣬߳Ϊ CPU ߳
+ *
+ * \retval  AM_OK   : ʼɹ
+ * \retval -AM_EIO  : źŴʧ
+ */
+int am_posix_int_init (void);
+
+/**
+ * \brief һж
+ *
+ * ߳еãҲжϷźŴеáжʹ
+ *  CPU δжʱжϷ CPU ߳оִС
+ *
+ * \param[in] inum : жϺ
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_EINVAL : жϺЧ
+ */
+int am_posix_int_pend (int inum);
+
+/**
+ * \brief жϵǰǷжϷִ
+ *
+ * \return жϷз AM_TRUE
+ */
+am_bool_t am_posix_int_context (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_POSIX_INT_H */
+
+/* end of file */
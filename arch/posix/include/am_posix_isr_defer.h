@@ -0,0 +1,55 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϻжʵֵ isr defer
+ *
+ * Ŀϵ PendSV ͬжӳȼ͵ж
+ * AM_POSIX_INUM_PENDSV д am_isr_defer.h
+ *
+ * \internal
+ * \par modification history
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_POSIX_ISR_DEFER_H
+#define __AM_POSIX_ISR_DEFER_H
+
+#include "ametal.h"
+#include "am_isr_defer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief жӳģʹõȼĿjob ЧȼΪ 0 ~ 31
+ */
+#define AM_POSIX_ISR_DEFER_PRIORITY_NUM   32
+
+/**
+ * \brief ʼ isr deferжӳжд
+ *
+ * \retval  AM_OK   : ʼɹ
+ * \retval -AM_EPERM: жѱռ
+ */
+int am_posix_isr_defer_init (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_POSIX_ISR_DEFER_H */
+
+/* end of file */
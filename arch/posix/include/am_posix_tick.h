@@ -0,0 +1,74 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵϵͳδ
+ *
+ * ʱ̵߳ȴԵ timerfdCLOCK_MONOTONICڣۼƵڴ
+ * AM_POSIX_INUM_TICK жϣжϷϵͳδam_system_module_tick()
+ * ʱam_softimer_module_tick()CPU ߳жڼ䵽ڵĵδ
+ * ᶪʧκһδ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_POSIX_TICK_H
+#define __AM_POSIX_TICK_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_posix_if_tick
+ * \copydoc am_posix_tick.h
+ * @{
+ */
+
+/**
+ * \brief ʼϵͳδ
+ *
+ * ʼϵͳδģʱģ飬ȵ am_posix_int_init()
+ *
+ * \param[in] tick_rate : δƵʣHz1 ~ 1000000
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EIO    : ʱ߳ʧ
+ * \retval -AM_EBUSY  : Ѿ
+ */
+int am_posix_tick_init (unsigned int tick_rate);
+
+/**
+ * \brief ֹͣϵͳδ
+ *
+ * \return 
+ */
+void am_posix_tick_deinit (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_POSIX_TICK_H */
+
+/* end of file */
@@ -0,0 +1,61 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵʱ
+ *
+ *  CLOCK_MONOTONIC ȡ 32 λ׼Կܡ
+ * кʱͳƵʱӦĿϵ DWT ڼ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_POSIX_TIMESTAMP_H
+#define __AM_POSIX_TIMESTAMP_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_posix_if_timestamp
+ * \copydoc am_posix_timestamp.h
+ * @{
+ */
+
+/** \brief ʱļƵʣHz */
+#define AM_POSIX_TIMESTAMP_HZ    1000000000ul
+
+/**
+ * \brief ȡʱ
+ *
+ * \return Լ 4.3s һ
+ */
+uint32_t am_posix_timestamp_get (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_POSIX_TIMESTAMP_H */
+
+/* end of file */
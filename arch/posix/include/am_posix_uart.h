@@ -0,0 +1,127 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵģ UART  UART ׼ӿ
+ *
+ * л UART ׼ӿڵ am_uart_rngbuf
+ * am_posix_uart_rx_inject() ע룬дָļ
+ *
+ * ֲ֧ѯжϺ DMA ģʽ
+ *  - жģʽ£עÿֽͨ AM_UART_CALLBACK_RXCHAR_PUT صύ
+ *  - DMA ģʽ£עѭд AM_UART_RXBUF_SET õĻд
+ *    һĩβʱύдλãģ⴫ʹжϣĩβύС
+ *    am_posix_uart_rx_idle() ģտУύǰдλá
+ *
+ * ע AM_UART_CALLBACK_TXCHARS_GET صʱͰȡݣÿһ
+ * write()ֽȡ
+ *
+ * עͿкģжϣִʱжϡ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.02 26-10-16  ljy, publish DMA write index on half buffer.
+ * - 1.01 26-10-16  ljy, add chunked TX.
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_POSIX_UART_H
+#define __AM_POSIX_UART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "am_uart.h"
+
+/**
+ * \addtogroup am_posix_if_uart
+ * \copydoc am_posix_uart.h
+ * @{
+ */
+
+/**
+ * \brief ģ UART 豸ṹ
+ */
+typedef struct am_posix_uart_dev {
+
+    am_uart_serv_t          uart_serv;        /**< \brief ׼UART */
+
+    am_uart_txchar_get_t    pfn_txchar_get;   /**< \brief ȡַص */
+    void                   *txget_arg;        /**< \brief txchar_get */
+    am_uart_txchars_get_t   pfn_txchars_get;  /**< \brief ȡַص */
+    void                   *txchars_arg;      /**< \brief txchars_get */
+    am_uart_rxchar_put_t    pfn_rxchar_put;   /**< \brief ύַص */
+    void                   *rxput_arg;        /**< \brief rxchar_put */
+    am_uart_rxbuf_update_t  pfn_rxbuf_update; /**< \brief ύдλûص */
+    void                   *rxbuf_arg;        /**< \brief rxbuf_update */
+    am_uart_err_t           pfn_err;          /**< \brief ص */
+    void                   *err_arg;          /**< \brief ص */
+
+    int                     tx_fd;            /**< \brief дļ */
+    uint32_t                channel_mode;     /**< \brief ǰģʽ */
+    uint32_t                baud_rate;        /**< \brief  */
+    uint32_t                options;          /**< \brief Ӳѡ */
+
+    uint8_t                *p_dma_buf;        /**< \brief DMAջ */
+    uint32_t                dma_size;         /**< \brief DMAջС */
+    uint32_t                dma_pos;          /**< \brief DMAǰдλ */
+
+    uint32_t                rx_lost;          /**< \brief δύĽֽ */
+
+} am_posix_uart_dev_t;
+
+/**
+ * \brief ʼģ UART
+ *
+ * \param[in] p_dev : ָģ UART 豸ָ
+ * \param[in] tx_fd : дļ-1 ʾ͵
+ *
+ * \return UART׼
+ */
+am_uart_handle_t am_posix_uart_init (am_posix_uart_dev_t *p_dev, int tx_fd);
+
+/**
+ * \brief ģյһ
+ *
+ * \param[in] p_dev  : ָģ UART 豸ָ
+ * \param[in] p_data : յ
+ * \param[in] len    : ݳ
+ *
+ * \return 
+ */
+void am_posix_uart_rx_inject (am_posix_uart_dev_t *p_dev,
+                              const uint8_t       *p_data,
+                              uint32_t             len);
+
+/**
+ * \brief ģտУDMA ģʽύǰдλã
+ *
+ * \param[in] p_dev : ָģ UART 豸ָ
+ *
+ * \return 
+ */
+void am_posix_uart_rx_idle (am_posix_uart_dev_t *p_dev);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_POSIX_UART_H */
+
+/* end of file */
@@ -0,0 +1,57 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵϢʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_koutput.h"
+#include "am_posix_console.h"
+#include <string.h>
+#include <unistd.h>
+
+static int __g_console_fd = -1;
+
+/* һַ */
+static int __console_putc (const char c, void *fil)
+{
+    (void)fil;
+
+    return (write(__g_console_fd, &c, 1) == 1) ? 1 : -1;
+}
+
+/* һַ */
+static int __console_puts (const char *s, void *fil)
+{
+    size_t len = strlen(s);
+
+    (void)fil;
+
+    return (int)write(__g_console_fd, s, len);
+}
+
+/******************************************************************************/
+void am_posix_console_init (int fd)
+{
+    __g_console_fd = fd;
+
+    am_koutput_set(NULL, __console_putc, __console_puts);
+}
+
+/* end of file */
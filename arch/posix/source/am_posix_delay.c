@@ -0,0 +1,57 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵʱʵ
+ *
+ * ʱڼ߳˯ߣжϣźţԻõĿϵΪͬ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_delay.h"
+#include <errno.h>
+#include <time.h>
+
+/* ˯ߵ ns ֮󣬱źжʱ˯ */
+static void __delay_ns (uint64_t ns)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    ns         += (uint64_t)ts.tv_nsec;
+    ts.tv_sec  += (time_t)(ns / 1000000000ull);
+    ts.tv_nsec  = (long)(ns % 1000000000ull);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+/******************************************************************************/
+void am_mdelay (uint32_t nms)
+{
+    __delay_ns((uint64_t)nms * 1000000ull);
+}
+
+/******************************************************************************/
+void am_udelay (uint32_t nus)
+{
+    __delay_ns((uint64_t)nus * 1000ull);
+}
+
+/* end of file */
@@ -0,0 +1,299 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵģ I2C ʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_int.h"
+#include "am_posix_int.h"
+#include "am_posix_i2c.h"
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/* λϢռõʱ䣨룩 */
+static uint64_t __msg_bus_ns (am_posix_i2c_dev_t *p_dev,
+                              am_i2c_message_t   *p_msg)
+{
+    am_i2c_transfer_t *p_trans = p_msg->p_transfers;
+    uint64_t           bits    = 1;                     /* ֹͣ */
+    int                i;
+
+    for (i = 0; i < p_msg->trans_num; i++, p_trans++) {
+
+        /* ʼ͵ַ */
+        if (!(p_trans->flags & AM_I2C_M_NOSTART)) {
+            bits += 1 + 9;
+            if (p_trans->flags & AM_I2C_M_10BIT) {
+                bits += 9;
+            }
+        }
+        bits += 9 * (uint64_t)p_trans->nbytes;
+    }
+
+    return bits * 1000000000ull / p_dev->bus_hz;
+}
+
+static am_posix_i2c_slave_t *__slave_find (am_posix_i2c_dev_t *p_dev,
+                                           uint16_t            addr)
+{
+    int i;
+
+    for (i = 0; i < p_dev->slave_num; i++) {
+        if (p_dev->p_slaves[i].addr == addr) {
+            return &p_dev->p_slaves[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* ԴӻִϢеȫ */
+static void __msg_exec (am_posix_i2c_dev_t *p_dev, am_i2c_message_t *p_msg)
+{
+    am_i2c_transfer_t    *p_trans = p_msg->p_transfers;
+    am_posix_i2c_slave_t *p_slave = NULL;
+    am_bool_t             first   = AM_FALSE;
+    uint32_t              n;
+
+    p_msg->status = AM_OK;
+
+    for (p_msg->done_num = 0;
+         p_msg->done_num < p_msg->trans_num;
+         p_msg->done_num++, p_trans++) {
+
+        if (!(p_trans->flags & AM_I2C_M_NOSTART) || (p_slave == NULL)) {
+            p_slave = __slave_find(p_dev, p_trans->addr);
+            first   = AM_TRUE;
+        }
+
+        if (p_slave == NULL) {
+            p_msg->status = -AM_ENODEV;
+            break;
+        }
+
+        for (n = 0; n < p_trans->nbytes; n++) {
+
+            if (p_trans->flags & AM_I2C_M_RD) {
+                p_trans->p_buf[n] = p_slave->p_mem[p_slave->ptr];
+            } else if (first) {
+
+                /* ʼдĵһֽΪĴַ */
+                p_slave->ptr = p_trans->p_buf[n] % p_slave->size;
+                first        = AM_FALSE;
+                continue;
+            } else {
+                p_slave->p_mem[p_slave->ptr] = p_trans->p_buf[n];
+            }
+
+            p_slave->ptr = (p_slave->ptr + 1) % p_slave->size;
+        }
+    }
+}
+
+/* еһϢʱжѹر */
+static void __msg_next (am_posix_i2c_dev_t *p_dev)
+{
+    struct am_list_head *p_node;
+    struct itimerspec    its;
+    uint64_t             ns;
+
+    if ((p_dev->p_cur_msg != NULL) || am_list_empty(&p_dev->msg_list)) {
+        return;
+    }
+
+    p_node = p_dev->msg_list.next;
+    am_list_del(p_node);
+
+    p_dev->p_cur_msg = am_list_entry(p_node, am_i2c_message_t, ctlrdata);
+
+    ns = __msg_bus_ns(p_dev, p_dev->p_cur_msg);
+    p_dev->bus_ns += ns;
+
+    /* ʱֵΪ 0 ʱʱ */
+    if (ns == 0) {
+        ns = 1;
+    }
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec  = ns / 1000000000ull;
+    its.it_value.tv_nsec = ns % 1000000000ull;
+
+    timerfd_settime(p_dev->timer_fd, 0, &its, NULL);
+}
+
+/* жϷ */
+static void __i2c_isr (void *p_arg)
+{
+    am_posix_i2c_dev_t *p_dev = (am_posix_i2c_dev_t *)p_arg;
+    am_i2c_message_t   *p_msg = p_dev->p_cur_msg;
+    int                 key;
+
+    if (p_msg == NULL) {
+        return;
+    }
+
+    __msg_exec(p_dev, p_msg);
+
+    key = am_int_cpu_lock();
+
+    p_dev->msg_count++;
+    p_dev->p_cur_msg = NULL;
+
+    /* һϢ߲ɻص */
+    __msg_next(p_dev);
+
+    am_int_cpu_unlock(key);
+
+    if (p_msg->pfn_complete != NULL) {
+        p_msg->pfn_complete(p_msg->p_arg);
+    }
+}
+
+/* ʱ̣߳ʱ䵽ж */
+static void *__i2c_thread (void *p_arg)
+{
+    am_posix_i2c_dev_t *p_dev = (am_posix_i2c_dev_t *)p_arg;
+    uint64_t            expirations;
+    sigset_t            mask;
+
+    /* źֻ CPU ̴߳ */
+    sigfillset(&mask);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    for (;;) {
+        if (read(p_dev->timer_fd, &expirations, sizeof(expirations)) !=
+            sizeof(expirations)) {
+            continue;
+        }
+
+        am_posix_int_pend(p_dev->inum);
+    }
+
+    return NULL;
+}
+
+static int __i2c_msg_start (void *p_drv, am_i2c_message_t *p_msg)
+{
+    am_posix_i2c_dev_t *p_dev = (am_posix_i2c_dev_t *)p_drv;
+    int                 key;
+
+    if ((p_dev == NULL) || (p_msg == NULL) ||
+        (p_msg->p_transfers == NULL) || (p_msg->trans_num == 0)) {
+        return -AM_EINVAL;
+    }
+
+    p_msg->status   = -AM_EISCONN;          /* Ŷ */
+    p_msg->done_num = 0;
+
+    key = am_int_cpu_lock();
+
+    am_list_add_tail((struct am_list_head *)(&p_msg->ctlrdata),
+                     &p_dev->msg_list);
+
+    __msg_next(p_dev);
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/** \brief I2C  */
+static const struct am_i2c_drv_funcs __g_i2c_drv_funcs = {
+    __i2c_msg_start,
+};
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+am_i2c_handle_t am_posix_i2c_init (am_posix_i2c_dev_t   *p_dev,
+                                   int                   inum,
+                                   uint32_t              bus_hz,
+                                   am_posix_i2c_slave_t *p_slaves,
+                                   int                   slave_num)
+{
+    if ((p_dev == NULL) || (bus_hz == 0) ||
+        ((p_slaves == NULL) && (slave_num != 0))) {
+        return NULL;
+    }
+
+    memset(p_dev, 0, sizeof(*p_dev));
+
+    am_list_head_init(&p_dev->msg_list);
+
+    p_dev->i2c_serv.p_funcs = (struct am_i2c_drv_funcs *)&__g_i2c_drv_funcs;
+    p_dev->i2c_serv.p_drv   = p_dev;
+    p_dev->p_slaves         = p_slaves;
+    p_dev->slave_num        = slave_num;
+    p_dev->bus_hz           = bus_hz;
+    p_dev->inum             = inum;
+    p_dev->timer_fd         = -1;
+
+    if (am_int_connect(inum, __i2c_isr, p_dev) != AM_OK) {
+        return NULL;
+    }
+    am_int_enable(inum);
+
+    p_dev->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (p_dev->timer_fd < 0) {
+        goto failed;
+    }
+
+    if (pthread_create(&p_dev->thread, NULL, __i2c_thread, p_dev) != 0) {
+        goto failed;
+    }
+
+    return &(p_dev->i2c_serv);
+
+failed:
+    if (p_dev->timer_fd >= 0) {
+        close(p_dev->timer_fd);
+        p_dev->timer_fd = -1;
+    }
+    am_int_disable(inum);
+    am_int_disconnect(inum, __i2c_isr, p_dev);
+
+    return NULL;
+}
+
+/******************************************************************************/
+void am_posix_i2c_deinit (am_posix_i2c_dev_t *p_dev)
+{
+    if ((p_dev == NULL) || (p_dev->timer_fd < 0)) {
+        return;
+    }
+
+    /* read() ȡ */
+    pthread_cancel(p_dev->thread);
+    pthread_join(p_dev->thread, NULL);
+
+    close(p_dev->timer_fd);
+    p_dev->timer_fd = -1;
+
+    am_int_disable(p_dev->inum);
+    am_int_disconnect(p_dev->inum, __i2c_isr, p_dev);
+}
+
+/* end of file */
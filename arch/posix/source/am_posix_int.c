@@ -0,0 +1,294 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵжģʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_int.h"
+#include "am_posix_int.h"
+#include <pthread.h>
+#include <signal.h>
+
+/*******************************************************************************
+  ȫֱ
+*******************************************************************************/
+
+/** \brief жϷϢ */
+struct __posix_isrinfo {
+    am_pfnvoid_t  pfn_isr;
+    void         *p_arg;
+};
+
+static struct __posix_isrinfo __g_isrinfo[AM_POSIX_INT_NUM];
+
+/** \brief ѹжϣÿжһλ */
+static volatile uint32_t      __g_int_pending = 0;
+
+/** \brief ʹܵжϣÿжһλ */
+static volatile uint32_t      __g_int_enabled = 0;
+
+/** \brief жǶȣ CPU ߳޸ģ */
+static volatile sig_atomic_t  __g_int_nest    = 0;
+
+/** \brief CPU ߳ */
+static pthread_t              __g_cpu_thread;
+static am_bool_t              __g_int_valid   = AM_FALSE;
+
+/** \brief  AM_POSIX_INT_SIG źż */
+static sigset_t               __g_int_sigset;
+
+/*******************************************************************************
+  ڲ
+*******************************************************************************/
+
+/* Ƿ CPU ̵߳жϷ */
+static am_bool_t __int_context (void)
+{
+    return (am_bool_t)(__g_int_valid &&
+                       (__g_int_nest != 0) &&
+                       pthread_equal(pthread_self(), __g_cpu_thread));
+}
+
+/* ֪ͨ CPU ̴߳жϣжϷʱǰٴμ */
+static void __int_signal (void)
+{
+    if (__g_int_valid && !__int_context()) {
+        pthread_kill(__g_cpu_thread, AM_POSIX_INT_SIG);
+    }
+}
+
+/* жϴźŴڼ AM_POSIX_INT_SIG ΣжϲǶ */
+static void __int_handler (int sig)
+{
+    uint32_t      pending;
+    uint32_t      bit;
+    int           inum;
+    am_pfnvoid_t  pfn_isr;
+
+    (void)sig;
+
+    __g_int_nest++;
+
+    for (;;) {
+        pending = __g_int_pending & __g_int_enabled;
+        if (pending == 0) {
+            break;
+        }
+
+        /* жϺԽСȼԽ */
+        inum = __builtin_ctz(pending);
+        bit  = 1ul << inum;
+
+        __atomic_fetch_and(&__g_int_pending, ~bit, __ATOMIC_SEQ_CST);
+
+        pfn_isr = __g_isrinfo[inum].pfn_isr;
+        if (pfn_isr != NULL) {
+            pfn_isr(__g_isrinfo[inum].p_arg);
+        }
+    }
+
+    __g_int_nest--;
+}
+
+/* ȴԣжϵͬʱȴź */
+static void __wait_idle_posix (void *p_arg, uint32_t key)
+{
+    sigset_t mask;
+
+    (void)p_arg;
+    (void)key;
+
+    pthread_sigmask(SIG_BLOCK, NULL, &mask);
+    sigdelset(&mask, AM_POSIX_INT_SIG);
+
+    /* ʱָΪ״̬ */
+    sigsuspend(&mask);
+}
+
+/* ȴԣ߳ɵȴʱ CPU ߳ */
+static void __wait_wake_posix (void *p_arg)
+{
+    (void)p_arg;
+
+    if (__g_int_valid && !pthread_equal(pthread_self(), __g_cpu_thread)) {
+        pthread_kill(__g_cpu_thread, AM_POSIX_INT_SIG);
+    }
+}
+
+/** \brief ȴԣsigsuspend() ˯ */
+const am_wait_strategy_t am_wait_strategy_posix = {
+    __wait_idle_posix,
+    __wait_wake_posix,
+    NULL
+};
+
+/*******************************************************************************
+  
+*******************************************************************************/
+
+int am_posix_int_init (void)
+{
+    struct sigaction sa;
+    int              i;
+
+    for (i = 0; i < AM_POSIX_INT_NUM; i++) {
+        __g_isrinfo[i].pfn_isr = NULL;
+        __g_isrinfo[i].p_arg   = NULL;
+    }
+    __g_int_pending = 0;
+    __g_int_enabled = 0;
+
+    sigemptyset(&__g_int_sigset);
+    sigaddset(&__g_int_sigset, AM_POSIX_INT_SIG);
+
+    sa.sa_handler = __int_handler;
+    sa.sa_flags   = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaddset(&sa.sa_mask, AM_POSIX_INT_SIG);
+
+    if (sigaction(AM_POSIX_INT_SIG, &sa, NULL) != 0) {
+        return -AM_EIO;
+    }
+
+    __g_cpu_thread = pthread_self();
+    __g_int_valid  = AM_TRUE;
+
+    pthread_sigmask(SIG_UNBLOCK, &__g_int_sigset, NULL);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_posix_int_pend (int inum)
+{
+    if ((inum < 0) || (inum >= AM_POSIX_INT_NUM)) {
+        return -AM_EINVAL;
+    }
+
+    __atomic_fetch_or(&__g_int_pending, 1ul << inum, __ATOMIC_SEQ_CST);
+
+    __int_signal();
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+am_bool_t am_posix_int_context (void)
+{
+    return __int_context();
+}
+
+/******************************************************************************/
+int am_int_connect (int inum, am_pfnvoid_t pfn_isr, void *p_arg)
+{
+    uint32_t key;
+
+    if ((inum < 0) || (inum >= AM_POSIX_INT_NUM) || (pfn_isr == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    if (__g_isrinfo[inum].pfn_isr != NULL) {
+        if ((__g_isrinfo[inum].pfn_isr == pfn_isr) &&
+            (__g_isrinfo[inum].p_arg   == p_arg)) {
+            return AM_OK;
+        }
+        return -AM_EPERM;
+    }
+
+    key = am_int_cpu_lock();
+    __g_isrinfo[inum].p_arg   = p_arg;
+    __g_isrinfo[inum].pfn_isr = pfn_isr;
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_int_disconnect (int inum, am_pfnvoid_t pfn_isr, void *p_arg)
+{
+    uint32_t key;
+
+    (void)p_arg;
+
+    if ((inum < 0) || (inum >= AM_POSIX_INT_NUM) || (pfn_isr == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    if (__g_isrinfo[inum].pfn_isr == NULL) {
+        return -AM_EPERM;
+    }
+
+    key = am_int_cpu_lock();
+    __g_isrinfo[inum].pfn_isr = NULL;
+    __g_isrinfo[inum].p_arg   = NULL;
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_int_enable (int inum)
+{
+    if ((inum < 0) || (inum >= AM_POSIX_INT_NUM)) {
+        return -AM_EINVAL;
+    }
+
+    __atomic_fetch_or(&__g_int_enabled, 1ul << inum, __ATOMIC_SEQ_CST);
+
+    /* ʹǰѹж */
+    if (__g_int_pending & (1ul << inum)) {
+        __int_signal();
+    }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_int_disable (int inum)
+{
+    if ((inum < 0) || (inum >= AM_POSIX_INT_NUM)) {
+        return -AM_EINVAL;
+    }
+
+    __atomic_fetch_and(&__g_int_enabled, ~(1ul << inum), __ATOMIC_SEQ_CST);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+uint32_t am_int_cpu_lock (void)
+{
+    sigset_t old;
+
+    pthread_sigmask(SIG_BLOCK, &__g_int_sigset, &old);
+
+    /* صǰ״̬1 ʾѾ */
+    return sigismember(&old, AM_POSIX_INT_SIG) ? 1 : 0;
+}
+
+/******************************************************************************/
+void am_int_cpu_unlock (uint32_t key)
+{
+    if (key == 0) {
+        pthread_sigmask(SIG_UNBLOCK, &__g_int_sigset, NULL);
+    }
+}
+
+/* end of file */
@@ -0,0 +1,70 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϻжʵֵ isr defer
+ *
+ * \internal
+ * \par modification history
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_int.h"
+#include "am_isr_defer.h"
+#include "am_posix_int.h"
+#include "am_posix_isr_defer.h"
+
+/*******************************************************************************
+  ڲ
+*******************************************************************************/
+static void __isr_defer_trigger (void *p_arg)
+{
+    (void)p_arg;
+
+    am_posix_int_pend(AM_POSIX_INUM_PENDSV);
+}
+
+/* жϴ */
+static void __isr_defer_isr (void *p_arg)
+{
+    (void)p_arg;
+
+    am_isr_defer_job_process();
+}
+
+/*******************************************************************************
+  ȼĿ
+*******************************************************************************/
+AM_ISR_DEFER_PRIORITY_NUM_DEF(AM_POSIX_ISR_DEFER_PRIORITY_NUM);
+
+/*******************************************************************************
+  
+*******************************************************************************/
+int am_posix_isr_defer_init (void)
+{
+    int ret;
+
+    ret = am_int_connect(AM_POSIX_INUM_PENDSV, __isr_defer_isr, NULL);
+    if (ret != AM_OK) {
+        return ret;
+    }
+    am_int_enable(AM_POSIX_INUM_PENDSV);
+
+    am_isr_defer_init(__isr_defer_trigger, NULL);
+
+    return AM_OK;
+}
+
+/* end of file */
@@ -0,0 +1,168 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵϵͳδʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_int.h"
+#include "am_system.h"
+#include "am_softimer.h"
+#include "am_posix_int.h"
+#include "am_posix_tick.h"
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+/*******************************************************************************
+  ȫֱ
+*******************************************************************************/
+
+static int                __g_tick_fd      = -1;
+static pthread_t          __g_tick_thread;
+
+/** \brief ѵڵδĵδ */
+static volatile uint32_t  __g_tick_pending = 0;
+
+/*******************************************************************************
+  ڲ
+*******************************************************************************/
+
+/* δжϷ */
+static void __tick_isr (void *p_arg)
+{
+    uint32_t n;
+
+    (void)p_arg;
+
+    n = __atomic_exchange_n(&__g_tick_pending, 0, __ATOMIC_SEQ_CST);
+
+    while (n-- > 0) {
+        am_system_module_tick();
+        am_softimer_module_tick();
+    }
+}
+
+/* ʱ߳ */
+static void *__tick_thread (void *p_arg)
+{
+    uint64_t expirations;
+    sigset_t mask;
+
+    (void)p_arg;
+
+    /* źֻ CPU ̴߳ */
+    sigfillset(&mask);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    for (;;) {
+        if (read(__g_tick_fd, &expirations, sizeof(expirations)) !=
+            sizeof(expirations)) {
+            continue;
+        }
+
+        __atomic_fetch_add(&__g_tick_pending,
+                           (uint32_t)expirations,
+                           __ATOMIC_SEQ_CST);
+
+        am_posix_int_pend(AM_POSIX_INUM_TICK);
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+  
+*******************************************************************************/
+
+int am_posix_tick_init (unsigned int tick_rate)
+{
+    struct itimerspec its;
+    long              period_ns;
+
+    if ((tick_rate == 0) || (tick_rate > 1000000)) {
+        return -AM_EINVAL;
+    }
+
+    if (__g_tick_fd >= 0) {
+        return -AM_EBUSY;
+    }
+
+    am_system_module_init(tick_rate);
+    am_softimer_module_init(tick_rate);
+
+    __g_tick_pending = 0;
+
+    if (am_int_connect(AM_POSIX_INUM_TICK, __tick_isr, NULL) != AM_OK) {
+        return -AM_EIO;
+    }
+    am_int_enable(AM_POSIX_INUM_TICK);
+
+    __g_tick_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (__g_tick_fd < 0) {
+        goto failed;
+    }
+
+    period_ns = 1000000000l / tick_rate;
+
+    its.it_interval.tv_sec  = period_ns / 1000000000l;
+    its.it_interval.tv_nsec = period_ns % 1000000000l;
+    its.it_value            = its.it_interval;
+
+    if (timerfd_settime(__g_tick_fd, 0, &its, NULL) != 0) {
+        goto failed;
+    }
+
+    if (pthread_create(&__g_tick_thread, NULL, __tick_thread, NULL) != 0) {
+        goto failed;
+    }
+
+    return AM_OK;
+
+failed:
+    if (__g_tick_fd >= 0) {
+        close(__g_tick_fd);
+        __g_tick_fd = -1;
+    }
+    am_int_disable(AM_POSIX_INUM_TICK);
+    am_int_disconnect(AM_POSIX_INUM_TICK, __tick_isr, NULL);
+
+    return -AM_EIO;
+}
+
+/******************************************************************************/
+void am_posix_tick_deinit (void)
+{
+    if (__g_tick_fd < 0) {
+        return;
+    }
+
+    /* read() ȡ */
+    pthread_cancel(__g_tick_thread);
+    pthread_join(__g_tick_thread, NULL);
+
+    close(__g_tick_fd);
+    __g_tick_fd = -1;
+
+    am_int_disable(AM_POSIX_INUM_TICK);
+    am_int_disconnect(AM_POSIX_INUM_TICK, __tick_isr, NULL);
+}
+
+/* end of file */
@@ -0,0 +1,322 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief POSIX ϵģ UART ʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.02 26-10-16  ljy, publish DMA write index on half buffer.
+ * - 1.01 26-10-16  ljy, add chunked TX.
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_int.h"
+#include "am_posix_uart.h"
+#include <string.h>
+#include <unistd.h>
+
+/** \brief 鷢ʱÿȡֽ */
+#define __TX_CHUNK_SIZE    64
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/* ύ DMA дλ */
+static void __rx_dma_publish (am_posix_uart_dev_t *p_dev, uint32_t wr_idx)
+{
+    if (p_dev->pfn_rxbuf_update != NULL) {
+        p_dev->pfn_rxbuf_update(p_dev->rxbuf_arg, wr_idx);
+    }
+}
+
+static int __uart_mode_set (am_posix_uart_dev_t *p_dev, uint32_t new_mode)
+{
+    if ((new_mode != AM_UART_MODE_POLL) &&
+        (new_mode != AM_UART_MODE_INT)  &&
+        (new_mode != AM_UART_MODE_DMA)) {
+        return -AM_EIO;
+    }
+
+    /* ˳ DMA ģʽʱύдλ */
+    if ((p_dev->channel_mode == AM_UART_MODE_DMA) &&
+        (new_mode != AM_UART_MODE_DMA)) {
+        __rx_dma_publish(p_dev, p_dev->dma_pos);
+    }
+
+    if ((new_mode == AM_UART_MODE_DMA) &&
+        (p_dev->channel_mode != AM_UART_MODE_DMA)) {
+
+        if ((p_dev->p_dma_buf == NULL) ||
+            (p_dev->dma_size == 0) ||
+            (p_dev->pfn_rxbuf_update == NULL)) {
+            return -AM_EIO;
+        }
+        p_dev->dma_pos = 0;
+    }
+
+    p_dev->channel_mode = new_mode;
+
+    return AM_OK;
+}
+
+static int __uart_ioctl (void *p_drv, int request, void *p_arg)
+{
+    am_posix_uart_dev_t *p_dev  = (am_posix_uart_dev_t *)p_drv;
+    am_uart_rxbuf_t     *p_rxbuf;
+    int                  status = AM_OK;
+
+    switch (request) {
+
+    case AM_UART_BAUD_SET:
+        p_dev->baud_rate = (uint32_t)(uintptr_t)p_arg;
+        break;
+
+    case AM_UART_BAUD_GET:
+        *(int *)p_arg = p_dev->baud_rate;
+        break;
+
+    case AM_UART_OPTS_SET:
+        p_dev->options = (uint32_t)(uintptr_t)p_arg;
+        break;
+
+    case AM_UART_OPTS_GET:
+        *(int *)p_arg = p_dev->options;
+        break;
+
+    case AM_UART_MODE_SET:
+        status = __uart_mode_set(p_dev, (uint32_t)(uintptr_t)p_arg);
+        break;
+
+    case AM_UART_MODE_GET:
+        *(int *)p_arg = p_dev->channel_mode;
+        break;
+
+    case AM_UART_AVAIL_MODES_GET:
+        *(int *)p_arg = AM_UART_MODE_POLL | AM_UART_MODE_INT | AM_UART_MODE_DMA;
+        break;
+
+    case AM_UART_RXBUF_SET:
+        p_rxbuf = (am_uart_rxbuf_t *)p_arg;
+        if (p_dev->channel_mode == AM_UART_MODE_DMA) {
+            status = -AM_EBUSY;
+        } else if (p_rxbuf == NULL) {
+            status = -AM_EINVAL;
+        } else {
+            p_dev->p_dma_buf = p_rxbuf->p_buf;
+            p_dev->dma_size  = p_rxbuf->size;
+        }
+        break;
+
+    default:
+        status = -AM_EIO;
+        break;
+    }
+
+    return status;
+}
+
+/* жģ⣺ȡȫ */
+static int __uart_tx_startup (void *p_drv)
+{
+    am_posix_uart_dev_t *p_dev = (am_posix_uart_dev_t *)p_drv;
+    char                 data;
+    char                 chunk[__TX_CHUNK_SIZE];
+    int                  len;
+    int                  key;
+
+    key = am_int_cpu_lock();
+
+    if (p_dev->pfn_txchars_get != NULL) {
+        while ((len = p_dev->pfn_txchars_get(p_dev->txchars_arg,
+                                             chunk,
+                                             sizeof(chunk))) > 0) {
+            if (p_dev->tx_fd >= 0) {
+                (void)write(p_dev->tx_fd, chunk, len);
+            }
+        }
+    }
+
+    /* δעᰴص򰴿ص֮ */
+    while ((p_dev->pfn_txchar_get != NULL) &&
+           (p_dev->pfn_txchar_get(p_dev->txget_arg, &data) == AM_OK)) {
+        if (p_dev->tx_fd >= 0) {
+            (void)write(p_dev->tx_fd, &data, 1);
+        }
+    }
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+static int __uart_callback_set (void  *p_drv,
+                                int    callback_type,
+                                void  *pfn_callback,
+                                void  *p_arg)
+{
+    am_posix_uart_dev_t *p_dev = (am_posix_uart_dev_t *)p_drv;
+
+    switch (callback_type) {
+
+    case AM_UART_CALLBACK_TXCHAR_GET:
+        p_dev->pfn_txchar_get = (am_uart_txchar_get_t)pfn_callback;
+        p_dev->txget_arg      = p_arg;
+        return AM_OK;
+
+    case AM_UART_CALLBACK_TXCHARS_GET:
+        p_dev->pfn_txchars_get = (am_uart_txchars_get_t)pfn_callback;
+        p_dev->txchars_arg     = p_arg;
+        return AM_OK;
+
+    case AM_UART_CALLBACK_RXCHAR_PUT:
+        p_dev->pfn_rxchar_put = (am_uart_rxchar_put_t)pfn_callback;
+        p_dev->rxput_arg      = p_arg;
+        return AM_OK;
+
+    case AM_UART_CALLBACK_ERROR:
+        p_dev->pfn_err = (am_uart_err_t)pfn_callback;
+        p_dev->err_arg = p_arg;
+        return AM_OK;
+
+    case AM_UART_CALLBACK_RXBUF_UPDATE:
+        p_dev->pfn_rxbuf_update = (am_uart_rxbuf_update_t)pfn_callback;
+        p_dev->rxbuf_arg        = p_arg;
+        return AM_OK;
+
+    default:
+        return -AM_ENOTSUP;
+    }
+}
+
+/* ģ UART ûнռĴѯδ */
+static int __uart_poll_getchar (void *p_drv, char *p_char)
+{
+    return -AM_EAGAIN;
+}
+
+static int __uart_poll_putchar (void *p_drv, char outchar)
+{
+    am_posix_uart_dev_t *p_dev = (am_posix_uart_dev_t *)p_drv;
+
+    if (p_dev->tx_fd >= 0) {
+        (void)write(p_dev->tx_fd, &outchar, 1);
+    }
+
+    return AM_OK;
+}
+
+/** \brief ׼ӿںʵ */
+static const struct am_uart_drv_funcs __g_uart_drv_funcs = {
+    __uart_ioctl,
+    __uart_tx_startup,
+    __uart_callback_set,
+    __uart_poll_getchar,
+    __uart_poll_putchar,
+};
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+am_uart_handle_t am_posix_uart_init (am_posix_uart_dev_t *p_dev, int tx_fd)
+{
+    if (p_dev == NULL) {
+        return NULL;
+    }
+
+    memset(p_dev, 0, sizeof(*p_dev));
+
+    p_dev->uart_serv.p_funcs = (struct am_uart_drv_funcs *)&__g_uart_drv_funcs;
+    p_dev->uart_serv.p_drv   = p_dev;
+    p_dev->tx_fd             = tx_fd;
+    p_dev->channel_mode      = AM_UART_MODE_POLL;
+    p_dev->baud_rate         = 115200;
+    p_dev->options           = AM_UART_CS8;
+
+    return &(p_dev->uart_serv);
+}
+
+/******************************************************************************/
+void am_posix_uart_rx_inject (am_posix_uart_dev_t *p_dev,
+                              const uint8_t       *p_data,
+                              uint32_t             len)
+{
+    uint32_t n;
+    uint32_t mark;
+    int      key;
+
+    key = am_int_cpu_lock();
+
+    switch (p_dev->channel_mode) {
+
+    case AM_UART_MODE_INT:
+        while (len--) {
+            if ((p_dev->pfn_rxchar_put == NULL) ||
+                (p_dev->pfn_rxchar_put(p_dev->rxput_arg,
+                                       (char)*p_data) != AM_OK)) {
+                p_dev->rx_lost++;
+            }
+            p_data++;
+        }
+        break;
+
+    case AM_UART_MODE_DMA:
+        while (len > 0) {
+
+            /* һύλãһ루жϣĩβжϣ */
+            mark = (p_dev->dma_pos < p_dev->dma_size / 2) ?
+                   (p_dev->dma_size / 2) : p_dev->dma_size;
+            n    = min(len, mark - p_dev->dma_pos);
+
+            memcpy(&p_dev->p_dma_buf[p_dev->dma_pos], p_data, n);
+
+            p_dev->dma_pos += n;
+            p_data         += n;
+            len            -= n;
+
+            /* дύλʱύдĩβصʼλ */
+            if (p_dev->dma_pos == mark) {
+                __rx_dma_publish(p_dev, mark);
+                if (mark == p_dev->dma_size) {
+                    p_dev->dma_pos = 0;
+                }
+            }
+        }
+        break;
+
+    default:
+        p_dev->rx_lost += len;
+        break;
+    }
+
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+void am_posix_uart_rx_idle (am_posix_uart_dev_t *p_dev)
+{
+    int key;
+
+    key = am_int_cpu_lock();
+
+    if (p_dev->channel_mode == AM_UART_MODE_DMA) {
+        __rx_dma_publish(p_dev, p_dev->dma_pos);
+    }
+
+    am_int_cpu_unlock(key);
+}
+
+/* end of file */
@@ -0,0 +1,131 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief عʹõļ麯
+ *
+ * ÿԳֻļһΡʧʱļкźͱʽ
+ * am_test_exit() ʧʧʱ 1CTest жΪʧܣ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_TEST_H
+#define __AM_TEST_H
+
+#include "ametal.h"
+#include "am_vdebug.h"
+#include "am_wait.h"
+#include "am_posix_int.h"
+#include "am_posix_console.h"
+#include <unistd.h>
+
+static int      __g_test_nchecks = 0;     /**< \brief  */
+static int      __g_test_nfail   = 0;     /**< \brief ʧܵļ */
+static uint32_t __g_test_seed    = 1;     /**< \brief α */
+
+/**
+ * \brief Ϊ
+ */
+#define AM_TEST_CHECK(expr)  \
+    am_test_check((expr) ? AM_TRUE : AM_FALSE, #expr, __FILE__, __LINE__)
+
+/**
+ * \brief 
+ */
+#define AM_TEST_EQ(val, expect)  \
+    am_test_eq((long)(val), (long)(expect), #val, __FILE__, __LINE__)
+
+am_static_inline
+am_bool_t am_test_check (am_bool_t   ok,
+                         const char *p_expr,
+                         const char *p_file,
+                         int         line)
+{
+    __g_test_nchecks++;
+
+    if (!ok) {
+        __g_test_nfail++;
+        am_kprintf("%s:%d: check failed: %s\n", p_file, line, p_expr);
+    }
+
+    return ok;
+}
+
+am_static_inline
+am_bool_t am_test_eq (long        val,
+                      long        expect,
+                      const char *p_expr,
+                      const char *p_file,
+                      int         line)
+{
+    __g_test_nchecks++;
+
+    if (val != expect) {
+        __g_test_nfail++;
+        am_kprintf("%s:%d: %s is %ld, expect %ld\n",
+                   p_file,
+                   line,
+                   p_expr,
+                   val,
+                   expect);
+        return AM_FALSE;
+    }
+
+    return AM_TRUE;
+}
+
+/**
+ * \brief αࣩͬظ
+ */
+am_static_inline
+uint32_t am_test_rand (void)
+{
+    __g_test_seed = __g_test_seed * 1103515245u + 12345u;
+
+    return __g_test_seed >> 8;
+}
+
+/**
+ * \brief ʼжģ͵߳Ϊ CPU ߳
+ */
+am_static_inline
+void am_test_init (void)
+{
+    am_posix_int_init();
+    am_posix_console_init(STDOUT_FILENO);
+    am_wait_strategy_set(&am_wait_strategy_posix);
+}
+
+/**
+ * \brief 
+ *
+ * \return Գ˳룬ȫͨʱΪ 0
+ */
+am_static_inline
+int am_test_exit (const char *p_name)
+{
+    am_kprintf("%s: %d checks, %d failed\n",
+               p_name,
+               __g_test_nchecks,
+               __g_test_nfail);
+
+    return (__g_test_nfail == 0) ? 0 : 1;
+}
+
+#endif /* __AM_TEST_H */
+
+/* end of file */
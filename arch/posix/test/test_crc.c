@@ -0,0 +1,115 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief  CRC ع
+ *
+ * ʹ "123456789" ı׼Уֵ CRC-32  CRC-16/KERMIT
+ * ֶμһμĽͬ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_crc.h"
+#include "am_crc_soft.h"
+#include "am_crc_table_def.h"
+
+static const uint8_t __g_check_data[] = "123456789";
+
+/** \brief CRC-32 ģ */
+static am_crc_pattern_t __g_crc32_pattern = {
+    32,                /* CRC  */
+    0x04C11DB7,        /* CRC ɶʽ */
+    0xFFFFFFFF,        /* CRC ʼֵ */
+    AM_TRUE,           /* ֽ bit  */
+    AM_TRUE,           /*  CRC bit  */
+    0xFFFFFFFF,        /* ֵ */
+};
+
+/** \brief CRC-16/KERMIT ģ */
+static am_crc_pattern_t __g_crc16_pattern = {
+    16,                /* CRC  */
+    0x1021,            /* CRC ɶʽ */
+    0x0000,            /* CRC ʼֵ */
+    AM_TRUE,           /* ֽ bit  */
+    AM_TRUE,           /*  CRC bit  */
+    0x0000,            /* ֵ */
+};
+
+static uint32_t __crc_get (am_crc_handle_t   handle,
+                           am_crc_pattern_t *p_pattern,
+                           const uint8_t    *p_data,
+                           uint32_t          len,
+                           uint32_t          step)
+{
+    uint32_t value = 0;
+    uint32_t n;
+
+    am_crc_init(handle, p_pattern);
+
+    while (len > 0) {
+        n = min(len, step);
+        am_crc_cal(handle, p_data, n);
+        p_data += n;
+        len    -= n;
+    }
+
+    am_crc_final(handle, &value);
+
+    return value;
+}
+
+static void __test_crc (am_crc_handle_t   handle,
+                        am_crc_pattern_t *p_pattern,
+                        uint32_t          check)
+{
+    static uint8_t data[1000];
+    uint32_t       crc;
+    uint32_t       i;
+
+    AM_TEST_CHECK(handle != NULL);
+
+    AM_TEST_EQ(__crc_get(handle, p_pattern, __g_check_data, 9, 9), check);
+
+    for (i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)am_test_rand();
+    }
+
+    crc = __crc_get(handle, p_pattern, data, sizeof(data), sizeof(data));
+    AM_TEST_EQ(__crc_get(handle, p_pattern, data, sizeof(data), 1), crc);
+    AM_TEST_EQ(__crc_get(handle, p_pattern, data, sizeof(data), 77), crc);
+}
+
+int main (void)
+{
+    am_crc_soft_t crc32_soft;
+    am_crc_soft_t crc16_soft;
+
+    am_test_init();
+
+    __test_crc(am_crc_soft_init(&crc32_soft, &g_crc_table_32_04c11db7_ref),
+               &__g_crc32_pattern,
+               0xCBF43926);
+
+    __test_crc(am_crc_soft_init(&crc16_soft, &g_crc_table_16_1021_ref),
+               &__g_crc16_pattern,
+               0x2189);
+
+    return am_test_exit("crc");
+}
+
+/* end of file */
@@ -0,0 +1,406 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ¼ӳٷַع
+ *
+ * жӳģ鲻ôصɲԳ am_isr_defer_job_process() 
+ * PendSVӳٷַ˳ݸ롢¼ϲ
+ * ַڼעᡢעʱÿִһΣԼַ֮Ȼ
+ * ÿζִС
+ *
+ * \internal
+ * \par Modification History
+ * - 1.02 26-10-16  ljy, add the nested raise case for the coalesced count.
+ * - 1.01 26-10-16  ljy, handlers registered during a dispatch run from the next
+ *                   event, add the long run case.
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_event.h"
+#include "am_isr_defer.h"
+#include <string.h>
+
+#define __MSG_NUM       4
+#define __LOG_SIZE      64
+
+static am_event_defer_msg_t __g_msgs[__MSG_NUM];
+
+static am_event_category_t  __g_cat;
+static am_event_type_t      __g_evt[3];
+static am_event_handler_t   __g_hdl[6];
+
+/* ִм¼š¼šݡϲ */
+static struct {
+    int      hdl;
+    int      evt;
+    uint32_t data;
+    uint16_t count;
+} __g_log[__LOG_SIZE];
+
+static int __g_nlog;
+static int __g_nrun[6];                 /* ÿִд */
+
+static void __log_reset (void)
+{
+    __g_nlog = 0;
+    memset(__g_log, 0xFF, sizeof(__g_log));
+    memset(__g_nrun, 0, sizeof(__g_nrun));
+}
+
+static void __handler (am_event_type_t *p_evt, void *p_evt_data, void *p_hdl)
+{
+    if (__g_nlog < __LOG_SIZE) {
+        __g_log[__g_nlog].hdl   = (int)(intptr_t)p_hdl;
+        __g_log[__g_nlog].evt   = (int)(p_evt - __g_evt);
+        __g_log[__g_nlog].data  = (p_evt_data != NULL) ?
+                                  *(uint32_t *)p_evt_data : 0;
+        __g_log[__g_nlog].count = am_event_coalesced_get(p_evt);
+    }
+    __g_nlog++;
+    __g_nrun[(int)(intptr_t)p_hdl]++;
+}
+
+/* ִʱעԼδִе __g_hdl[2]ע __g_hdl[5] */
+static void __handler_modify (am_event_type_t *p_evt,
+                              void            *p_evt_data,
+                              void            *p_hdl)
+{
+    __handler(p_evt, p_evt_data, p_hdl);
+
+    am_event_category_handler_unregister(&__g_cat, &__g_hdl[4]);
+    am_event_category_handler_unregister(&__g_cat, &__g_hdl[2]);
+    am_event_category_handler_register(&__g_cat, &__g_hdl[5]);
+}
+
+/*
+ * ģӳٷַĴִڼ䣬жͬһ¼ִֻദ
+ * ¼жǰȡĺϲ
+ */
+static uint16_t __g_count_before;
+static uint16_t __g_count_after;
+
+static void __handler_irq (am_event_type_t *p_evt,
+                           void            *p_evt_data,
+                           void            *p_hdl)
+{
+    uint32_t data = 0xAA;
+
+    __g_count_before = am_event_coalesced_get(p_evt);
+    am_event_raise(p_evt, &data, AM_EVENT_PROC_FLAG_CAT_ONLY);
+    __g_count_after  = am_event_coalesced_get(p_evt);
+}
+
+static void __setup (void)
+{
+    int i;
+
+    am_event_category_init(&__g_cat);
+
+    for (i = 0; i < 3; i++) {
+        am_event_init(&__g_evt[i]);
+        am_event_category_event_register(&__g_cat, &__g_evt[i]);
+    }
+    for (i = 0; i < 6; i++) {
+        am_event_handler_init(&__g_hdl[i], __handler, (void *)(intptr_t)i, 0);
+    }
+    am_event_defer_stat_reset();
+}
+
+/* ݱƣаദ¼˳ִ */
+static void __test_defer (void)
+{
+    struct am_event_defer_stat stat;
+    uint32_t                   data;
+
+    __setup();
+    __log_reset();
+
+    am_event_category_handler_register(&__g_cat, &__g_hdl[0]);
+    am_event_handler_register(&__g_evt[1], &__g_hdl[1]);
+
+    data = 0x1234;
+    AM_TEST_EQ(am_event_raise_defer(&__g_evt[1], &data, sizeof(data), 0),
+               AM_OK);
+    data = 0x5678;
+    AM_TEST_EQ(am_event_raise_defer(&__g_evt[0], &data, sizeof(data), 0),
+               AM_OK);
+    data = 0;
+    AM_TEST_EQ(am_event_raise_defer(&__g_evt[1], &data, sizeof(data),
+                                    AM_EVENT_PROC_FLAG_CAT_ONLY),
+               AM_OK);
+    AM_TEST_EQ(am_event_raise_defer(&__g_evt[0], &data,
+                                    AM_EVENT_DEFER_DATA_SIZE + 1, 0),
+               -AM_EINVAL);
+    AM_TEST_EQ(__g_nlog, 0);
+
+    am_isr_defer_job_process();
+
+    AM_TEST_EQ(__g_nlog, 4);
+    AM_TEST_EQ(__g_log[0].hdl, 0);
+    AM_TEST_EQ(__g_log[0].data, 0x1234);
+    AM_TEST_EQ(__g_log[1].hdl, 1);
+    AM_TEST_EQ(__g_log[1].data, 0x1234);
+    AM_TEST_EQ(__g_log[2].hdl, 0);
+    AM_TEST_EQ(__g_log[2].evt, 0);
+    AM_TEST_EQ(__g_log[2].data, 0x5678);
+    AM_TEST_EQ(__g_log[3].hdl, 0);
+    AM_TEST_EQ(__g_log[3].evt, 1);
+
+    am_event_defer_stat_get(&stat);
+    AM_TEST_EQ(stat.raised, 3);
+    AM_TEST_EQ(stat.dispatched, 3);
+    AM_TEST_EQ(stat.pending_max, 3);
+
+    am_event_category_handler_unregister(&__g_cat, &__g_hdl[0]);
+    am_event_handler_unregister(&__g_evt[1], &__g_hdl[1]);
+}
+
+/* ֻĵ¼ûжߵ¼ */
+static void __test_mask (void)
+{
+    struct am_event_defer_stat stat;
+    uint32_t                   data = 1;
+
+    __setup();
+    __log_reset();
+
+    am_event_category_handler_register_mask(&__g_cat,
+                                            &__g_hdl[0],
+                                            am_event_mask_get(&__g_evt[0]));
+    am_event_category_handler_register_mask(&__g_cat,
+                                            &__g_hdl[1],
+                                            am_event_mask_get(&__g_evt[0]) |
+                                            am_event_mask_get(&__g_evt[1]));
+
+    am_event_raise_defer(&__g_evt[0], &data, sizeof(data), 0);
+    am_event_raise_defer(&__g_evt[1], &data, sizeof(data), 0);
+    am_event_raise_defer(&__g_evt[2], &data, sizeof(data), 0);
+
+    am_isr_defer_job_process();
+
+    AM_TEST_EQ(__g_nlog, 3);
+    AM_TEST_EQ(__g_log[0].evt, 0);
+    AM_TEST_EQ(__g_log[1].evt, 0);
+    AM_TEST_EQ(__g_log[2].hdl, 1);
+    AM_TEST_EQ(__g_log[2].evt, 1);
+
+    am_event_defer_stat_get(&stat);
+    AM_TEST_EQ(stat.raised, 2);
+    AM_TEST_EQ(stat.filtered, 1);
+
+    /* ע¼ */
+    am_event_category_handler_unregister(&__g_cat, &__g_hdl[1]);
+    AM_TEST_EQ(__g_cat.sub_mask, am_event_mask_get(&__g_evt[0]));
+    am_event_category_handler_unregister(&__g_cat, &__g_hdl[0]);
+}
+
+/* еȴַ¼ϲ» */
+static void __test_coalesce (void)
+{
+    struct am_event_defer_stat stat;
+    uint32_t                   data;
+
+    __setup();
+    __log_reset();
+
+    am_event_category_handler_register(&__g_cat, &__g_hdl[0]);
+    am_event_coalesce_set(&__g_evt[0], AM_EVENT_COALESCE_LATEST);
+    am_event_coalesce_set(&__g_evt[1], AM_EVENT_COALESCE_FIRST);
+
+    for (data = 1; data <= 5; data++) {
+        am_event_raise_defer(&__g_evt[0], &data, sizeof(data), 0);
+        am_event_raise_defer(&__g_evt[1], &data, sizeof(data), 0);
+        am_event_raise_defer(&__g_evt[2], &data, sizeof(data), 0);
+    }
+
+    am_isr_defer_job_process();
+
+    /* evt[2] ϲ5 ֻ __MSG_NUM - 2 ܼ */
+    AM_TEST_EQ(__g_nlog, 2 + __MSG_NUM - 2);
+    AM_TEST_EQ(__g_log[0].evt, 0);
+    AM_TEST_EQ(__g_log[0].data, 5);
+    AM_TEST_EQ(__g_log[0].count, 5);
+    AM_TEST_EQ(__g_log[1].evt, 1);
+    AM_TEST_EQ(__g_log[1].data, 1);
+    AM_TEST_EQ(__g_log[1].count, 5);
+    AM_TEST_EQ(__g_log[2].evt, 2);
+    AM_TEST_EQ(__g_log[2].count, 1);
+
+    am_event_defer_stat_get(&stat);
+    AM_TEST_EQ(stat.coalesced, 8);
+    AM_TEST_EQ(stat.dropped, 5 - (__MSG_NUM - 2));
+
+    /* ַ֮ٴδʱ¼ */
+    __log_reset();
+    am_event_raise_defer(&__g_evt[0], &data, sizeof(data), 0);
+    am_isr_defer_job_process();
+    AM_TEST_EQ(__g_nlog, 1);
+    AM_TEST_EQ(__g_log[0].count, 1);
+
+    am_event_category_handler_unregister(&__g_cat, &__g_hdl[0]);
+}
+
+/* ϲַݣǶ׵Ӱִеӳٷַ */
+static void __test_coalesce_nested (void)
+{
+    am_event_handler_t hdl_irq;
+    uint32_t           data;
+
+    __setup();
+    __log_reset();
+
+    am_event_handler_init(&hdl_irq, __handler_irq, NULL, 0);
+    am_event_category_handler_register(&__g_cat, &__g_hdl[0]);
+    am_event_handler_register(&__g_evt[0], &hdl_irq);
+    am_event_coalesce_set(&__g_evt[0], AM_EVENT_COALESCE_LATEST);
+
+    for (data = 1; data <= 3; data++) {
+        am_event_raise_defer(&__g_evt[0], &data, sizeof(data), 0);
+    }
+    am_isr_defer_job_process();
+
+    /* ӳٷַദȻжദ */
+    AM_TEST_EQ(__g_nlog, 2);
+    AM_TEST_EQ(__g_log[0].data, 3);
+    AM_TEST_EQ(__g_log[0].count, 3);
+    AM_TEST_EQ(__g_log[1].data, 0xAA);
+    AM_TEST_EQ(__g_log[1].count, 1);
+    AM_TEST_EQ(__g_count_before, 3);
+    AM_TEST_EQ(__g_count_after, 3);
+
+    /* ڷַʱΪ 1 */
+    AM_TEST_EQ(am_event_coalesced_get(&__g_evt[0]), 1);
+
+    am_event_handler_unregister(&__g_evt[0], &hdl_irq);
+    am_event_category_handler_unregister(&__g_cat, &__g_hdl[0]);
+}
+
+/* ִڼ޸ʱִйĴظִ */
+static void __test_modify (void)
+{
+    struct am_event_defer_stat stat;
+    int                        count[6] = {0};
+    int                        i;
+
+    __setup();
+    __log_reset();
+
+    am_event_handler_init(&__g_hdl[4], __handler_modify, (void *)4, 0);
+    am_event_handler_init(&__g_hdl[3], __handler, (void *)3,
+                          AM_EVENT_HANDLER_FLAG_AUTO_UNREG);
+
+    /* ˳Ϊ 0 3 4 1 2 */
+    am_event_category_handler_register(&__g_cat, &__g_hdl[2]);
+    am_event_category_handler_register(&__g_cat, &__g_hdl[1]);
+    am_event_category_handler_register(&__g_cat, &__g_hdl[4]);
+    am_event_category_handler_register(&__g_cat, &__g_hdl[3]);
+    am_event_category_handler_register(&__g_cat, &__g_hdl[0]);
+
+    am_event_raise_defer(&__g_evt[0], NULL, 0, 0);
+    am_isr_defer_job_process();
+
+    for (i = 0; i < __g_nlog; i++) {
+        count[__g_log[i].hdl]++;
+    }
+
+    /*
+     * ִеĴظִУδִоͱע 2 ִУע 5 
+     * ͷһ¼ʼִ
+     */
+    AM_TEST_EQ(__g_nlog, 4);
+    AM_TEST_EQ(__g_log[0].hdl, 0);
+    AM_TEST_EQ(__g_log[1].hdl, 3);
+    AM_TEST_EQ(__g_log[2].hdl, 4);
+    AM_TEST_EQ(__g_log[3].hdl, 1);
+    for (i = 0; i < 5; i++) {
+        AM_TEST_EQ(count[i], (i == 2) ? 0 : 1);
+    }
+    AM_TEST_EQ(count[5], 0);
+
+    am_event_defer_stat_get(&stat);
+    AM_TEST_CHECK(stat.relocate > 0);
+
+    /* δע˵ĴִУΪ 5 0 1 */
+    __log_reset();
+    am_event_raise_defer(&__g_evt[0], NULL, 0, 0);
+    am_isr_defer_job_process();
+    AM_TEST_EQ(__g_nlog, 3);
+    AM_TEST_EQ(__g_log[0].hdl, 5);
+    AM_TEST_EQ(__g_log[1].hdl, 0);
+    AM_TEST_EQ(__g_log[2].hdl, 1);
+
+    for (i = 0; i < 6; i++) {
+        am_event_category_handler_unregister(&__g_cat, &__g_hdl[i]);
+    }
+}
+
+/*
+ * ַ 65535 ȻÿζִУʹ 16 λַűִе
+ * ĳ¼ǡ 65535 ַٴηַʱ䴦ᱻ
+ */
+static void __test_long_run (void)
+{
+    uint32_t i;
+    int      n;
+
+    __setup();
+    __log_reset();
+
+    am_event_handler_register(&__g_evt[0], &__g_hdl[0]);
+    am_event_handler_register(&__g_evt[1], &__g_hdl[1]);
+
+    for (n = 0; n < 3; n++) {
+        am_event_raise_defer(&__g_evt[0], NULL, 0, 0);
+        am_isr_defer_job_process();
+
+        for (i = 0; i < 65534; i++) {
+            am_event_raise_defer(&__g_evt[1], NULL, 0, 0);
+            if ((i % __MSG_NUM) == __MSG_NUM - 1) {
+                am_isr_defer_job_process();
+            }
+        }
+        am_isr_defer_job_process();
+    }
+
+    am_event_raise_defer(&__g_evt[0], NULL, 0, 0);
+    am_isr_defer_job_process();
+
+    AM_TEST_EQ(__g_nrun[0], 4);
+    AM_TEST_EQ(__g_nrun[1], 3 * 65534);
+
+    am_event_handler_unregister(&__g_evt[0], &__g_hdl[0]);
+    am_event_handler_unregister(&__g_evt[1], &__g_hdl[1]);
+}
+
+int main (void)
+{
+    am_test_init();
+
+    /* ֻӲɲԳӳ */
+    am_isr_defer_init(NULL, NULL);
+    AM_TEST_EQ(am_event_defer_init(__g_msgs, __MSG_NUM, 1), AM_OK);
+
+    __test_defer();
+    __test_mask();
+    __test_coalesce();
+    __test_coalesce_nested();
+    __test_modify();
+    __test_long_run();
+
+    return am_test_exit("event");
+}
+
+/* end of file */
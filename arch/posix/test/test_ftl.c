@@ -0,0 +1,198 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief FTL ع
+ *
+ * ʹ RAM ģ NOR FLASHΪ 0xFFдֻܽλ㣩д߼
+ * ־ϲͲοݱȽϣ³ʼ FTL Ӧֲ䡣
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_mtd.h"
+#include "am_ftl.h"
+#include <string.h>
+
+#define __FLASH_SIZE         (64 * 1024)   /**< \brief ģ FLASH  */
+#define __FLASH_ERASE_SIZE   4096          /**< \brief ԪС */
+#define __FTL_BLOCK_SIZE     256           /**< \brief ߼С */
+#define __FTL_LOG_BLOCK_NUM  4             /**< \brief ־ */
+#define __LBN_NUM            64            /**< \brief Ե߼Ŀ */
+#define __ROUNDS             5000
+
+static uint8_t  __g_flash_mem[__FLASH_SIZE];
+static uint32_t __g_erase_count;
+
+static uint8_t  __g_ref[__LBN_NUM][__FTL_BLOCK_SIZE];
+static uint8_t  __g_blk[__FTL_BLOCK_SIZE];
+
+static uint8_t  __g_ftl_buf[AM_FTL_RAM_SIZE_GET(__FLASH_SIZE,
+                                                __FLASH_ERASE_SIZE,
+                                                __FTL_BLOCK_SIZE,
+                                                __FTL_LOG_BLOCK_NUM)];
+
+static const am_ftl_info_t __g_ftl_info = {
+    __g_ftl_buf,               /* RAM  */
+    sizeof(__g_ftl_buf),       /* RAM С */
+    __FTL_BLOCK_SIZE,          /* ߼ĴС */
+    __FTL_LOG_BLOCK_NUM,       /* ־ */
+    0                          /* 飨Ԫ */
+};
+
+/*******************************************************************************
+  RAM ģ NOR FLASH
+*******************************************************************************/
+static int __flash_erase (void *p_drv, struct am_mtd_erase_info *p_info)
+{
+    __g_erase_count++;
+
+    p_info->fail_addr = AM_MTD_ERASE_FAIL_ADDR_UNKNOWN;
+    memset(&__g_flash_mem[p_info->addr], 0xFF, p_info->len);
+    p_info->state     = AM_MTD_ERASE_DONE;
+
+    if (p_info->pfn_callback) {
+        p_info->pfn_callback(p_info);
+    }
+
+    return AM_OK;
+}
+
+static int __flash_read (void *p_drv, uint32_t addr, void *p_buf, uint32_t len)
+{
+    memcpy(p_buf, &__g_flash_mem[addr], len);
+    return AM_OK;
+}
+
+static int __flash_write (void       *p_drv,
+                          uint32_t    addr,
+                          const void *p_buf,
+                          uint32_t    len)
+{
+    const uint8_t *p_src = (const uint8_t *)p_buf;
+    uint8_t       *p_dst = &__g_flash_mem[addr];
+
+    while (len--) {
+        *p_dst++ &= *p_src++;
+    }
+
+    return AM_OK;
+}
+
+static const struct am_mtd_ops __g_flash_ops = {
+    __flash_erase,
+    __flash_read,
+    __flash_write,
+};
+
+static am_mtd_serv_t __g_flash_mtd = {
+    AM_MTD_TYPE_NOR_FLASH,     /*  */
+    AM_MTD_FLAGS_NOR_FLASH,    /* ־ */
+    __FLASH_SIZE,              /*  */
+    __FLASH_ERASE_SIZE,        /* ԪС */
+    1,                         /* Сд뵥ԪС */
+    __FTL_BLOCK_SIZE,          /* дС */
+    &__g_flash_ops,            /*  */
+    NULL,                      /* ˽ */
+};
+
+/******************************************************************************/
+
+/* ȫ߼οݱȽϣزһµĿ */
+static int __verify (am_ftl_handle_t handle)
+{
+    int lbn;
+    int nbad = 0;
+
+    for (lbn = 0; lbn < __LBN_NUM; lbn++) {
+        if ((am_ftl_read(handle, lbn, __g_blk) != AM_OK) ||
+            (memcmp(__g_blk, __g_ref[lbn], __FTL_BLOCK_SIZE) != 0)) {
+            nbad++;
+        }
+    }
+
+    return nbad;
+}
+
+static void __block_write (am_ftl_handle_t handle, int lbn, int *p_nerr)
+{
+    int i;
+    int fill = (int)am_test_rand();
+
+    for (i = 0; i < __FTL_BLOCK_SIZE; i++) {
+        __g_ref[lbn][i] = (uint8_t)(fill + i * 3);
+    }
+    memcpy(__g_blk, __g_ref[lbn], __FTL_BLOCK_SIZE);
+
+    if (am_ftl_write(handle, lbn, __g_blk) != AM_OK) {
+        (*p_nerr)++;
+    }
+}
+
+int main (void)
+{
+    am_ftl_serv_t   ftl;
+    am_ftl_handle_t handle;
+    int             nerr = 0;
+    int             r, lbn;
+
+    am_test_init();
+
+    memset(__g_flash_mem, 0xFF, sizeof(__g_flash_mem));
+
+    handle = am_ftl_init(&ftl, &__g_ftl_info, &__g_flash_mtd);
+    if (!AM_TEST_CHECK(handle != NULL)) {
+        return am_test_exit("ftl");
+    }
+    AM_TEST_CHECK(am_ftl_max_lbn_get(handle) >= __LBN_NUM);
+
+    for (lbn = 0; lbn < __LBN_NUM; lbn++) {
+        __block_write(handle, lbn, &nerr);
+    }
+    AM_TEST_EQ(__verify(handle), 0);
+
+    /* ид߼飬־ϲ */
+    for (r = 0; r < __ROUNDS; r++) {
+        lbn = am_test_rand() % 8;
+        if (r & 1) {
+            lbn = am_test_rand() % __LBN_NUM;
+        }
+        __block_write(handle, lbn, &nerr);
+
+        if ((r % 500) == 0) {
+            AM_TEST_EQ(__verify(handle), 0);
+        }
+    }
+
+    AM_TEST_EQ(nerr, 0);
+    AM_TEST_EQ(__verify(handle), 0);
+    AM_TEST_CHECK(__g_erase_count > 0);
+
+    /* ³ʼ൱ϵ磩 FLASH лָӳϵ */
+    memset(__g_ftl_buf, 0, sizeof(__g_ftl_buf));
+    handle = am_ftl_init(&ftl, &__g_ftl_info, &__g_flash_mtd);
+    AM_TEST_CHECK(handle != NULL);
+    AM_TEST_EQ(__verify(handle), 0);
+
+    am_kprintf("%d writes, %u erases\n",
+               __ROUNDS + __LBN_NUM,
+               (unsigned)__g_erase_count);
+
+    return am_test_exit("ftl");
+}
+
+/* end of file */
@@ -0,0 +1,243 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief лع
+ *
+ * ȼ˳򣨺λͼͬȼȽȳظ롢ֹʱ
+ * ִ˳ʱԤ㣬Լͷʱвٷʸ
+ * ʱʹֶƽļֵٶ޹ء
+ *
+ * \internal
+ * \par Modification History
+ * - 1.01 26-10-16  ljy, add the self-freeing job case.
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_jobq.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define __PRI_NUM       2000        /*  1024ʹλͼ */
+#define __JOB_NUM       256
+
+AM_JOBQ_QUEUE_DECL_STATIC(__g_jobq, __PRI_NUM);
+
+static am_jobq_handle_t __g_handle;
+static am_jobq_job_t    __g_jobs[__JOB_NUM];
+static uint32_t         __g_seq[__JOB_NUM];     /* е˳ */
+
+static int              __g_order[__JOB_NUM];   /* ʵִ˳ */
+static int              __g_nrun;
+
+static uint32_t         __g_time;               /* ֶƽʱ */
+
+static uint32_t __timestamp_get (void)
+{
+    return __g_time;
+}
+
+/* ÿִ 10 ʱ䵥λ */
+static void __job_func (void *p_arg)
+{
+    __g_order[__g_nrun++] = (int)(intptr_t)p_arg;
+    __g_time += 10;
+}
+
+static void __order_reset (void)
+{
+    __g_nrun = 0;
+    memset(__g_order, 0xFF, sizeof(__g_order));
+}
+
+/* ȼȼӸߵͣͬȼȽȳ */
+static void __test_priority (void)
+{
+    int      i, a, b;
+    int      nbad = 0;
+    uint32_t pri;
+
+    __order_reset();
+
+    for (i = 0; i < __JOB_NUM; i++) {
+
+        /* ȼϣʹͬȼж */
+        pri = am_test_rand() % 8;
+        pri = (pri < 4) ? pri * 600 : am_test_rand() % __PRI_NUM;
+
+        am_jobq_job_init(&__g_jobs[i], __job_func, (void *)(intptr_t)i, pri);
+        __g_seq[i] = i;
+        AM_TEST_EQ(am_jobq_post(__g_handle, &__g_jobs[i]), AM_OK);
+    }
+
+    /* ڶ */
+    AM_TEST_EQ(am_jobq_post(__g_handle, &__g_jobs[7]), -AM_EBUSY);
+
+    AM_TEST_EQ(am_jobq_process(__g_handle), AM_OK);
+    AM_TEST_EQ(__g_nrun, __JOB_NUM);
+
+    for (i = 1; i < __JOB_NUM; i++) {
+        a = __g_order[i - 1];
+        b = __g_order[i];
+        if ((__g_jobs[a].pri > __g_jobs[b].pri) ||
+            ((__g_jobs[a].pri == __g_jobs[b].pri) &&
+             (__g_seq[a] > __g_seq[b]))) {
+            nbad++;
+        }
+    }
+    AM_TEST_EQ(nbad, 0);
+
+    /* ִкٴμ */
+    __order_reset();
+    AM_TEST_EQ(am_jobq_post(__g_handle, &__g_jobs[7]), AM_OK);
+    AM_TEST_EQ(am_jobq_process(__g_handle), AM_OK);
+    AM_TEST_EQ(__g_order[0], 7);
+}
+
+/* ֹʱִͨУ໥ֹ֮ʱ */
+static void __test_deadline (void)
+{
+    static const uint32_t deadline[] = {500, 120, 900, 120, 300, 5};
+    int                   i;
+
+    __order_reset();
+
+    am_jobq_stat_timestamp_set(__g_handle, NULL);
+    am_jobq_job_init(&__g_jobs[0], __job_func, (void *)0, 0);
+    AM_TEST_EQ(am_jobq_post_deadline(__g_handle, &__g_jobs[0], 100),
+               -AM_EPERM);
+
+    am_jobq_stat_timestamp_set(__g_handle, __timestamp_get);
+    am_jobq_stat_reset(__g_handle);
+    __g_time = 0xFFFFFF00u;                 /* ֹʱԽֵ */
+
+    /* ͨȼ */
+    am_jobq_job_init(&__g_jobs[10], __job_func, (void *)10, 0);
+    am_jobq_post(__g_handle, &__g_jobs[10]);
+
+    for (i = 0; i < (int)AM_NELEMENTS(deadline); i++) {
+        am_jobq_job_init(&__g_jobs[i], __job_func, (void *)(intptr_t)i, 100);
+        AM_TEST_EQ(am_jobq_post_deadline(__g_handle,
+                                         &__g_jobs[i],
+                                         __g_time + deadline[i]),
+                   AM_OK);
+    }
+    AM_TEST_EQ(am_jobq_post_deadline(__g_handle, &__g_jobs[2], __g_time),
+               -AM_EBUSY);
+
+    AM_TEST_EQ(am_jobq_process(__g_handle), AM_OK);
+
+    /* ֹʱͬʱȽȳ */
+    AM_TEST_EQ(__g_order[0], 5);
+    AM_TEST_EQ(__g_order[1], 1);
+    AM_TEST_EQ(__g_order[2], 3);
+    AM_TEST_EQ(__g_order[3], 4);
+    AM_TEST_EQ(__g_order[4], 0);
+    AM_TEST_EQ(__g_order[5], 2);
+    AM_TEST_EQ(__g_order[6], 10);
+}
+
+/* ʱԤʣ´δ */
+static void __test_budget (void)
+{
+    struct am_jobq_stat stat;
+    int                 i;
+
+    __order_reset();
+    am_jobq_stat_reset(__g_handle);
+
+    for (i = 0; i < 10; i++) {
+        am_jobq_job_init(&__g_jobs[i], __job_func, (void *)(intptr_t)i, i);
+        am_jobq_post(__g_handle, &__g_jobs[i]);
+    }
+
+    /* ÿ 10 ʱ䵥λԤ 35 ʱִ 4  */
+    AM_TEST_EQ(am_jobq_process_budget(__g_handle, 35), -AM_ETIME);
+    AM_TEST_EQ(__g_nrun, 4);
+    AM_TEST_EQ(am_jobq_process_budget(__g_handle, 35), -AM_ETIME);
+    AM_TEST_EQ(__g_nrun, 8);
+    AM_TEST_EQ(am_jobq_process_budget(__g_handle, 35), AM_OK);
+    AM_TEST_EQ(__g_nrun, 10);
+
+    for (i = 0; i < 10; i++) {
+        AM_TEST_EQ(__g_order[i], i);
+    }
+
+    am_jobq_stat_get(__g_handle, &stat);
+    AM_TEST_EQ(stat.runs, 10);
+    AM_TEST_EQ(stat.budget_exhausted, 2);
+    AM_TEST_EQ(stat.run_time_max, 10);
+}
+
+/* ͷͬһڴ·һ񲢼Уִ count  */
+static void __job_free_func (void *p_arg)
+{
+    am_jobq_job_t *p_job = (am_jobq_job_t *)p_arg;
+    int            left  = (int)p_job->pri;
+
+    free(p_job);
+
+    __g_order[__g_nrun++] = left;
+    __g_time += 10;
+
+    if (left > 0) {
+        p_job = (am_jobq_job_t *)malloc(sizeof(*p_job));
+        am_jobq_job_init(p_job, __job_free_func, p_job, (uint16_t)(left - 1));
+        am_jobq_post(__g_handle, p_job);
+    }
+}
+
+/*
+ * ʱѱͷţѱ·䣩вٷ
+ * ʹ AddressSanitizer ʱԼͷźʹ
+ */
+static void __test_self_free (void)
+{
+    struct am_jobq_stat  stat;
+    am_jobq_job_t       *p_job;
+
+    __order_reset();
+    am_jobq_stat_reset(__g_handle);
+
+    p_job = (am_jobq_job_t *)malloc(sizeof(*p_job));
+    am_jobq_job_init(p_job, __job_free_func, p_job, 5);
+    AM_TEST_EQ(am_jobq_post(__g_handle, p_job), AM_OK);
+
+    AM_TEST_EQ(am_jobq_process(__g_handle), AM_OK);
+    AM_TEST_EQ(__g_nrun, 6);
+    AM_TEST_EQ(__g_order[0], 5);
+    AM_TEST_EQ(__g_order[5], 0);
+
+    am_jobq_stat_get(__g_handle, &stat);
+    AM_TEST_EQ(stat.runs, 6);
+    AM_TEST_EQ(stat.run_time_max, 10);
+}
+
+int main (void)
+{
+    am_test_init();
+
+    __g_handle = AM_JOBQ_QUEUE_INIT(__g_jobq);
+    AM_TEST_CHECK(__g_handle != NULL);
+
+    __test_priority();
+    __test_deadline();
+    __test_budget();
+    __test_self_free();
+
+    return am_test_exit("jobq");
+}
+
+/* end of file */
@@ -0,0 +1,200 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ѹعԣ״ TLSF
+ *
+ * 䡢СͷţÿڴԵݣǷƻ
+ * am_memheap_walk() УǷͨͳƵĿĿǷһ£ȫͷźпռ
+ * ӦϲΪһ顣
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_memheap.h"
+#include <string.h>
+
+#define __HEAP_SIZE     (64 * 1024)
+#define __SLOT_NUM      64
+#define __ROUNDS        20000
+
+typedef am_err_t (*__heap_init_t) (struct am_memheap *,
+                                   const char *,
+                                   void *,
+                                   uint32_t);
+
+static uint32_t __g_heap_mem[__HEAP_SIZE / 4];
+
+/** \brief ڴ */
+struct __slot {
+    uint8_t  *p;
+    uint32_t  size;
+    uint8_t   fill;
+};
+
+static struct __slot __g_slots[__SLOT_NUM];
+
+/* СֲΪС飬Ϊ */
+static uint32_t __size_rand (void)
+{
+    uint32_t r = am_test_rand();
+
+    if ((r & 0xF) == 0) {
+        return 512 + (r >> 8) % 4096;
+    }
+    return 1 + (r >> 8) % 96;
+}
+
+static am_bool_t __slot_check (struct __slot *p_slot, uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (p_slot->p[i] != (uint8_t)(p_slot->fill + i)) {
+            return AM_FALSE;
+        }
+    }
+    return AM_TRUE;
+}
+
+static void __slot_fill (struct __slot *p_slot)
+{
+    uint32_t i;
+
+    p_slot->fill = (uint8_t)am_test_rand();
+    for (i = 0; i < p_slot->size; i++) {
+        p_slot->p[i] = (uint8_t)(p_slot->fill + i);
+    }
+}
+
+static void __test_heap (const char *p_name, __heap_init_t pfn_init)
+{
+    struct am_memheap      heap;
+    struct am_memheap_info info;
+    struct __slot         *p_slot;
+    uint8_t               *p;
+    uint32_t               size;
+    int                    nlive  = 0;
+    int                    nbad   = 0;
+    int                    nalign = 0;
+    int                    nfail  = 0;
+    int                    nwalk  = 0;
+    int                    r, i;
+
+    memset(__g_slots, 0, sizeof(__g_slots));
+
+    AM_TEST_EQ(pfn_init(&heap, p_name, __g_heap_mem, sizeof(__g_heap_mem)),
+               AM_OK);
+
+    for (r = 0; r < __ROUNDS; r++) {
+
+        p_slot = &__g_slots[am_test_rand() % __SLOT_NUM];
+
+        if (p_slot->p == NULL) {
+            size      = __size_rand();
+            p_slot->p = am_memheap_alloc(&heap, size);
+            if (p_slot->p == NULL) {
+                nfail++;
+                continue;
+            }
+            p_slot->size = size;
+            __slot_fill(p_slot);
+            nlive++;
+
+        } else if (am_test_rand() & 1) {
+
+            /* СԭݣСĲֲ֣ */
+            size = __size_rand();
+            p    = am_memheap_realloc(&heap, p_slot->p, size);
+            if (p == NULL) {
+                nfail++;
+                continue;
+            }
+            p_slot->p = p;
+            if (!__slot_check(p_slot, min(size, p_slot->size))) {
+                nbad++;
+            }
+            p_slot->size = size;
+            __slot_fill(p_slot);
+
+        } else {
+            if (!__slot_check(p_slot, p_slot->size)) {
+                nbad++;
+            }
+            am_memheap_free(p_slot->p);
+            p_slot->p = NULL;
+            nlive--;
+        }
+
+        if (((uintptr_t)p_slot->p & (sizeof(void *) - 1)) != 0) {
+            nalign++;
+        }
+        if ((p_slot->p != NULL) &&
+            (am_memheap_memsize(&heap, p_slot->p) < p_slot->size)) {
+            nbad++;
+        }
+
+        if ((r % 256) == 0) {
+            if (am_memheap_info_get(&heap, &info) != AM_OK) {
+                nwalk++;
+            } else if (info.used_blocks != (uint32_t)nlive) {
+                nbad++;
+            }
+        }
+    }
+
+    AM_TEST_EQ(nbad, 0);
+    AM_TEST_EQ(nalign, 0);
+    AM_TEST_EQ(nwalk, 0);
+    AM_TEST_CHECK(nfail < __ROUNDS / 100);
+    AM_TEST_EQ(am_memheap_walk(&heap, NULL, NULL), AM_OK);
+
+    /* ȫͷźпռϲΪһ */
+    for (i = 0; i < __SLOT_NUM; i++) {
+        if (__g_slots[i].p != NULL) {
+            am_memheap_free(__g_slots[i].p);
+        }
+    }
+
+    AM_TEST_EQ(am_memheap_info_get(&heap, &info), AM_OK);
+    AM_TEST_EQ(info.used_blocks, 0);
+    AM_TEST_EQ(info.free_blocks, 1);
+    AM_TEST_EQ(info.frag_permille, 0);
+
+    /* Է䵽󲿷ֿռ䣨TLSF ʱСȡһСࣩ */
+    p = am_memheap_alloc(&heap, info.free_largest / 8 * 7);
+    AM_TEST_CHECK(p != NULL);
+    am_memheap_free(p);
+
+    am_kprintf("%s: %d alloc failures, largest free %u of %u\n",
+               p_name,
+               nfail,
+               (unsigned)info.free_largest,
+               (unsigned)sizeof(__g_heap_mem));
+}
+
+int main (void)
+{
+    am_test_init();
+
+    __test_heap("first-fit", am_memheap_init);
+    __test_heap("tlsf", am_memheap_init_tlsf);
+
+    return am_test_exit("memheap");
+}
+
+/* end of file */
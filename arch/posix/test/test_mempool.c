@@ -0,0 +1,318 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ̶Сڴػع
+ *
+ * ڴصĳʼ顢䵽Ϊֹͷź󰴺ȳ˳
+ * 䡢ܾͷŲڿصĵַ䡢ͷʱÿݻţԼּ
+ * ڿ̫ʱתѹͷʱ黹ȷĵط
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_mempool.h"
+#include <string.h>
+
+#define __BLOCK_SIZE    13          /* ָС */
+#define __BLOCK_NUM     16
+#define __ROUNDS        20000
+
+AM_MEMPOOL_MEM_DEF(__g_pool_mem, __BLOCK_SIZE, __BLOCK_NUM);
+
+AM_MEMPOOL_MEM_DEF(__g_small_mem, 16, 4);
+AM_MEMPOOL_MEM_DEF(__g_large_mem, 64, 2);
+
+static uint32_t __g_heap_mem[1024];
+
+static void __block_fill (uint8_t *p, uint8_t fill)
+{
+    memset(p, fill, __BLOCK_SIZE);
+}
+
+static am_bool_t __block_check (const uint8_t *p, uint8_t fill)
+{
+    int i;
+
+    for (i = 0; i < __BLOCK_SIZE; i++) {
+        if (p[i] != fill) {
+            return AM_FALSE;
+        }
+    }
+    return AM_TRUE;
+}
+
+/* ʼ */
+static void __test_init (void)
+{
+    am_mempool_t pool;
+
+    AM_TEST_CHECK(am_mempool_init(NULL, __g_pool_mem, 64, 8) == NULL);
+    AM_TEST_CHECK(am_mempool_init(&pool, NULL, 64, 8) == NULL);
+    AM_TEST_CHECK(am_mempool_init(&pool, __g_pool_mem, 64, 0) == NULL);
+
+    /* ڴռδָС */
+    AM_TEST_CHECK(am_mempool_init(&pool,
+                                  (uint8_t *)__g_pool_mem + 1,
+                                  64,
+                                  8) == NULL);
+
+    /* ڴռ䲻һ */
+    AM_TEST_CHECK(am_mempool_init(&pool,
+                                  __g_pool_mem,
+                                  AM_MEMPOOL_BLOCK_SIZE(__BLOCK_SIZE) - 1,
+                                  __BLOCK_SIZE) == NULL);
+}
+
+/* 䵽Ϊֹͷź󰴺ȳ˳·䣬ܾЧĵַ */
+static void __test_pool (void)
+{
+    am_mempool_t           pool;
+    am_mempool_handle_t    handle;
+    struct am_mempool_stat stat;
+    uint8_t               *p_blocks[__BLOCK_NUM];
+    uint8_t               *p;
+    size_t                 size = AM_MEMPOOL_BLOCK_SIZE(__BLOCK_SIZE);
+    int                    nbad = 0;
+    int                    i;
+
+    handle = am_mempool_init(&pool,
+                             __g_pool_mem,
+                             sizeof(__g_pool_mem),
+                             __BLOCK_SIZE);
+    AM_TEST_CHECK(handle != NULL);
+
+    AM_TEST_EQ(am_mempool_stat_get(handle, &stat), AM_OK);
+    AM_TEST_EQ(stat.block_size, size);
+    AM_TEST_EQ(stat.block_num, __BLOCK_NUM);
+    AM_TEST_EQ(stat.nfree, __BLOCK_NUM);
+
+    /* ʼĿַ˳Уÿ鰴ָС */
+    for (i = 0; i < __BLOCK_NUM; i++) {
+        p_blocks[i] = am_mempool_alloc(handle);
+        if ((p_blocks[i] != (uint8_t *)__g_pool_mem + i * size) ||
+            (((uintptr_t)p_blocks[i] & (sizeof(void *) - 1)) != 0)) {
+            nbad++;
+        }
+        __block_fill(p_blocks[i], (uint8_t)i);
+    }
+    AM_TEST_EQ(nbad, 0);
+
+    /* ֮ʧܣͳ */
+    AM_TEST_CHECK(am_mempool_alloc(handle) == NULL);
+    AM_TEST_CHECK(am_mempool_alloc(handle) == NULL);
+    AM_TEST_EQ(am_mempool_stat_get(handle, &stat), AM_OK);
+    AM_TEST_EQ(stat.nfree, 0);
+    AM_TEST_EQ(stat.used_max, __BLOCK_NUM);
+    AM_TEST_EQ(stat.nfail, 2);
+
+    /* ݻ */
+    for (i = 0; i < __BLOCK_NUM; i++) {
+        if (!__block_check(p_blocks[i], (uint8_t)i)) {
+            nbad++;
+        }
+    }
+    AM_TEST_EQ(nbad, 0);
+
+    /* ȳ */
+    AM_TEST_EQ(am_mempool_free(handle, p_blocks[3]), AM_OK);
+    AM_TEST_EQ(am_mempool_free(handle, p_blocks[7]), AM_OK);
+    AM_TEST_EQ(am_mempool_free(handle, p_blocks[1]), AM_OK);
+    AM_TEST_CHECK(am_mempool_alloc(handle) == p_blocks[1]);
+    AM_TEST_CHECK(am_mempool_alloc(handle) == p_blocks[7]);
+    AM_TEST_CHECK(am_mempool_alloc(handle) == p_blocks[3]);
+    AM_TEST_CHECK(am_mempool_alloc(handle) == NULL);
+
+    /* ڿػڿ߽ϵĵַ */
+    p = (uint8_t *)__g_pool_mem;
+    AM_TEST_EQ(am_mempool_free(handle, NULL), -AM_EINVAL);
+    AM_TEST_EQ(am_mempool_free(handle, __g_heap_mem), -AM_EINVAL);
+    AM_TEST_EQ(am_mempool_free(handle, p + 1), -AM_EINVAL);
+    AM_TEST_EQ(am_mempool_free(handle, p + size + sizeof(void *)), -AM_EINVAL);
+    AM_TEST_EQ(am_mempool_free(handle, p + __BLOCK_NUM * size), -AM_EINVAL);
+    AM_TEST_EQ(am_mempool_free(NULL, p), -AM_EINVAL);
+
+    AM_TEST_CHECK(am_mempool_contains(handle, p));
+    AM_TEST_CHECK(am_mempool_contains(handle, p + __BLOCK_NUM * size - 1));
+    AM_TEST_CHECK(!am_mempool_contains(handle, p + __BLOCK_NUM * size));
+    AM_TEST_CHECK(!am_mempool_contains(handle, __g_heap_mem));
+
+    /* ܾĵַûн */
+    AM_TEST_EQ(am_mempool_stat_get(handle, &stat), AM_OK);
+    AM_TEST_EQ(stat.nfree, 0);
+    AM_TEST_CHECK(am_mempool_alloc(handle) == NULL);
+
+    for (i = 0; i < __BLOCK_NUM; i++) {
+        AM_TEST_EQ(am_mempool_free(handle, p_blocks[i]), AM_OK);
+    }
+    AM_TEST_EQ(am_mempool_stat_get(handle, &stat), AM_OK);
+    AM_TEST_EQ(stat.nfree, __BLOCK_NUM);
+}
+
+/* 䡢ͷţÿݱֲ䣬ȫ黹 */
+static void __test_random (void)
+{
+    am_mempool_t           pool;
+    am_mempool_handle_t    handle;
+    struct am_mempool_stat stat;
+    uint8_t               *p_blocks[__BLOCK_NUM];
+    uint8_t                fills[__BLOCK_NUM];
+    int                    nlive = 0;
+    int                    nbad  = 0;
+    int                    nfail = 0;
+    int                    r, i;
+
+    memset(p_blocks, 0, sizeof(p_blocks));
+
+    handle = am_mempool_init(&pool,
+                             __g_pool_mem,
+                             sizeof(__g_pool_mem),
+                             __BLOCK_SIZE);
+    AM_TEST_CHECK(handle != NULL);
+
+    for (r = 0; r < __ROUNDS; r++) {
+
+        i = am_test_rand() % __BLOCK_NUM;
+
+        if (p_blocks[i] == NULL) {
+            p_blocks[i] = am_mempool_alloc(handle);
+            if (p_blocks[i] == NULL) {
+                nfail++;
+                continue;
+            }
+            fills[i] = (uint8_t)am_test_rand();
+            __block_fill(p_blocks[i], fills[i]);
+            nlive++;
+        } else {
+            if (!__block_check(p_blocks[i], fills[i])) {
+                nbad++;
+            }
+            if (am_mempool_free(handle, p_blocks[i]) != AM_OK) {
+                nbad++;
+            }
+            p_blocks[i] = NULL;
+            nlive--;
+        }
+
+        if ((r % 256) == 0) {
+            am_mempool_stat_get(handle, &stat);
+            if (stat.nfree != (unsigned int)(__BLOCK_NUM - nlive)) {
+                nbad++;
+            }
+        }
+    }
+
+    /* ͬ䲻ʧ */
+    AM_TEST_EQ(nbad, 0);
+    AM_TEST_EQ(nfail, 0);
+
+    for (i = 0; i < __BLOCK_NUM; i++) {
+        if (p_blocks[i] != NULL) {
+            am_mempool_free(handle, p_blocks[i]);
+        }
+    }
+    AM_TEST_EQ(am_mempool_stat_get(handle, &stat), AM_OK);
+    AM_TEST_EQ(stat.nfree, __BLOCK_NUM);
+}
+
+/* ּ */
+static void __test_class (void)
+{
+    am_mempool_t           small, large;
+    am_mempool_handle_t    pools[2];
+    am_mempool_handle_t    rev[2];
+    am_mempool_class_t     cls;
+    struct am_memheap      heap;
+    struct am_memheap_info info;
+    struct am_mempool_stat stat;
+    void                  *p[8];
+    int                    i;
+
+    pools[0] = am_mempool_init(&small,
+                               __g_small_mem,
+                               sizeof(__g_small_mem),
+                               16);
+    pools[1] = am_mempool_init(&large,
+                               __g_large_mem,
+                               sizeof(__g_large_mem),
+                               64);
+    AM_TEST_CHECK(pools[0] != NULL);
+    AM_TEST_CHECK(pools[1] != NULL);
+
+    AM_TEST_EQ(am_memheap_init(&heap,
+                               "mempool",
+                               __g_heap_mem,
+                               sizeof(__g_heap_mem)),
+               AM_OK);
+
+    /* ر밴СС */
+    rev[0] = pools[1];
+    rev[1] = pools[0];
+    AM_TEST_EQ(am_mempool_class_init(&cls, rev, 2, &heap), -AM_EINVAL);
+    AM_TEST_EQ(am_mempool_class_init(&cls, pools, 2, &heap), AM_OK);
+
+    /* Сתأת */
+    for (i = 0; i < 4; i++) {
+        p[i] = am_mempool_class_alloc(&cls, 10);
+        AM_TEST_CHECK(am_mempool_contains(pools[0], p[i]));
+    }
+    p[4] = am_mempool_class_alloc(&cls, 10);
+    p[5] = am_mempool_class_alloc(&cls, 10);
+    AM_TEST_CHECK(am_mempool_contains(pools[1], p[4]));
+    AM_TEST_CHECK(am_mempool_contains(pools[1], p[5]));
+    p[6] = am_mempool_class_alloc(&cls, 10);
+    AM_TEST_CHECK(p[6] != NULL);
+    AM_TEST_CHECK(!am_mempool_contains(pools[0], p[6]));
+    AM_TEST_CHECK(!am_mempool_contains(pools[1], p[6]));
+
+    /* ֱ̫ӴӶз */
+    p[7] = am_mempool_class_alloc(&cls, 100);
+    AM_TEST_CHECK(p[7] != NULL);
+    AM_TEST_CHECK(!am_mempool_contains(pools[1], p[7]));
+
+    AM_TEST_CHECK(am_mempool_class_alloc(&cls, 0) == NULL);
+
+    /* ͷʱ黹ԵĿغͶ */
+    for (i = 0; i < 8; i++) {
+        am_mempool_class_free(&cls, p[i]);
+    }
+
+    AM_TEST_EQ(am_mempool_stat_get(pools[0], &stat), AM_OK);
+    AM_TEST_EQ(stat.nfree, 4);
+    AM_TEST_EQ(am_mempool_stat_get(pools[1], &stat), AM_OK);
+    AM_TEST_EQ(stat.nfree, 2);
+    AM_TEST_EQ(am_memheap_info_get(&heap, &info), AM_OK);
+    AM_TEST_EQ(info.used_blocks, 0);
+
+    /* ʹöʱ꼴ʧ */
+    AM_TEST_EQ(am_mempool_class_init(&cls, pools, 2, NULL), AM_OK);
+    AM_TEST_CHECK(am_mempool_class_alloc(&cls, 100) == NULL);
+}
+
+int main (void)
+{
+    am_test_init();
+
+    __test_init();
+    __test_pool();
+    __test_random();
+    __test_class();
+
+    return am_test_exit("mempool");
+}
+
+/* end of file */
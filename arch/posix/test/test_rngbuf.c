@@ -0,0 +1,321 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief λعԣam_rngbufam_rngbuf_spsc
+ *
+ * ȵд/οģͱȽϣǻơպֱӶдӿڣ
+ * SPSC ̲߳д/˳
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_rngbuf.h"
+#include "am_rngbuf_spsc.h"
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define __BUF_SIZE      64
+#define __ROUNDS        20000
+#define __STREAM_BYTES  (1024 * 1024)
+
+/* ͱ߽ */
+static void __test_rngbuf_basic (void)
+{
+    struct am_rngbuf rb;
+    char             buf[8];
+    char             out[8];
+    char             c;
+    int              i;
+
+    AM_TEST_EQ(am_rngbuf_init(&rb, buf, 0), -AM_EINVAL);
+    AM_TEST_EQ(am_rngbuf_init(&rb, buf, sizeof(buf)), AM_OK);
+
+    AM_TEST_CHECK(am_rngbuf_isempty(&rb));
+    AM_TEST_EQ(am_rngbuf_getchar(&rb, &c), 0);
+    AM_TEST_EQ(am_rngbuf_freebytes(&rb), sizeof(buf) - 1);
+
+    /* һֽ */
+    for (i = 0; i < (int)sizeof(buf) - 1; i++) {
+        AM_TEST_EQ(am_rngbuf_putchar(&rb, (char)i), 1);
+    }
+    AM_TEST_CHECK(am_rngbuf_isfull(&rb));
+    AM_TEST_EQ(am_rngbuf_putchar(&rb, 'x'), 0);
+    AM_TEST_EQ(am_rngbuf_nbytes(&rb), sizeof(buf) - 1);
+
+    AM_TEST_EQ(am_rngbuf_get(&rb, out, 3), 3);
+    AM_TEST_EQ(out[0] + out[1] + out[2], 0 + 1 + 2);
+    AM_TEST_EQ(am_rngbuf_put(&rb, "abcdef", 6), 3);
+    AM_TEST_EQ(am_rngbuf_nbytes(&rb), sizeof(buf) - 1);
+
+    am_rngbuf_flush(&rb);
+    AM_TEST_CHECK(am_rngbuf_isempty(&rb));
+
+    /* ֱдύ */
+    for (i = 0; i < 5; i++) {
+        am_rngbuf_put_ahead(&rb, (char)('A' + i), i);
+    }
+    AM_TEST_CHECK(am_rngbuf_isempty(&rb));
+    am_rngbuf_move_ahead(&rb, 5);
+    AM_TEST_EQ(am_rngbuf_get(&rb, out, sizeof(out)), 5);
+    AM_TEST_CHECK(memcmp(out, "ABCDE", 5) == 0);
+}
+
+/* ȶдοбȽ */
+static void __test_rngbuf_random (void)
+{
+    struct am_rngbuf rb;
+    char             buf[__BUF_SIZE];
+    char             tmp[__BUF_SIZE];
+    uint8_t          wr_seq = 0;
+    uint8_t          rd_seq = 0;
+    size_t           level  = 0;
+    size_t           n, got, i;
+    int              nbad   = 0;
+    int              r;
+
+    am_rngbuf_init(&rb, buf, sizeof(buf));
+
+    for (r = 0; r < __ROUNDS; r++) {
+        n = am_test_rand() % sizeof(tmp);
+        for (i = 0; i < n; i++) {
+            tmp[i] = (char)(wr_seq + i);
+        }
+        got     = am_rngbuf_put(&rb, tmp, n);
+        wr_seq += got;
+        level  += got;
+        if (got != min(n, sizeof(buf) - 1 - (level - got))) {
+            nbad++;
+        }
+
+        n   = am_test_rand() % sizeof(tmp);
+        got = am_rngbuf_get(&rb, tmp, n);
+        if (got != min(n, level)) {
+            nbad++;
+        }
+        for (i = 0; i < got; i++) {
+            if ((uint8_t)tmp[i] != rd_seq++) {
+                nbad++;
+            }
+        }
+        level -= got;
+
+        if (am_rngbuf_nbytes(&rb) != level) {
+            nbad++;
+        }
+    }
+
+    AM_TEST_EQ(nbad, 0);
+}
+
+static void __test_spsc_basic (void)
+{
+    struct am_rngbuf_spsc rb;
+    char                  buf[16];
+    char                 *p;
+    size_t                len;
+    char                  c;
+    int                   i;
+
+    AM_TEST_EQ(am_rngbuf_spsc_init(&rb, buf, 12), -AM_EINVAL);
+    AM_TEST_EQ(am_rngbuf_spsc_init(&rb, buf, sizeof(buf)), AM_OK);
+
+    AM_TEST_CHECK(am_rngbuf_spsc_isempty(&rb));
+    AM_TEST_EQ(am_rngbuf_spsc_getchar(&rb, &c), 0);
+    AM_TEST_EQ(am_rngbuf_spsc_peek_read(&rb, &p, &len), -AM_EEMPTY);
+
+    /* ռȫʹ */
+    for (i = 0; i < (int)sizeof(buf); i++) {
+        AM_TEST_EQ(am_rngbuf_spsc_putchar(&rb, (char)i), 1);
+    }
+    AM_TEST_CHECK(am_rngbuf_spsc_isfull(&rb));
+    AM_TEST_EQ(am_rngbuf_spsc_putchar(&rb, 'x'), 0);
+    AM_TEST_EQ(am_rngbuf_spsc_reserve_write(&rb, &p, &len), -AM_EFULL);
+    AM_TEST_EQ(am_rngbuf_spsc_freebytes(&rb), 0);
+
+    /*  10 ֽںпռΪͷ 10 ֽ */
+    am_rngbuf_spsc_consume(&rb, 10);
+    AM_TEST_EQ(am_rngbuf_spsc_nbytes(&rb), 6);
+    AM_TEST_EQ(am_rngbuf_spsc_reserve_write(&rb, &p, &len), AM_OK);
+    AM_TEST_CHECK(p == buf);
+    AM_TEST_EQ(len, 10);
+    memcpy(p, "0123456789", 10);
+    am_rngbuf_spsc_commit_write(&rb, 4);
+
+    /* ЧݿԽĩβʱζȡ */
+    AM_TEST_EQ(am_rngbuf_spsc_peek_read(&rb, &p, &len), AM_OK);
+    AM_TEST_CHECK(p == &buf[10]);
+    AM_TEST_EQ(len, 6);
+    am_rngbuf_spsc_consume(&rb, len);
+    AM_TEST_EQ(am_rngbuf_spsc_peek_read(&rb, &p, &len), AM_OK);
+    AM_TEST_EQ(len, 4);
+    AM_TEST_CHECK(memcmp(p, "0123", 4) == 0);
+
+    /* ֱ */
+    am_rngbuf_spsc_consume(&rb, 100);
+    AM_TEST_CHECK(am_rngbuf_spsc_isempty(&rb));
+    am_rngbuf_spsc_commit_write(&rb, 100);
+    AM_TEST_CHECK(am_rngbuf_spsc_isfull(&rb));
+
+    am_rngbuf_spsc_flush(&rb);
+    AM_TEST_CHECK(am_rngbuf_spsc_isempty(&rb));
+}
+
+static void __test_spsc_random (void)
+{
+    struct am_rngbuf_spsc rb;
+    char                  buf[__BUF_SIZE];
+    char                  tmp[__BUF_SIZE * 2];
+    uint8_t               wr_seq = 0;
+    uint8_t               rd_seq = 0;
+    size_t                level  = 0;
+    size_t                n, got, i;
+    int                   nbad   = 0;
+    int                   r;
+
+    am_rngbuf_spsc_init(&rb, buf, sizeof(buf));
+
+    for (r = 0; r < __ROUNDS; r++) {
+        n = am_test_rand() % sizeof(tmp);
+        for (i = 0; i < n; i++) {
+            tmp[i] = (char)(wr_seq + i);
+        }
+        got     = am_rngbuf_spsc_put(&rb, tmp, n);
+        wr_seq += got;
+        if (got != min(n, sizeof(buf) - level)) {
+            nbad++;
+        }
+        level += got;
+
+        n   = am_test_rand() % sizeof(tmp);
+        got = am_rngbuf_spsc_get(&rb, tmp, n);
+        if (got != min(n, level)) {
+            nbad++;
+        }
+        for (i = 0; i < got; i++) {
+            if ((uint8_t)tmp[i] != rd_seq++) {
+                nbad++;
+            }
+        }
+        level -= got;
+
+        if (am_rngbuf_spsc_nbytes(&rb) != level) {
+            nbad++;
+        }
+    }
+
+    AM_TEST_EQ(nbad, 0);
+}
+
+/* д̣߳д룬ʹøƽӿںֱдӿ */
+static void *__spsc_producer (void *p_arg)
+{
+    am_rngbuf_spsc_t rb  = (am_rngbuf_spsc_t)p_arg;
+    uint32_t         seq = 0;
+    char             tmp[37];
+    char            *p;
+    size_t           len, i, n;
+
+    while (seq < __STREAM_BYTES) {
+        if (seq & 0x100) {
+            if (am_rngbuf_spsc_reserve_write(rb, &p, &len) != AM_OK) {
+                sched_yield();
+                continue;
+            }
+            len = min(len, (size_t)(__STREAM_BYTES - seq));
+            for (i = 0; i < len; i++) {
+                p[i] = (char)(seq + i);
+            }
+            am_rngbuf_spsc_commit_write(rb, len);
+            seq += len;
+        } else {
+            n = min(sizeof(tmp), (size_t)(__STREAM_BYTES - seq));
+            for (i = 0; i < n; i++) {
+                tmp[i] = (char)(seq + i);
+            }
+            n = am_rngbuf_spsc_put(rb, tmp, n);
+            if (n == 0) {
+                sched_yield();
+            }
+            seq += n;
+        }
+    }
+
+    return NULL;
+}
+
+/* ̲߳д˳ */
+static void __test_spsc_threads (void)
+{
+    static char           buf[256];
+    struct am_rngbuf_spsc rb;
+    pthread_t             thread;
+    uint32_t              seq  = 0;
+    int                   nbad = 0;
+    char                  tmp[23];
+    char                 *p;
+    size_t                len, i;
+
+    am_rngbuf_spsc_init(&rb, buf, sizeof(buf));
+
+    pthread_create(&thread, NULL, __spsc_producer, &rb);
+
+    while (seq < __STREAM_BYTES) {
+        if (seq & 0x200) {
+            if (am_rngbuf_spsc_peek_read(&rb, &p, &len) != AM_OK) {
+                sched_yield();
+                continue;
+            }
+        } else {
+            len = am_rngbuf_spsc_get(&rb, tmp, sizeof(tmp));
+            p   = tmp;
+            if (len == 0) {
+                sched_yield();
+            }
+        }
+        for (i = 0; i < len; i++) {
+            if (p[i] != (char)(seq + i)) {
+                nbad++;
+            }
+        }
+        if (p != tmp) {
+            am_rngbuf_spsc_consume(&rb, len);
+        }
+        seq += len;
+    }
+
+    pthread_join(thread, NULL);
+
+    AM_TEST_EQ(nbad, 0);
+    AM_TEST_CHECK(am_rngbuf_spsc_isempty(&rb));
+}
+
+int main (void)
+{
+    am_test_init();
+
+    __test_rngbuf_basic();
+    __test_rngbuf_random();
+    __test_spsc_basic();
+    __test_spsc_random();
+    __test_spsc_threads();
+
+    return am_test_exit("rngbuf");
+}
+
+/* end of file */
@@ -0,0 +1,204 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ʱع
+ *
+ * ֶ am_softimer_module_tick()ֹͣʱֶʱڻص
+ * µԼÿεڵ tick οģͱȽϡ
+ *  AM_SOFTIMER_WHEEL ʱʱʵ֣Բʵ֡
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_softimer.h"
+
+#define __TIMER_NUM     32
+#define __TICKS         50000
+#define __CLKRATE       1000        /* 1 tick Ϊ 1ms */
+
+/** \brief οģеĶʱ */
+struct __ref_timer {
+    am_softimer_t timer;
+    am_bool_t     running;
+    am_bool_t     restart;          /* صµ */
+    uint32_t      period;           /* ڣtick */
+    uint32_t      expect;           /* һεڵ tick */
+    uint32_t      nfired;
+};
+
+static struct __ref_timer __g_timers[__TIMER_NUM];
+static uint32_t           __g_now;          /* ڴ tick */
+static int                __g_nlate;        /*  tick Ĵ */
+static uint32_t           __g_nfired;
+
+/*  1 ~ 300 tickżʱֵ 0 ~ 2 ķΧ */
+static uint32_t __period_rand (void)
+{
+    uint32_t r = am_test_rand();
+
+    if ((r & 0x3F) == 0) {
+        return 4096 + (r >> 8) % 30000;
+    }
+    return 1 + (r >> 8) % 300;
+}
+
+static void __timer_start (struct __ref_timer *p_ref, uint32_t start)
+{
+    p_ref->period  = __period_rand();
+    p_ref->expect  = start + p_ref->period;
+    p_ref->running = AM_TRUE;
+
+    am_softimer_start(&p_ref->timer, p_ref->period * 1000 / __CLKRATE);
+}
+
+static void __timer_callback (void *p_arg)
+{
+    struct __ref_timer *p_ref = (struct __ref_timer *)p_arg;
+
+    __g_nfired++;
+    p_ref->nfired++;
+
+    if (!p_ref->running || (p_ref->expect != __g_now)) {
+        __g_nlate++;
+        if (__g_nlate < 10) {
+            am_kprintf("timer %d fired at %u, expect %u (%s)\n",
+                       (int)(p_ref - __g_timers),
+                       (unsigned)__g_now,
+                       (unsigned)p_ref->expect,
+                       p_ref->running ? "running" : "stopped");
+        }
+    }
+
+    if (p_ref->restart) {
+        __timer_start(p_ref, __g_now);
+    } else {
+        p_ref->expect = __g_now + p_ref->period;
+    }
+}
+
+/* ֹͣʱ鵽ʱ */
+static void __test_random (void)
+{
+    struct __ref_timer *p_ref;
+    uint32_t            r;
+    int                 i;
+
+    AM_TEST_EQ(am_softimer_module_init(__CLKRATE), AM_OK);
+    AM_TEST_EQ(am_softimer_next_expiry_ticks(), AM_SOFTIMER_TICKS_FOREVER);
+
+    for (i = 0; i < __TIMER_NUM; i++) {
+        p_ref = &__g_timers[i];
+        AM_TEST_EQ(am_softimer_init(&p_ref->timer, __timer_callback, p_ref),
+                   AM_OK);
+        p_ref->restart = (am_bool_t)((i & 3) == 0);
+    }
+
+    for (__g_now = 0; __g_now < __TICKS; ) {
+
+        /*  tick ֮ĶʱӵǰѴ tick ʼʱ */
+        r = am_test_rand();
+        if ((r & 3) == 0) {
+            p_ref = &__g_timers[(r >> 8) % __TIMER_NUM];
+            if ((r & 0x30) == 0) {
+                am_softimer_stop(&p_ref->timer);
+                p_ref->running = AM_FALSE;
+            } else {
+                __timer_start(p_ref, __g_now);
+            }
+        }
+
+        __g_now++;
+        am_softimer_module_tick();
+    }
+
+    for (i = 0; i < __TIMER_NUM; i++) {
+        am_softimer_stop(&__g_timers[i].timer);
+        __g_timers[i].running = AM_FALSE;
+    }
+
+    am_kprintf("%u callbacks in %u ticks\n",
+               (unsigned)__g_nfired,
+               (unsigned)__g_now);
+
+    AM_TEST_EQ(__g_nlate, 0);
+    AM_TEST_CHECK(__g_nfired > __TICKS / 10);
+
+    /* ȫֹͣ */
+    AM_TEST_EQ(am_softimer_next_expiry_ticks(), AM_SOFTIMER_TICKS_FOREVER);
+}
+
+/* am_softimer_next_expiry_ticks() ĵʱ */
+static void __test_next_expiry (void)
+{
+    am_softimer_t timer[3];
+    int           i;
+
+    am_softimer_module_init(__CLKRATE);
+
+    for (i = 0; i < 3; i++) {
+        am_softimer_init(&timer[i], NULL, NULL);
+    }
+
+    /*
+     * ʱʵַһҪڻʱ̣ĵʱ̣
+     * ʵַصľĵʱ
+     */
+#ifdef AM_SOFTIMER_WHEEL
+#define __NEXT_EXPIRY_CHECK(expect) \
+    AM_TEST_CHECK((am_softimer_next_expiry_ticks() >= 1) && \
+                  (am_softimer_next_expiry_ticks() <= (expect)))
+#else
+#define __NEXT_EXPIRY_CHECK(expect) \
+    AM_TEST_EQ(am_softimer_next_expiry_ticks(), (expect))
+#endif
+
+    am_softimer_start(&timer[0], 500);
+    __NEXT_EXPIRY_CHECK(500);
+    am_softimer_start(&timer[1], 20);
+    am_softimer_start(&timer[2], 10000);
+    __NEXT_EXPIRY_CHECK(20);
+
+    for (i = 0; i < 20; i++) {
+        am_softimer_module_tick();
+    }
+
+    /* timer[1] ѵڲ */
+    __NEXT_EXPIRY_CHECK(20);
+    am_softimer_stop(&timer[1]);
+    __NEXT_EXPIRY_CHECK(480);
+
+    am_softimer_stop(&timer[0]);
+    am_softimer_stop(&timer[2]);
+    AM_TEST_EQ(am_softimer_next_expiry_ticks(), AM_SOFTIMER_TICKS_FOREVER);
+}
+
+int main (void)
+{
+    am_test_init();
+
+    __test_random();
+    __test_next_expiry();
+
+#ifdef AM_SOFTIMER_WHEEL
+    return am_test_exit("softimer (wheel)");
+#else
+    return am_test_exit("softimer (list)");
+#endif
+}
+
+/* end of file */
@@ -0,0 +1,271 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ʱ޵δģʽع
+ *
+ * ʹģ 16 λӲʱƵ 10KHztick Ƶ 1KHzһ tick Ϊ
+ * 10 ֵԳֵƽʱ䣬趨ֵʱöʱص
+ * ʱ 8 ڵĶʱÿζ tick м
+ * Ӳʱ飺
+ *  1. 50ms ڶʱεڵļϸΪ 500 ֵ
+ *  2. жʱ tick 㵽ڣλ䣩
+ *  3. Ķʱ (ms - 1, ms]  tick ֮ڣ֮ϸڵڡ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_softimer.h"
+
+#define __COUNT_FREQ    10000       /* ӲʱƵ */
+#define __CLKRATE       1000        /* tick Ƶ */
+#define __CPT           (__COUNT_FREQ / __CLKRATE)
+#define __COUNTS        400000      /* ģ 40s */
+#define __TIMER_NUM     8
+
+/*******************************************************************************
+  ģ 16 λӲʱ
+*******************************************************************************/
+
+static struct {
+    am_timer_serv_t   serv;
+    uint32_t          count;
+    uint32_t          period;
+    am_bool_t         running;
+    void            (*pfn_callback) (void *);
+    void             *p_arg;
+    int               nbad_period;      /* õڳ 16 λ */
+} __g_hw;
+
+static const am_timer_info_t __g_hw_info = {
+    16,                                 /* 16 λʱ */
+    1,                                  /* 1 ͨ */
+    0,
+    1,
+};
+
+static const am_timer_info_t *__hw_info_get (void *p_drv)
+{
+    return &__g_hw_info;
+}
+
+static int __hw_clkin_freq_get (void *p_drv, uint32_t *p_freq)
+{
+    *p_freq = __COUNT_FREQ;
+    return AM_OK;
+}
+
+static int __hw_prescale_set (void *p_drv, uint8_t chan, uint32_t prescale)
+{
+    return -AM_ENOTSUP;
+}
+
+static int __hw_prescale_get (void *p_drv, uint8_t chan, uint32_t *p_prescale)
+{
+    *p_prescale = 1;
+    return AM_OK;
+}
+
+static int __hw_count_get (void *p_drv, uint8_t chan, void *p_count)
+{
+    *(uint32_t *)p_count = __g_hw.count;
+    return AM_OK;
+}
+
+static int __hw_rollover_get (void *p_drv, uint8_t chan, void *p_rollover)
+{
+    *(uint32_t *)p_rollover = 0xFFFF / __COUNT_FREQ;
+    return AM_OK;
+}
+
+static int __hw_enable (void *p_drv, uint8_t chan, void *p_count)
+{
+    uint32_t period = *(uint32_t *)p_count;
+
+    if ((period == 0) || (period > 0xFFFF)) {
+        __g_hw.nbad_period++;
+    }
+
+    __g_hw.count   = 0;
+    __g_hw.period  = period;
+    __g_hw.running = AM_TRUE;
+
+    return AM_OK;
+}
+
+static int __hw_disable (void *p_drv, uint8_t chan)
+{
+    __g_hw.running = AM_FALSE;
+    return AM_OK;
+}
+
+static int __hw_callback_set (void    *p_drv,
+                              uint8_t  chan,
+                              void   (*pfn_callback) (void *),
+                              void    *p_arg)
+{
+    __g_hw.pfn_callback = pfn_callback;
+    __g_hw.p_arg        = p_arg;
+    return AM_OK;
+}
+
+static struct am_timer_drv_funcs __g_hw_funcs = {
+    __hw_info_get,
+    __hw_clkin_freq_get,
+    __hw_prescale_set,
+    __hw_prescale_get,
+    __hw_count_get,
+    __hw_rollover_get,
+    __hw_enable,
+    __hw_disable,
+    __hw_callback_set,
+};
+
+/*******************************************************************************
+  
+*******************************************************************************/
+
+/** \brief Ķʱ */
+struct __chk_timer {
+    am_softimer_t timer;
+    uint32_t      ms;
+    uint32_t      start;            /* ʱ̣0xFFFFFFFF ʾѵڹ */
+    uint32_t      expect;           /* һεʱ̣start Чʱ */
+    uint32_t      nfired;
+};
+
+static struct __chk_timer __g_periodic;             /* 50ms ڶʱ */
+static struct __chk_timer __g_timers[__TIMER_NUM];  /* Ķʱ */
+
+static uint32_t           __g_now;                  /* ǰʱֵ̣ */
+static uint32_t           __g_phase = 0xFFFFFFFF;   /* tick λ */
+static int                __g_nphase;               /*  tick 㵽 */
+static int                __g_nlate;                /* ʱ̴ */
+
+static void __timer_callback (void *p_arg)
+{
+    struct __chk_timer *p_chk = (struct __chk_timer *)p_arg;
+    uint32_t            span;
+
+    p_chk->nfired++;
+
+    if (__g_phase == 0xFFFFFFFF) {
+        __g_phase = __g_now % __CPT;
+    } else if ((__g_now % __CPT) != __g_phase) {
+        __g_nphase++;
+    }
+
+    if (p_chk->start != 0xFFFFFFFF) {
+
+        /* ĵһεڣʱ tick һ tick */
+        span = __g_now - p_chk->start;
+        if ((span <= (p_chk->ms - 1) * __CPT) || (span > p_chk->ms * __CPT)) {
+            __g_nlate++;
+        }
+        p_chk->start = 0xFFFFFFFF;
+
+    } else if (__g_now != p_chk->expect) {
+        __g_nlate++;
+        if (__g_nlate < 10) {
+            am_kprintf("timer %u ms fired at %u, expect %u\n",
+                       (unsigned)p_chk->ms,
+                       (unsigned)__g_now,
+                       (unsigned)p_chk->expect);
+        }
+    }
+
+    p_chk->expect = __g_now + p_chk->ms * __CPT;
+}
+
+static void __chk_start (struct __chk_timer *p_chk, uint32_t ms)
+{
+    p_chk->ms    = ms;
+    p_chk->start = __g_now;
+    am_softimer_start(&p_chk->timer, ms);
+}
+
+/* ƽһֵʱж */
+static void __hw_step (void)
+{
+    __g_now++;
+
+    if (__g_hw.running && (++__g_hw.count >= __g_hw.period)) {
+        __g_hw.count = 0;
+        if (__g_hw.pfn_callback != NULL) {
+            __g_hw.pfn_callback(__g_hw.p_arg);
+        }
+    }
+}
+
+int main (void)
+{
+    uint32_t r;
+    int      i;
+    int      nrestart = 0;
+
+    am_test_init();
+
+    __g_hw.serv.p_funcs = &__g_hw_funcs;
+    __g_hw.serv.p_drv   = &__g_hw;
+
+    AM_TEST_EQ(am_softimer_module_init_tickless(&__g_hw.serv, 0, __CLKRATE),
+               AM_OK);
+
+    am_softimer_init(&__g_periodic.timer, __timer_callback, &__g_periodic);
+    for (i = 0; i < __TIMER_NUM; i++) {
+        am_softimer_init(&__g_timers[i].timer,
+                         __timer_callback,
+                         &__g_timers[i]);
+    }
+
+    /*  tick м */
+    for (i = 0; i < 3; i++) {
+        __hw_step();
+    }
+    __chk_start(&__g_periodic, 50);
+
+    while (__g_now < __COUNTS) {
+
+        __hw_step();
+
+        /* жϷغʱµһʱ */
+        r = am_test_rand();
+        if ((r % 37) == 0) {
+            __chk_start(&__g_timers[(r >> 8) % __TIMER_NUM],
+                        1 + (r >> 12) % 120);
+            nrestart++;
+        }
+
+        /* żѯ´εʱ䣨ͬᲹѾ tick */
+        if ((r % 101) == 0) {
+            am_softimer_next_expiry_ticks();
+        }
+    }
+
+    am_kprintf("%u periodic expiries, %d restarts\n",
+               (unsigned)__g_periodic.nfired,
+               nrestart);
+
+    AM_TEST_EQ(__g_hw.nbad_period, 0);
+    AM_TEST_EQ(__g_nphase, 0);
+    AM_TEST_EQ(__g_nlate, 0);
+    AM_TEST_EQ(__g_periodic.nfired, (__COUNTS - 3) / (50 * __CPT));
+
+    return am_test_exit("tickless");
+}
+
+/* end of file */
@@ -0,0 +1,254 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ֡䣨COBS/SLIPع
+ *
+ * ģ UART ķдܵӹܵĳעͬһ UART 
+ * նˣжӳٶִУôصɲԳ
+ * am_isr_defer_job_process()  PendSV֡дַָתַ
+ * ȸ COBS ı߽磬յ֡CRC ͳ֡
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_uart_frame.h"
+#include "am_uart_rngbuf.h"
+#include "am_crc_soft.h"
+#include "am_crc_table_def.h"
+#include "am_isr_defer.h"
+#include "am_posix_uart.h"
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define __FRAME_MAX     600         /*  COBS 飨254 ֽڣ */
+#define __FRAME_NUM     300
+#define __CRC_BYTES     2
+
+static am_posix_uart_dev_t     __g_uart;
+static am_uart_rngbuf_dev_t    __g_rngbuf;
+static uint8_t                 __g_rxbuf[256];
+static uint8_t                 __g_txbuf[256];
+
+static am_uart_frame_dev_t     __g_frame_dev;
+static uint8_t                 __g_frame_buf[__FRAME_MAX + __CRC_BYTES];
+
+static int                     __g_pipe[2];
+
+static uint8_t                 __g_sent[__FRAME_MAX + 1];
+static uint8_t                 __g_recv[__FRAME_MAX + 1];
+static int                     __g_recv_len;      /* յ֡Ȼ */
+static int                     __g_recv_num;      /* յ֡ */
+
+/* CRC-16/KERMIT g_crc_table_16_1021_ref һ */
+static const am_crc_pattern_t  __g_crc_pattern = {
+    16,                     /*  */
+    0x1021,                 /* ɶʽ */
+    0x0000,                 /* ʼֵ */
+    AM_TRUE,                /* λת */
+    AM_TRUE,                /* λת */
+    0x0000,                 /* ֵ */
+};
+
+static void __frame_rx_callback (void *p_arg, const uint8_t *p_frame, int len)
+{
+    __g_recv_num++;
+    __g_recv_len = len;
+
+    if ((len > 0) && (len <= (int)sizeof(__g_recv))) {
+        memcpy(__g_recv, p_frame, len);
+    }
+}
+
+/* ѹܵеݰעնˣÿעִһӳ */
+static int __loopback (am_bool_t corrupt)
+{
+    uint8_t buf[__FRAME_MAX * 2 + 16];
+    int     len, n, pos;
+
+    len = read(__g_pipe[0], buf, sizeof(buf));
+    if (len <= 0) {
+        return 0;
+    }
+
+    /* ޸мһֽڣΪָ֡ӦУʧ */
+    if (corrupt && (len > 4)) {
+        pos       = 1 + am_test_rand() % (len - 2);
+        buf[pos] ^= 0x11;
+        if ((buf[pos] == 0x00) || (buf[pos] == 0xC0)) {
+            buf[pos] ^= 0x22;
+        }
+    }
+
+    for (pos = 0; pos < len; pos += n) {
+        n = 1 + am_test_rand() % 64;
+        if (n > len - pos) {
+            n = len - pos;
+        }
+        am_posix_uart_rx_inject(&__g_uart, &buf[pos], n);
+        am_isr_defer_job_process();
+    }
+
+    return len;
+}
+
+/* ֡жΪ 0x000xC00xDB ֽڣ򳤴 0 ֽ */
+static uint32_t __frame_rand (uint8_t *p_buf, uint32_t max)
+{
+    static const uint8_t special[] = {0x00, 0xC0, 0xDB, 0xDC, 0xDD, 0x01};
+    uint32_t             len;
+    uint32_t             i;
+    uint32_t             r = am_test_rand();
+
+    switch (r & 3) {
+    case 0:
+        len = 253 + (r >> 8) % 4;           /* COBS ߽總 */
+        break;
+    case 1:
+        len = (r >> 8) % 8;
+        break;
+    default:
+        len = (r >> 8) % (max + 1);
+        break;
+    }
+
+    for (i = 0; i < len; i++) {
+        r = am_test_rand();
+        if ((r & 7) == 0) {
+            p_buf[i] = special[(r >> 8) % sizeof(special)];
+        } else {
+            p_buf[i] = (uint8_t)((r >> 8) | 1);
+        }
+    }
+
+    return len;
+}
+
+static void __test_coding (const char *p_name, uint8_t coding)
+{
+    am_crc_soft_t           crc_rx;
+    am_crc_soft_t           crc_tx;
+    am_uart_frame_handle_t  handle;
+    uint32_t                len;
+    int                     nbad = 0;
+    int                     nerr = 0;
+    int                     i;
+
+    const am_uart_frame_devinfo_t devinfo = {
+        coding,
+        __g_frame_buf,
+        sizeof(__g_frame_buf),
+        &__g_crc_pattern,
+        0,
+    };
+
+    am_uart_rngbuf_ioctl(&__g_rngbuf, AM_UART_RNGBUF_RFLUSH, NULL);
+
+    handle = am_uart_frame_init(&__g_frame_dev,
+                                &devinfo,
+                                &__g_rngbuf,
+                                am_crc_soft_init(&crc_rx,
+                                                 &g_crc_table_16_1021_ref),
+                                am_crc_soft_init(&crc_tx,
+                                                 &g_crc_table_16_1021_ref));
+    AM_TEST_CHECK(handle != NULL);
+    AM_TEST_EQ(am_uart_frame_rx_cb_reg(handle, __frame_rx_callback, NULL),
+               AM_OK);
+
+    /* ȷ֡ԭյ */
+    for (i = 0; i < __FRAME_NUM; i++) {
+        len          = __frame_rand(__g_sent, __FRAME_MAX);
+        __g_recv_num = 0;
+        __g_recv_len = -1;
+
+        AM_TEST_EQ(am_uart_frame_send(handle, __g_sent, len), AM_OK);
+        __loopback(AM_FALSE);
+
+        if ((__g_recv_num != 1) ||
+            (__g_recv_len != (int)len) ||
+            (memcmp(__g_recv, __g_sent, len) != 0)) {
+            nbad++;
+        }
+    }
+    AM_TEST_EQ(nbad, 0);
+
+    /* б޸ĵ֡Ϊȷ֡ύ */
+    for (i = 0; i < 50; i++) {
+        len          = 16 + __frame_rand(__g_sent, __FRAME_MAX - 16);
+        __g_recv_num = 0;
+        __g_recv_len = 0;
+
+        am_uart_frame_send(handle, __g_sent, len);
+        __loopback(AM_TRUE);
+
+        if ((__g_recv_num > 0) && (__g_recv_len >= 0)) {
+            nbad++;
+        } else if (__g_recv_num > 0) {
+            nerr++;
+        }
+    }
+    AM_TEST_EQ(nbad, 0);
+    AM_TEST_CHECK(nerr > 0);
+
+    /* ֡֡ */
+    memset(__g_sent, 0x55, sizeof(__g_sent));
+    __g_recv_num = 0;
+    am_uart_frame_send(handle, __g_sent, __FRAME_MAX + 1);
+    __loopback(AM_FALSE);
+    AM_TEST_EQ(__g_recv_num, 1);
+    AM_TEST_EQ(__g_recv_len, -AM_EMSGSIZE);
+
+    /* Լ */
+    __g_recv_num = 0;
+    am_uart_frame_send(handle, (const uint8_t *)"\0abc\xC0", 5);
+    __loopback(AM_FALSE);
+    AM_TEST_EQ(__g_recv_num, 1);
+    AM_TEST_EQ(__g_recv_len, 5);
+    AM_TEST_CHECK(memcmp(__g_recv, "\0abc\xC0", 5) == 0);
+
+    am_kprintf("%s: %d frames, %d corrupted frames rejected\n",
+               p_name, __FRAME_NUM, nerr);
+}
+
+int main (void)
+{
+    am_uart_handle_t uart_handle;
+
+    am_test_init();
+
+    /* ֻӲ __loopback() ӳ */
+    am_isr_defer_init(NULL, NULL);
+
+    AM_TEST_EQ(pipe(__g_pipe), 0);
+    fcntl(__g_pipe[0], F_SETFL, O_NONBLOCK);
+
+    uart_handle = am_posix_uart_init(&__g_uart, __g_pipe[1]);
+    am_uart_rngbuf_init(&__g_rngbuf,
+                        uart_handle,
+                        __g_rxbuf,
+                        sizeof(__g_rxbuf),
+                        __g_txbuf,
+                        sizeof(__g_txbuf));
+
+    __test_coding("cobs", AM_UART_FRAME_COBS);
+    __test_coding("slip", AM_UART_FRAME_SLIP);
+
+    return am_test_exit("uart_frame");
+}
+
+/* end of file */
@@ -0,0 +1,337 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief XMODEM ع
+ *
+ * ӵĻػڣжģʽȫַԶ˵
+ * ջصһΪ XMODEM ͷһΪշֱ 1K/CRC 
+ * 128/ۼӺģʽһ֡СļȽյݡ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_test.h"
+#include "am_xmodem.h"
+#include "am_crc_soft.h"
+#include "am_crc_table_def.h"
+#include "am_softimer.h"
+#include <string.h>
+
+#define __DOC_SIZE      5000
+#define __CTRLZ         0x1A        /* һַ֡ */
+
+/*******************************************************************************
+  ػ
+*******************************************************************************/
+
+/** \brief ػ豸 */
+struct __loop_uart {
+    am_uart_serv_t       serv;
+    struct __loop_uart  *p_peer;
+
+    int                (*pfn_txchar_get) (void *, char *);
+    void                *p_txget_arg;
+    int                (*pfn_rxchar_put) (void *, char);
+    void                *p_rxput_arg;
+
+    am_bool_t            busy;      /* ڷ */
+    am_bool_t            pending;   /* ڼٴ˷ */
+    uint32_t             tx_count;
+};
+
+static int __loop_ioctl (void *p_drv, int request, void *p_arg)
+{
+    return (request == AM_UART_MODE_SET) ? AM_OK : -AM_ENOTSUP;
+}
+
+/*
+ * Ѵ͵ַνԶˡԶ˵Ľջصпٴ˻Զ˵
+ * ͣڷʱֻ¼ѭͣ޵ݹ顣
+ */
+static int __loop_tx_startup (void *p_drv)
+{
+    struct __loop_uart *p_dev  = (struct __loop_uart *)p_drv;
+    struct __loop_uart *p_peer = p_dev->p_peer;
+    char                c;
+
+    if (p_dev->busy) {
+        p_dev->pending = AM_TRUE;
+        return AM_OK;
+    }
+
+    p_dev->busy = AM_TRUE;
+
+    do {
+        p_dev->pending = AM_FALSE;
+
+        while ((p_dev->pfn_txchar_get != NULL) &&
+               (p_dev->pfn_txchar_get(p_dev->p_txget_arg, &c) == AM_OK)) {
+            p_dev->tx_count++;
+            if (p_peer->pfn_rxchar_put != NULL) {
+                p_peer->pfn_rxchar_put(p_peer->p_rxput_arg, c);
+            }
+        }
+    } while (p_dev->pending);
+
+    p_dev->busy = AM_FALSE;
+
+    return AM_OK;
+}
+
+static int __loop_callback_set (void  *p_drv,
+                                int    callback_type,
+                                void  *pfn_callback,
+                                void  *p_arg)
+{
+    struct __loop_uart *p_dev = (struct __loop_uart *)p_drv;
+
+    switch (callback_type) {
+
+    case AM_UART_CALLBACK_TXCHAR_GET:
+        p_dev->pfn_txchar_get = (int (*) (void *, char *))pfn_callback;
+        p_dev->p_txget_arg    = p_arg;
+        return AM_OK;
+
+    case AM_UART_CALLBACK_RXCHAR_PUT:
+        p_dev->pfn_rxchar_put = (int (*) (void *, char))pfn_callback;
+        p_dev->p_rxput_arg    = p_arg;
+        return AM_OK;
+
+    default:
+        return -AM_ENOTSUP;
+    }
+}
+
+static int __loop_poll_getchar (void *p_drv, char *p_inchar)
+{
+    return -AM_EAGAIN;
+}
+
+static int __loop_poll_putchar (void *p_drv, char outchar)
+{
+    return -AM_EAGAIN;
+}
+
+static struct am_uart_drv_funcs __g_loop_funcs = {
+    __loop_ioctl,
+    __loop_tx_startup,
+    __loop_callback_set,
+    __loop_poll_getchar,
+    __loop_poll_putchar,
+};
+
+static void __loop_init (struct __loop_uart *p_a, struct __loop_uart *p_b)
+{
+    memset(p_a, 0, sizeof(*p_a));
+    memset(p_b, 0, sizeof(*p_b));
+
+    p_a->serv.p_funcs = &__g_loop_funcs;
+    p_a->serv.p_drv   = p_a;
+    p_a->p_peer       = p_b;
+
+    p_b->serv.p_funcs = &__g_loop_funcs;
+    p_b->serv.p_drv   = p_b;
+    p_b->p_peer       = p_a;
+}
+
+/*******************************************************************************
+  
+*******************************************************************************/
+
+static char                  __g_doc[__DOC_SIZE];
+static char                  __g_rx_doc[__DOC_SIZE + 1024];
+static char                  __g_frame[1024 + 8];
+
+static struct __loop_uart    __g_uart_tx;
+static struct __loop_uart    __g_uart_rx;
+
+static am_xmodem_tx_dev_t    __g_tx_dev;
+static am_xmodem_rec_dev_t   __g_rx_dev;
+static am_xmodem_tx_handle_t __g_tx_handle;
+static am_xmodem_rec_handle_t __g_rx_handle;
+
+static uint32_t              __g_frame_size;    /* ͷʹõ֡С */
+static uint32_t              __g_tx_offset;     /* ѷ͵ֽ */
+static uint32_t              __g_rx_len;        /* ѽյֽ */
+static uint32_t              __g_rx_frames;
+static am_bool_t             __g_tx_done;
+static am_bool_t             __g_rx_done;
+static int                   __g_nerr;
+
+/* һ֡ļͽַ */
+static void __tx_next (void)
+{
+    uint32_t n;
+
+    if (__g_tx_offset >= __DOC_SIZE) {
+        __g_tx_done = AM_TRUE;
+        am_xmodem_tx_over(__g_tx_handle);
+        return;
+    }
+
+    n = min(__g_frame_size, (uint32_t)(__DOC_SIZE - __g_tx_offset));
+    am_xmodem_tx_pack(__g_tx_handle, &__g_doc[__g_tx_offset], n);
+    __g_tx_offset += n;
+}
+
+static void __tx_callback (void *p_arg, int event)
+{
+    switch (event) {
+
+    case AM_XMODEM_1k:
+        __g_frame_size = 1024;
+        __tx_next();
+        break;
+
+    case AM_XMODEM_NAK:
+        __g_frame_size = 128;
+        __tx_next();
+        break;
+
+    case AM_XMODEM_ACK:
+        __tx_next();
+        break;
+
+    /* һ֡䣩ȷϣͽַ */
+    case AM_XMODEM_MOU_SUC:
+        __tx_next();
+        break;
+
+    default:
+        am_kprintf("tx event %d\n", event);
+        __g_nerr++;
+        break;
+    }
+}
+
+static void __rx_callback (void *p_arg, void *p_frames, int event)
+{
+    if (event > 0) {
+        if (__g_rx_len + event <= sizeof(__g_rx_doc)) {
+            memcpy(&__g_rx_doc[__g_rx_len], p_frames, event);
+        }
+        __g_rx_len += event;
+        __g_rx_frames++;
+        am_xmodem_rec_ack_set(__g_rx_handle);
+    } else if (event == -AM_DATA_SUC) {
+        __g_rx_done = AM_TRUE;
+    } else {
+        am_kprintf("rx event %d\n", event);
+        __g_nerr++;
+    }
+}
+
+static void __test_transfer (const char *p_name,
+                             uint32_t    data_mode,
+                             uint32_t    parity_mode)
+{
+    am_crc_soft_t  crc_tx;
+    am_crc_soft_t  crc_rx;
+    uint32_t       frame_size = (data_mode == AM_XMODEM_1K_MODE) ? 1024 : 128;
+    uint32_t       i;
+    int            npad = 0;
+
+    am_xmodem_rec_dev_info_t rx_info = {
+        __g_frame,              /* ֡ */
+        5,                      /* ط */
+        frame_size,             /* һ֡ݵֽ */
+        data_mode,              /* ģʽ */
+        parity_mode,            /* Уģʽ */
+        1000,                   /* ճʱʱ */
+        1000,                   /* ʱ */
+    };
+
+    am_xmodem_tx_dev_info_t tx_info = {
+        1000,                   /* ͳʱʱ */
+        5,                      /* ط */
+    };
+
+    __g_tx_offset = 0;
+    __g_rx_len    = 0;
+    __g_rx_frames = 0;
+    __g_tx_done   = AM_FALSE;
+    __g_rx_done   = AM_FALSE;
+    __g_nerr      = 0;
+    memset(__g_rx_doc, 0, sizeof(__g_rx_doc));
+
+    __loop_init(&__g_uart_tx, &__g_uart_rx);
+
+    __g_tx_handle = am_xmodem_tx_init(&__g_tx_dev,
+                                      &tx_info,
+                                      &__g_uart_tx.serv,
+                                      am_crc_soft_init(&crc_tx,
+                                                       &g_crc_table_16_1021));
+    __g_rx_handle = am_xmodem_rec_init(&__g_rx_dev,
+                                       &rx_info,
+                                       &__g_uart_rx.serv,
+                                       am_crc_soft_init(&crc_rx,
+                                                        &g_crc_table_16_1021));
+
+    AM_TEST_CHECK(__g_tx_handle != NULL);
+    AM_TEST_CHECK(__g_rx_handle != NULL);
+
+    am_xmodem_tx_cb_reg(__g_tx_handle, __tx_callback, NULL);
+    am_xmodem_rec_cb_reg(__g_rx_handle, __rx_callback, NULL);
+
+    /* ػͬ䣬ļɲŷ */
+    AM_TEST_EQ(am_xmodem_rec_start(__g_rx_handle), AM_OK);
+
+    AM_TEST_EQ(__g_nerr, 0);
+    AM_TEST_CHECK(__g_tx_done);
+    AM_TEST_CHECK(__g_rx_done);
+    AM_TEST_EQ(__g_rx_frames, (__DOC_SIZE + frame_size - 1) / frame_size);
+    AM_TEST_EQ(__g_rx_len, __g_rx_frames * frame_size);
+    AM_TEST_CHECK(memcmp(__g_rx_doc, __g_doc, __DOC_SIZE) == 0);
+
+    /* һ֡㲿 CTRL-Z */
+    for (i = __DOC_SIZE; i < __g_rx_len; i++) {
+        if (__g_rx_doc[i] != __CTRLZ) {
+            npad++;
+        }
+    }
+    AM_TEST_EQ(npad, 0);
+
+    am_kprintf("%s: %u frames, %u + %u bytes on the line\n",
+               p_name,
+               (unsigned)__g_rx_frames,
+               (unsigned)__g_uart_tx.tx_count,
+               (unsigned)__g_uart_rx.tx_count);
+
+    am_softimer_stop(&__g_tx_dev.tx_softimer);
+    am_softimer_stop(&__g_rx_dev.rx_softimer);
+}
+
+int main (void)
+{
+    uint32_t i;
+
+    am_test_init();
+
+    /* ʱʱֹֻͣƽʱ */
+    am_softimer_module_init(1000);
+
+    for (i = 0; i < __DOC_SIZE; i++) {
+        __g_doc[i] = (char)am_test_rand();
+    }
+
+    __test_transfer("1k/crc", AM_XMODEM_1K_MODE, AM_XMODEM_CRC_MODE);
+    __test_transfer("128/sum", AM_XMODEM_128_MODE, AM_XMODEM_SUM_MODE);
+
+    return am_test_exit("xmodem");
+}
+
+/* end of file */
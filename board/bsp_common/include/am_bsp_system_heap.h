@@ -16,8 +16,16 @@
  *
  * ʼ󣬼ʹ am_mem.h ļеؽӿ
  *
+ * am_bsp_system_heap_init() ָڴΪϵͳѵ򣨿ɱ DMA ʣоƬ
+ * ж SRAM ʱʹ am_bsp_system_heap_region_add() 򣬲
+ * ָԣam_mem_alloc_attr() ѡºڹж壺
+ *  - AM_BSP_SYSTEM_HEAP_REGION_MAX : ĿĬΪ 4
+ *  - AM_BSP_SYSTEM_HEAP_TLSF       : ʹ TLSF 㷨 am_memheap.h
+ *
  * \internal
  * \par Modification History
+ * - 1.02 26-10-16  ljy, support multiple regions.
+ * - 1.01 26-10-16  ljy, add am_bsp_system_heap_get().
  * - 1.00 17-08-17  tee, first implementation.
  * \endinternal
  */
@@ -29,11 +37,53 @@
 extern "C" {
 #endif
 
+#include "am_common.h"
+
+/** \brief ϵͳĿ */
+#ifndef AM_BSP_SYSTEM_HEAP_REGION_MAX
+#define AM_BSP_SYSTEM_HEAP_REGION_MAX    4
+#endif
+
 /**
  * \brief ʼ
+ *
+ * е򣬲 [heap_start, heap_end) ΪΪ
+ * AM_MEM_ATTR_DMA
  */
 void am_bsp_system_heap_init (void *, void *);
 
+/**
+ * \brief Ϊϵͳһڴ
+ *
+ * \param[in] start : ʼַ
+ * \param[in] end   : ַ
+ * \param[in] attr  : ԣAM_MEM_ATTR_* ϣ am_mem.h
+ *
+ * \retval  AM_OK      : ӳɹ
+ * \retval -AM_EINVAL  : Ч
+ * \retval -AM_ENOSPC  : ĿѴﵽ AM_BSP_SYSTEM_HEAP_REGION_MAX
+ * \retval -AM_ENOMEM  : ̫С
+ *
+ * \note  am_bsp_system_heap_init() ֮
+ */
+int am_bsp_system_heap_region_add (void *start, void *end, uint32_t attr);
+
+struct am_memheap;
+
+/**
+ * \brief ȡϵͳѵ am_memheap_dump() Ͻӿ
+ */
+struct am_memheap *am_bsp_system_heap_get (void);
+
+/**
+ * \brief ȡϵͳѵһ am_memheap_dump() Ͻӿ
+ *
+ * \param[in] idx : ӵ˳Ϊ 0
+ *
+ * \return Ķѹidx Чʱ NULL
+ */
+struct am_memheap *am_bsp_system_heap_region_get (unsigned int idx);
+
 #ifdef __cplusplus
 }
 #endif
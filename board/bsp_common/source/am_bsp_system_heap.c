@@ -16,6 +16,8 @@
  *
  * \internal
  * \par modification history:
+ * - 1.02 26-10-16  ljy, support multiple regions with attributes
+ * - 1.01 26-10-16  ljy, tag allocations with the caller (AM_MEMHEAP_TRACE)
  * - 1.00 14-06-13  zen, first implementation
  * \endinternal
  */
@@ -24,30 +26,165 @@
 #include "am_mem.h"
 #include "am_memheap.h"
 #include "am_board.h"
+#include "am_bsp_system_heap.h"
 
 #include <string.h>
 
 /*******************************************************************************
   locals
 *******************************************************************************/
-static struct am_memheap __g_system_heap;       /* system heap object */
+
+/* a memory region of the system heap */
+struct __heap_region {
+    struct am_memheap  heap;       /* heap object of the region */
+    uint8_t           *p_start;    /* start address             */
+    uint8_t           *p_end;      /* end address (excluded)    */
+    uint32_t           attr;       /* AM_MEM_ATTR_*             */
+};
+
+static struct __heap_region __g_heap_regions[AM_BSP_SYSTEM_HEAP_REGION_MAX];
+static unsigned int         __g_heap_region_num = 0;
 
 /*******************************************************************************
   implementation
 *******************************************************************************/
 
+/* number of bits set */
+static unsigned int __attr_bits (uint32_t attr)
+{
+    unsigned int n = 0;
+
+    while (attr != 0) {
+        attr &= attr - 1;
+        n++;
+    }
+
+    return n;
+}
+
+/* find the region the memory belongs to */
+static struct __heap_region *__region_find (void *ptr)
+{
+    unsigned int i;
+
+    for (i = 0; i < __g_heap_region_num; i++) {
+        if (((uint8_t *)ptr >= __g_heap_regions[i].p_start) &&
+            ((uint8_t *)ptr <  __g_heap_regions[i].p_end)) {
+            return &__g_heap_regions[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* allocate from the regions meeting the attributes, least extra ones first */
+static void *__region_alloc (uint32_t size, uint32_t flags, const void *caller)
+{
+    uint32_t      tried = 0;
+    unsigned int  i, best, extra, best_extra;
+    void         *ptr;
+
+    for (;;) {
+
+        best       = __g_heap_region_num;
+        best_extra = 0;
+
+        for (i = 0; i < __g_heap_region_num; i++) {
+            if ((tried & (1ul << i)) ||
+                ((__g_heap_regions[i].attr & flags) != flags)) {
+                continue;
+            }
+            extra = __attr_bits(__g_heap_regions[i].attr & ~flags);
+            if ((best == __g_heap_region_num) || (extra < best_extra)) {
+                best       = i;
+                best_extra = extra;
+            }
+        }
+
+        if (best == __g_heap_region_num) {
+            return NULL;
+        }
+
+        ptr = am_memheap_alloc_tag(&__g_heap_regions[best].heap, size, caller);
+        if (ptr != NULL) {
+            return ptr;
+        }
+
+        tried |= 1ul << best;
+    }
+}
+
 /******************************************************************************/
 void am_bsp_system_heap_init (void *heap_start, void *heap_end)
 {
+    __g_heap_region_num = 0;
+
     /* initialize a default heap in the system */
-    am_memheap_init(&__g_system_heap,
-                    "system_heap",
-                    (void *)heap_start,
-                    (uint32_t)heap_end - (uint32_t)heap_start);
+    am_bsp_system_heap_region_add(heap_start, heap_end, AM_MEM_ATTR_DMA);
 }
 
 /******************************************************************************/
-void *am_mem_align(size_t size, size_t align)
+int am_bsp_system_heap_region_add (void *start, void *end, uint32_t attr)
+{
+    struct __heap_region *p_region;
+    am_err_t              ret;
+
+    if ((start == NULL) || ((uint8_t *)end <= (uint8_t *)start)) {
+        return -AM_EINVAL;
+    }
+
+    if (__g_heap_region_num >= AM_BSP_SYSTEM_HEAP_REGION_MAX) {
+        return -AM_ENOSPC;
+    }
+
+    p_region = &__g_heap_regions[__g_heap_region_num];
+
+#ifdef AM_BSP_SYSTEM_HEAP_TLSF
+    ret = am_memheap_init_tlsf(&p_region->heap,
+                               "system_heap",
+                               start,
+                               (uint32_t)((uint8_t *)end - (uint8_t *)start));
+#else
+    ret = am_memheap_init(&p_region->heap,
+                          "system_heap",
+                          start,
+                          (uint32_t)((uint8_t *)end - (uint8_t *)start));
+#endif
+
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    p_region->p_start = (uint8_t *)start;
+    p_region->p_end   = (uint8_t *)end;
+    p_region->attr    = attr;
+
+    __g_heap_region_num++;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+struct am_memheap *am_bsp_system_heap_get (void)
+{
+    return am_bsp_system_heap_region_get(0);
+}
+
+/******************************************************************************/
+struct am_memheap *am_bsp_system_heap_region_get (unsigned int idx)
+{
+    if (idx >= __g_heap_region_num) {
+        return NULL;
+    }
+
+    return &__g_heap_regions[idx].heap;
+}
+
+/******************************************************************************/
+static void *__mem_align (size_t      size,
+                          size_t      align,
+                          uint32_t    flags,
+                          const void *caller)
 {
     void    *align_ptr;
     void    *ptr;
@@ -60,14 +197,15 @@ void *am_mem_align(size_t size, size_t align)
     align_size =  AM_ROUND_UP(size, sizeof(void *)) + align + sizeof(void *);
 
     /* allocate memory block from heap */
-    ptr = am_memheap_alloc(&__g_system_heap, align_size);
+    ptr = __region_alloc(align_size, flags, caller);
     if (ptr != NULL) {
 
         /* round up ptr to align */
-        align_ptr = (void *)AM_ROUND_UP((uint32_t)ptr + sizeof(void *), align);
+        align_ptr = (void *)(((uintptr_t)ptr + sizeof(void *) + align - 1) &
+                             ~(uintptr_t)(align - 1));
 
         /* set the pointer before alignment pointer to the real pointer */
-        *((uint32_t *)((uint32_t)align_ptr - sizeof(void *))) = (uint32_t)ptr;
+        *((void **)align_ptr - 1) = ptr;
 
         ptr = align_ptr;
     }
@@ -75,11 +213,23 @@ void *am_mem_align(size_t size, size_t align)
     return ptr;
 }
 
+/******************************************************************************/
+void *am_mem_align(size_t size, size_t align)
+{
+    return __mem_align(size, align, 0, AM_MEMHEAP_CALLER());
+}
+
 /******************************************************************************/
 void *am_mem_alloc(size_t size)
 {
     /* allocate in the system heap */
-    return am_mem_align(size, 4);
+    return __mem_align(size, 4, 0, AM_MEMHEAP_CALLER());
+}
+
+/******************************************************************************/
+void *am_mem_alloc_attr(size_t size, uint32_t flags)
+{
+    return __mem_align(size, 4, flags, AM_MEMHEAP_CALLER());
 }
 
 /******************************************************************************/
@@ -89,7 +239,7 @@ void *am_mem_calloc(size_t nelem, size_t size)
     size_t      total_size;
 
     total_size = nelem * size;
-    ptr = am_mem_alloc(total_size);
+    ptr = __mem_align(total_size, 4, 0, AM_MEMHEAP_CALLER());
     if (ptr != NULL) {
         memset(ptr, 0, total_size);
     }
@@ -103,7 +253,7 @@ void am_mem_free(void *ptr)
     void *real_ptr = NULL;
 
     if (ptr != NULL) {
-        real_ptr = (void *)*(uint32_t *)((uint32_t)ptr - sizeof(void *));
+        real_ptr = *((void **)ptr - 1);
     }
     am_memheap_free(real_ptr);
 }
@@ -111,36 +261,50 @@ void am_mem_free(void *ptr)
 /******************************************************************************/
 size_t am_mem_size(void *ptr)
 {
-    void *real_ptr = NULL;
+    void                 *real_ptr = NULL;
+    struct __heap_region *p_region;
 
     if (ptr != NULL) {
-        real_ptr = (void *)*(uint32_t *)((uint32_t)ptr - sizeof(void *));
+        real_ptr = *((void **)ptr - 1);
+    }
+
+    p_region = __region_find(real_ptr);
+    if (p_region == NULL) {
+        return 0;
     }
-    return am_memheap_memsize( &__g_system_heap, real_ptr);
+
+    return am_memheap_memsize(&p_region->heap, real_ptr);
 }
 
 /******************************************************************************/
 void *am_mem_realloc(void *ptr, size_t newsize)
 {
-    void  *real_ptr     = NULL;
-    void  *new_ptr      = NULL;
+    void                 *real_ptr     = NULL;
+    void                 *new_ptr      = NULL;
+    struct __heap_region *p_region;
 
     if (ptr != NULL) {
         /* get real pointer */
-        real_ptr = (void *)*(uint32_t *)((uint32_t)ptr - sizeof(void *));
+        real_ptr = *((void **)ptr - 1);
     } else {
         /* equal malloc when ptr==NULL */
-        return am_mem_alloc(newsize);
+        return __mem_align(newsize, 4, 0, AM_MEMHEAP_CALLER());
+    }
+
+    /* reallocate in the same region, keeping its attributes */
+    p_region = __region_find(real_ptr);
+    if (p_region == NULL) {
+        return NULL;
     }
 
     /* allocate newsize plus one more pointer, used for save real pointer */
-    real_ptr = am_memheap_realloc(&__g_system_heap,
+    real_ptr = am_memheap_realloc(&p_region->heap,
                                   real_ptr,
                                   newsize + sizeof(void *));
 
     if (real_ptr != NULL) {
-        *(uint32_t *)real_ptr = (uint32_t)real_ptr;
-        new_ptr               = (void *)((size_t)real_ptr + sizeof(void *));
+        *(void **)real_ptr = real_ptr;
+        new_ptr            = (void *)((uint8_t *)real_ptr + sizeof(void *));
     } else {
         new_ptr = NULL;
     }
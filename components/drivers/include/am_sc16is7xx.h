@@ -22,6 +22,7 @@
  *
  * \internal
  * \par modification history
+ * - 1.01 26-10-16  ljy, fill TX FIFO with chunked TX callback
  * - 1.00 18-05-22  pea, first implementation
  * \endinternal
  */
@@ -103,6 +104,9 @@ typedef struct am_sc16is7xx_dev {
     /** \brief ָûע txchar_get  */
     am_uart_txchar_get_t    pfn_txchar_get[SC16IS7XX_CHAN_MAX];
 
+    /** \brief ָûע txchars_get Ϊ NULL */
+    am_uart_txchars_get_t   pfn_txchars_get[SC16IS7XX_CHAN_MAX];
+
     /** \brief ָûע rxchar_put  */
     am_uart_rxchar_put_t    pfn_rxchar_put[SC16IS7XX_CHAN_MAX];
 
@@ -112,6 +116,9 @@ typedef struct am_sc16is7xx_dev {
     /** \brief txchar_get  */
     void                   *p_txget_arg[SC16IS7XX_CHAN_MAX];
 
+    /** \brief txchars_get  */
+    void                   *p_txchars_arg[SC16IS7XX_CHAN_MAX];
+
     /** \brief rxchar_put  */
     void                   *p_rxput_arg[SC16IS7XX_CHAN_MAX];
 
@@ -79,6 +79,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, fill TX FIFO with chunked TX callback
  * - 1.00 18-05-22  pea, first implementation
  * \endinternal
  */
@@ -839,13 +840,21 @@ am_local am_err_t __sm_event (am_sc16is7xx_dev_t *p_dev,
                     p_dev->txlvl_reg[chan] = SC16IS7XX_FIFO_SIZE / 2;
                 }
 
-                /*  UART ϵͳȡҪ͵ */
-                for (i = 0; i < p_dev->txlvl_reg[chan]; i++) {
-                    err = p_dev->pfn_txchar_get[chan](
-                                     p_dev->p_txget_arg[chan],
-                            (char *)&p_dev->tx_buf[chan][i]);
-                    if (err != AM_OK) {
-                        break;
+                /*  UART ϵͳȡҪ͵ݣһȡһ */
+                if (NULL != p_dev->pfn_txchars_get[chan]) {
+                    err = p_dev->pfn_txchars_get[chan](
+                                     p_dev->p_txchars_arg[chan],
+                            (char *)&p_dev->tx_buf[chan][0],
+                                     p_dev->txlvl_reg[chan]);
+                    i = (err > 0) ? err : 0;
+                } else {
+                    for (i = 0; i < p_dev->txlvl_reg[chan]; i++) {
+                        err = p_dev->pfn_txchar_get[chan](
+                                         p_dev->p_txget_arg[chan],
+                                (char *)&p_dev->tx_buf[chan][i]);
+                        if (err != AM_OK) {
+                            break;
+                        }
                     }
                 }
 
@@ -1360,6 +1369,12 @@ am_local int __uart_callback_set (void *p_drv,
         p_dev->p_err_arg[*p_chan] = p_arg;
         break;
 
+    /* ȡַ */
+    case AM_UART_CALLBACK_TXCHARS_GET:
+        p_dev->pfn_txchars_get[*p_chan] = (am_uart_txchars_get_t)pfn_callback;
+        p_dev->p_txchars_arg[*p_chan]   = p_arg;
+        break;
+
     default:
         return -AM_ENOTSUP;
     }
@@ -1506,6 +1521,7 @@ am_sc16is7xx_handle_t am_sc16is7xx_init (am_sc16is7xx_dev_t           *p_dev,
         p_dev->uart_serv[i].p_funcs = (struct am_uart_drv_funcs *)&__g_uart_drv_funcs;
         p_dev->uart_serv[i].p_drv   = &p_dev->uartinfo[i];
         p_dev->pfn_txchar_get[i]    = NULL;
+        p_dev->pfn_txchars_get[i]   = NULL;
         p_dev->pfn_rxchar_put[i]    = NULL;
         p_dev->pfn_err[i]           = NULL;
 
@@ -1681,6 +1697,7 @@ am_err_t am_sc16is7xx_deinit (am_sc16is7xx_handle_t handle)
     for (i = 0; i < p_dev->p_devinfo->chan_num; i++) {
         p_dev->uart_serv[i].p_funcs = NULL;
         p_dev->pfn_txchar_get[i]    = NULL;
+        p_dev->pfn_txchars_get[i]   = NULL;
         p_dev->pfn_rxchar_put[i]    = NULL;
         p_dev->pfn_err[i]           = NULL;
     }
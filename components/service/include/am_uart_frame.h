@@ -0,0 +1,196 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief  UARTring buffer֡䣨COBS/SLIP 룬ѡ CRC У飩
+ *
+ * ֡ʽΪ + CRCСˣֽ CRC Ⱦ CRC ʱʡԣ徭
+ * COBS  SLIP ԷָCOBS Ϊ 0x00SLIP Ϊ 0xC0ʼͽ
+ *
+ * ʱֱӴӽջλн루am_uart_rngbuf_rx_peek()ֻ֡
+ * ûṩ֡Уپм仺մصжн
+ * жӳٶУam_isr_defer֡ӳͨصύ
+ * ӦóѯҲֱӵ am_uart_frame_process() 
+ *
+ * ʱݷֶд뷢ͻλ
+ *
+ * \note ģʹ UARTring bufferĽմصʼӦóӦ
+ *       Ӹ UART ȡݻýմ
+ *
+ * \internal
+ * \par Modification History
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#ifndef __AM_UART_FRAME_H
+#define __AM_UART_FRAME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ametal.h"
+#include "am_crc.h"
+#include "am_isr_defer.h"
+#include "am_uart_rngbuf.h"
+
+/**
+ * \addtogroup am_if_uart_frame
+ * \copydoc am_uart_frame.h
+ * @{
+ */
+
+/**
+ * \name ֡뷽ʽ
+ * @{
+ */
+#define AM_UART_FRAME_COBS    0    /**< \brief COBS 룬 0x00 ָ */
+#define AM_UART_FRAME_SLIP    1    /**< \brief SLIP 루RFC 1055 0xC0 ָ */
+/** @} */
+
+/**
+ * \brief ֡ջص
+ *
+ * \param[in] p_arg   : ûص
+ * \param[in] p_frame : ֡ݣ CRCڻصЧʱΪ NULL
+ * \param[in] len     : ڵ 0 ʱΪ֡ݵֽС 0 ʱΪ
+ *                      - -AM_EBADMSG : CRC У
+ *                      - -AM_EMSGSIZE : ֡֡С
+ *
+ * \return 
+ */
+typedef void (*am_uart_frame_rx_cb_t) (void          *p_arg,
+                                       const uint8_t *p_frame,
+                                       int            len);
+
+/**
+ * \brief ֡豸Ϣ
+ */
+typedef struct am_uart_frame_devinfo {
+
+    uint8_t                 coding;       /**< \brief 뷽ʽ AM_UART_FRAME_* */
+    uint8_t                *p_frame_buf;  /**< \brief ֡ */
+    uint32_t                frame_size;   /**< \brief ֡СCRC */
+
+    /** \brief CRC ģͣNULL ʾʹ CRC */
+    const am_crc_pattern_t *p_crc_pattern;
+
+    uint16_t                job_prio;     /**< \brief ӳȼ */
+
+} am_uart_frame_devinfo_t;
+
+/**
+ * \brief ֡豸
+ */
+typedef struct am_uart_frame_dev {
+
+    am_uart_rngbuf_handle_t        rngbuf_handle; /**< \brief UARTring buffer */
+    am_crc_handle_t                rx_crc_handle; /**< \brief ʹõ CRC  */
+    am_crc_handle_t                tx_crc_handle; /**< \brief ʹõ CRC  */
+    am_crc_pattern_t               crc_pattern;   /**< \brief CRC ģ */
+    uint8_t                        crc_bytes;     /**< \brief CRC ֽ */
+
+    am_uart_frame_rx_cb_t          pfn_rx_cb;     /**< \brief ֡ջص */
+    void                          *p_rx_arg;      /**< \brief ֡ջص */
+
+    am_isr_defer_job_t             rx_job;        /**< \brief ӳ */
+
+    uint32_t                       rx_len;        /**< \brief ǰ֡ѽֽ */
+    uint8_t                        cobs_left;     /**< \brief COBS ǰʣֽ */
+    am_bool_t                      cobs_zero;     /**< \brief COBS ǰ貹 0 */
+    am_bool_t                      slip_esc;      /**< \brief SLIP յתַ */
+    int                            rx_err;        /**< \brief ǰ֡Ĵ */
+
+    const am_uart_frame_devinfo_t *p_devinfo;     /**< \brief 豸Ϣ */
+
+} am_uart_frame_dev_t;
+
+/** \brief ֡ */
+typedef am_uart_frame_dev_t *am_uart_frame_handle_t;
+
+/**
+ * \brief ֡ʼ
+ *
+ * \param[in] p_dev         : ֡豸
+ * \param[in] p_devinfo     : ֡豸Ϣ
+ * \param[in] rngbuf_handle : UARTring buffer
+ * \param[in] rx_crc_handle : ʹõ CRC ʹ CRC ʱΪ NULL
+ * \param[in] tx_crc_handle : ʹõ CRC ʹ CRC ʱΪ NULL
+ *
+ * \return ֡Ϊ NULL ʾ
+ *
+ * \note жӳм CRCͿеãշӦʹ
+ *       ͬ CRC շͬһִʱʹͬһ
+ */
+am_uart_frame_handle_t am_uart_frame_init (
+                                   am_uart_frame_dev_t           *p_dev,
+                                   const am_uart_frame_devinfo_t *p_devinfo,
+                                   am_uart_rngbuf_handle_t        rngbuf_handle,
+                                   am_crc_handle_t                rx_crc_handle,
+                                   am_crc_handle_t                tx_crc_handle);
+
+/**
+ * \brief ע֡ջص
+ *
+ * \param[in] handle    : ֡
+ * \param[in] pfn_rx_cb : ֡ջص
+ * \param[in] p_arg     : ص
+ *
+ * \retval AM_OK      : עɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_uart_frame_rx_cb_reg (am_uart_frame_handle_t  handle,
+                             am_uart_frame_rx_cb_t   pfn_rx_cb,
+                             void                   *p_arg);
+
+/**
+ * \brief ջеݣÿյһ֡һλص
+ *
+ * ӳлԶøúδʼжӳģʱҲӦóá
+ *
+ * \param[in] handle : ֡
+ *
+ * \return ύ֡֡-AM_EINVAL ʾ
+ */
+int am_uart_frame_process (am_uart_frame_handle_t handle);
+
+/**
+ * \brief 벢һ֡
+ *
+ * \param[in] handle : ֡
+ * \param[in] p_data : ֡
+ * \param[in] len    : ֡ݵֽ
+ *
+ * \retval AM_OK        : ֡д뷢ͻ
+ * \retval -AM_EINVAL   : 
+ * \retval -AM_EAGAIN   : ģʽ·ͻռ䲻㣬δдκ
+ * \retval -AM_ETIME    : дʱֻ֡дһ֣շ֡
+ *
+ * \note ͻʱΪ UARTring bufferдʱͷģʽ
+ */
+int am_uart_frame_send (am_uart_frame_handle_t  handle,
+                        const uint8_t          *p_data,
+                        uint32_t                len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_UART_FRAME_H */
+
+/* end of file */
@@ -16,6 +16,12 @@
  *
  * \internal
  * \par modification history:
+ * - 1.05 26-10-16 ljy, pass the coalesced count with the dispatch instead of
+ *                  storing it in the event.
+ * - 1.04 26-10-16 ljy, keep the deferred walk position with a cursor node
+ *                  instead of stamping the handlers.
+ * - 1.03 26-10-16 ljy, add subscription masks and coalescing.
+ * - 1.02 26-10-16 ljy, add deferred dispatch.
  * - 1.01 15-01-05 orz, move event configuration to aw_event_cfg.c.
  * - 1.00 14-06-05 orz, first implementation.
  * \endinternal
@@ -23,15 +29,51 @@
 #include "ametal.h"
 #include "am_event.h"
 #include "am_int.h"
+#include "am_isr_defer.h"
+#include <string.h>
+
+/*******************************************************************************
+  Local variables
+*******************************************************************************/
+
+/* modification count of the handler lists, changed with interrupts locked */
+static uint32_t                    __g_event_gen;
+
+/*
+ * a dispatch in progress, on the stack of the dispatcher. An immediate raise
+ * from an interrupt may nest in a deferred dispatch, dispatches always end in
+ * the reverse order they started.
+ */
+struct __event_dispatch {
+    am_event_type_t         *p_event;
+    uint16_t                 count;     /* number of raises coalesced */
+    struct __event_dispatch *p_prev;
+};
+
+/* the innermost dispatch in progress */
+static struct __event_dispatch    *__gp_event_dispatch;
+
+/* deferred dispatch queue */
+static am_event_defer_msg_t       *__gp_defer_msgs;
+static unsigned int                __g_defer_num;
+static unsigned int                __g_defer_head;
+static unsigned int                __g_defer_count;
+static am_isr_defer_job_t          __g_defer_job;
+static struct am_event_defer_stat  __g_defer_stat;
+static uint32_t                  (*__g_defer_pfn_timestamp) (void);
 
 /*******************************************************************************
   Local functions
 *******************************************************************************/
 
-/* go through an event handler list and call each handler functions */
+/*
+ * go through an event handler list and call each handler functions whose mask
+ * contains the event bit
+ */
 static void __event_handler_process (am_event_handler_t **pp_head,
                                      am_event_type_t     *p_event,
-                                     void                *p_evt_data)
+                                     void                *p_evt_data,
+                                     uint32_t             bit)
 {
     am_event_handler_t *p_next, *p_handler;
 
@@ -39,6 +81,11 @@ static void __event_handler_process (am_event_handler_t **pp_head,
 
         p_next = p_handler->p_next;   /* handlers may delete themselves */
 
+        if (!(p_handler->mask & bit)) {
+            pp_head = &p_handler->p_next;
+            continue;
+        }
+
         if (NULL != p_handler->pfn_proc) {
             p_handler->pfn_proc(p_event, p_evt_data, p_handler->p_data);
         }
@@ -47,6 +94,7 @@ static void __event_handler_process (am_event_handler_t **pp_head,
             /* the handler request to delete it's self */
             p_handler->p_next = NULL; /* this handler point to NULL */
             *pp_head          = p_next; /* previous handler pointer point to next */
+            __g_event_gen++;
         } else {
              pp_head = &p_handler->p_next; /* now this handler is 'previous' */
         }
@@ -57,22 +105,219 @@ static void __event_handler_process (am_event_handler_t **pp_head,
 /* raise an event immediately. */
 static int __event_raise (am_event_type_t *p_event, void *p_evt_data, int cat_only)
 {
+    am_event_category_t     *p_category;
+    uint32_t                 bit;
+    struct __event_dispatch  dispatch;
+
     int key = am_int_cpu_lock();
 
+    p_category = p_event->p_category;
+    bit        = am_event_mask_get(p_event);
+
+    dispatch.p_event    = p_event;
+    dispatch.count      = 1;
+    dispatch.p_prev     = __gp_event_dispatch;
+    __gp_event_dispatch = &dispatch;
+
     /* process category handler for this event first */
-    __event_handler_process(&p_event->p_category->p_handler, p_event, p_evt_data);
+    if ((NULL != p_category) && (p_category->sub_mask & bit)) {
+        __event_handler_process(&p_category->p_handler,
+                                p_event,
+                                p_evt_data,
+                                bit);
+    }
 
     if (!cat_only) {
 
         /* process event handler */
-        __event_handler_process(&p_event->p_handler, p_event, p_evt_data);
+        __event_handler_process(&p_event->p_handler,
+                                p_event,
+                                p_evt_data,
+                                AM_EVENT_MASK_ALL);
     }
 
+    __gp_event_dispatch = dispatch.p_prev;
+
     am_int_cpu_unlock(key);
 
     return AM_OK;;
 }
 
+/******************************************************************************/
+/*
+ * go through an event handler list with interrupts enabled while the handlers
+ * run. Interrupts are only locked to pick the next handler. While a handler
+ * runs, a cursor node on the stack is linked in behind it and the walk goes
+ * on from the cursor afterwards, so the handlers themselves carry no state of
+ * the walk. If the list is modified meanwhile, the handlers already run stay
+ * in front of the cursor and are not run again, removed handlers are no
+ * longer behind it, and handlers registered at the head take effect from the
+ * next event, as with am_event_raise().
+ * Handlers whose mask does not contain the event bit are skipped.
+ */
+static void __event_handler_process_defer (am_event_handler_t **pp_head,
+                                           am_event_type_t     *p_event,
+                                           void                *p_evt_data,
+                                           uint32_t             bit)
+{
+    am_event_handler_t   cursor;
+    am_event_handler_t  *p_handler;
+    am_event_handler_t **pp_link;   /* the link pointing to p_handler */
+    am_event_function_t *pfn_proc;
+    void                *p_hdl_data;
+    uint32_t             gen;
+    int                  key;
+
+    am_event_handler_init(&cursor, NULL, NULL, 0);
+    cursor.mask = 0;                /* never run by other walks */
+
+    key = am_int_cpu_lock();
+
+    pp_link   = pp_head;
+    p_handler = *pp_link;
+
+    while (NULL != p_handler) {
+
+        if (!(p_handler->mask & bit)) {
+            pp_link   = &p_handler->p_next;
+            p_handler = *pp_link;
+            continue;
+        }
+
+        pfn_proc   = p_handler->pfn_proc;
+        p_hdl_data = p_handler->p_data;
+
+        /* link the cursor in behind the handler */
+        cursor.p_next     = p_handler->p_next;
+        p_handler->p_next = &cursor;
+
+        /* one-shot handlers leave the list before they run */
+        if (p_handler->flags & AM_EVENT_HANDLER_FLAG_AUTO_UNREG) {
+            *pp_link          = &cursor;
+            p_handler->p_next = NULL;
+            __g_event_gen++;
+        } else {
+            pp_link = &p_handler->p_next;
+        }
+
+        gen = __g_event_gen;
+
+        am_int_cpu_unlock(key);
+
+        if (NULL != pfn_proc) {
+            pfn_proc(p_event, p_evt_data, p_hdl_data);
+        }
+
+        key = am_int_cpu_lock();
+
+        /* the link in front of the cursor may have changed, look it up */
+        if (gen != __g_event_gen) {
+            __g_defer_stat.relocate++;
+            for (pp_link = pp_head;
+                 (NULL != *pp_link) && (*pp_link != &cursor);
+                 pp_link = &(*pp_link)->p_next);
+
+            /* the whole list was dropped (re-initialised) */
+            if (NULL == *pp_link) {
+                break;
+            }
+        }
+
+        /* take the cursor out again */
+        *pp_link  = cursor.p_next;
+        p_handler = cursor.p_next;
+    }
+
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+/* the isr defer job: dispatch the events queued when it was started */
+static void __event_defer_job (void *p_arg)
+{
+    am_event_defer_msg_t     msg;
+    struct __event_dispatch  dispatch;
+    am_event_category_t     *p_category;
+    uint32_t              bit;
+    unsigned int          n;
+    uint32_t              latency;
+    int                   key;
+
+    key = am_int_cpu_lock();
+    n   = __g_defer_count;
+    am_int_cpu_unlock(key);
+
+    while (n--) {
+
+        key = am_int_cpu_lock();
+
+        /* copy the message out so that the slot is free again at once */
+        msg = __gp_defer_msgs[__g_defer_head];
+
+        /* later raises can no longer be merged into this one */
+        if (msg.p_event->p_pending == &__gp_defer_msgs[__g_defer_head]) {
+            msg.p_event->p_pending = NULL;
+        }
+
+        if (++__g_defer_head == __g_defer_num) {
+            __g_defer_head = 0;
+        }
+        __g_defer_count--;
+
+        if (__g_defer_pfn_timestamp != NULL) {
+            latency = __g_defer_pfn_timestamp() - msg.time;
+
+            __g_defer_stat.latency_last  = latency;
+            __g_defer_stat.latency_sum  += latency;
+            if (latency > __g_defer_stat.latency_max) {
+                __g_defer_stat.latency_max = latency;
+            }
+        }
+        __g_defer_stat.dispatched++;
+
+        p_category = msg.p_event->p_category;
+        bit        = am_event_mask_get(msg.p_event);
+
+        /* the handlers get the coalesced count from the dispatch */
+        dispatch.p_event    = msg.p_event;
+        dispatch.count      = msg.count;
+        dispatch.p_prev     = __gp_event_dispatch;
+        __gp_event_dispatch = &dispatch;
+
+        am_int_cpu_unlock(key);
+
+        if (msg.size != 0) {
+            msg.p_data = msg.data.buf;
+        }
+
+        /* process category handler for this event first */
+        if (NULL != p_category) {
+            __event_handler_process_defer(&p_category->p_handler,
+                                          msg.p_event,
+                                          msg.p_data,
+                                          bit);
+        }
+
+        if (!(msg.flags & AM_EVENT_PROC_FLAG_CAT_ONLY)) {
+            __event_handler_process_defer(&msg.p_event->p_handler,
+                                          msg.p_event,
+                                          msg.p_data,
+                                          AM_EVENT_MASK_ALL);
+        }
+
+        key = am_int_cpu_lock();
+        __gp_event_dispatch = dispatch.p_prev;
+        am_int_cpu_unlock(key);
+    }
+
+    /* events raised meanwhile are dispatched in the next run */
+    key = am_int_cpu_lock();
+    if (__g_defer_count != 0) {
+        am_isr_defer_job_add(&__g_defer_job);
+    }
+    am_int_cpu_unlock(key);
+}
+
 /******************************************************************************/
 static int __event_handler_delete (am_event_handler_t **pp_head,
                                    am_event_handler_t  *p_handler)
@@ -88,6 +333,7 @@ static int __event_handler_delete (am_event_handler_t **pp_head,
             prev->p_next      = p_handler->p_next;
             p_handler->p_next = NULL;
             ret               = AM_OK;
+            __g_event_gen++;
             break;
         }
     }
@@ -97,6 +343,25 @@ static int __event_handler_delete (am_event_handler_t **pp_head,
     return ret;
 }
 
+/******************************************************************************/
+/* recompute the union of the category handler masks */
+static void __event_category_sub_mask_update (am_event_category_t *p_category)
+{
+    am_event_handler_t *p_handler;
+    uint32_t            mask = 0;
+
+    int key = am_int_cpu_lock();
+
+    for (p_handler = p_category->p_handler;
+         NULL != p_handler;
+         p_handler = p_handler->p_next) {
+        mask |= p_handler->mask;
+    }
+    p_category->sub_mask = mask;
+
+    am_int_cpu_unlock(key);
+}
+
 /******************************************************************************/
 static int __event_type_delete (am_event_type_t **pp_head,
                                 am_event_type_t  *p_evt_type)
@@ -152,6 +417,7 @@ int am_event_handler_register (am_event_type_t     *p_event,
     /* add the handler to event handler list */
     p_handler->p_next  = p_event->p_handler;
     p_event->p_handler = p_handler;
+    __g_event_gen++;
 
     am_int_cpu_unlock(key);
 
@@ -172,6 +438,16 @@ int am_event_handler_unregister (am_event_type_t     *p_event,
 /******************************************************************************/
 int am_event_category_handler_register (am_event_category_t *p_category,
                                          am_event_handler_t  *p_handler)
+{
+    return am_event_category_handler_register_mask(p_category,
+                                                   p_handler,
+                                                   AM_EVENT_MASK_ALL);
+}
+
+/******************************************************************************/
+int am_event_category_handler_register_mask (am_event_category_t *p_category,
+                                             am_event_handler_t  *p_handler,
+                                             uint32_t             mask)
 {
     int key;
 
@@ -182,8 +458,11 @@ int am_event_category_handler_register (am_event_category_t *p_category,
     key = am_int_cpu_lock();
 
     /* add the handler to event category handler list */
+    p_handler->mask       = mask;
     p_handler->p_next     = p_category->p_handler;
     p_category->p_handler = p_handler;
+    p_category->sub_mask |= mask;
+    __g_event_gen++;
 
     am_int_cpu_unlock(key);
 
@@ -194,7 +473,19 @@ int am_event_category_handler_register (am_event_category_t *p_category,
 int am_event_category_handler_unregister (am_event_category_t *p_category,
                                           am_event_handler_t  *p_handler)
 {
-    return __event_handler_delete(&p_category->p_handler, p_handler);
+    int ret;
+
+    if ((p_category == NULL) || (p_handler == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    ret = __event_handler_delete(&p_category->p_handler, p_handler);
+
+    if (ret == AM_OK) {
+        __event_category_sub_mask_update(p_category);
+    }
+
+    return ret;
 }
 
 /******************************************************************************/
@@ -202,6 +493,7 @@ int am_event_category_event_register (am_event_category_t  *p_category,
                                       am_event_type_t      *p_event)
 {
     int key;
+    int i;
 
     if ((p_category == NULL) || (p_event == NULL)) {
         return -AM_EINVAL;
@@ -211,6 +503,16 @@ int am_event_category_event_register (am_event_category_t  *p_category,
 
     p_event->p_category = p_category;
 
+    /* allocate the lowest free index */
+    p_event->index = AM_EVENT_INDEX_NONE;
+    for (i = 0; i < 32; i++) {
+        if (!(p_category->idx_used & (1u << i))) {
+            p_category->idx_used |= 1u << i;
+            p_event->index        = (uint8_t)i;
+            break;
+        }
+    }
+
     /* add the handler to event category handler list */
     p_event->p_next     = p_category->p_event;
     p_category->p_event = p_event;
@@ -224,6 +526,9 @@ int am_event_category_event_register (am_event_category_t  *p_category,
 int am_event_category_event_unregister (am_event_category_t *p_category,
                                         am_event_type_t     *p_event)
 {
+    int ret;
+    int key;
+
     if ((p_category == NULL) || (p_event == NULL)) {
         return -AM_EINVAL;
     }
@@ -232,7 +537,207 @@ int am_event_category_event_unregister (am_event_category_t *p_category,
         return -AM_EINVAL;
     }
 
-    return __event_type_delete(&p_category->p_event, p_event);
+    ret = __event_type_delete(&p_category->p_event, p_event);
+
+    if (ret == AM_OK) {
+        key = am_int_cpu_lock();
+        if (p_event->index != AM_EVENT_INDEX_NONE) {
+            p_category->idx_used &= ~(1u << p_event->index);
+            p_event->index        = AM_EVENT_INDEX_NONE;
+        }
+        am_int_cpu_unlock(key);
+    }
+
+    return ret;
+}
+
+/******************************************************************************/
+int am_event_coalesce_set (am_event_type_t *p_event, uint8_t policy)
+{
+    int key;
+
+    if ((p_event == NULL) || (policy > AM_EVENT_COALESCE_FIRST)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    p_event->coalesce = policy;
+    if (policy == AM_EVENT_COALESCE_NONE) {
+        p_event->p_pending = NULL;
+    }
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+uint16_t am_event_coalesced_get (am_event_type_t *p_event)
+{
+    struct __event_dispatch *p_dispatch;
+    uint16_t                 count = 1;
+    int                      key;
+
+    key = am_int_cpu_lock();
+
+    for (p_dispatch = __gp_event_dispatch;
+         p_dispatch != NULL;
+         p_dispatch = p_dispatch->p_prev) {
+        if (p_dispatch->p_event == p_event) {
+            count = p_dispatch->count;
+            break;
+        }
+    }
+
+    am_int_cpu_unlock(key);
+
+    return count;
+}
+
+/******************************************************************************/
+int am_event_defer_init (am_event_defer_msg_t *p_msgs,
+                         unsigned int          num,
+                         uint16_t              pri)
+{
+    int key;
+
+    if ((p_msgs == NULL) || (num == 0)) {
+        return -AM_EINVAL;
+    }
+
+    am_isr_defer_job_init(&__g_defer_job, __event_defer_job, NULL, pri);
+
+    key = am_int_cpu_lock();
+
+    __g_defer_num   = num;
+    __g_defer_head  = 0;
+    __g_defer_count = 0;
+    __gp_defer_msgs = p_msgs;
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_event_raise_defer (am_event_type_t *p_event,
+                          const void      *p_evt_data,
+                          size_t           size,
+                          int              flags)
+{
+    am_event_defer_msg_t *p_msg;
+    am_event_category_t  *p_category;
+    unsigned int          tail;
+    int                   key;
+
+    if ((p_event == NULL) || (size > AM_EVENT_DEFER_DATA_SIZE)) {
+        return -AM_EINVAL;
+    }
+
+    if (__gp_defer_msgs == NULL) {
+        return am_event_raise(p_event, (void *)p_evt_data, flags);
+    }
+
+    key = am_int_cpu_lock();
+
+    /* nobody subscribes to this event */
+    p_category = p_event->p_category;
+    if (((NULL == p_category) ||
+         !(p_category->sub_mask & am_event_mask_get(p_event))) &&
+        ((flags & AM_EVENT_PROC_FLAG_CAT_ONLY) || (NULL == p_event->p_handler))) {
+        __g_defer_stat.filtered++;
+        am_int_cpu_unlock(key);
+        return AM_OK;
+    }
+
+    /* merge into the same event still waiting in the queue */
+    p_msg = p_event->p_pending;
+    if (p_msg != NULL) {
+        if (p_event->coalesce == AM_EVENT_COALESCE_LATEST) {
+            p_msg->p_data = (void *)p_evt_data;
+            p_msg->flags  = (uint8_t)flags;
+            p_msg->size   = (uint8_t)size;
+            if (size != 0) {
+                memcpy(p_msg->data.buf, p_evt_data, size);
+            }
+        }
+        if (p_msg->count != 0xFFFF) {
+            p_msg->count++;
+        }
+        __g_defer_stat.coalesced++;
+        am_int_cpu_unlock(key);
+        return AM_OK;
+    }
+
+    if (__g_defer_count == __g_defer_num) {
+        __g_defer_stat.dropped++;
+        am_int_cpu_unlock(key);
+        return -AM_EFULL;
+    }
+
+    tail = __g_defer_head + __g_defer_count;
+    if (tail >= __g_defer_num) {
+        tail -= __g_defer_num;
+    }
+
+    p_msg          = &__gp_defer_msgs[tail];
+    p_msg->p_event = p_event;
+    p_msg->p_data  = (void *)p_evt_data;
+    p_msg->flags   = (uint8_t)flags;
+    p_msg->size    = (uint8_t)size;
+    p_msg->count   = 1;
+    p_msg->time    = (__g_defer_pfn_timestamp != NULL) ?
+                     __g_defer_pfn_timestamp() : 0;
+    if (size != 0) {
+        memcpy(p_msg->data.buf, p_evt_data, size);
+    }
+
+    if (p_event->coalesce != AM_EVENT_COALESCE_NONE) {
+        p_event->p_pending = p_msg;
+    }
+
+    __g_defer_stat.raised++;
+    if (++__g_defer_count > __g_defer_stat.pending_max) {
+        __g_defer_stat.pending_max = __g_defer_count;
+    }
+
+    /* the job may already be queued, it then picks this event up too */
+    am_isr_defer_job_add(&__g_defer_job);
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_event_defer_timestamp_set (uint32_t (*pfn_timestamp) (void))
+{
+    __g_defer_pfn_timestamp = pfn_timestamp;
+}
+
+/******************************************************************************/
+void am_event_defer_stat_get (struct am_event_defer_stat *p_stat)
+{
+    int key;
+
+    if (p_stat == NULL) {
+        return;
+    }
+
+    key     = am_int_cpu_lock();
+    *p_stat = __g_defer_stat;
+    am_int_cpu_unlock(key);
+}
+
+/******************************************************************************/
+void am_event_defer_stat_reset (void)
+{
+    int key = am_int_cpu_lock();
+
+    memset(&__g_defer_stat, 0, sizeof(__g_defer_stat));
+
+    am_int_cpu_unlock(key);
 }
 
 /* end of file */
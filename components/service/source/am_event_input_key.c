@@ -16,6 +16,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, report keys through am_event_raise_defer().
  * - 1.00 17-05-12  tee, first implementation.
  * \endinternal
  */
@@ -82,7 +83,8 @@ static int __event_input_key_report (int key_code, int key_state, int keep_time)
     data.key_state  = key_state;
     data.keep_time  = keep_time;
 
-    return am_event_raise(&__g_event_input_key, &data, 0);
+    /* ʼ¼ӳٷַʱжӳִ */
+    return am_event_raise_defer(&__g_event_input_key, &data, sizeof(data), 0);
 }
 
 /******************************************************************************/
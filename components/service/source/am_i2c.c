@@ -16,6 +16,7 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.03 26-10-16  ljy, add asynchronous read/write and priority scheduler.
  * - 1.02 15-10-27  tee, add the concept of message.
  * - 1.01 15-08-19  tee, modified some interface.
  * - 1.00 14-11-01  jon, first implementation.
@@ -23,6 +24,7 @@
  */
 
 #include "am_i2c.h"
+#include "am_int.h"
 #include "am_wait.h"
 
 /******************************************************************************/
@@ -35,22 +37,24 @@ static void __i2c_callback (void *p_arg)
 
 /******************************************************************************/
 
-static int __i2c_rw_sync (am_i2c_device_t *p_dev,
-                          uint32_t         sub_addr,
-                          uint8_t         *p_buf,
-                          uint32_t         nbytes,
-                          am_bool_t        is_read)
+/**
+ * \brief build the message to read or write a device
+ *
+ * trans must have 2 elements, subaddr_buf must have 2 bytes.
+ */
+static int __i2c_mkmsg_rw (am_i2c_device_t   *p_dev,
+                           uint32_t           sub_addr,
+                           uint8_t           *p_buf,
+                           uint32_t           nbytes,
+                           am_bool_t          is_read,
+                           am_i2c_transfer_t *trans,
+                           uint8_t           *subaddr_buf,
+                           am_i2c_message_t  *p_msg,
+                           am_pfnvoid_t       pfn_complete,
+                           void              *p_arg)
 {
     uint16_t subaddr_len = AM_I2C_SUBADDR_LEN_GET(p_dev->dev_flags);
     
-    am_i2c_transfer_t trans[3];
-    am_wait_t         trans_wait;
-    am_i2c_message_t  msg;
-    uint8_t           subaddr_buf[2];  /* ڴ2bytesڼӵַ */
-    int               ret;
-    
-    am_wait_init(&trans_wait);
-    
     /* if no sub address just send the data */
     if (subaddr_len == 0) {
         
@@ -61,7 +65,7 @@ static int __i2c_rw_sync (am_i2c_device_t *p_dev,
                        p_buf, 
                        nbytes);
         
-        am_i2c_mkmsg( &msg, &trans[0], 1, __i2c_callback, &trans_wait);
+        am_i2c_mkmsg(p_msg, &trans[0], 1, pfn_complete, p_arg);
                        
                        
     } else {
@@ -101,7 +105,40 @@ static int __i2c_rw_sync (am_i2c_device_t *p_dev,
                        p_buf, 
                        nbytes);
         
-        am_i2c_mkmsg( &msg, &trans[0], 2, __i2c_callback, &trans_wait);
+        am_i2c_mkmsg(p_msg, &trans[0], 2, pfn_complete, p_arg);
+    }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+
+static int __i2c_rw_sync (am_i2c_device_t *p_dev,
+                          uint32_t         sub_addr,
+                          uint8_t         *p_buf,
+                          uint32_t         nbytes,
+                          am_bool_t        is_read)
+{
+    am_i2c_transfer_t trans[2];
+    am_wait_t         trans_wait;
+    am_i2c_message_t  msg;
+    uint8_t           subaddr_buf[2];  /* ڴ2bytesڼӵַ */
+    int               ret;
+    
+    am_wait_init(&trans_wait);
+
+    ret = __i2c_mkmsg_rw(p_dev,
+                         sub_addr,
+                         p_buf,
+                         nbytes,
+                         is_read,
+                         trans,
+                         subaddr_buf,
+                         &msg,
+                         __i2c_callback,
+                         &trans_wait);
+    if (ret != AM_OK) {
+        return ret;
     }
     
     ret = am_i2c_msg_start(p_dev->handle, &msg);
@@ -149,4 +186,247 @@ int am_i2c_read (am_i2c_device_t *p_dev,
                          AM_TRUE);
 }
 
+/*******************************************************************************
+  I2C bus scheduler
+*******************************************************************************/
+
+static int __i2c_sched_msg_start (void *p_drv, am_i2c_message_t *p_msg);
+
+/** \brief ṩ I2C  */
+static const struct am_i2c_drv_funcs __g_i2c_sched_drv_funcs = {
+    __i2c_sched_msg_start,
+};
+
+static void __i2c_sched_next (am_i2c_sched_t *p_sched);
+
+/**
+ * \brief the current message is complete (in the controller interrupt)
+ */
+static void __i2c_sched_complete (void *p_arg)
+{
+    am_i2c_sched_t   *p_sched = (am_i2c_sched_t *)p_arg;
+    am_i2c_message_t *p_msg   = p_sched->p_cur_msg;
+    am_pfnvoid_t      pfn     = p_sched->pfn_cur;
+    void             *p_cb_arg = p_sched->p_cur_arg;
+    int               key;
+
+    p_msg->pfn_complete = pfn;
+    p_msg->p_arg        = p_cb_arg;
+
+    key = am_int_cpu_lock();
+
+    p_sched->p_cur_msg = NULL;
+
+    /*
+     * һϢٵɻصʹ߲صУ
+     * am_i2c_msg_start() ͬʱ __i2c_sched_next() ύ
+     */
+    if (!p_sched->starting) {
+        __i2c_sched_next(p_sched);
+    }
+
+    am_int_cpu_unlock(key);
+
+    if (pfn != NULL) {
+        pfn(p_cb_arg);
+    }
+}
+
+/**
+ * \brief start the highest priority message, interrupt must be locked
+ */
+static void __i2c_sched_next (am_i2c_sched_t *p_sched)
+{
+    struct am_list_head *p_node;
+    am_i2c_message_t    *p_msg;
+    int                  ret;
+    int                  i;
+
+    while (p_sched->p_cur_msg == NULL) {
+
+        for (i = 0; i < AM_I2C_PRIO_NUM; i++) {
+            if (!am_list_empty(&p_sched->queue[i])) {
+                break;
+            }
+        }
+
+        if (i == AM_I2C_PRIO_NUM) {
+            return;
+        }
+
+        p_node = p_sched->queue[i].next;
+        am_list_del(p_node);
+        p_msg  = am_list_entry(p_node, am_i2c_message_t, ctlrdata);
+
+        /* ػɻصʱٻָ */
+        p_sched->p_cur_msg  = p_msg;
+        p_sched->pfn_cur    = p_msg->pfn_complete;
+        p_sched->p_cur_arg  = p_msg->p_arg;
+        p_msg->pfn_complete = __i2c_sched_complete;
+        p_msg->p_arg        = (void *)p_sched;
+
+        p_sched->starting = AM_TRUE;
+        ret = am_i2c_msg_start(p_sched->bus, p_msg);
+        p_sched->starting = AM_FALSE;
+
+        if (ret != AM_OK) {
+            p_msg->pfn_complete = p_sched->pfn_cur;
+            p_msg->p_arg        = p_sched->p_cur_arg;
+            p_msg->status       = ret;
+            p_sched->p_cur_msg  = NULL;
+
+            if (p_msg->pfn_complete != NULL) {
+                p_msg->pfn_complete(p_msg->p_arg);
+            }
+        }
+    }
+}
+
+/******************************************************************************/
+static int __i2c_sched_msg_start (void *p_drv, am_i2c_message_t *p_msg)
+{
+    return am_i2c_sched_msg_start((am_i2c_sched_t *)p_drv,
+                                  p_msg,
+                                  AM_I2C_PRIO_NORMAL);
+}
+
+/******************************************************************************/
+am_i2c_handle_t am_i2c_sched_init (am_i2c_sched_t *p_sched, am_i2c_handle_t bus)
+{
+    int i;
+
+    if ((p_sched == NULL) || (bus == NULL)) {
+        return NULL;
+    }
+
+    for (i = 0; i < AM_I2C_PRIO_NUM; i++) {
+        am_list_head_init(&p_sched->queue[i]);
+    }
+
+    p_sched->bus       = bus;
+    p_sched->p_cur_msg = NULL;
+    p_sched->pfn_cur   = NULL;
+    p_sched->p_cur_arg = NULL;
+    p_sched->starting  = AM_FALSE;
+
+    p_sched->serv.p_funcs = (struct am_i2c_drv_funcs *)&__g_i2c_sched_drv_funcs;
+    p_sched->serv.p_drv   = p_sched;
+
+    return &p_sched->serv;
+}
+
+/******************************************************************************/
+int am_i2c_sched_msg_start (am_i2c_sched_t   *p_sched,
+                            am_i2c_message_t *p_msg,
+                            uint8_t           prio)
+{
+    int key;
+
+    if ((p_sched == NULL) || (p_msg == NULL) ||
+        (p_msg->p_transfers == NULL) || (p_msg->trans_num == 0)) {
+        return -AM_EINVAL;
+    }
+
+    if (prio >= AM_I2C_PRIO_NUM) {
+        prio = AM_I2C_PRIO_LOW;
+    }
+
+    p_msg->status   = -AM_EISCONN;
+    p_msg->done_num = 0;
+
+    key = am_int_cpu_lock();
+
+    am_list_add_tail((struct am_list_head *)(&p_msg->ctlrdata),
+                     &p_sched->queue[prio]);
+
+    __i2c_sched_next(p_sched);
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/*******************************************************************************
+  Asynchronous read and write
+*******************************************************************************/
+
+static void __i2c_async_complete (void *p_arg)
+{
+    am_i2c_async_t *p_req = (am_i2c_async_t *)p_arg;
+
+    if (p_req->pfn_complete != NULL) {
+        p_req->pfn_complete(p_req->p_arg, p_req->msg.status);
+    }
+}
+
+static int __i2c_rw_async (am_i2c_device_t *p_dev,
+                           uint32_t         sub_addr,
+                           uint8_t         *p_buf,
+                           uint32_t         nbytes,
+                           am_bool_t        is_read,
+                           am_i2c_async_t  *p_req)
+{
+    am_i2c_handle_t handle;
+    int             ret;
+
+    if ((p_dev == NULL) || (p_dev->handle == NULL) || (p_req == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    ret = __i2c_mkmsg_rw(p_dev,
+                         sub_addr,
+                         p_buf,
+                         nbytes,
+                         is_read,
+                         p_req->trans,
+                         p_req->subaddr,
+                         &p_req->msg,
+                         __i2c_async_complete,
+                         (void *)p_req);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    handle = p_dev->handle;
+
+    /* ʱȼŶ */
+    if (handle->p_funcs == &__g_i2c_sched_drv_funcs) {
+        return am_i2c_sched_msg_start((am_i2c_sched_t *)handle->p_drv,
+                                      &p_req->msg,
+                                      p_req->prio);
+    }
+
+    return am_i2c_msg_start(handle, &p_req->msg);
+}
+
+/******************************************************************************/
+int am_i2c_write_async (am_i2c_device_t *p_dev,
+                        uint32_t         sub_addr,
+                        const uint8_t   *p_buf,
+                        uint32_t         nbytes,
+                        am_i2c_async_t  *p_req)
+{
+    return __i2c_rw_async(p_dev,
+                          sub_addr,
+                          (uint8_t *)p_buf,
+                          nbytes,
+                          AM_FALSE,
+                          p_req);
+}
+
+/******************************************************************************/
+int am_i2c_read_async (am_i2c_device_t *p_dev,
+                       uint32_t         sub_addr,
+                       uint8_t         *p_buf,
+                       uint32_t         nbytes,
+                       am_i2c_async_t  *p_req)
+{
+    return __i2c_rw_async(p_dev,
+                          sub_addr,
+                          p_buf,
+                          nbytes,
+                          AM_TRUE,
+                          p_req);
+}
+
 /* end of file */
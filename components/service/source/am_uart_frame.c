@@ -0,0 +1,473 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief  UARTring buffer֡ʵ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+#include "am_uart_frame.h"
+
+/*******************************************************************************
+  Macro definitions
+*******************************************************************************/
+
+#define __COBS_DELIM        0x00    /**< \brief COBS ָ֡ */
+#define __COBS_BLOCK_MAX    254     /**< \brief COBS ֽ */
+
+#define __SLIP_END          0xC0    /**< \brief SLIP ָ֡ */
+#define __SLIP_ESC          0xDB    /**< \brief SLIP תַ */
+#define __SLIP_ESC_END      0xDC    /**< \brief ת 0xC0 */
+#define __SLIP_ESC_ESC      0xDD    /**< \brief ת 0xDB */
+
+/** \brief ʱÿд뷢ͻֽ */
+#define __TX_CHUNK_SIZE     32
+
+/*******************************************************************************
+  Local type definitions
+*******************************************************************************/
+
+/** \brief ͱʱݴ */
+typedef struct __frame_tx {
+    am_uart_frame_dev_t *p_dev;
+    uint8_t              buf[__TX_CHUNK_SIZE];
+    uint32_t             len;
+    int                  err;
+} __frame_tx_t;
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+static uint32_t __frame_crc_cal (am_uart_frame_dev_t *p_dev,
+                                 am_crc_handle_t      crc_handle,
+                                 const uint8_t       *p_data,
+                                 uint32_t             len)
+{
+    uint32_t crc = 0;
+
+    am_crc_init(crc_handle, &p_dev->crc_pattern);
+    am_crc_cal(crc_handle, p_data, len);
+    am_crc_final(crc_handle, &crc);
+
+    return crc;
+}
+
+/* ʼµһ֡ */
+static void __frame_rx_reset (am_uart_frame_dev_t *p_dev)
+{
+    p_dev->rx_len    = 0;
+    p_dev->cobs_left = 0;
+    p_dev->cobs_zero = AM_FALSE;
+    p_dev->slip_esc  = AM_FALSE;
+    p_dev->rx_err    = AM_OK;
+}
+
+/* һֽڣֻ¼һ */
+am_static_inline
+void __frame_rx_put (am_uart_frame_dev_t *p_dev, uint8_t data)
+{
+    if (p_dev->rx_len < p_dev->p_devinfo->frame_size) {
+        p_dev->p_devinfo->p_frame_buf[p_dev->rx_len++] = data;
+    } else if (p_dev->rx_err == AM_OK) {
+        p_dev->rx_err = -AM_EMSGSIZE;
+    }
+}
+
+/* յָУ鲢ύһ֡ύ֡ */
+static int __frame_rx_end (am_uart_frame_dev_t *p_dev)
+{
+    uint8_t  *p_buf = p_dev->p_devinfo->p_frame_buf;
+    uint32_t  len   = p_dev->rx_len;
+    int       err   = p_dev->rx_err;
+    uint32_t  crc;
+    uint32_t  i;
+
+    __frame_rx_reset(p_dev);
+
+    /* ķָ֮ûݣ֡ͬ */
+    if ((len == 0) && (err == AM_OK)) {
+        return 0;
+    }
+
+    if ((err == AM_OK) && (p_dev->crc_bytes != 0)) {
+        if (len < p_dev->crc_bytes) {
+            err = -AM_EBADMSG;
+        } else {
+            len -= p_dev->crc_bytes;
+            crc  = __frame_crc_cal(p_dev, p_dev->rx_crc_handle, p_buf, len);
+
+            /* CRC С˷ʽ֮ */
+            for (i = 0; i < p_dev->crc_bytes; i++) {
+                if (p_buf[len + i] != (uint8_t)(crc >> (i * 8))) {
+                    err = -AM_EBADMSG;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (p_dev->pfn_rx_cb != NULL) {
+        if (err == AM_OK) {
+            p_dev->pfn_rx_cb(p_dev->p_rx_arg, p_buf, (int)len);
+        } else {
+            p_dev->pfn_rx_cb(p_dev->p_rx_arg, NULL, err);
+        }
+    }
+
+    return 1;
+}
+
+/* COBS һݣύ֡ */
+static int __frame_cobs_decode (am_uart_frame_dev_t *p_dev,
+                                const uint8_t       *p_data,
+                                uint32_t             len)
+{
+    uint8_t data;
+    int     nframes = 0;
+
+    while (len--) {
+        data = *p_data++;
+
+        if (data == __COBS_DELIM) {
+
+            /* δյָ */
+            if ((p_dev->cobs_left != 0) && (p_dev->rx_err == AM_OK)) {
+                p_dev->rx_err = -AM_EBADMSG;
+            }
+            nframes += __frame_rx_end(p_dev);
+
+        } else if (p_dev->cobs_left == 0) {
+
+            /* 鳤ֽڣһ֮ 0 ȷ֡δʱŲ */
+            if (p_dev->cobs_zero) {
+                __frame_rx_put(p_dev, 0);
+            }
+            p_dev->cobs_left = data - 1;
+            p_dev->cobs_zero = (am_bool_t)(data != __COBS_BLOCK_MAX + 1);
+
+        } else {
+            __frame_rx_put(p_dev, data);
+            p_dev->cobs_left--;
+        }
+    }
+
+    return nframes;
+}
+
+/* SLIP һݣύ֡ */
+static int __frame_slip_decode (am_uart_frame_dev_t *p_dev,
+                                const uint8_t       *p_data,
+                                uint32_t             len)
+{
+    uint8_t data;
+    int     nframes = 0;
+
+    while (len--) {
+        data = *p_data++;
+
+        if (data == __SLIP_END) {
+
+            if (p_dev->slip_esc && (p_dev->rx_err == AM_OK)) {
+                p_dev->rx_err = -AM_EBADMSG;
+            }
+            nframes += __frame_rx_end(p_dev);
+
+        } else if (p_dev->slip_esc) {
+
+            p_dev->slip_esc = AM_FALSE;
+
+            if (data == __SLIP_ESC_END) {
+                __frame_rx_put(p_dev, __SLIP_END);
+            } else if (data == __SLIP_ESC_ESC) {
+                __frame_rx_put(p_dev, __SLIP_ESC);
+            } else if (p_dev->rx_err == AM_OK) {
+                p_dev->rx_err = -AM_EBADMSG;
+            }
+
+        } else if (data == __SLIP_ESC) {
+            p_dev->slip_esc = AM_TRUE;
+        } else {
+            __frame_rx_put(p_dev, data);
+        }
+    }
+
+    return nframes;
+}
+
+/* մصжģжӳٶ */
+static void __frame_rx_trigger (void *p_arg)
+{
+    am_uart_frame_dev_t *p_dev = (am_uart_frame_dev_t *)p_arg;
+
+    /* ڶʱ -AM_EBUSYɸһ */
+    am_isr_defer_job_add(&p_dev->rx_job);
+}
+
+/* ӳ */
+static void __frame_rx_job (void *p_arg)
+{
+    am_uart_frame_process((am_uart_frame_handle_t)p_arg);
+}
+
+/* ݴед뷢ͻ */
+static void __frame_tx_flush (__frame_tx_t *p_tx)
+{
+    if ((p_tx->len > 0) && (p_tx->err == AM_OK)) {
+        if (am_uart_rngbuf_send(p_tx->p_dev->rngbuf_handle,
+                                p_tx->buf,
+                                p_tx->len) != (int)p_tx->len) {
+            p_tx->err = -AM_ETIME;
+        }
+    }
+    p_tx->len = 0;
+}
+
+am_static_inline
+void __frame_tx_put (__frame_tx_t *p_tx, uint8_t data)
+{
+    p_tx->buf[p_tx->len++] = data;
+
+    if (p_tx->len == sizeof(p_tx->buf)) {
+        __frame_tx_flush(p_tx);
+    }
+}
+
+/*  CRC ɴֽ */
+#define __FRAME_TX_BYTE(i)  \
+    (((i) < len) ? p_data[(i)] : p_crc[(i) - len])
+
+static void __frame_cobs_encode (__frame_tx_t  *p_tx,
+                                 const uint8_t *p_data,
+                                 uint32_t       len,
+                                 const uint8_t *p_crc,
+                                 uint32_t       total)
+{
+    uint32_t i = 0;
+    uint32_t j;
+    uint32_t code;
+
+    __frame_tx_put(p_tx, __COBS_DELIM);
+
+    for (;;) {
+
+        /* ҳһ飺 254  0 ֽ */
+        for (j = i;
+             (j < total) && (j - i < __COBS_BLOCK_MAX) &&
+             (__FRAME_TX_BYTE(j) != 0);
+             j++);
+
+        code = j - i + 1;
+
+        __frame_tx_put(p_tx, (uint8_t)code);
+        for (; i < j; i++) {
+            __frame_tx_put(p_tx, __FRAME_TX_BYTE(i));
+        }
+
+        if (j >= total) {
+            break;
+        }
+
+        /*  0 ʱ 0 254 ֽڵĿ֮û 0 */
+        if (code != __COBS_BLOCK_MAX + 1) {
+            i = j + 1;
+        }
+    }
+
+    __frame_tx_put(p_tx, __COBS_DELIM);
+}
+
+static void __frame_slip_encode (__frame_tx_t  *p_tx,
+                                 const uint8_t *p_data,
+                                 uint32_t       len,
+                                 const uint8_t *p_crc,
+                                 uint32_t       total)
+{
+    uint32_t i;
+    uint8_t  data;
+
+    __frame_tx_put(p_tx, __SLIP_END);
+
+    for (i = 0; i < total; i++) {
+        data = __FRAME_TX_BYTE(i);
+
+        if (data == __SLIP_END) {
+            __frame_tx_put(p_tx, __SLIP_ESC);
+            __frame_tx_put(p_tx, __SLIP_ESC_END);
+        } else if (data == __SLIP_ESC) {
+            __frame_tx_put(p_tx, __SLIP_ESC);
+            __frame_tx_put(p_tx, __SLIP_ESC_ESC);
+        } else {
+            __frame_tx_put(p_tx, data);
+        }
+    }
+
+    __frame_tx_put(p_tx, __SLIP_END);
+}
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+
+am_uart_frame_handle_t am_uart_frame_init (
+                                   am_uart_frame_dev_t           *p_dev,
+                                   const am_uart_frame_devinfo_t *p_devinfo,
+                                   am_uart_rngbuf_handle_t        rngbuf_handle,
+                                   am_crc_handle_t                rx_crc_handle,
+                                   am_crc_handle_t                tx_crc_handle)
+{
+    if ((p_dev == NULL) || (p_devinfo == NULL) || (rngbuf_handle == NULL) ||
+        (p_devinfo->p_frame_buf == NULL) || (p_devinfo->frame_size == 0) ||
+        (p_devinfo->coding > AM_UART_FRAME_SLIP)) {
+        return NULL;
+    }
+
+    p_dev->crc_bytes = 0;
+
+    if (p_devinfo->p_crc_pattern != NULL) {
+        if ((rx_crc_handle == NULL) || (tx_crc_handle == NULL) ||
+            (p_devinfo->p_crc_pattern->width == 0) ||
+            (p_devinfo->p_crc_pattern->width > 32)) {
+            return NULL;
+        }
+        p_dev->crc_pattern = *p_devinfo->p_crc_pattern;
+        p_dev->crc_bytes   = (p_devinfo->p_crc_pattern->width + 7) / 8;
+    }
+
+    p_dev->rngbuf_handle = rngbuf_handle;
+    p_dev->rx_crc_handle = rx_crc_handle;
+    p_dev->tx_crc_handle = tx_crc_handle;
+    p_dev->pfn_rx_cb     = NULL;
+    p_dev->p_rx_arg      = NULL;
+    p_dev->p_devinfo     = p_devinfo;
+
+    __frame_rx_reset(p_dev);
+
+    am_isr_defer_job_init(&p_dev->rx_job,
+                          __frame_rx_job,
+                          (void *)p_dev,
+                          p_devinfo->job_prio);
+
+    /* յݼDMA ģʽÿݴһ */
+    am_uart_rngbuf_rx_trigger_cfg(rngbuf_handle,
+                                  1,
+                                  __frame_rx_trigger,
+                                  (void *)p_dev);
+    am_uart_rngbuf_rx_trigger_enable(rngbuf_handle);
+
+    return p_dev;
+}
+
+/******************************************************************************/
+int am_uart_frame_rx_cb_reg (am_uart_frame_handle_t  handle,
+                             am_uart_frame_rx_cb_t   pfn_rx_cb,
+                             void                   *p_arg)
+{
+    if (handle == NULL) {
+        return -AM_EINVAL;
+    }
+
+    handle->pfn_rx_cb = pfn_rx_cb;
+    handle->p_rx_arg  = p_arg;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_uart_frame_process (am_uart_frame_handle_t handle)
+{
+    const uint8_t *p_data;
+    uint32_t       len;
+    int            nframes = 0;
+
+    if (handle == NULL) {
+        return -AM_EINVAL;
+    }
+
+    /* ֱڽջн룬ʱδ */
+    while ((len = am_uart_rngbuf_rx_peek(handle->rngbuf_handle, &p_data)) > 0) {
+
+        if (handle->p_devinfo->coding == AM_UART_FRAME_COBS) {
+            nframes += __frame_cobs_decode(handle, p_data, len);
+        } else {
+            nframes += __frame_slip_decode(handle, p_data, len);
+        }
+
+        am_uart_rngbuf_rx_consume(handle->rngbuf_handle, len);
+    }
+
+    return nframes;
+}
+
+/******************************************************************************/
+int am_uart_frame_send (am_uart_frame_handle_t  handle,
+                        const uint8_t          *p_data,
+                        uint32_t                len)
+{
+    __frame_tx_t tx;
+    uint8_t      crc_buf[4];
+    uint32_t     crc;
+    uint32_t     total;
+    uint32_t     nmax;
+    uint32_t     nfree = 0;
+    uint32_t     i;
+
+    if ((handle == NULL) || ((p_data == NULL) && (len != 0))) {
+        return -AM_EINVAL;
+    }
+
+    if (handle->crc_bytes != 0) {
+        crc = __frame_crc_cal(handle, handle->tx_crc_handle, p_data, len);
+        for (i = 0; i < handle->crc_bytes; i++) {
+            crc_buf[i] = (uint8_t)(crc >> (i * 8));
+        }
+    }
+
+    total = len + handle->crc_bytes;
+
+    /* ģʽֻ֡󳤶жϿռ */
+    if (handle->rngbuf_handle->nonblock == AM_TRUE) {
+        if (handle->p_devinfo->coding == AM_UART_FRAME_COBS) {
+            nmax = total + total / __COBS_BLOCK_MAX + 3;
+        } else {
+            nmax = total * 2 + 2;
+        }
+
+        am_uart_rngbuf_ioctl(handle->rngbuf_handle,
+                             AM_UART_RNGBUF_NFREE,
+                             (void *)&nfree);
+        if (nfree < nmax) {
+            return -AM_EAGAIN;
+        }
+    }
+
+    tx.p_dev = handle;
+    tx.len   = 0;
+    tx.err   = AM_OK;
+
+    if (handle->p_devinfo->coding == AM_UART_FRAME_COBS) {
+        __frame_cobs_encode(&tx, p_data, len, crc_buf, total);
+    } else {
+        __frame_slip_encode(&tx, p_data, len, crc_buf, total);
+    }
+
+    __frame_tx_flush(&tx);
+
+    return tx.err;
+}
+
+/* end of file */
@@ -16,6 +16,10 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.05 26-10-16  ljy, add zero-copy receive
+ * - 1.04 26-10-16  ljy, add TX timeout and non-blocking mode
+ * - 1.03 26-10-16  ljy, add chunked TX callback
+ * - 1.02 26-10-16  ljy, add DMA receive mode
  * - 1.01 15-07-15  bob, add UART flowctrl mode
  * - 1.01 14-12-03  jon, add UART interrupt mode
  * - 1.00 14-11-01  tee, first implementation.
@@ -29,6 +33,21 @@
  
 /******************************************************************************/
  
+/**
+ * \brief call the tx trigger callback if free bytes reached the threshold.
+ */
+static void __uart_rngbuf_tx_trigger (am_uart_rngbuf_dev_t *p_dev)
+{
+    /* ֽڷֵһصǿ */
+    if ((AM_TRUE == p_dev->tx_trigger_enable) &&
+        (am_rngbuf_freebytes(&(p_dev->tx_rngbuf)) >= p_dev->tx_trigger_threshold)) {
+
+        if (NULL != p_dev->pfn_tx_callback) {
+            p_dev->pfn_tx_callback(p_dev->p_tx_arg);
+        }
+    }
+}
+
 /** 
  * \brief the function that to get one char to transmit.
  */
@@ -44,18 +63,33 @@ static int __uart_rngbuf_txchar_get (void *p_arg, char *p_outchar)
         return -AM_EEMPTY;     /* No data to transmit,return -AM_EEMPTY */
     }
 
-    /* ֽڷֵһصǿ */
-    if ((AM_TRUE == p_dev->rx_trigger_enable) &&
-        (am_rngbuf_nbytes(rb) >= p_dev->tx_trigger_threshold)) {
+    am_wait_done(&p_dev->tx_wait);
 
-        if (NULL != p_dev->pfn_tx_callback) {
-            p_dev->pfn_tx_callback(p_dev->p_tx_arg);
-        }
-    }
+    __uart_rngbuf_tx_trigger(p_dev);
 
     return AM_OK;
 }
 
+/**
+ * \brief the function that to get chars to transmit.
+ */
+static int __uart_rngbuf_txchars_get (void *p_arg, char *p_buf, uint32_t max)
+{
+    am_uart_rngbuf_dev_t *p_dev = (am_uart_rngbuf_dev_t *)p_arg;
+    int                   n;
+
+    n = am_rngbuf_get(&(p_dev->tx_rngbuf), p_buf, max);
+    if (n == 0) {
+        return -AM_EEMPTY;     /* No data to transmit,return -AM_EEMPTY */
+    }
+
+    am_wait_done(&p_dev->tx_wait);
+
+    __uart_rngbuf_tx_trigger(p_dev);
+
+    return n;
+}
+
 /** 
  * \brief the function revived one char.
  */
@@ -93,6 +127,95 @@ static int __uart_rngbuf_rxchar_put (void *p_arg, char inchar)
     return AM_OK;
 }
 
+/**
+ * \brief the function that publish the write index of DMA receive.
+ *
+ * Called by the driver from interrupt context, flow control, rx_wait and rx
+ * trigger are handled once for all the bytes received since last call.
+ */
+static int __uart_rngbuf_rxbuf_update (void *p_arg, uint32_t wr_idx)
+{
+    am_uart_rngbuf_dev_t *p_dev = (am_uart_rngbuf_dev_t *)p_arg;
+    am_rngbuf_t            rb    = &(p_dev->rx_rngbuf);
+
+    uint32_t size = rb->size;
+    uint32_t nnew;
+    uint32_t nfree;
+
+    if (wr_idx > size) {
+        return -AM_EINVAL;
+    }
+
+    /* DMA дĩβʱдλΪ sizeдһȦʱݸΪ size */
+    if (wr_idx == size) {
+        nnew   = size - rb->in;
+        wr_idx = 0;
+    } else {
+        nnew   = (wr_idx + size - rb->in) % size;
+    }
+
+    if (nnew == 0) {
+        return AM_OK;
+    }
+
+    /* δ¶λλʱΪ */
+    nfree = p_dev->rx_overrun ? 0 : am_rngbuf_freebytes(rb);
+
+    /* δѱǣɶȡ¶λλ */
+    if (nnew > nfree) {
+        p_dev->rx_lost   += nnew - nfree;
+        p_dev->rx_overrun = AM_TRUE;
+    }
+
+    am_rngbuf_move_ahead(rb, nnew);
+
+    /* ֽСֵ */
+    if ((p_dev->flow_stat == AM_TRUE) &&
+        ((p_dev->rx_overrun == AM_TRUE) ||
+         (am_rngbuf_freebytes(rb) < p_dev->xoff_threshold))) {
+
+        am_uart_ioctl(p_dev->handle,
+                      AM_UART_FLOWSTAT_RX_SET,
+                      (void *)AM_UART_FLOWSTAT_OFF);
+
+        p_dev->flow_stat = AM_FALSE;
+    }
+
+    am_wait_done(&p_dev->rx_wait);
+
+    /* ֽڽֵһصǿ */
+    if ((AM_TRUE == p_dev->rx_trigger_enable) &&
+        ((p_dev->rx_overrun == AM_TRUE) ||
+         (am_rngbuf_nbytes(rb) >= p_dev->rx_trigger_threshold))) {
+
+        if (NULL != p_dev->pfn_rx_callback) {
+            p_dev->pfn_rx_callback(p_dev->p_rx_arg);
+        }
+    }
+
+    return AM_OK;
+}
+
+/**
+ * \brief re-locate the read index after DMA overrun.
+ *
+ * The oldest bytes still in the buffer begin right after the write index.
+ */
+static void __uart_rngbuf_rx_overrun_fix (am_uart_rngbuf_dev_t *p_dev)
+{
+    am_rngbuf_t rb = &(p_dev->rx_rngbuf);
+    int         key;
+
+    key = am_int_cpu_lock();
+
+    if (p_dev->rx_overrun == AM_TRUE) {
+        rb->out           = (rb->in + 1 >= rb->size) ? 0 : rb->in + 1;
+        p_dev->rx_overrun = AM_FALSE;
+    }
+
+    am_int_cpu_unlock(key);
+}
+
 /**
  * \brief UART send data.
  */
@@ -106,27 +229,47 @@ int am_uart_rngbuf_send (am_uart_rngbuf_handle_t  rngbuf_handle,
 
     uint32_t rb_ct, write_ct;
 
-    uint32_t len = nbytes;
+    uint32_t len = 0;                                /* дֽ      */
     
-    while (len > 0) {
-        if (am_rngbuf_isfull(rb) == AM_TRUE) {
+    while (nbytes > 0) {
+
+        if (am_rngbuf_isfull(rb) == AM_TRUE) {      /* õȴ */
+
+            if ((p_dev->nonblock == AM_TRUE) ||
+                (p_dev->tx_timeout_ms == AM_NO_WAIT)) {
+
+                return len;
+
+            } else if (p_dev->tx_timeout_ms == (uint32_t)AM_WAIT_FOREVER) {
+
+                am_wait_on(&p_dev->tx_wait);
+
+            } else {
+
+                if (am_wait_on_timeout(&p_dev->tx_wait,
+                                       p_dev->tx_timeout_ms) != AM_OK) {
+                    return len;
+                }
+            }
+
+            /* ȴ֮ǰķͻѣжǷппռ */
             continue;
         }
 
         rb_ct    = am_rngbuf_freebytes(rb);
 
-        write_ct = (rb_ct > len) ? len : rb_ct;
+        write_ct = (rb_ct > nbytes) ? nbytes : rb_ct;
 
         am_rngbuf_put(rb, (const char *)p_txbuf, write_ct);
         
         p_txbuf += write_ct;
-        
-        len     -= write_ct;
+        nbytes  -= write_ct;
+        len     += write_ct;
         
         am_uart_tx_startup(p_dev->handle);
     }
 
-    return nbytes;
+    return len;
 }
 
 /******************************************************************************/
@@ -140,6 +283,8 @@ static void __uart_rngbuf_tx_flush (am_uart_rngbuf_dev_t *p_dev)
     am_rngbuf_flush(&p_dev->tx_rngbuf);
     
     am_int_cpu_unlock(key);
+
+    am_wait_done(&p_dev->tx_wait);
 }
 
 static void __uart_rngbuf_rx_flush (am_uart_rngbuf_dev_t *p_dev)
@@ -148,11 +293,75 @@ static void __uart_rngbuf_rx_flush (am_uart_rngbuf_dev_t *p_dev)
     
     key = am_int_cpu_lock();
     
-    am_rngbuf_flush(&p_dev->rx_rngbuf);
+    /* DMA ʱдλ DMA ֻܶѽյ */
+    if (p_dev->rx_dma) {
+        p_dev->rx_rngbuf.out = p_dev->rx_rngbuf.in;
+        p_dev->rx_overrun    = AM_FALSE;
+    } else {
+        am_rngbuf_flush(&p_dev->rx_rngbuf);
+    }
     
     am_int_cpu_unlock(key);
 }
 
+static int __uart_rngbuf_rx_dma_set (am_uart_rngbuf_dev_t *p_dev,
+                                     am_bool_t             enable)
+{
+    am_uart_rxbuf_t rxbuf;
+    int             modes = 0;
+    int             ret;
+
+    if (enable == p_dev->rx_dma) {
+        return AM_OK;
+    }
+
+    if (!enable) {
+        ret = am_uart_ioctl(p_dev->handle,
+                            AM_UART_MODE_SET,
+                            (void *)AM_UART_MODE_INT);
+        if (ret == AM_OK) {
+            p_dev->rx_dma = AM_FALSE;
+            __uart_rngbuf_rx_overrun_fix(p_dev);
+        }
+        return ret;
+    }
+
+    if ((am_uart_ioctl(p_dev->handle,
+                       AM_UART_AVAIL_MODES_GET,
+                       (void *)&modes) != AM_OK) ||
+        !(modes & AM_UART_MODE_DMA)) {
+        return -AM_ENOTSUP;
+    }
+
+    /* DMA ӻʼλÿʼд */
+    __uart_rngbuf_rx_flush(p_dev);
+
+    p_dev->rx_overrun = AM_FALSE;
+    p_dev->rx_lost    = 0;
+
+    am_uart_callback_set(p_dev->handle,
+                         AM_UART_CALLBACK_RXBUF_UPDATE,
+                         (void *)__uart_rngbuf_rxbuf_update,
+                         (void *)(p_dev));
+
+    rxbuf.p_buf = (uint8_t *)p_dev->rx_rngbuf.buf;
+    rxbuf.size  = p_dev->rx_rngbuf.size;
+
+    ret = am_uart_ioctl(p_dev->handle, AM_UART_RXBUF_SET, (void *)&rxbuf);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    ret = am_uart_ioctl(p_dev->handle,
+                        AM_UART_MODE_SET,
+                        (void *)AM_UART_MODE_DMA);
+    if (ret == AM_OK) {
+        p_dev->rx_dma = AM_TRUE;
+    }
+
+    return ret;
+}
+
 /******************************************************************************/
 
 int am_uart_rngbuf_ioctl (am_uart_rngbuf_handle_t   handle,
@@ -166,12 +375,19 @@ int am_uart_rngbuf_ioctl (am_uart_rngbuf_handle_t   handle,
     switch (request) {
         
     case AM_UART_RNGBUF_NREAD :
+        if (p_dev->rx_overrun == AM_TRUE) {
+            __uart_rngbuf_rx_overrun_fix(p_dev);
+        }
         *(int *)p_arg = am_rngbuf_nbytes(&p_dev->rx_rngbuf);
         break;
     
     case AM_UART_RNGBUF_NWRITE :
         *(int *)p_arg = am_rngbuf_nbytes(&p_dev->tx_rngbuf);
         break;
+
+    case AM_UART_RNGBUF_NFREE :
+        *(uint32_t *)p_arg = am_rngbuf_freebytes(&p_dev->tx_rngbuf);
+        break;
     
     case AM_UART_RNGBUF_FLUSH :
         __uart_rngbuf_tx_flush(p_dev);
@@ -187,14 +403,32 @@ int am_uart_rngbuf_ioctl (am_uart_rngbuf_handle_t   handle,
         break;
     
     case AM_UART_RNGBUF_TIMEOUT:
-        p_dev->timeout_ms   = (int)p_arg;
+        p_dev->timeout_ms   = (int)(intptr_t)p_arg;
         break;
+
+    case AM_UART_RNGBUF_TX_TIMEOUT:
+        p_dev->tx_timeout_ms = (int)(intptr_t)p_arg;
+        break;
+
+    case AM_UART_RNGBUF_NONBLOCK:
+        p_dev->nonblock = (p_arg != NULL) ? AM_TRUE : AM_FALSE;
+        break;
+
     case AM_UART_RNGBUF_RX_FLOW_OFF_THR:
-        p_dev->xoff_threshold = (int)p_arg;
+        p_dev->xoff_threshold = (int)(intptr_t)p_arg;
         break;
 
     case AM_UART_RNGBUF_RX_FLOW_ON_THR:
-        p_dev->xon_threshold  = (int)p_arg;
+        p_dev->xon_threshold  = (int)(intptr_t)p_arg;
+        break;
+
+    case AM_UART_RNGBUF_RX_DMA_SET:
+        ret = __uart_rngbuf_rx_dma_set(p_dev,
+                                       (p_arg != NULL) ? AM_TRUE : AM_FALSE);
+        break;
+
+    case AM_UART_RNGBUF_RX_LOST:
+        *(uint32_t *)p_arg = p_dev->rx_lost;
         break;
     
     case AM_UART_MODE_SET :                   /* ģʽ̶ΪжģʽΪѯģʽ */
@@ -210,6 +444,28 @@ int am_uart_rngbuf_ioctl (am_uart_rngbuf_handle_t   handle,
 }
 
 /******************************************************************************/
+
+/**
+ * \brief re-open the data receiving if free bytes reached the xon threshold.
+ */
+static void __uart_rngbuf_rx_flow_on (am_uart_rngbuf_dev_t *p_dev)
+{
+    /* ݽչرգжǷҪ */
+    if (p_dev->flow_stat == AM_FALSE) {
+        
+        /* ֵֽ */
+        if (am_rngbuf_freebytes(&p_dev->rx_rngbuf) > p_dev->xon_threshold) {
+
+            /* Notify the other party continues to send */ 
+            am_uart_ioctl(p_dev->handle, 
+                          AM_UART_FLOWSTAT_RX_SET, 
+                          (void *)AM_UART_FLOWSTAT_ON);
+            
+            p_dev->flow_stat = AM_TRUE;
+        }
+    }
+}
+
 /**
  * \brief UART receive data
  */
@@ -225,10 +481,15 @@ int am_uart_rngbuf_receive (am_uart_rngbuf_handle_t   handle,
     uint32_t len = 0;                                /* ȡֽ      */
 
     while (nbytes > 0) {
+
+        if (p_dev->rx_overrun == AM_TRUE) {
+            __uart_rngbuf_rx_overrun_fix(p_dev);
+        }
          
         if (am_rngbuf_isempty(rb) == AM_TRUE) {     /* Ϊգõȴ */
             
-            if (p_dev->timeout_ms == AM_NO_WAIT) {
+            if ((p_dev->nonblock == AM_TRUE) ||
+                (p_dev->timeout_ms == AM_NO_WAIT)) {
 
                 return len;
 
@@ -255,25 +516,63 @@ int am_uart_rngbuf_receive (am_uart_rngbuf_handle_t   handle,
         nbytes  -= read_ct;
         len     += read_ct;
         
-        /* ݽչرգжǷҪ */
-        if (p_dev->flow_stat == AM_FALSE) {
-            
-            /* ֵֽ */
-            if (am_rngbuf_freebytes(rb) > p_dev->xon_threshold) {
-
-                /* Notify the other party continues to send */ 
-                am_uart_ioctl(p_dev->handle, 
-                              AM_UART_FLOWSTAT_RX_SET, 
-                              (void *)AM_UART_FLOWSTAT_ON);
-                
-                p_dev->flow_stat = AM_TRUE;
-            }
-        }
+        __uart_rngbuf_rx_flow_on(p_dev);
     }
 
     return len;
 }
 
+/******************************************************************************/
+uint32_t am_uart_rngbuf_rx_peek (am_uart_rngbuf_handle_t   handle,
+                                 const uint8_t           **pp_data)
+{
+    am_uart_rngbuf_dev_t *p_dev = (am_uart_rngbuf_dev_t *)handle;
+    am_rngbuf_t            rb    = &(p_dev->rx_rngbuf);
+
+    int in;
+    int out;
+
+    if (p_dev->rx_overrun == AM_TRUE) {
+        __uart_rngbuf_rx_overrun_fix(p_dev);
+    }
+
+    in  = rb->in;
+    out = rb->out;
+
+    *pp_data = (const uint8_t *)&rb->buf[out];
+
+    /* дλûʱֻصĩβĲ */
+    return (in >= out) ? (uint32_t)(in - out) : (uint32_t)(rb->size - out);
+}
+
+/******************************************************************************/
+int am_uart_rngbuf_rx_consume (am_uart_rngbuf_handle_t handle, uint32_t nbytes)
+{
+    am_uart_rngbuf_dev_t *p_dev = (am_uart_rngbuf_dev_t *)handle;
+    am_rngbuf_t            rb    = &(p_dev->rx_rngbuf);
+
+    int out;
+    int key;
+
+    if (nbytes > am_rngbuf_nbytes(rb)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    /* λ __uart_rngbuf_rx_overrun_fix() ¶λ */
+    if (p_dev->rx_overrun == AM_FALSE) {
+        out     = rb->out + nbytes;
+        rb->out = (out >= rb->size) ? out - rb->size : out;
+    }
+
+    am_int_cpu_unlock(key);
+
+    __uart_rngbuf_rx_flow_on(p_dev);
+
+    return AM_OK;
+}
+
 /******************************************************************************/
 /**
  * \brief UART rx trigger cfg
@@ -426,8 +725,11 @@ am_uart_rngbuf_handle_t am_uart_rngbuf_init (am_uart_rngbuf_dev_t *p_dev,
     p_dev->xoff_threshold = rxbuf_size * 20 / 100;
     
     am_wait_init(&p_dev->rx_wait);
+    am_wait_init(&p_dev->tx_wait);
     
     p_dev->timeout_ms               = (uint32_t)AM_WAIT_FOREVER;  /* ĬϳʱʱΪ0һֱȴ */
+    p_dev->tx_timeout_ms            = (uint32_t)AM_WAIT_FOREVER;
+    p_dev->nonblock                 = AM_FALSE;
     
     p_dev->rx_trigger_enable        = AM_FALSE;
     p_dev->rx_trigger_threshold     = 0;
@@ -437,6 +739,9 @@ am_uart_rngbuf_handle_t am_uart_rngbuf_init (am_uart_rngbuf_dev_t *p_dev,
     p_dev->tx_trigger_threshold     = 0;
     p_dev->pfn_tx_callback          = NULL;
     p_dev->p_tx_arg                 = NULL;
+    p_dev->rx_dma                   = AM_FALSE;
+    p_dev->rx_overrun               = AM_FALSE;
+    p_dev->rx_lost                  = 0;
 	
     /* Initialize the ring-buffer */
     am_rngbuf_init(&(p_dev->rx_rngbuf), (char *)p_rxbuf, rxbuf_size);
@@ -449,6 +754,12 @@ am_uart_rngbuf_handle_t am_uart_rngbuf_init (am_uart_rngbuf_dev_t *p_dev,
                          __uart_rngbuf_txchar_get,
                          (void *)(p_dev));
 
+    /* ֧ʱ -AM_ENOTSUPʹֽڵĻص */
+    am_uart_callback_set(handle,
+                         AM_UART_CALLBACK_TXCHARS_GET,
+                         __uart_rngbuf_txchars_get,
+                         (void *)(p_dev));
+
     am_uart_callback_set(handle,
                          AM_UART_CALLBACK_RXCHAR_PUT,
                          __uart_rngbuf_rxchar_put,
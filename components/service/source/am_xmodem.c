@@ -16,6 +16,9 @@
  *
  * \internal
  * \par Modification History
+ * - 1.01 26-10-16  ljy, re-init the CRC pattern before every frame, since
+ *                   am_crc_final() clears it; reset the TX frame number in
+ *                   am_xmodem_tx_init().
  * - 1.00 18-8-31 , xgg, first implementation.
  * \endinternal
  */
@@ -105,6 +108,8 @@ am_local int __xmodem_data_check(am_xmodem_rec_dev_t *p_dev)
     uint16_t  tcrc;
     if (p_dev->p_rec_devinfo->parity_mode == AM_XMODEM_CRC_MODE)
     {
+        /* am_crc_final()  CRC ģͱÿ֡ǰ */
+        am_crc_init(p_dev->crc_handle, &p_dev->crc_pattern);
         am_crc_cal(p_dev->crc_handle,
                    (uint8_t *)p_dev->p_rec_devinfo->frames_info,
                    p_dev->p_rec_devinfo->frames_bytes);
@@ -772,7 +777,8 @@ am_local uint16_t __xmodem_tx_crc_set (am_xmodem_tx_dev_t *p_dev,
     uint32_t crc         = 0;
     uint32_t ctrlz_count = 0;
 
-    //׼CRC
+    //׼CRC㣬am_crc_final()  CRC ģͱÿμǰ
+    am_crc_init(p_dev->crc_handle, &p_dev->crc_pattern);
     am_crc_cal(p_dev->crc_handle,
                (uint8_t *)ptr,
                p_dev->doc_bytes);
@@ -1119,6 +1125,7 @@ am_xmodem_tx_handle_t  am_xmodem_tx_init (
     p_dev->p_tx_buf     = NULL; /**< \brief ʼļָ */
     p_dev->state_flag   = 0;    /**< \brief ĬϵһյַΪģʽжַ */
     p_dev->nake_state   = 0;    /**< \brief ʼط״̬Ϊ0*/
+    p_dev->frames_num   = 0;    /**< \brief ͵һ֡ǰ1кŴ1ʼ*/
     p_dev->p_tx_func    = NULL; /**< \brief ʼ״ָ̬ */
     p_dev->crc_handle   = crc_handle;   /**< \brief CRC*/
     p_dev->uart_handle  = uart_handle;  /**< \brief ھ*/
@@ -0,0 +1,221 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief 첽ϢĴڿ̨
+ *
+ *     am_debug_init() װԲѯʽַam_kprintf() Ҫȵ
+ * ַƳŷأ115200bps һϢҪ롣
+ *
+ *     ģ齫ַ'\n' תΪ "\r\n"Ƶλأɴ
+ * жں̨ȡ͡ʱĴʽݡȴɵ
+ * ݣáӲ쳣ʱ쳣е
+ * am_koutput_async_flush() Բѯʽͻʣַ
+ *
+ * \par 
+ * \code
+ * #include "am_koutput_async.h"
+ *
+ * static char                __g_kout_buf[1024];   // СΪ 2^n
+ * static am_koutput_async_t  __g_kout;
+ *
+ * am_uart_ioctl(uart_handle, AM_UART_BAUD_SET, (void *)115200);
+ * am_koutput_async_init(&__g_kout,
+ *                       uart_handle,
+ *                       __g_kout_buf,
+ *                       sizeof(__g_kout_buf),
+ *                       AM_KOUTPUT_ASYNC_DROP);
+ *
+ * am_kprintf("tick %d\n", tick);                     // ٵȴ
+ *
+ * void HardFault_Handler (void)
+ * {
+ *     am_kprintf("hard fault\n");
+ *     am_koutput_async_flush(&__g_kout);
+ *     while (1);
+ * }
+ * \endcode
+ *
+ * \internal
+ * \par modification history:
+ * - 1.01 26-10-16  ljy, start TX only when it is idle
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_KOUTPUT_ASYNC_H
+#define __AM_KOUTPUT_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "am_common.h"
+#include "am_uart.h"
+
+/**
+ * \name am_koutput_async
+ * @{
+ */
+
+/**
+ * \name ʱĴʽ
+ * @{
+ */
+
+/** \brief ַĬϣᱻ */
+#define AM_KOUTPUT_ASYNC_DROP        0
+
+/**
+ * \brief ȴппռ
+ *
+ * Բѯʽͻɵַڳռ䣬жлرжʱ
+ * Ҳ˳򱣳ֲ䡣
+ */
+#define AM_KOUTPUT_ASYNC_BLOCK       1
+
+/** \brief ǻɵַµϢ */
+#define AM_KOUTPUT_ASYNC_OVERWRITE   2
+
+/** @} */
+
+/**
+ * \brief 첽Ϣ豸ӦóӦֱӲṹԱ
+ */
+typedef struct am_koutput_async {
+
+    /** \brief ڱ׼ */
+    am_uart_handle_t   handle;
+
+    /** \brief  */
+    char              *p_buf;
+
+    /** \brief ±룬С - 1 */
+    uint32_t           mask;
+
+    /** \brief дַ */
+    volatile uint32_t  head;
+
+    /** \brief ȡ͵ַ */
+    volatile uint32_t  tail;
+
+    /** \brief ڷδȡջ */
+    volatile am_bool_t tx_active;
+
+    /** \brief ʱĴʽ */
+    int                policy;
+
+    /** \brief 򸲸ǵַ */
+    uint32_t           lost;
+
+    /** \brief ʹʷֵ */
+    uint32_t           used_max;
+} am_koutput_async_t;
+
+/**
+ * \brief 첽ϢͳϢ
+ */
+struct am_koutput_async_stat {
+    uint32_t  size;         /**< \brief С                 */
+    uint32_t  used;         /**< \brief д͵ַ     */
+    uint32_t  used_max;     /**< \brief ʹʷֵ   */
+    uint32_t  lost;         /**< \brief 򸲸ǵַ       */
+};
+
+/**
+ * \brief ʼ첽ϢΪ am_kprintf() 
+ *
+ * ڱΪжģʽ÷ͻصڵĲʵȲӦá
+ *
+ * \param[in] p_dev  : ָ첽Ϣ豸
+ * \param[in] handle : ڱ׼
+ * \param[in] p_buf  : 
+ * \param[in] size   : СΪ 2^n
+ * \param[in] policy : ʱĴʽAM_KOUTPUT_ASYNC_*
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_koutput_async_init (am_koutput_async_t *p_dev,
+                           am_uart_handle_t    handle,
+                           char               *p_buf,
+                           size_t              size,
+                           int                 policy);
+
+/**
+ * \brief ûʱĴʽ
+ *
+ * \param[in] p_dev  : ָ첽Ϣ豸
+ * \param[in] policy : ʱĴʽAM_KOUTPUT_ASYNC_*
+ *
+ * \retval  AM_OK     : óɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_koutput_async_policy_set (am_koutput_async_t *p_dev, int policy);
+
+/**
+ * \brief һַ'\n' תΪ "\r\n"
+ *
+ * \param[in] c   : ַ
+ * \param[in] fil : ָ첽Ϣ豸
+ *
+ * \return ַ 1ַʱҲ 1
+ *
+ * \note же
+ */
+int am_koutput_async_putc (const char c, void *fil);
+
+/**
+ * \brief һַ'\n' תΪ "\r\n"
+ *
+ * \param[in] s   : ַ
+ * \param[in] fil : ָ첽Ϣ豸
+ *
+ * \return ַĳ
+ *
+ * \note же
+ */
+int am_koutput_async_puts (const char *s, void *fil);
+
+/**
+ * \brief Բѯʽͻʣַʱַд봮
+ *
+ * ڴжϣڹرжϺ쳣лλǰá
+ *
+ * \param[in] p_dev : ָ첽Ϣ豸
+ *
+ * \return 
+ */
+void am_koutput_async_flush (am_koutput_async_t *p_dev);
+
+/**
+ * \brief ȡͳϢ
+ *
+ * \param[in]  p_dev  : ָ첽Ϣ豸
+ * \param[out] p_stat : ڻȡͳϢ
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_koutput_async_stat_get (am_koutput_async_t           *p_dev,
+                               struct am_koutput_async_stat *p_stat);
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_KOUTPUT_ASYNC_H */
+
+/* end of file */
@@ -0,0 +1,275 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ΢׼Կʵ
+ *
+ * \internal
+ * \par modification history:
+ * - 1.01 26-10-16  ljy, add am_bench_counter_get()/am_bench_counter_hz_get()
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "am_bench.h"
+#include "am_vdebug.h"
+#include <string.h>
+
+/*******************************************************************************
+  Local variables
+*******************************************************************************/
+
+/** \brief ״̬ */
+static struct {
+    uint32_t                 (*pfn_counter) (void);
+    uint32_t                   counter_hz;
+    uint32_t                   min_counts;
+    unsigned int               repeat;
+    const am_bench_baseline_t *p_baseline;
+    size_t                     baseline_num;
+    unsigned int               threshold_pct;
+} __g_bench;
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/* ִһβؼֵ */
+static uint32_t __bench_measure (const am_bench_case_t *p_case, uint32_t nops)
+{
+    uint32_t start;
+
+    start = __g_bench.pfn_counter();
+    p_case->pfn_run(p_case->p_arg, p_case->size, nops);
+    return __g_bench.pfn_counter() - start;
+}
+
+/* һ׼߼¼ */
+static const am_bench_baseline_t *__baseline_find (const am_bench_case_t *p_case)
+{
+    size_t i;
+
+    for (i = 0; i < __g_bench.baseline_num; i++) {
+        if ((__g_bench.p_baseline[i].size == p_case->size) &&
+            (strcmp(__g_bench.p_baseline[i].p_name, p_case->p_name) == 0)) {
+            return &__g_bench.p_baseline[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* ӡ x100  */
+static void __fixed_x100_print (uint32_t val)
+{
+    am_kprintf("%lu.%02lu", (unsigned long)(val / 100), (unsigned long)(val % 100));
+}
+
+/* ӡ 64 λ޷am_kprintf() ֧ 64 λ */
+static void __u64_print (uint64_t val)
+{
+    if (val >= 1000000000u) {
+        __u64_print(val / 1000000000u);
+        am_kprintf("%09lu", (unsigned long)(val % 1000000000u));
+    } else {
+        am_kprintf("%lu", (unsigned long)val);
+    }
+}
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+int am_bench_init (uint32_t (*pfn_counter) (void), uint32_t counter_hz)
+{
+    if ((pfn_counter == NULL) || (counter_hz == 0)) {
+        return -AM_EINVAL;
+    }
+
+    __g_bench.pfn_counter = pfn_counter;
+    __g_bench.counter_hz  = counter_hz;
+    __g_bench.p_baseline  = NULL;
+
+    am_bench_config(0, 0);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_bench_config (unsigned int repeat, unsigned int min_time_ms)
+{
+    if (repeat == 0) {
+        repeat = AM_BENCH_REPEAT_DEF;
+    }
+    if (min_time_ms == 0) {
+        min_time_ms = AM_BENCH_MIN_TIME_MS_DEF;
+    }
+
+    __g_bench.repeat     = repeat;
+    __g_bench.min_counts = (uint32_t)((uint64_t)__g_bench.counter_hz *
+                                      min_time_ms / 1000);
+    if (__g_bench.min_counts == 0) {
+        __g_bench.min_counts = 1;
+    }
+}
+
+/******************************************************************************/
+void am_bench_baseline_set (const am_bench_baseline_t *p_baseline,
+                            size_t                     num,
+                            unsigned int               threshold_pct)
+{
+    __g_bench.p_baseline    = p_baseline;
+    __g_bench.baseline_num  = (p_baseline != NULL) ? num : 0;
+    __g_bench.threshold_pct = threshold_pct;
+}
+
+/******************************************************************************/
+uint32_t am_bench_counter_get (void)
+{
+    return (__g_bench.pfn_counter != NULL) ? __g_bench.pfn_counter() : 0;
+}
+
+/******************************************************************************/
+uint32_t am_bench_counter_hz_get (void)
+{
+    return (__g_bench.pfn_counter != NULL) ? __g_bench.counter_hz : 0;
+}
+
+/******************************************************************************/
+int am_bench_run (const am_bench_case_t *p_case, am_bench_result_t *p_result)
+{
+    uint32_t     nops = 1;
+    uint32_t     counts;
+    uint32_t     min;
+    unsigned int i;
+    int          ret;
+
+    if ((p_case == NULL) || (p_case->pfn_run == NULL) || (p_result == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    if (__g_bench.pfn_counter == NULL) {
+        return -AM_EPERM;
+    }
+
+    if (p_case->pfn_setup != NULL) {
+        ret = p_case->pfn_setup(p_case->p_arg, p_case->size);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    /* ȷͬʱԤȻ */
+    while (((counts = __bench_measure(p_case, nops)) < __g_bench.min_counts) &&
+           (nops < AM_BENCH_OPS_MAX)) {
+        nops <<= 1;
+    }
+
+    min = counts;
+    for (i = 0; i < __g_bench.repeat; i++) {
+        counts = __bench_measure(p_case, nops);
+        if (counts < min) {
+            min = counts;
+        }
+    }
+
+    if (p_case->pfn_teardown != NULL) {
+        p_case->pfn_teardown(p_case->p_arg);
+    }
+
+    p_result->ops                = nops;
+    p_result->counts             = min;
+    p_result->counts_per_op_x100 = (uint32_t)((uint64_t)min * 100 / nops);
+
+    if ((p_case->bytes_per_op == 0) || (min == 0)) {
+        p_result->bytes_per_sec = 0;
+    } else {
+        p_result->bytes_per_sec = (uint64_t)p_case->bytes_per_op * nops *
+                                  __g_bench.counter_hz / min;
+    }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_bench_header_print (void)
+{
+    am_kprintf("# am_bench counter_hz=%lu\n",
+               (unsigned long)__g_bench.counter_hz);
+    am_kprintf("name,size,ops,counts_per_op,bytes_per_sec,"
+               "baseline,delta_pct,status\n");
+}
+
+/******************************************************************************/
+int am_bench_run_all (const am_bench_case_t *p_cases,
+                      size_t                 num,
+                      const char            *p_filter)
+{
+    const am_bench_baseline_t *p_base;
+    am_bench_result_t          result;
+    int32_t                    delta;       /* 仯λ 0.1% */
+    int                        nregress = 0;
+    size_t                     i;
+    int                        ret;
+
+    if (__g_bench.pfn_counter == NULL) {
+        return -AM_EPERM;
+    }
+
+    for (i = 0; i < num; i++) {
+
+        if ((p_filter != NULL) &&
+            (strncmp(p_cases[i].p_name, p_filter, strlen(p_filter)) != 0)) {
+            continue;
+        }
+
+        am_kprintf("%s,%lu,", p_cases[i].p_name, (unsigned long)p_cases[i].size);
+
+        ret = am_bench_run(&p_cases[i], &result);
+        if (ret != AM_OK) {
+            am_kprintf(",,,,,skipped(%d)\n", ret);
+            continue;
+        }
+
+        am_kprintf("%lu,", (unsigned long)result.ops);
+        __fixed_x100_print(result.counts_per_op_x100);
+        am_kprintf(",");
+        __u64_print(result.bytes_per_sec);
+        am_kprintf(",");
+
+        p_base = __baseline_find(&p_cases[i]);
+        if ((p_base == NULL) || (p_base->counts_per_op_x100 == 0)) {
+            am_kprintf(",,%s\n", (__g_bench.p_baseline != NULL) ? "new" : "");
+            continue;
+        }
+
+        delta = (int32_t)(((int64_t)result.counts_per_op_x100 -
+                           (int64_t)p_base->counts_per_op_x100) * 1000 /
+                           (int64_t)p_base->counts_per_op_x100);
+
+        __fixed_x100_print(p_base->counts_per_op_x100);
+        am_kprintf(",%c%ld.%ld,", (delta < 0) ? '-' : '+',
+                   (long)(((delta < 0) ? -delta : delta) / 10),
+                   (long)(((delta < 0) ? -delta : delta) % 10));
+
+        if (delta > (int32_t)__g_bench.threshold_pct * 10) {
+            am_kprintf("REGRESSION\n");
+            nregress++;
+        } else {
+            am_kprintf("ok\n");
+        }
+    }
+
+    return nregress;
+}
+
+/* end of file */
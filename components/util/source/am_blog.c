@@ -0,0 +1,269 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ӳ־ʵ
+ *
+ * д뷽жѭ͸жϣдһ¼ʱݹرжϣʹ¼
+ * Ϊһд룻ֻһ DMAλʹ SPSC
+ * ʱرжϡ
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "am_blog.h"
+#include "am_rngbuf_spsc.h"
+#include "am_int.h"
+#include <string.h>
+
+/*******************************************************************************
+  Local defines
+*******************************************************************************/
+
+#define __BLOG_HDR_MAGIC     0xA0    /* ¼ͷĸ 4 λ         */
+#define __BLOG_HDR_TS        0x08    /* ¼ʱ            */
+#define __BLOG_HDR_LOST      0x07    /* ʧ¼                */
+
+/*******************************************************************************
+  Local variables
+*******************************************************************************/
+
+static struct am_rngbuf_spsc  __g_blog_rb;
+static am_bool_t              __g_blog_init = AM_FALSE;
+static am_blog_write_t        __g_blog_pfn_write;
+static void                  *__g_blog_p_arg;
+static uint32_t             (*__g_blog_pfn_timestamp) (void);
+static am_jobq_handle_t       __g_blog_jobq;
+static am_jobq_job_t          __g_blog_job;
+static struct am_blog_stat    __g_blog_stat;
+
+/* δĶʧ¼ */
+static uint32_t               __g_blog_lost_pending;
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/* Сд 32 λ */
+static uint8_t *__blog_put32 (uint8_t *p, uint32_t val)
+{
+    p[0] = (uint8_t)val;
+    p[1] = (uint8_t)(val >> 8);
+    p[2] = (uint8_t)(val >> 16);
+    p[3] = (uint8_t)(val >> 24);
+
+    return p + 4;
+}
+
+/*  */
+static void __blog_job (void *p_arg)
+{
+    (void)p_arg;
+
+    (void)am_blog_process();
+}
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+int am_blog_init (char           *p_buf,
+                  size_t          size,
+                  am_blog_write_t pfn_write,
+                  void           *p_arg)
+{
+    int ret;
+
+    if (size < AM_BLOG_RECORD_MAX) {
+        return -AM_EINVAL;
+    }
+
+    ret = am_rngbuf_spsc_init(&__g_blog_rb, p_buf, size);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    __g_blog_pfn_write    = pfn_write;
+    __g_blog_p_arg        = p_arg;
+    __g_blog_lost_pending = 0;
+
+    memset(&__g_blog_stat, 0, sizeof(__g_blog_stat));
+
+    __g_blog_init = AM_TRUE;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_blog_timestamp_set (uint32_t (*pfn_timestamp) (void))
+{
+    __g_blog_pfn_timestamp = pfn_timestamp;
+}
+
+/******************************************************************************/
+void am_blog_jobq_set (am_jobq_handle_t handle, uint16_t pri)
+{
+    am_jobq_job_init(&__g_blog_job, __blog_job, NULL, pri);
+
+    __g_blog_jobq = handle;
+}
+
+/******************************************************************************/
+int am_blog_write (const char *p_fmt, uint32_t nargs, const uint32_t *p_args)
+{
+    uint8_t   record[AM_BLOG_RECORD_MAX];
+    uint8_t  *p = record;
+    uint32_t  i;
+    uint32_t  used;
+    int       key;
+
+    if (!__g_blog_init) {
+        return -AM_EPERM;
+    }
+
+    if ((nargs > AM_BLOG_ARGS_MAX) || ((nargs != 0) && (p_args == NULL))) {
+        return -AM_EINVAL;
+    }
+
+    /* ڹرж֮ǰ֯ü¼ʱ⣩ */
+    *p++ = (uint8_t)(__BLOG_HDR_MAGIC | nargs);
+    if (__g_blog_pfn_timestamp != NULL) {
+        record[0] |= __BLOG_HDR_TS;
+        p += 4;
+    }
+    p = __blog_put32(p, (uint32_t)(uintptr_t)p_fmt);
+    for (i = 0; i < nargs; i++) {
+        p = __blog_put32(p, p_args[i]);
+    }
+
+    key = am_int_cpu_lock();
+
+    /* ȱ֮ǰʧļ¼ */
+    if (__g_blog_lost_pending != 0) {
+        uint8_t lost[5];
+
+        if (am_rngbuf_spsc_freebytes(&__g_blog_rb) < sizeof(lost) + (p - record)) {
+            __g_blog_lost_pending++;
+            __g_blog_stat.lost++;
+            am_int_cpu_unlock(key);
+            return -AM_EFULL;
+        }
+
+        lost[0] = __BLOG_HDR_MAGIC | __BLOG_HDR_LOST;
+        (void)__blog_put32(&lost[1], __g_blog_lost_pending);
+        (void)am_rngbuf_spsc_put(&__g_blog_rb, (const char *)lost, sizeof(lost));
+
+        __g_blog_lost_pending = 0;
+    }
+
+    if (am_rngbuf_spsc_freebytes(&__g_blog_rb) < (size_t)(p - record)) {
+        __g_blog_lost_pending++;
+        __g_blog_stat.lost++;
+        am_int_cpu_unlock(key);
+        return -AM_EFULL;
+    }
+
+    /* ʱٽڶȡ֤¼ʱ˳ */
+    if (record[0] & __BLOG_HDR_TS) {
+        (void)__blog_put32(&record[1], __g_blog_pfn_timestamp());
+    }
+
+    (void)am_rngbuf_spsc_put(&__g_blog_rb, (const char *)record, p - record);
+
+    __g_blog_stat.records++;
+
+    used = am_rngbuf_spsc_nbytes(&__g_blog_rb);
+    if (used > __g_blog_stat.used_max) {
+        __g_blog_stat.used_max = used;
+    }
+
+    am_int_cpu_unlock(key);
+
+    if (__g_blog_jobq != NULL) {
+        (void)am_jobq_post(__g_blog_jobq, &__g_blog_job);
+    }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+size_t am_blog_process (void)
+{
+    const char *p_data;
+    size_t      len;
+    size_t      n;
+    size_t      total = 0;
+
+    if (!__g_blog_init || (__g_blog_pfn_write == NULL)) {
+        return 0;
+    }
+
+    while (am_blog_peek(&p_data, &len) == AM_OK) {
+
+        n = __g_blog_pfn_write(__g_blog_p_arg, p_data, len);
+
+        am_blog_consume(n);
+
+        total += n;
+
+        if (n < len) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+/******************************************************************************/
+int am_blog_peek (const char **pp_data, size_t *p_len)
+{
+    char *p_data;
+    int   ret;
+
+    if (!__g_blog_init) {
+        return -AM_EEMPTY;
+    }
+
+    ret = am_rngbuf_spsc_peek_read(&__g_blog_rb, &p_data, p_len);
+    if (ret == AM_OK) {
+        *pp_data = p_data;
+    }
+
+    return ret;
+}
+
+/******************************************************************************/
+void am_blog_consume (size_t len)
+{
+    if (__g_blog_init) {
+        am_rngbuf_spsc_consume(&__g_blog_rb, len);
+    }
+}
+
+/******************************************************************************/
+void am_blog_stat_get (struct am_blog_stat *p_stat)
+{
+    int key;
+
+    if (p_stat == NULL) {
+        return;
+    }
+
+    key = am_int_cpu_lock();
+    *p_stat = __g_blog_stat;
+    am_int_cpu_unlock(key);
+}
+
+/* end of file */
@@ -0,0 +1,149 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ¼ʵ
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "am_evgroup.h"
+#include "am_int.h"
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/* 鲢ȡ¼λʱжѹر */
+static am_bool_t __evgroup_take (am_wait_src_t *p_src, am_bool_t take)
+{
+    am_evgroup_t *p_evgroup = (am_evgroup_t *)p_src->p_obj;
+    uint32_t      bits      = p_evgroup->bits & p_src->arg;
+    am_bool_t     ready;
+
+    if (p_src->opt & AM_EVGROUP_WAIT_ALL) {
+        ready = (am_bool_t)(bits == p_src->arg);
+    } else {
+        ready = (am_bool_t)(bits != 0);
+    }
+
+    if (ready && take) {
+        p_src->val = bits;
+        if (p_src->opt & AM_EVGROUP_CLEAR) {
+            p_evgroup->bits &= ~bits;
+        }
+    }
+
+    return ready;
+}
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+int am_evgroup_init (am_evgroup_t *p_evgroup, uint32_t bits)
+{
+    if (p_evgroup == NULL) {
+        return -AM_EINVAL;
+    }
+
+    p_evgroup->bits = bits;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+uint32_t am_evgroup_set (am_evgroup_t *p_evgroup, uint32_t bits)
+{
+    uint32_t old;
+    int      key;
+
+    key = am_int_cpu_lock();
+    old = p_evgroup->bits;
+    p_evgroup->bits = old | bits;
+    am_int_cpu_unlock(key);
+
+    am_wait_wake();
+
+    return old;
+}
+
+/******************************************************************************/
+uint32_t am_evgroup_clear (am_evgroup_t *p_evgroup, uint32_t bits)
+{
+    uint32_t old;
+    int      key;
+
+    key = am_int_cpu_lock();
+    old = p_evgroup->bits;
+    p_evgroup->bits = old & ~bits;
+    am_int_cpu_unlock(key);
+
+    return old;
+}
+
+/******************************************************************************/
+uint32_t am_evgroup_get (am_evgroup_t *p_evgroup)
+{
+    return p_evgroup->bits;
+}
+
+/******************************************************************************/
+int am_evgroup_src_init (am_wait_src_t *p_src,
+                         am_evgroup_t  *p_evgroup,
+                         uint32_t       bits,
+                         uint32_t       opt)
+{
+    if ((p_src == NULL) || (p_evgroup == NULL) || (bits == 0)) {
+        return -AM_EINVAL;
+    }
+
+    p_src->pfn_take = __evgroup_take;
+    p_src->p_obj    = p_evgroup;
+    p_src->arg      = bits;
+    p_src->opt      = opt;
+    p_src->val      = 0;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_evgroup_wait (am_evgroup_t *p_evgroup,
+                     uint32_t      bits,
+                     uint32_t      opt,
+                     uint32_t      timeout_ms,
+                     uint32_t     *p_bits)
+{
+    am_wait_src_t src;
+    int           ret;
+
+    ret = am_evgroup_src_init(&src, p_evgroup, bits, opt);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    ret = am_wait_any(&src, 1, timeout_ms);
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (p_bits != NULL) {
+        *p_bits = src.val;
+    }
+
+    return AM_OK;
+}
+
+/* end of file */
@@ -26,6 +26,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, am_isr_defer_job_add() returns the result of posting
  * - 1.00 15-09-23  tee, first implementation
  * \endinternal
  */
@@ -68,17 +69,20 @@ void am_isr_defer_job_init (am_isr_defer_job_t  *p_job,
 /******************************************************************************/
 int am_isr_defer_job_add (am_isr_defer_job_t *p_job)
 {
+    int ret;
+
     if (__g_isr_defer_handle == NULL) {
         return -AM_EPERM;
     }
     
-    am_jobq_post(__g_isr_defer_handle, p_job);
- 
-    if (__gpfn_trigger_cb) {
+    ret = am_jobq_post(__g_isr_defer_handle, p_job);
+
+    /* ڶʱ֮ǰʱѾ */
+    if ((ret == AM_OK) && __gpfn_trigger_cb) {
         __gpfn_trigger_cb(__gp_cb_arg);
     }
  
-    return AM_OK;
+    return ret;
 }
 
 /******************************************************************************/
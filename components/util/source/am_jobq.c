@@ -21,6 +21,11 @@
  *
  * \internal
  * \par modification history:
+ * - 1.03 26-10-16  ljy, do not touch the job after its handler has run unless
+ *                        AM_JOBQ_JOB_RUN_TIME is defined
+ * - 1.02 26-10-16  ljy, deadline (EDF) jobs, time budget and job run time
+ * - 1.01 26-10-16  ljy, CLZ based priority search, three level bitmap and
+ *                        statistics
  * - 1.00 15-09-18  tee, first implementation
  * \endinternal
  */
@@ -36,27 +41,37 @@
 /* ־ѱ                        */
 #define __JOBQ_JOB_ENQUEUED      0x100
 
+/* ־λڽֹʱ                  */
+#define __JOBQ_JOB_DEADLINE      0x200
+
 /* ־ǰڴ                   */
 #define __JOBQ_FLG_RUNNING   0x01
 
-/** \brief λȼеӦλ  */
-#define __JOBQ_BITMAP_GRP_SET(bitmap_grp, pri) \
-               bitmap_grp |= (1 << ((pri) >> 5))
+/* ȼĿλͼ32 * 32 * 32 */
+#define __JOBQ_PRI_NUM_MAX       (32 * 32 * 32)
+
+/******************************************************************************/
+
+/*
+ * úȡһ޷λ1λã 0x01 λΪ 1
+ *
+ * Cortex-M3 ںʹ RBIT + CLZ ָCortex-M0 ûָʹò
+ */
+#if defined(__GNUC__) && !defined(AM_CORTEX_M0)
 
-/** \brief ȼеӦλ  */
-#define __JOBQ_BITMAP_GRP_CLR(bitmap_grp, pri) \
-               bitmap_grp &= ~(1 << ((pri) >> 5))
-               
-/** \brief λȼӦλ  */
-#define __JOBQ_BITMAP_JOB_SET(bitmap_job, pri) \
-               bitmap_job[(pri) >> 5] |= (1 << ((pri) & 0x1F))
+int __jobq_ffs (unsigned int x)
+{
+    return __builtin_ctz(x) + 1;
+}
 
-/** \brief ȼӦλ  */
-#define __JOBQ_BITMAP_JOB_CLR(bitmap_job, pri) \
-               bitmap_job[(pri) >> 5] &= ~(1 << ((pri) & 0x1F))
+#elif defined(__CC_ARM) && !defined(AM_CORTEX_M0)
 
+int __jobq_ffs (unsigned int x)
+{
+    return __clz(__rbit(x)) + 1;
+}
 
-/******************************************************************************/
+#else
 
 static const unsigned char __ffs8_table[256] = {
     0, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
@@ -77,9 +92,6 @@ static const unsigned char __ffs8_table[256] = {
     5, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1,
 };
 
-/* 
- * úȡһ޷λ1λã 0x01 λΪ 1
- */
 int __jobq_ffs (unsigned int x )
 {
     int pos = 0;  /* ¼λΪ1λãʼΪ0  */
@@ -99,22 +111,87 @@ int __jobq_ffs (unsigned int x )
     return pos;
 }
 
+#endif
+
+/*
+ * λͼṹ
+ *   - ȼĿ 1024bitmap_grp ÿһλӦ p_bitmap_job 
+ *     һ֣p_bitmap_mid Ϊ NULL
+ *   - bitmap_grp ÿһλӦ p_bitmap_mid еһ֣p_bitmap_mid 
+ *     ÿһλӦ p_bitmap_job еһ֡
+ */
+
+/* λȼӦλ */
+static void __jobq_bitmap_set (am_jobq_queue_t *p_jobq_queue, unsigned int pri)
+{
+    unsigned int idx = pri >> 5;
+
+    p_jobq_queue->p_bitmap_job[idx] |= 1u << (pri & 0x1F);
+
+    if (p_jobq_queue->p_bitmap_mid != NULL) {
+        p_jobq_queue->p_bitmap_mid[idx >> 5] |= 1u << (idx & 0x1F);
+        idx >>= 5;
+    }
+
+    p_jobq_queue->bitmap_grp |= 1u << idx;
+}
+
+/* ȼӦλ */
+static void __jobq_bitmap_clr (am_jobq_queue_t *p_jobq_queue, unsigned int pri)
+{
+    unsigned int idx = pri >> 5;
+
+    p_jobq_queue->p_bitmap_job[idx] &= ~(1u << (pri & 0x1F));
+
+    /* Ѿû */
+    if (p_jobq_queue->p_bitmap_job[idx] != 0) {
+        return;
+    }
+
+    if (p_jobq_queue->p_bitmap_mid != NULL) {
+        p_jobq_queue->p_bitmap_mid[idx >> 5] &= ~(1u << (idx & 0x1F));
+        if (p_jobq_queue->p_bitmap_mid[idx >> 5] != 0) {
+            return;
+        }
+        idx >>= 5;
+    }
+
+    p_jobq_queue->bitmap_grp &= ~(1u << idx);
+}
+
+/* ȡȼֵСbitmap_grp Ϊ 0 */
+static unsigned int __jobq_bitmap_first (am_jobq_queue_t *p_jobq_queue)
+{
+    unsigned int idx;
+
+    /* ҵȼߵ     */
+    idx = __jobq_ffs(p_jobq_queue->bitmap_grp) - 1;
+
+    if (p_jobq_queue->p_bitmap_mid != NULL) {
+        idx = __jobq_ffs(p_jobq_queue->p_bitmap_mid[idx]) - 1 + (idx << 5);
+    }
+
+    /* ҵȼߵеȼ */
+    return __jobq_ffs(p_jobq_queue->p_bitmap_job[idx]) - 1 + (idx << 5);
+}
+
 /******************************************************************************/
 am_jobq_handle_t am_jobq_queue_init (am_jobq_queue_t     *p_jobq_queue,
                                      unsigned int         pri_num,
                                      struct am_list_head *p_heads,
                                      unsigned int        *p_bitmap_job)
 {
-    int i;
-    int key;
+    unsigned int i;
+    int          key;
 
-    uint8_t grp_num;
+    unsigned int grp_num;
     
-    if ((p_jobq_queue == NULL) || (p_heads == NULL) || (p_bitmap_job == NULL)) {
+    if ((p_jobq_queue == NULL) || (p_heads == NULL) || (p_bitmap_job == NULL) ||
+        (pri_num == 0) || (pri_num > __JOBQ_PRI_NUM_MAX)) {
         return NULL;
     }
 
-    grp_num = (pri_num + 31) >> 5;
+    grp_num = AM_JOBQ_BITMAP_SIZE(pri_num);
     
     for (i = 0; i < grp_num; i++) {
         p_bitmap_job[i] = 0;
@@ -127,10 +204,23 @@ am_jobq_handle_t am_jobq_queue_init (am_jobq_queue_t     *p_jobq_queue,
     
     key = am_int_cpu_lock();
 
-    p_jobq_queue->bitmap_grp   = 0;
-    p_jobq_queue->p_heads      = p_heads;
-    p_jobq_queue->pri_num      = pri_num;
-    p_jobq_queue->p_bitmap_job = p_bitmap_job;
+    p_jobq_queue->bitmap_grp    = 0;
+    p_jobq_queue->p_heads       = p_heads;
+    p_jobq_queue->pri_num       = pri_num;
+    p_jobq_queue->p_bitmap_job  = p_bitmap_job;
+    p_jobq_queue->flags         = 0;
+    p_jobq_queue->pfn_timestamp = NULL;
+
+    /*  1024 ȼʱʹλͼм伶λҶӼ֮ */
+    if (pri_num > 32 * 32) {
+        p_jobq_queue->p_bitmap_mid = p_bitmap_job + ((pri_num + 31) >> 5);
+    } else {
+        p_jobq_queue->p_bitmap_mid = NULL;
+    }
+
+    am_list_head_init(&p_jobq_queue->edf_head);
+
+    memset(&p_jobq_queue->stat, 0, sizeof(p_jobq_queue->stat));
  
     am_int_cpu_unlock(key);
     
@@ -147,13 +237,40 @@ void am_jobq_job_init (am_jobq_job_t  *p_job,
     p_job->func  = func;
     p_job->p_arg = p_arg;
     p_job->pri   = pri;
-    p_job->flags = 0;
+    p_job->flags        = 0;
+    p_job->time         = 0;
+    p_job->deadline     = 0;
+    p_job->run_count    = 0;
+#ifdef AM_JOBQ_JOB_RUN_TIME
+    p_job->run_time_max = 0;
+#endif
     
     am_list_head_init(&p_job->node);
 }
 
-/******************************************************************************/
-int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
+/* ֹʱȺֹʱУֹʱͬʱȼǰ */
+static void __jobq_edf_insert (am_jobq_queue_t *p_jobq_queue,
+                               am_jobq_job_t   *p_job)
+{
+    struct am_list_head *p_pos;
+    am_jobq_job_t       *p_cur;
+
+    am_list_for_each(p_pos, &p_jobq_queue->edf_head) {
+        p_cur = am_list_entry(p_pos, am_jobq_job_t, node);
+        if ((int32_t)(p_job->deadline - p_cur->deadline) < 0) {
+            break;
+        }
+    }
+
+    /* 뵽 p_pos ֮ǰp_pos Ϊͷʱ뵽β */
+    am_list_add_tail(&p_job->node, p_pos);
+}
+
+/*  */
+static int __jobq_post (am_jobq_queue_t *p_jobq_queue,
+                        am_jobq_job_t   *p_job,
+                        am_bool_t        use_deadline,
+                        uint32_t         deadline)
 {
     uint32_t pri;
     int      key;
@@ -169,6 +286,22 @@ int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
     
     /* ûڶУŽ */
     if ((pri & (__JOBQ_JOB_ENQUEUED)) == 0) {
+
+        if (p_jobq_queue->pfn_timestamp != NULL) {
+            p_job->time = p_jobq_queue->pfn_timestamp();
+        }
+        p_jobq_queue->stat.posts++;
+
+        if (use_deadline) {
+            p_job->flags    = pri | __JOBQ_JOB_ENQUEUED | __JOBQ_JOB_DEADLINE;
+            p_job->deadline = p_job->time + deadline;
+
+            __jobq_edf_insert(p_jobq_queue, p_job);
+
+            am_int_cpu_unlock(key);
+
+            return AM_OK;
+        }
         
         p_job->flags = pri | __JOBQ_JOB_ENQUEUED;
 
@@ -177,8 +310,7 @@ int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
                            (p_jobq_queue->pri_num - 1) :
                             p_job->pri;
         
-        __JOBQ_BITMAP_GRP_SET(p_jobq_queue->bitmap_grp, pri);
-        __JOBQ_BITMAP_JOB_SET(p_jobq_queue->p_bitmap_job, pri);
+        __jobq_bitmap_set(p_jobq_queue, pri);
         
         /* ȼβ */
         am_list_add_tail(&p_job->node, &p_jobq_queue->p_heads[pri]);
@@ -188,24 +320,105 @@ int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
         return AM_OK;
     }
 
+    p_jobq_queue->stat.busy++;
+
     am_int_cpu_unlock(key);
 
     return -AM_EBUSY;
 }
- 
+
 /******************************************************************************/
-int am_jobq_process (am_jobq_queue_t *p_jobq_queue)
+int am_jobq_post (am_jobq_queue_t *p_jobq_queue, am_jobq_job_t *p_job)
+{
+    return __jobq_post(p_jobq_queue, p_job, AM_FALSE, 0);
+}
+
+/******************************************************************************/
+int am_jobq_post_deadline (am_jobq_queue_t *p_jobq_queue,
+                           am_jobq_job_t   *p_job,
+                           uint32_t         deadline)
+{
+    if ((p_jobq_queue != NULL) && (p_jobq_queue->pfn_timestamp == NULL)) {
+        return -AM_EPERM;
+    }
+
+    return __jobq_post(p_jobq_queue, p_job, AM_TRUE, deadline);
+}
+
+/* ȡһҪִе񣬵ʱжѹرգΪʱ NULL */
+static am_jobq_job_t *__jobq_take (am_jobq_queue_t *p_jobq_queue)
+{
+    struct am_list_head *p_q;
+    am_jobq_job_t       *p_job;
+    unsigned int         pri;
+
+    /* нֹʱȣֹʱȺִ */
+    if (!am_list_empty(&p_jobq_queue->edf_head)) {
+
+        p_job = am_list_entry(p_jobq_queue->edf_head.next, am_jobq_job_t, node);
+
+        am_list_del_init(&p_job->node);
+
+        p_job->flags &= ~(__JOBQ_JOB_ENQUEUED | __JOBQ_JOB_DEADLINE);
+
+        if ((p_jobq_queue->pfn_timestamp != NULL) &&
+            ((int32_t)(p_jobq_queue->pfn_timestamp() - p_job->deadline) > 0)) {
+            p_jobq_queue->stat.deadline_miss++;
+        }
+
+        return p_job;
+    }
+
+    /* κ */
+    if (p_jobq_queue->bitmap_grp == 0) {
+        return NULL;
+    }
+        
+    pri = __jobq_bitmap_first(p_jobq_queue);
+ 
+    /* Remove the job from the appropriate queue */
+    p_q = &p_jobq_queue->p_heads[pri];
+
+    /* ȡһ */
+    p_job = am_list_entry(p_q->next, am_jobq_job_t, node);
+        
+    /* Ӷɾ */
+    am_list_del_init(p_q->next);
+        
+    /* ȼΪգɾӦȼ־λ */
+    if (am_list_empty_careful(p_q)) {
+        __jobq_bitmap_clr(p_jobq_queue, pri);
+    }
+
+    p_job->flags &= ~__JOBQ_JOB_ENQUEUED;
+
+    return p_job;
+}
+
+/* Уuse_budget Ϊ AM_TRUE ʱʱﵽ budget ٿʼµ */
+static int __jobq_process (am_jobq_queue_t *p_jobq_queue,
+                           am_bool_t        use_budget,
+                           uint32_t         budget)
 {
     int             key;
     am_pfnvoid_t    func;
     void           *p_arg;
+    uint32_t        (*pfn_timestamp) (void);
+    uint32_t        start = 0;
+    uint32_t        now   = 0;
+    uint32_t        time;
 
-    struct am_list_head *p_q;
-    am_jobq_job_t       *p_job;
+    am_jobq_job_t  *p_job;
  
     if (p_jobq_queue == NULL) {
         return -AM_EINVAL;
     }
+
+    pfn_timestamp = p_jobq_queue->pfn_timestamp;
+
+    if (use_budget && (pfn_timestamp == NULL)) {
+        return -AM_EPERM;
+    }
     
     /* ڴ */
     if ((p_jobq_queue->flags & __JOBQ_FLG_RUNNING) != 0) {
@@ -218,55 +431,149 @@ int am_jobq_process (am_jobq_queue_t *p_jobq_queue)
 
     am_int_cpu_unlock(key);
 
-    while(1) {
+    if (pfn_timestamp != NULL) {
+        start = pfn_timestamp();
+        now   = start;
+    }
 
-        unsigned int pri;
+    while(1) {
 
         key = am_int_cpu_lock();
-        
-        /* κ */
-        if (p_jobq_queue->bitmap_grp == 0) {
+
+        /* ʱԤ꣬ʣ´δ */
+        if (use_budget && (now - start >= budget) &&
+            ((p_jobq_queue->bitmap_grp != 0) ||
+             !am_list_empty(&p_jobq_queue->edf_head))) {
+            p_jobq_queue->stat.budget_exhausted++;
+            p_jobq_queue->flags &= ~__JOBQ_FLG_RUNNING;
+            am_int_cpu_unlock(key);
+            return -AM_ETIME;
+        }
+
+        p_job = __jobq_take(p_jobq_queue);
+
+        if (p_job == NULL) {
             p_jobq_queue->flags &= ~__JOBQ_FLG_RUNNING;
             am_int_cpu_unlock(key);
             return AM_OK;
         }
-        
-        /* ҵȼߵ     */
-        pri = __jobq_ffs(p_jobq_queue->bitmap_grp) - 1;
- 
-        /* ҵȼߵеȼ */
-        pri = __jobq_ffs(p_jobq_queue->p_bitmap_job[pri]) - 1 + (pri << 5);
- 
-        /* Remove the job from the appropriate queue */
-        p_q = &p_jobq_queue->p_heads[pri];
 
-        /* ȡһ */
-        p_job = am_list_entry(p_q->next, am_jobq_job_t, node);
-        
-        /* Ӷɾ */
-        am_list_del_init(p_q->next);
-        
-        /* ȼΪգɾӦȼ־λ */
-        if (am_list_empty_careful(p_q)) {
-            __JOBQ_BITMAP_JOB_CLR(p_jobq_queue->p_bitmap_job, pri);
-            
-            /* Ѿû */
-            if (p_jobq_queue->p_bitmap_job[pri >> 5] == 0) {
-                __JOBQ_BITMAP_GRP_CLR(p_jobq_queue->bitmap_grp, pri);
+        /* ͳƴӼеʼִеӳ */
+        if (pfn_timestamp != NULL) {
+            time = pfn_timestamp() - p_job->time;
+            if (time > p_jobq_queue->stat.latency_max) {
+                p_jobq_queue->stat.latency_max = time;
             }
         }
-
-        p_job->flags &= ~__JOBQ_JOB_ENQUEUED;
+        p_jobq_queue->stat.runs++;
+        p_job->run_count++;
 
         func  = p_job->func;
         p_arg = p_job->p_arg;
         
         am_int_cpu_unlock(key);
 
+        if (pfn_timestamp == NULL) {
+            if (func) {
+                func(p_arg);
+            }
+            continue;
+        }
+
+        time = pfn_timestamp();
+
         if (func) {
             func(p_arg);
         }
+
+        /*
+         * ͳִʱ䡣пͷŻʹ˸ֻж
+         * AM_JOBQ_JOB_RUN_TIMEҪ񱣳Чʱٷ p_job
+         */
+        now  = pfn_timestamp();
+        time = now - time;
+
+#ifdef AM_JOBQ_JOB_RUN_TIME
+        if (time > p_job->run_time_max) {
+            p_job->run_time_max = time;
+        }
+#endif
+        if (time > p_jobq_queue->stat.run_time_max) {
+            p_jobq_queue->stat.run_time_max = time;
+        }
     }
 }
+ 
+/******************************************************************************/
+int am_jobq_process (am_jobq_queue_t *p_jobq_queue)
+{
+    return __jobq_process(p_jobq_queue, AM_FALSE, 0);
+}
+
+/******************************************************************************/
+int am_jobq_process_budget (am_jobq_queue_t *p_jobq_queue, uint32_t budget)
+{
+    return __jobq_process(p_jobq_queue, AM_TRUE, budget);
+}
+
+/******************************************************************************/
+int am_jobq_job_stat_get (am_jobq_job_t *p_job, struct am_jobq_job_stat *p_stat)
+{
+    int key;
+
+    if ((p_job == NULL) || (p_stat == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+    p_stat->run_count    = p_job->run_count;
+#ifdef AM_JOBQ_JOB_RUN_TIME
+    p_stat->run_time_max = p_job->run_time_max;
+#else
+    p_stat->run_time_max = 0;
+#endif
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_jobq_stat_timestamp_set (am_jobq_queue_t  *p_jobq_queue,
+                                 uint32_t        (*pfn_timestamp) (void))
+{
+    if (p_jobq_queue != NULL) {
+        p_jobq_queue->pfn_timestamp = pfn_timestamp;
+    }
+}
+
+/******************************************************************************/
+int am_jobq_stat_get (am_jobq_queue_t *p_jobq_queue, struct am_jobq_stat *p_stat)
+{
+    int key;
+
+    if ((p_jobq_queue == NULL) || (p_stat == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+    *p_stat = p_jobq_queue->stat;
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_jobq_stat_reset (am_jobq_queue_t *p_jobq_queue)
+{
+    int key;
+
+    if (p_jobq_queue == NULL) {
+        return;
+    }
+
+    key = am_int_cpu_lock();
+    memset(&p_jobq_queue->stat, 0, sizeof(p_jobq_queue->stat));
+    am_int_cpu_unlock(key);
+}
 
 /* end of file */
@@ -0,0 +1,286 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief 첽Ϣʵ
+ *
+ * κĶϢд뷽ҸǷʽд뷽Ҳ޸ tail
+ * ˻Ķдڹж½Сֶַд룬ÿ
+ * __KOUT_LOCK_CHARS ַƹжϵʱ䡣
+ *
+ * ڵͺܵȴһηɣ˽ڷͿʱtx_active
+ * ʱλжȡջʱ
+ *
+ * \internal
+ * \par modification history:
+ * - 1.01 26-10-16  ljy, start TX only when it is idle
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_int.h"
+#include "am_koutput.h"
+#include "am_koutput_async.h"
+
+/** \brief һιждַ */
+#define __KOUT_LOCK_CHARS   32
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/**
+ * \brief Բѯʽͻɵһַжϵã
+ */
+static void __kout_oldest_send (am_koutput_async_t *p_dev)
+{
+    char c = p_dev->p_buf[p_dev->tail & p_dev->mask];
+
+    p_dev->tail++;
+
+    while (am_uart_poll_putchar(p_dev->handle, c) == -AM_EAGAIN) {
+    }
+}
+
+/**
+ * \brief дһַжϵã
+ */
+static void __kout_char_put (am_koutput_async_t *p_dev, char c)
+{
+    uint32_t used = p_dev->head - p_dev->tail;
+
+    if (used > p_dev->mask) {
+
+        switch (p_dev->policy) {
+
+        case AM_KOUTPUT_ASYNC_BLOCK:
+            __kout_oldest_send(p_dev);
+            break;
+
+        case AM_KOUTPUT_ASYNC_OVERWRITE:
+            p_dev->tail++;
+            p_dev->lost++;
+            break;
+
+        default:
+            p_dev->lost++;
+            return;
+        }
+        used--;
+    }
+
+    p_dev->p_buf[p_dev->head & p_dev->mask] = c;
+    p_dev->head++;
+
+    if (used + 1 > p_dev->used_max) {
+        p_dev->used_max = used + 1;
+    }
+}
+
+/**
+ * \brief ڷжϻȡ͵ַ
+ */
+static int __kout_txchar_get (void *p_arg, char *p_outchar)
+{
+    am_koutput_async_t *p_dev = (am_koutput_async_t *)p_arg;
+    int                 key;
+
+    key = am_int_cpu_lock();
+
+    if (p_dev->tail == p_dev->head) {
+        p_dev->tx_active = AM_FALSE;
+        am_int_cpu_unlock(key);
+        return -AM_EEMPTY;
+    }
+
+    *p_outchar = p_dev->p_buf[p_dev->tail & p_dev->mask];
+    p_dev->tail++;
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/**
+ * \brief ͿʱǷжϵã
+ *
+ * \retval AM_TRUE  : Ҫ am_uart_tx_startup()
+ * \retval AM_FALSE : ڽлû
+ */
+static am_bool_t __kout_tx_kick (am_koutput_async_t *p_dev)
+{
+    if (p_dev->tx_active || (p_dev->tail == p_dev->head)) {
+        return AM_FALSE;
+    }
+
+    p_dev->tx_active = AM_TRUE;
+
+    return AM_TRUE;
+}
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+
+int am_koutput_async_init (am_koutput_async_t *p_dev,
+                           am_uart_handle_t    handle,
+                           char               *p_buf,
+                           size_t              size,
+                           int                 policy)
+{
+    if ((p_dev == NULL) || (handle == NULL) || (p_buf == NULL) ||
+        (size == 0) || ((size & (size - 1)) != 0) ||
+        (policy < AM_KOUTPUT_ASYNC_DROP) ||
+        (policy > AM_KOUTPUT_ASYNC_OVERWRITE)) {
+        return -AM_EINVAL;
+    }
+
+    p_dev->handle    = handle;
+    p_dev->p_buf     = p_buf;
+    p_dev->mask      = size - 1;
+    p_dev->head      = 0;
+    p_dev->tail      = 0;
+    p_dev->tx_active = AM_FALSE;
+    p_dev->policy    = policy;
+    p_dev->lost      = 0;
+    p_dev->used_max  = 0;
+
+    am_uart_ioctl(handle, AM_UART_MODE_SET, (void *)AM_UART_MODE_INT);
+
+    am_uart_callback_set(handle,
+                         AM_UART_CALLBACK_TXCHAR_GET,
+                         (void *)__kout_txchar_get,
+                         (void *)p_dev);
+
+    am_koutput_set(p_dev, am_koutput_async_putc, am_koutput_async_puts);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_koutput_async_policy_set (am_koutput_async_t *p_dev, int policy)
+{
+    if ((p_dev == NULL) ||
+        (policy < AM_KOUTPUT_ASYNC_DROP) ||
+        (policy > AM_KOUTPUT_ASYNC_OVERWRITE)) {
+        return -AM_EINVAL;
+    }
+
+    p_dev->policy = policy;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_koutput_async_putc (const char c, void *fil)
+{
+    am_koutput_async_t *p_dev = (am_koutput_async_t *)fil;
+    am_bool_t           kick;
+    int                 key;
+
+    key = am_int_cpu_lock();
+
+    if (c == '\n') {
+        __kout_char_put(p_dev, '\r');
+    }
+    __kout_char_put(p_dev, c);
+
+    kick = __kout_tx_kick(p_dev);
+
+    am_int_cpu_unlock(key);
+
+    if (kick) {
+        am_uart_tx_startup(p_dev->handle);
+    }
+
+    return 1;
+}
+
+/******************************************************************************/
+int am_koutput_async_puts (const char *s, void *fil)
+{
+    am_koutput_async_t *p_dev = (am_koutput_async_t *)fil;
+    const char         *ss    = s;
+    am_bool_t           kick;
+    int                 key;
+    int                 n;
+
+    while (*ss != '\0') {
+
+        key = am_int_cpu_lock();
+
+        for (n = 0; (n < __KOUT_LOCK_CHARS) && (*ss != '\0'); n++, ss++) {
+            if (*ss == '\n') {
+                __kout_char_put(p_dev, '\r');
+            }
+            __kout_char_put(p_dev, *ss);
+        }
+
+        kick = __kout_tx_kick(p_dev);
+
+        am_int_cpu_unlock(key);
+
+        if (kick) {
+            am_uart_tx_startup(p_dev->handle);
+        }
+    }
+
+    return ss - s;
+}
+
+/******************************************************************************/
+void am_koutput_async_flush (am_koutput_async_t *p_dev)
+{
+    int key;
+
+    if (p_dev == NULL) {
+        return;
+    }
+
+    for (;;) {
+        key = am_int_cpu_lock();
+
+        if (p_dev->tail == p_dev->head) {
+            am_int_cpu_unlock(key);
+            break;
+        }
+        __kout_oldest_send(p_dev);
+
+        am_int_cpu_unlock(key);
+    }
+}
+
+/******************************************************************************/
+int am_koutput_async_stat_get (am_koutput_async_t           *p_dev,
+                               struct am_koutput_async_stat *p_stat)
+{
+    int key;
+
+    if ((p_dev == NULL) || (p_stat == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    p_stat->size     = p_dev->mask + 1;
+    p_stat->used     = p_dev->head - p_dev->tail;
+    p_stat->used_max = p_dev->used_max;
+    p_stat->lost     = p_dev->lost;
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/* end of file */
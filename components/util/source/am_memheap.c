@@ -16,6 +16,8 @@
  *
  * \internal
  * \par modification history:
+ * - 1.02 26-10-16  ljy, add walk/info/dump and AM_MEMHEAP_TRACE
+ * - 1.01 26-10-16  ljy, add TLSF engine (am_memheap_init_tlsf())
  * - 1.00 16-10-27  tee, copy from amorks
  * \endinternal
  */
@@ -35,15 +37,249 @@
 
 #define __MEMHEAP_IS_USED(i)   ((i)->magic & __MEMHEAP_USED)
 
-#define __MEMHEAP_MINALLOC      12
+#define __MEMHEAP_MINALLOC      AM_ROUND_UP(12, __MEM_ALIGN_SIZE)
 
 #define __MEM_ALIGN_SIZE        (sizeof(void *))
 #define __MEMHEAP_SIZE          AM_ROUND_UP(sizeof(struct am_memheap_item), __MEM_ALIGN_SIZE)
-#define __MEMITEM_SIZE(item)    ((uint32_t)item->next - (uint32_t)item - __MEMHEAP_SIZE)
+#define __MEMITEM_SIZE(item)    ((uint32_t)((uint8_t *)(item)->next -        \
+                                            (uint8_t *)(item)) - __MEMHEAP_SIZE)
 
 
 void am_memheap_free(void *ptr);
 
+/*******************************************************************************
+  TLSF (Two-Level Segregated Fit) engine
+
+  Free blocks are kept in fl_count * SL_COUNT segregated lists. The first level
+  splits sizes by power of two, the second level splits each power of two range
+  into SL_COUNT linear ranges. Two levels of bitmaps record non-empty lists, so
+  finding a suitable free block takes constant time. Blocks smaller than
+  __TLSF_SMALL_SIZE are all put in first level 0, each list holding one size.
+*******************************************************************************/
+
+#ifndef AM_MEMHEAP_TLSF_SL_LOG2
+#define AM_MEMHEAP_TLSF_SL_LOG2  3
+#endif
+
+#define __TLSF_SL_COUNT         (1u << AM_MEMHEAP_TLSF_SL_LOG2)
+#define __TLSF_ALIGN_LOG2       ((sizeof(void *) == 8) ? 3 : 2)
+#define __TLSF_FL_SHIFT         (AM_MEMHEAP_TLSF_SL_LOG2 + __TLSF_ALIGN_LOG2)
+#define __TLSF_SMALL_SIZE       (1u << __TLSF_FL_SHIFT)
+
+/**
+ * \brief TLSF control block, placed at the beginning of the pool
+ */
+struct am_memheap_tlsf {
+    uint32_t                 fl_bitmap;    /**< non-empty first level lists  */
+    uint32_t                 fl_count;     /**< number of first level lists  */
+    uint32_t                *p_sl_bitmap;  /**< non-empty second level lists */
+    struct am_memheap_item **p_heads;      /**< fl_count * SL_COUNT lists    */
+};
+
+/* find last set bit, word must not be 0 */
+static uint32_t __tlsf_fls (uint32_t word)
+{
+#if defined(__GNUC__) && !defined(AM_CORTEX_M0)
+    return 31 - __builtin_clz(word);
+#elif defined(__CC_ARM) && !defined(AM_CORTEX_M0)
+    return 31 - __clz(word);
+#else
+    uint32_t bit = 31;
+
+    if (!(word & 0xffff0000)) { word <<= 16; bit -= 16; }
+    if (!(word & 0xff000000)) { word <<= 8;  bit -= 8;  }
+    if (!(word & 0xf0000000)) { word <<= 4;  bit -= 4;  }
+    if (!(word & 0xc0000000)) { word <<= 2;  bit -= 2;  }
+    if (!(word & 0x80000000)) {              bit -= 1;  }
+
+    return bit;
+#endif
+}
+
+/* find first set bit, word must not be 0 */
+static uint32_t __tlsf_ffs (uint32_t word)
+{
+    return __tlsf_fls(word & (~word + 1));
+}
+
+/* get the list index of a free block with the size */
+static void __tlsf_mapping (uint32_t size, uint32_t *p_fl, uint32_t *p_sl)
+{
+    uint32_t fl;
+
+    if (size < __TLSF_SMALL_SIZE) {
+        *p_fl = 0;
+        *p_sl = size / (__TLSF_SMALL_SIZE / __TLSF_SL_COUNT);
+    } else {
+        fl    = __tlsf_fls(size);
+        *p_sl = (size >> (fl - AM_MEMHEAP_TLSF_SL_LOG2)) ^ __TLSF_SL_COUNT;
+        *p_fl = fl - (__TLSF_FL_SHIFT - 1);
+    }
+}
+
+/* number of first level lists needed by a pool with the size */
+static uint32_t __tlsf_fl_count (uint32_t size)
+{
+    uint32_t fl, sl;
+
+    __tlsf_mapping(size, &fl, &sl);
+
+    return fl + 1;
+}
+
+/* insert a free block to the head of its list */
+static void __tlsf_insert (struct am_memheap_tlsf  *p_tlsf,
+                           struct am_memheap_item *item)
+{
+    uint32_t                 fl, sl;
+    struct am_memheap_item **pp_head;
+
+    __tlsf_mapping(__MEMITEM_SIZE(item), &fl, &sl);
+
+    pp_head = &p_tlsf->p_heads[fl * __TLSF_SL_COUNT + sl];
+
+    item->prev_free = NULL;
+    item->next_free = *pp_head;
+    if (*pp_head != NULL) {
+        (*pp_head)->prev_free = item;
+    }
+    *pp_head = item;
+
+    p_tlsf->fl_bitmap       |= 1ul << fl;
+    p_tlsf->p_sl_bitmap[fl] |= 1ul << sl;
+}
+
+/* remove a free block from its list */
+static void __tlsf_remove (struct am_memheap_tlsf  *p_tlsf,
+                           struct am_memheap_item *item)
+{
+    uint32_t                 fl, sl;
+    struct am_memheap_item **pp_head;
+
+    __tlsf_mapping(__MEMITEM_SIZE(item), &fl, &sl);
+
+    pp_head = &p_tlsf->p_heads[fl * __TLSF_SL_COUNT + sl];
+
+    if (item->next_free != NULL) {
+        item->next_free->prev_free = item->prev_free;
+    }
+    if (item->prev_free != NULL) {
+        item->prev_free->next_free = item->next_free;
+    } else {
+        *pp_head = item->next_free;
+
+        /* the list is empty now */
+        if (*pp_head == NULL) {
+            p_tlsf->p_sl_bitmap[fl] &= ~(1ul << sl);
+            if (p_tlsf->p_sl_bitmap[fl] == 0) {
+                p_tlsf->fl_bitmap &= ~(1ul << fl);
+            }
+        }
+    }
+
+    item->next_free = NULL;
+    item->prev_free = NULL;
+}
+
+/* find a free block not less than size */
+static struct am_memheap_item *__tlsf_find (struct am_memheap_tlsf *p_tlsf,
+                                            uint32_t               size)
+{
+    uint32_t fl, sl;
+    uint32_t sl_map, fl_map;
+
+    /*
+     * round the size up to the next list, so that any block in the found list
+     * is large enough
+     */
+    if (size >= __TLSF_SMALL_SIZE) {
+        size += (1ul << (__tlsf_fls(size) - AM_MEMHEAP_TLSF_SL_LOG2)) - 1;
+    }
+    __tlsf_mapping(size, &fl, &sl);
+
+    if (fl >= p_tlsf->fl_count) {
+        return NULL;
+    }
+
+    sl_map = p_tlsf->p_sl_bitmap[fl] & (~0ul << sl);
+    if (sl_map == 0) {
+
+        /* no block in this first level, search the larger ones */
+        fl_map = p_tlsf->fl_bitmap & (~0ul << (fl + 1));
+        if (fl_map == 0) {
+            return NULL;
+        }
+        fl     = __tlsf_ffs(fl_map);
+        sl_map = p_tlsf->p_sl_bitmap[fl];
+    }
+    sl = __tlsf_ffs(sl_map);
+
+    return p_tlsf->p_heads[fl * __TLSF_SL_COUNT + sl];
+}
+
+/*******************************************************************************
+  free list operations, dispatched to the engine used by the heap
+*******************************************************************************/
+
+/* insert a free block to the free list */
+static void __memheap_free_insert (struct am_memheap      *heap,
+                                   struct am_memheap_item *item)
+{
+    if (heap->p_tlsf != NULL) {
+        __tlsf_insert(heap->p_tlsf, item);
+        return;
+    }
+
+    item->next_free = heap->free_list->next_free;
+    item->prev_free = heap->free_list;
+    heap->free_list->next_free->prev_free = item;
+    heap->free_list->next_free            = item;
+}
+
+/*
+ * remove a free block from the free list, must be called before the size of
+ * the block changes
+ */
+static void __memheap_free_remove (struct am_memheap      *heap,
+                                   struct am_memheap_item *item)
+{
+    if (heap->p_tlsf != NULL) {
+        __tlsf_remove(heap->p_tlsf, item);
+        return;
+    }
+
+    item->next_free->prev_free = item->prev_free;
+    item->prev_free->next_free = item->next_free;
+    item->next_free = NULL;
+    item->prev_free = NULL;
+}
+
+/* find a free block not less than size, NULL if not found */
+static struct am_memheap_item *__memheap_free_find (struct am_memheap *heap,
+                                                    uint32_t           size)
+{
+    struct am_memheap_item *header_ptr;
+
+    if (heap->p_tlsf != NULL) {
+        return __tlsf_find(heap->p_tlsf, size);
+    }
+
+    /* get the first free memory block */
+    header_ptr = heap->free_list->next_free;
+    while (header_ptr != heap->free_list) {
+
+        /* get current freed memory block size */
+        if (__MEMITEM_SIZE(header_ptr) >= size) {
+            return header_ptr;
+        }
+
+        /* move to next free memory block */
+        header_ptr = header_ptr->next_free;
+    }
+
+    return NULL;
+}
+
 /*
  * The initialized memory pool will be:
  * +-----------------------------------+--------------------------+
@@ -55,16 +291,16 @@ void am_memheap_free(void *ptr);
  * The length of Used Memory Block Tailer is 0,
  * which is prevents block merging across list
  */
-am_err_t am_memheap_init(struct am_memheap *memheap,
-                         const char        *name,
-                         void              *start_addr,
-                         uint32_t           size)
+static void __memheap_init (struct am_memheap     *memheap,
+                            const char            *name,
+                            void                  *start_addr,
+                            uint32_t               size,
+                            struct am_memheap_tlsf *p_tlsf)
 {
     struct am_memheap_item *item;
 
-    am_assert(memheap != NULL);
-
     /* initialize pool object */
+    memheap->p_tlsf         = p_tlsf;
     memheap->name           = name;
     memheap->start_addr     = start_addr;
     memheap->pool_size      = AM_ROUND_DOWN(size, __MEM_ALIGN_SIZE);
@@ -100,10 +336,7 @@ am_err_t am_memheap_init(struct am_memheap *memheap,
     memheap->block_list = item;
 
     /* place the big memory block to free list */
-    item->next_free = memheap->free_list->next_free;
-    item->prev_free = memheap->free_list;
-    memheap->free_list->next_free->prev_free = item;
-    memheap->free_list->next_free            = item;
+    __memheap_free_insert(memheap, item);
 
     /* move to the end of memory pool to build a small tailer block,
      * which prevents block merging
@@ -119,6 +352,62 @@ am_err_t am_memheap_init(struct am_memheap *memheap,
 
     AM_DBGF(("create memory heap %x (start 0x%08x, size %d)\n",
               memheap, start_addr, size));
+}
+
+/******************************************************************************/
+am_err_t am_memheap_init(struct am_memheap *memheap,
+                         const char        *name,
+                         void              *start_addr,
+                         uint32_t           size)
+{
+    am_assert(memheap != NULL);
+
+    __memheap_init(memheap, name, start_addr, size, NULL);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+am_err_t am_memheap_init_tlsf(struct am_memheap *memheap,
+                              const char        *name,
+                              void              *start_addr,
+                              uint32_t           size)
+{
+    struct am_memheap_tlsf *p_tlsf;
+    uint32_t               fl_count;
+    uint32_t               ctrl_size;
+
+    am_assert(memheap != NULL);
+
+    size      = AM_ROUND_DOWN(size, __MEM_ALIGN_SIZE);
+    fl_count  = __tlsf_fl_count(size);
+    ctrl_size = AM_ROUND_UP(sizeof(struct am_memheap_tlsf) +
+                            fl_count * sizeof(uint32_t) +
+                            fl_count * __TLSF_SL_COUNT *
+                            sizeof(struct am_memheap_item *),
+                            __MEM_ALIGN_SIZE);
+
+    /* the pool must hold the control block and at least one block */
+    if (size < ctrl_size + 3 * __MEMHEAP_SIZE + __MEMHEAP_MINALLOC) {
+        return -AM_ENOMEM;
+    }
+
+    /* place the control block at the beginning of the pool */
+    p_tlsf              = (struct am_memheap_tlsf *)start_addr;
+    p_tlsf->fl_bitmap   = 0;
+    p_tlsf->fl_count    = fl_count;
+    p_tlsf->p_heads     = (struct am_memheap_item **)(p_tlsf + 1);
+    p_tlsf->p_sl_bitmap = (uint32_t *)(p_tlsf->p_heads +
+                                       fl_count * __TLSF_SL_COUNT);
+    memset(p_tlsf->p_heads, 0,
+           fl_count * __TLSF_SL_COUNT * sizeof(struct am_memheap_item *));
+    memset(p_tlsf->p_sl_bitmap, 0, fl_count * sizeof(uint32_t));
+
+    __memheap_init(memheap,
+                   name,
+                   (uint8_t *)start_addr + ctrl_size,
+                   size - ctrl_size,
+                   p_tlsf);
 
     return AM_OK;
 }
@@ -142,23 +431,20 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
     if (size < heap->available_size) {
 
         /* search on free list */
-        free_size = 0;
-
-        /* get the first free memory block */
-        header_ptr = heap->free_list->next_free;
-        while (header_ptr != heap->free_list && free_size < size) {
-
-            /* get current freed memory block size */
-            free_size = __MEMITEM_SIZE(header_ptr);
-            if (free_size < size) {
-                /* move to next free memory block */
-                header_ptr = header_ptr->next_free;
-            }
-        }
+        header_ptr = __memheap_free_find(heap, size);
 
         /* determine if the memory is available. */
-        if (free_size >= size) {
+        if (header_ptr != NULL) {
             /* a block that satisfies the request has been found. */
+            free_size = __MEMITEM_SIZE(header_ptr);
+
+            /* remove header ptr from free list */
+            AM_DBGF(("remove block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x\n",
+                     header_ptr,
+                     header_ptr->next_free,
+                     header_ptr->prev_free));
+
+            __memheap_free_remove(heap, header_ptr);
 
             /* determine if the block needs to be split. */
             if (free_size >= (size + __MEMHEAP_SIZE + __MEMHEAP_MINALLOC)){
@@ -187,17 +473,8 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
                 header_ptr->next->prev = new_ptr;
                 header_ptr->next       = new_ptr;
 
-                /* remove header ptr from free list */
-                header_ptr->next_free->prev_free = header_ptr->prev_free;
-                header_ptr->prev_free->next_free = header_ptr->next_free;
-                header_ptr->next_free = NULL;
-                header_ptr->prev_free = NULL;
-
                 /* insert new_ptr to free list */
-                new_ptr->next_free = heap->free_list->next_free;
-                new_ptr->prev_free = heap->free_list;
-                heap->free_list->next_free->prev_free = new_ptr;
-                heap->free_list->next_free            = new_ptr;
+                __memheap_free_insert(heap, new_ptr);
                 AM_DBGF(("new ptr: next_free 0x%08x, prev_free 0x%08x\n",
                          new_ptr->next_free,
                          new_ptr->prev_free));
@@ -217,20 +494,13 @@ void *am_memheap_alloc(struct am_memheap *heap, uint32_t size)
                 if (heap->pool_size - heap->available_size > heap->max_used_size) {
                     heap->max_used_size = heap->pool_size - heap->available_size;
                 }
-                /* remove header_ptr from free list */
-                AM_DBGF(("one block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x\n",
-                         header_ptr,
-                         header_ptr->next_free,
-                         header_ptr->prev_free));
-
-                header_ptr->next_free->prev_free = header_ptr->prev_free;
-                header_ptr->prev_free->next_free = header_ptr->next_free;
-                header_ptr->next_free = NULL;
-                header_ptr->prev_free = NULL;
             }
 
             /* Mark the allocated block as not available. */
             header_ptr->magic    |= __MEMHEAP_USED;
+#ifdef AM_MEMHEAP_TRACE
+            header_ptr->caller    = AM_MEMHEAP_CALLER();
+#endif
 
             /* Return a memory address to the caller.  */
             AM_DBGF(("alloc mem: memory[0x%08x], heap[0x%08x], size: %d\n",
@@ -326,8 +596,7 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
                          next_ptr->next_free,
                          next_ptr->prev_free));
 
-                next_ptr->next_free->prev_free = next_ptr->prev_free;
-                next_ptr->prev_free->next_free = next_ptr->next_free;
+                __memheap_free_remove(heap, next_ptr);
                 next_ptr->next->prev = next_ptr->prev;
                 next_ptr->prev->next = next_ptr->next;
 
@@ -351,10 +620,7 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
                 header_ptr->next       = next_ptr;
 
                 /* insert next_ptr to free list */
-                next_ptr->next_free = heap->free_list->next_free;
-                next_ptr->prev_free = heap->free_list;
-                heap->free_list->next_free->prev_free = next_ptr;
-                heap->free_list->next_free            = next_ptr;
+                __memheap_free_insert(heap, next_ptr);
                 AM_DBGF(("new ptr: next_free 0x%08x, prev_free 0x%08x",
                          next_ptr->next_free,
                          next_ptr->prev_free));
@@ -367,6 +633,11 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
         new_ptr = (void*)am_memheap_alloc(heap, newsize);
         if (new_ptr != NULL) {
             memcpy(new_ptr, ptr, oldsize < newsize ? oldsize : newsize);
+#ifdef AM_MEMHEAP_TRACE
+            /* the new block belongs to the original caller */
+            ((struct am_memheap_item *)
+            ((uint8_t *)new_ptr - __MEMHEAP_SIZE))->caller = header_ptr->caller;
+#endif
             am_memheap_free(ptr);
         }
 
@@ -410,19 +681,15 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize)
         AM_DBGF(("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
                  header_ptr, header_ptr->next_free, header_ptr->prev_free));
 
+        /* remove free ptr from free list */
+        __memheap_free_remove(heap, free_ptr);
+
         free_ptr->next->prev = new_ptr;
         new_ptr->next   = free_ptr->next;
-
-        /* remove free ptr from free list */
-        free_ptr->next_free->prev_free = free_ptr->prev_free;
-        free_ptr->prev_free->next_free = free_ptr->next_free;
     }
 
     /* insert the split block to free list */
-    new_ptr->next_free = heap->free_list->next_free;
-    new_ptr->prev_free = heap->free_list;
-    heap->free_list->next_free->prev_free = new_ptr;
-    heap->free_list->next_free            = new_ptr;
+    __memheap_free_insert(heap, new_ptr);
     AM_DBGF(("new free ptr: next_free 0x%08x, prev_free 0x%08x\n",
              new_ptr->next_free,
              new_ptr->prev_free));
@@ -439,13 +706,10 @@ void am_memheap_free(void *ptr)
 {
     struct am_memheap *heap;
     struct am_memheap_item *header_ptr, *new_ptr;
-    uint32_t insert_header;
 
 	/* NULL check */
 	if (ptr == NULL) return;
 
-    /* set initial status as OK */
-    insert_header = 1;
     new_ptr       = NULL;
     header_ptr    = (struct am_memheap_item *)
                     ((uint8_t *)ptr - __MEMHEAP_SIZE);
@@ -471,14 +735,15 @@ void am_memheap_free(void *ptr)
         /* adjust the available number of bytes. */
         heap->available_size = heap->available_size + __MEMHEAP_SIZE;
 
+        /* the size of previous block changes, take it out of free list */
+        __memheap_free_remove(heap, header_ptr->prev);
+
         /* yes, merge block with previous neighbor. */
         (header_ptr->prev)->next = header_ptr->next;
         (header_ptr->next)->prev = header_ptr->prev;
 
         /* move header pointer to previous. */
         header_ptr = header_ptr->prev;
-        /* don't insert header to free list */
-        insert_header = 0;
     }
 
     /* determine if the block can be merged with the next neighbor. */
@@ -492,26 +757,284 @@ void am_memheap_free(void *ptr)
         AM_DBGF(("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
                  new_ptr, new_ptr->next_free, new_ptr->prev_free));
 
+        /* remove new ptr from free list */
+        __memheap_free_remove(heap, new_ptr);
+
         new_ptr->next->prev = header_ptr;
         header_ptr->next    = new_ptr->next;
+    }
 
-        /* remove new ptr from free list */
-        new_ptr->next_free->prev_free = new_ptr->prev_free;
-        new_ptr->prev_free->next_free = new_ptr->next_free;
+    /* insert the merged block to free list */
+    __memheap_free_insert(heap, header_ptr);
+
+    AM_DBGF(("insert to free list: next_free 0x%08x, prev_free 0x%08x\n",
+             header_ptr->next_free, header_ptr->prev_free));
+}
+
+#ifdef AM_MEMHEAP_TRACE
+
+/******************************************************************************/
+void *am_memheap_alloc_tag(struct am_memheap *heap,
+                           uint32_t           size,
+                           const void        *caller)
+{
+    void *ptr = am_memheap_alloc(heap, size);
+
+    if (ptr != NULL) {
+        ((struct am_memheap_item *)((uint8_t *)ptr - __MEMHEAP_SIZE))->caller =
+                                                                        caller;
+    }
+
+    return ptr;
+}
+
+#endif /* AM_MEMHEAP_TRACE */
+
+/*******************************************************************************
+  diagnostics
+*******************************************************************************/
+
+/******************************************************************************/
+int am_memheap_walk(struct am_memheap    *heap,
+                    am_memheap_walk_cb_t  pfn,
+                    void                 *p_arg)
+{
+    struct am_memheap_item       *item;
+    struct am_memheap_item       *tail;
+    struct am_memheap_block_info  info;
+
+    if (heap == NULL) {
+        return -AM_EINVAL;
+    }
+
+    /* the tailer block is at the end of the pool, see am_memheap_init() */
+    tail = (struct am_memheap_item *)
+           ((uint8_t *)heap->start_addr + heap->pool_size - __MEMHEAP_SIZE);
+    item = heap->block_list;
+
+    while (item != tail) {
+
+        /* the block and the next one must be inside the pool, in order */
+        if ((item < (struct am_memheap_item *)heap->start_addr) ||
+            (item->next <= item) ||
+            (item->next > tail)) {
+            return -AM_EFAULT;
+        }
+
+        if (((item->magic & __MEMHEAP_MASK) != __MEMHEAP_MAGIC) ||
+            (item->pool_ptr != heap) ||
+            (item->next->prev != item)) {
+            return -AM_EFAULT;
+        }
+
+        if (pfn != NULL) {
+            info.ptr    = (uint8_t *)item + __MEMHEAP_SIZE;
+            info.size   = __MEMITEM_SIZE(item);
+            info.used   = (am_bool_t)__MEMHEAP_IS_USED(item);
+#ifdef AM_MEMHEAP_TRACE
+            info.caller = info.used ? item->caller : NULL;
+#else
+            info.caller = NULL;
+#endif
+            if (pfn(p_arg, &info) != 0) {
+                return AM_OK;
+            }
+        }
+
+        item = item->next;
+    }
+
+    if (((tail->magic & __MEMHEAP_MASK) != __MEMHEAP_MAGIC) ||
+        !__MEMHEAP_IS_USED(tail)) {
+        return -AM_EFAULT;
+    }
+
+    return AM_OK;
+}
+
+/* index of the size in the histogram */
+static unsigned int __memheap_hist_idx (uint32_t size)
+{
+    unsigned int idx = 0;
+
+    size >>= 4;
+    while ((size != 0) && (idx < AM_MEMHEAP_HIST_NUM - 1)) {
+        size >>= 1;
+        idx++;
     }
 
-    if (insert_header) {
-        /* no left merge, insert to free list */
-        header_ptr->next_free = heap->free_list->next_free;
-        header_ptr->prev_free = heap->free_list;
-        heap->free_list->next_free->prev_free = header_ptr;
-        heap->free_list->next_free            = header_ptr;
+    return idx;
+}
+
+/* collect the information of one block */
+static int __memheap_info_cb (void                               *p_arg,
+                              const struct am_memheap_block_info *p_blk)
+{
+    struct am_memheap_info *p_info = (struct am_memheap_info *)p_arg;
+
+    if (p_blk->used) {
+        p_info->used_size += p_blk->size;
+        p_info->used_blocks++;
+        p_info->hist_used[__memheap_hist_idx(p_blk->size)]++;
+    } else {
+        p_info->free_size += p_blk->size;
+        p_info->free_blocks++;
+        p_info->hist_free[__memheap_hist_idx(p_blk->size)]++;
+        if (p_blk->size > p_info->free_largest) {
+            p_info->free_largest = p_blk->size;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+int am_memheap_info_get(struct am_memheap *heap, struct am_memheap_info *p_info)
+{
+    int ret;
+
+    if (p_info == NULL) {
+        return -AM_EINVAL;
+    }
+
+    memset(p_info, 0, sizeof(*p_info));
+
+    ret = am_memheap_walk(heap, __memheap_info_cb, p_info);
+
+    if ((ret == AM_OK) && (p_info->free_size != 0)) {
+        p_info->frag_permille = 1000 - (uint32_t)
+                                ((uint64_t)p_info->free_largest * 1000 /
+                                 p_info->free_size);
+    }
+
+    return ret;
+}
+
+/* print one block */
+static int __memheap_dump_cb (void                               *p_arg,
+                              const struct am_memheap_block_info *p_blk)
+{
+    (void)p_arg;
+
+    am_kprintf("  0x%08lx %8u %s 0x%08lx\r\n",
+               (unsigned long)p_blk->ptr,
+               (unsigned int)p_blk->size,
+               p_blk->used ? "used" : "free",
+               (unsigned long)p_blk->caller);
+
+    return 0;
+}
+
+/******************************************************************************/
+int am_memheap_dump(struct am_memheap *heap)
+{
+    struct am_memheap_info info;
+    unsigned int           i;
+    int                    ret;
+
+    if (heap == NULL) {
+        return -AM_EINVAL;
+    }
 
-        AM_DBGF(("insert to free list: next_free 0x%08x, prev_free 0x%08x\n",
-                 header_ptr->next_free, header_ptr->prev_free));
+    am_kprintf("memheap %s: start 0x%08lx, size %u, available %u, max used %u\r\n",
+               heap->name,
+               (unsigned long)heap->start_addr,
+               (unsigned int)heap->pool_size,
+               (unsigned int)heap->available_size,
+               (unsigned int)heap->max_used_size);
+    am_kprintf("  address      size      caller\r\n");
+
+    ret = am_memheap_walk(heap, __memheap_dump_cb, NULL);
+    if (ret != AM_OK) {
+        am_kprintf("memheap %s: corrupted\r\n", heap->name);
+        return ret;
     }
+
+    am_memheap_info_get(heap, &info);
+
+    am_kprintf("free %u in %u blocks (largest %u, frag %u/1000), "
+               "used %u in %u blocks\r\n",
+               (unsigned int)info.free_size,
+               (unsigned int)info.free_blocks,
+               (unsigned int)info.free_largest,
+               (unsigned int)info.frag_permille,
+               (unsigned int)info.used_size,
+               (unsigned int)info.used_blocks);
+
+    for (i = 0; i < AM_MEMHEAP_HIST_NUM; i++) {
+        if ((info.hist_free[i] != 0) || (info.hist_used[i] != 0)) {
+            am_kprintf("  < %8u free %6u used %6u\r\n",
+                       (unsigned int)(16u << i),
+                       (unsigned int)info.hist_free[i],
+                       (unsigned int)info.hist_used[i]);
+        }
+    }
+
+    return AM_OK;
+}
+
+#ifdef AM_MEMHEAP_TRACE
+
+/* caller statistics context */
+struct __memheap_caller_ctx {
+    struct am_memheap_caller_stat *p_stat;
+    unsigned int                   num;
+    unsigned int                   count;
+};
+
+/* account one used block to its caller */
+static int __memheap_caller_cb (void                               *p_arg,
+                                const struct am_memheap_block_info *p_blk)
+{
+    struct __memheap_caller_ctx *p_ctx = (struct __memheap_caller_ctx *)p_arg;
+    unsigned int                 i;
+
+    if (!p_blk->used) {
+        return 0;
+    }
+
+    for (i = 0; i < p_ctx->count; i++) {
+        if (p_ctx->p_stat[i].caller == p_blk->caller) {
+            p_ctx->p_stat[i].live_size += p_blk->size;
+            p_ctx->p_stat[i].live_blocks++;
+            return 0;
+        }
+    }
+
+    /* a new caller, ignored if the array is full */
+    if (p_ctx->count < p_ctx->num) {
+        p_ctx->p_stat[i].caller      = p_blk->caller;
+        p_ctx->p_stat[i].live_size   = p_blk->size;
+        p_ctx->p_stat[i].live_blocks = 1;
+        p_ctx->count++;
+    }
+
+    return 0;
+}
+
+/******************************************************************************/
+int am_memheap_caller_stat_get(struct am_memheap             *heap,
+                               struct am_memheap_caller_stat *p_stat,
+                               unsigned int                   num)
+{
+    struct __memheap_caller_ctx ctx;
+    int                         ret;
+
+    if ((p_stat == NULL) && (num != 0)) {
+        return -AM_EINVAL;
+    }
+
+    ctx.p_stat = p_stat;
+    ctx.num    = num;
+    ctx.count  = 0;
+
+    ret = am_memheap_walk(heap, __memheap_caller_cb, &ctx);
+
+    return (ret == AM_OK) ? (int)ctx.count : ret;
 }
 
+#endif /* AM_MEMHEAP_TRACE */
+
 /* end of file */
 
 
@@ -0,0 +1,226 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ̶Сڴʵ
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "am_mempool.h"
+#include "am_int.h"
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+am_mempool_handle_t am_mempool_init (am_mempool_t *p_pool,
+                                     void         *p_mem,
+                                     size_t        mem_size,
+                                     size_t        block_size)
+{
+    uint8_t      *p_block;
+    unsigned int  i;
+
+    if ((p_pool == NULL) || (p_mem == NULL) || (block_size == 0) ||
+        (((uintptr_t)p_mem & (sizeof(void *) - 1)) != 0)) {
+        return NULL;
+    }
+
+    block_size = AM_MEMPOOL_BLOCK_SIZE(block_size);
+
+    if (mem_size < block_size) {
+        return NULL;
+    }
+
+    p_pool->block_size = block_size;
+    p_pool->block_num  = mem_size / block_size;
+    p_pool->p_start    = (uint8_t *)p_mem;
+    p_pool->p_end      = p_pool->p_start + p_pool->block_num * block_size;
+    p_pool->nfree      = p_pool->block_num;
+    p_pool->nfree_min  = p_pool->block_num;
+    p_pool->nfail      = 0;
+
+    /* п鰴ַ˳ӳɿ */
+    p_block = p_pool->p_start;
+    for (i = 0; i < p_pool->block_num - 1; i++) {
+        *(void **)p_block = p_block + block_size;
+        p_block          += block_size;
+    }
+    *(void **)p_block = NULL;
+
+    p_pool->p_free = p_pool->p_start;
+
+    return p_pool;
+}
+
+/******************************************************************************/
+void *am_mempool_alloc (am_mempool_handle_t handle)
+{
+    void *p_block;
+    int   key;
+
+    if (handle == NULL) {
+        return NULL;
+    }
+
+    key = am_int_cpu_lock();
+
+    p_block = handle->p_free;
+
+    if (p_block != NULL) {
+        handle->p_free = *(void **)p_block;
+        if (--handle->nfree < handle->nfree_min) {
+            handle->nfree_min = handle->nfree;
+        }
+    } else {
+        handle->nfail++;
+    }
+
+    am_int_cpu_unlock(key);
+
+    return p_block;
+}
+
+/******************************************************************************/
+int am_mempool_free (am_mempool_handle_t handle, void *p_block)
+{
+    int key;
+
+    if (!am_mempool_contains(handle, p_block) ||
+        (((uint8_t *)p_block - handle->p_start) % handle->block_size != 0)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    *(void **)p_block = handle->p_free;
+    handle->p_free    = p_block;
+    handle->nfree++;
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+am_bool_t am_mempool_contains (am_mempool_handle_t handle, const void *p_block)
+{
+    if ((handle == NULL) || (p_block == NULL)) {
+        return AM_FALSE;
+    }
+
+    return (am_bool_t)(((const uint8_t *)p_block >= handle->p_start) &&
+                       ((const uint8_t *)p_block <  handle->p_end));
+}
+
+/******************************************************************************/
+int am_mempool_stat_get (am_mempool_handle_t     handle,
+                         struct am_mempool_stat *p_stat)
+{
+    int key;
+
+    if ((handle == NULL) || (p_stat == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    p_stat->block_size = handle->block_size;
+    p_stat->block_num  = handle->block_num;
+    p_stat->nfree      = handle->nfree;
+    p_stat->used_max   = handle->block_num - handle->nfree_min;
+    p_stat->nfail      = handle->nfail;
+
+    am_int_cpu_unlock(key);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_mempool_class_init (am_mempool_class_t  *p_class,
+                           am_mempool_handle_t *p_pools,
+                           unsigned int         pool_num,
+                           am_memheap_t        *p_heap)
+{
+    unsigned int i;
+
+    if ((p_class == NULL) || ((p_pools == NULL) && (pool_num != 0))) {
+        return -AM_EINVAL;
+    }
+
+    /* رѾʼҰСС */
+    for (i = 0; i < pool_num; i++) {
+        if ((p_pools[i] == NULL) ||
+            ((i > 0) && (p_pools[i]->block_size < p_pools[i - 1]->block_size))) {
+            return -AM_EINVAL;
+        }
+    }
+
+    p_class->p_pools  = p_pools;
+    p_class->pool_num = pool_num;
+    p_class->p_heap   = p_heap;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void *am_mempool_class_alloc (am_mempool_class_t *p_class, size_t size)
+{
+    unsigned int  i;
+    void         *ptr;
+
+    if ((p_class == NULL) || (size == 0)) {
+        return NULL;
+    }
+
+    for (i = 0; i < p_class->pool_num; i++) {
+        if (p_class->p_pools[i]->block_size >= size) {
+            ptr = am_mempool_alloc(p_class->p_pools[i]);
+            if (ptr != NULL) {
+                return ptr;
+            }
+        }
+    }
+
+    if (p_class->p_heap != NULL) {
+        return am_memheap_alloc(p_class->p_heap, size);
+    }
+
+    return NULL;
+}
+
+/******************************************************************************/
+void am_mempool_class_free (am_mempool_class_t *p_class, void *ptr)
+{
+    unsigned int i;
+
+    if ((p_class == NULL) || (ptr == NULL)) {
+        return;
+    }
+
+    for (i = 0; i < p_class->pool_num; i++) {
+        if (am_mempool_contains(p_class->p_pools[i], ptr)) {
+            am_mempool_free(p_class->p_pools[i], ptr);
+            return;
+        }
+    }
+
+    if (p_class->p_heap != NULL) {
+        am_memheap_free(ptr);
+    }
+}
+
+/* end of file */
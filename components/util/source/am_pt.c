@@ -0,0 +1,173 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief Эʵ
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "am_pt.h"
+#include "am_int.h"
+
+/*******************************************************************************
+  Local defines
+*******************************************************************************/
+
+#define __PT_TASK_STAT_IDLE      0   /* δѽ */
+#define __PT_TASK_STAT_RUNNING   1   /*        */
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/* ִһЭ̺ */
+static void __pt_task_run (void *p_arg)
+{
+    am_pt_task_t *p_task = (am_pt_task_t *)p_arg;
+    int           ret;
+
+    if (p_task->stat != __PT_TASK_STAT_RUNNING) {
+        return;
+    }
+
+    ret = p_task->pfn_thread(p_task, p_task->p_arg);
+
+    if (ret == AM_PT_YIELDED) {
+        (void)am_jobq_post(p_task->jobq, &p_task->job);
+    } else if (ret != AM_PT_WAITING) {
+        am_pt_task_stop(p_task);
+    }
+}
+
+/* ʱ */
+static void __pt_task_timer_callback (void *p_arg)
+{
+    am_pt_task_t *p_task = (am_pt_task_t *)p_arg;
+
+    am_softimer_stop(&p_task->timer);
+
+    am_pt_task_wake(p_task);
+}
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+int am_pt_task_init (am_pt_task_t     *p_task,
+                     am_jobq_handle_t  jobq,
+                     am_pt_thread_t    pfn_thread,
+                     void             *p_arg,
+                     uint16_t          pri)
+{
+    if ((p_task == NULL) || (jobq == NULL) || (pfn_thread == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    AM_PT_INIT(&p_task->pt);
+
+    p_task->signal     = 0;
+    p_task->stat       = __PT_TASK_STAT_IDLE;
+    p_task->pfn_thread = pfn_thread;
+    p_task->p_arg      = p_arg;
+    p_task->jobq       = jobq;
+
+    am_jobq_job_init(&p_task->job, __pt_task_run, p_task, pri);
+
+    return am_softimer_init(&p_task->timer, __pt_task_timer_callback, p_task);
+}
+
+/******************************************************************************/
+int am_pt_task_start (am_pt_task_t *p_task)
+{
+    if ((p_task == NULL) || (p_task->pfn_thread == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    if (p_task->stat == __PT_TASK_STAT_RUNNING) {
+        return -AM_EBUSY;
+    }
+
+    AM_PT_INIT(&p_task->pt);
+
+    p_task->signal = 0;
+    p_task->stat   = __PT_TASK_STAT_RUNNING;
+
+    (void)am_jobq_post(p_task->jobq, &p_task->job);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_pt_task_stop (am_pt_task_t *p_task)
+{
+    if (p_task == NULL) {
+        return;
+    }
+
+    p_task->stat = __PT_TASK_STAT_IDLE;
+
+    am_softimer_stop(&p_task->timer);
+}
+
+/******************************************************************************/
+am_bool_t am_pt_task_is_running (am_pt_task_t *p_task)
+{
+    return (am_bool_t)((p_task != NULL) &&
+                       (p_task->stat == __PT_TASK_STAT_RUNNING));
+}
+
+/******************************************************************************/
+void am_pt_task_wake (void *p_arg)
+{
+    am_pt_task_t *p_task = (am_pt_task_t *)p_arg;
+
+    if (p_task == NULL) {
+        return;
+    }
+
+    p_task->signal = 1;
+
+    /* ʱ -AM_EBUSYִʱͬ鵽ź */
+    (void)am_jobq_post(p_task->jobq, &p_task->job);
+}
+
+/******************************************************************************/
+am_bool_t am_pt_task_signal_take (am_pt_task_t *p_task)
+{
+    am_bool_t signal;
+    int       key;
+
+    key = am_int_cpu_lock();
+    signal = (am_bool_t)(p_task->signal != 0);
+    p_task->signal = 0;
+    am_int_cpu_unlock(key);
+
+    return signal;
+}
+
+/******************************************************************************/
+void am_pt_task_signal_clear (am_pt_task_t *p_task)
+{
+    p_task->signal = 0;
+}
+
+/******************************************************************************/
+void am_pt_task_timer_start (am_pt_task_t *p_task, unsigned int ms)
+{
+    am_softimer_start(&p_task->timer, ms);
+}
+
+/* end of file */
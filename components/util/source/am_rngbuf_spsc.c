@@ -0,0 +1,255 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief /ߣSPSCλ
+ *
+ * head д뷽޸ģtail ɶ޸ģ߾ɵֵΪЧ
+ * ȡԷļֵʹ acquire 壬֮ݣռ䣩ķʲǰ
+ * Լļֵʹ release 壬֮ǰݣռ䣩ķʲƺԼ
+ * ֵֻԼ޸ģֱӶȡɡ
+ *
+ * \internal
+ * \par modification history
+ * - 1.01 26-10-16  ljy, use acquire/release ordering, read the counter of the
+ *                  other side only once
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "am_rngbuf_spsc.h"
+#include "am_common.h"          /* for min()    */
+#include <string.h>             /* for memcpy() */
+
+/*******************************************************************************
+  ȡԷֵacquireͷԼļֵrelease
+*******************************************************************************/
+
+#if defined(__GNUC__) && !defined(__CC_ARM)
+#define __SPSC_LOAD_ACQ(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define __SPSC_STORE_REL(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+
+#if defined(__CC_ARM)
+#define __SPSC_MB()    do {                                         \
+                           __schedule_barrier();                    \
+                           __dmb(0xF);                              \
+                           __schedule_barrier();                    \
+                       } while (0)
+#elif defined(__ICCARM__)
+#include <intrinsics.h>
+#define __SPSC_MB()    __DMB()
+#else
+#define __SPSC_MB()
+#endif
+
+am_static_inline
+uint32_t __spsc_load_acq (volatile uint32_t *p)
+{
+    uint32_t val = *p;
+
+    __SPSC_MB();
+
+    return val;
+}
+
+#define __SPSC_LOAD_ACQ(p)        __spsc_load_acq(p)
+#define __SPSC_STORE_REL(p, v)    do {                              \
+                                      __SPSC_MB();                  \
+                                      *(p) = (v);                   \
+                                  } while (0)
+#endif
+
+/******************************************************************************/
+int am_rngbuf_spsc_init (struct am_rngbuf_spsc *p_rb, char *p_buf, size_t size)
+{
+    /* СΪ 2^nҼֵ */
+    if ((p_rb == NULL) || (p_buf == NULL) || (size == 0) ||
+        ((size & (size - 1)) != 0) || (size > 0x80000000ul)) {
+        return -AM_EINVAL;
+    }
+
+    p_rb->head = 0;
+    p_rb->tail = 0;
+    p_rb->mask = size - 1;
+    p_rb->buf  = p_buf;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_rngbuf_spsc_putchar (am_rngbuf_spsc_t rb, const char data)
+{
+    uint32_t head = rb->head;
+    uint32_t tail = __SPSC_LOAD_ACQ(&rb->tail);  /* ͷſռܸ */
+
+    if (head - tail > rb->mask) {
+        return 0;
+    }
+
+    rb->buf[head & rb->mask] = data;
+
+    __SPSC_STORE_REL(&rb->head, head + 1);         /* дٷ head    */
+
+    return 1;
+}
+
+/******************************************************************************/
+int am_rngbuf_spsc_getchar (am_rngbuf_spsc_t rb, char *p_data)
+{
+    uint32_t tail = rb->tail;
+    uint32_t head = __SPSC_LOAD_ACQ(&rb->head);  /*  head ܶȡ */
+
+    if (tail == head) {
+        return 0;
+    }
+
+    *p_data = rb->buf[tail & rb->mask];
+
+    __SPSC_STORE_REL(&rb->tail, tail + 1);         /* ݶٷ tail    */
+
+    return 1;
+}
+
+/******************************************************************************/
+size_t am_rngbuf_spsc_put (am_rngbuf_spsc_t rb, const char *p_buf, size_t nbytes)
+{
+    uint32_t head  = rb->head;
+    uint32_t nfree = rb->mask + 1 - (head - __SPSC_LOAD_ACQ(&rb->tail));
+    uint32_t off   = head & rb->mask;
+    size_t   len;
+
+    nbytes = min(nbytes, (size_t)nfree);
+
+    /* 䵽ĩβʣಿִӻʼ */
+    len = min(nbytes, (size_t)(rb->mask + 1 - off));
+    memcpy(rb->buf + off, p_buf, len);
+    memcpy(rb->buf, p_buf + len, nbytes - len);
+
+    __SPSC_STORE_REL(&rb->head, head + nbytes);
+
+    return nbytes;
+}
+
+/******************************************************************************/
+size_t am_rngbuf_spsc_get (am_rngbuf_spsc_t rb, char *p_buf, size_t nbytes)
+{
+    uint32_t tail = rb->tail;
+    uint32_t used = __SPSC_LOAD_ACQ(&rb->head) - tail;
+    uint32_t off  = tail & rb->mask;
+    size_t   len;
+
+    nbytes = min(nbytes, (size_t)used);
+
+    len = min(nbytes, (size_t)(rb->mask + 1 - off));
+    memcpy(p_buf, rb->buf + off, len);
+    memcpy(p_buf + len, rb->buf, nbytes - len);
+
+    __SPSC_STORE_REL(&rb->tail, tail + nbytes);
+
+    return nbytes;
+}
+
+/******************************************************************************/
+int am_rngbuf_spsc_reserve_write (am_rngbuf_spsc_t   rb,
+                                  char             **pp_buf,
+                                  size_t            *p_len)
+{
+    uint32_t head  = rb->head;
+    uint32_t nfree = rb->mask + 1 - (head - __SPSC_LOAD_ACQ(&rb->tail));
+    uint32_t off   = head & rb->mask;
+
+    if (nfree == 0) {
+        return -AM_EFULL;
+    }
+
+    *pp_buf = rb->buf + off;
+    *p_len  = min(nfree, rb->mask + 1 - off);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_rngbuf_spsc_commit_write (am_rngbuf_spsc_t rb, size_t n)
+{
+    uint32_t head  = rb->head;
+    uint32_t nfree = rb->mask + 1 - (head - __SPSC_LOAD_ACQ(&rb->tail));
+
+    n = min(n, (size_t)nfree);
+
+    __SPSC_STORE_REL(&rb->head, head + n);
+}
+
+/******************************************************************************/
+int am_rngbuf_spsc_peek_read (am_rngbuf_spsc_t   rb,
+                              char             **pp_buf,
+                              size_t            *p_len)
+{
+    uint32_t tail = rb->tail;
+    uint32_t used = __SPSC_LOAD_ACQ(&rb->head) - tail;
+    uint32_t off  = tail & rb->mask;
+
+    if (used == 0) {
+        return -AM_EEMPTY;
+    }
+
+    *pp_buf = rb->buf + off;
+    *p_len  = min(used, rb->mask + 1 - off);
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+void am_rngbuf_spsc_consume (am_rngbuf_spsc_t rb, size_t n)
+{
+    uint32_t tail = rb->tail;
+    uint32_t used = __SPSC_LOAD_ACQ(&rb->head) - tail;
+
+    n = min(n, (size_t)used);
+
+    __SPSC_STORE_REL(&rb->tail, tail + n);
+}
+
+/******************************************************************************/
+void am_rngbuf_spsc_flush (am_rngbuf_spsc_t rb)
+{
+    __SPSC_STORE_REL(&rb->tail, __SPSC_LOAD_ACQ(&rb->head));
+}
+
+/******************************************************************************/
+am_bool_t am_rngbuf_spsc_isempty (am_rngbuf_spsc_t rb)
+{
+    return (am_bool_t)(am_rngbuf_spsc_nbytes(rb) == 0);
+}
+
+/******************************************************************************/
+am_bool_t am_rngbuf_spsc_isfull (am_rngbuf_spsc_t rb)
+{
+    return (am_bool_t)(am_rngbuf_spsc_nbytes(rb) > rb->mask);
+}
+
+/******************************************************************************/
+size_t am_rngbuf_spsc_freebytes (am_rngbuf_spsc_t rb)
+{
+    return rb->mask + 1 - am_rngbuf_spsc_nbytes(rb);
+}
+
+/******************************************************************************/
+size_t am_rngbuf_spsc_nbytes (am_rngbuf_spsc_t rb)
+{
+    uint32_t tail = __SPSC_LOAD_ACQ(&rb->tail);
+
+    return __SPSC_LOAD_ACQ(&rb->head) - tail;
+}
+
+/* end of file */
@@ -0,0 +1,125 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief źʵ
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "am_sem.h"
+#include "am_int.h"
+
+/*******************************************************************************
+  Local functions
+*******************************************************************************/
+
+/* 鲢ȡźʱжѹر */
+static am_bool_t __sem_take (am_wait_src_t *p_src, am_bool_t take)
+{
+    am_sem_t *p_sem = (am_sem_t *)p_src->p_obj;
+
+    if (p_sem->count == 0) {
+        return AM_FALSE;
+    }
+
+    if (take) {
+        p_src->val = p_sem->count;
+        p_sem->count--;
+    }
+
+    return AM_TRUE;
+}
+
+/*******************************************************************************
+  Public functions
+*******************************************************************************/
+int am_sem_init (am_sem_t *p_sem, uint32_t init, uint32_t max)
+{
+    if ((p_sem == NULL) || (max == 0) || (init > max)) {
+        return -AM_EINVAL;
+    }
+
+    p_sem->count = init;
+    p_sem->max   = max;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_sem_give (am_sem_t *p_sem)
+{
+    int key;
+
+    if (p_sem == NULL) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    if (p_sem->count >= p_sem->max) {
+        am_int_cpu_unlock(key);
+        return -AM_EFULL;
+    }
+
+    p_sem->count++;
+
+    am_int_cpu_unlock(key);
+
+    am_wait_wake();
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_sem_src_init (am_wait_src_t *p_src, am_sem_t *p_sem)
+{
+    if ((p_src == NULL) || (p_sem == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    p_src->pfn_take = __sem_take;
+    p_src->p_obj    = p_sem;
+    p_src->arg      = 0;
+    p_src->opt      = 0;
+    p_src->val      = 0;
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_sem_take (am_sem_t *p_sem, uint32_t timeout_ms)
+{
+    am_wait_src_t src;
+    int           ret;
+
+    ret = am_sem_src_init(&src, p_sem);
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    ret = am_wait_any(&src, 1, timeout_ms);
+
+    return (ret < 0) ? ret : AM_OK;
+}
+
+/******************************************************************************/
+uint32_t am_sem_count_get (am_sem_t *p_sem)
+{
+    return p_sem->count;
+}
+
+/* end of file */
@@ -16,6 +16,11 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.05 26-10-16  ljy, process a single tick without searching ahead
+ * - 1.04 26-10-16  ljy, tickless: keep the tick phase across reprogramming
+ * - 1.03 26-10-16  ljy, add deferred callbacks and statistics
+ * - 1.02 26-10-16  ljy, add tickless mode
+ * - 1.01 26-10-16  ljy, add hierarchical timing wheel (AM_SOFTIMER_WHEEL)
  * - 1.00 15-08-03  tee, first implementation.
  * \endinternal
  */
@@ -23,22 +28,226 @@
 #include "am_softimer.h"
 #include "am_common.h"
 #include "am_int.h"
+#include "am_isr_defer.h"
 
 /** \brief ʱӲʱƵʣʱƵʲΪ0 */
 static unsigned int __g_hwtimer_freq = 0;
 
-/** \brief ʱͷ */
-static struct am_list_head g_softimer_head;
-
 /******************************************************************************/
 static unsigned int __ms_to_ticks (unsigned int ms)
 {
     if (__g_hwtimer_freq != 0) {
-        return  AM_DIV_ROUND_UP(__g_hwtimer_freq * ms, 1000u);
+        return  (unsigned int)AM_DIV_ROUND_UP((uint64_t)__g_hwtimer_freq * ms,
+                                              1000u);
     }
     return 0;
 }
 
+#ifdef AM_SOFTIMER_WHEEL
+
+/*******************************************************************************
+  ֲʱʵ
+
+   AM_SOFTIMER_WHEEL_LEVELS 㣬ÿ 2^AM_SOFTIMER_WHEEL_BITS ۣ n ÿ
+  ۵ĿΪ 2^(n * AM_SOFTIMER_WHEEL_BITS)  tickʱ ticks Ա
+  ǵʱ̣ tick ֵ롢ɾΪʱ䣻ͲÿתһȦ߲Ӧ
+  еĶʱ·䵽Ͳ㣨ʱַΧĶʱ߲ԶĲ
+  Уʱʣʱ·䡣
+*******************************************************************************/
+
+/** \brief ÿʱֲĿλ */
+#ifndef AM_SOFTIMER_WHEEL_BITS
+#define AM_SOFTIMER_WHEEL_BITS    4
+#endif
+
+/** \brief ʱֵĲ */
+#ifndef AM_SOFTIMER_WHEEL_LEVELS
+#define AM_SOFTIMER_WHEEL_LEVELS  4
+#endif
+
+#if (AM_SOFTIMER_WHEEL_BITS * AM_SOFTIMER_WHEEL_LEVELS) > 31
+#error "AM_SOFTIMER_WHEEL_BITS * AM_SOFTIMER_WHEEL_LEVELS must not exceed 31"
+#endif
+
+#define __WHEEL_SIZE       (1u << AM_SOFTIMER_WHEEL_BITS)
+#define __WHEEL_MASK       (__WHEEL_SIZE - 1)
+
+/** \brief  lvl ɵ tick  */
+#define __WHEEL_SPAN(lvl)  (1ul << (AM_SOFTIMER_WHEEL_BITS * ((lvl) + 1)))
+
+/** \brief ʱֱӱʾ tick  */
+#define __WHEEL_MAX_TICKS  (__WHEEL_SPAN(AM_SOFTIMER_WHEEL_LEVELS - 1) - 1)
+
+/** \brief ʱָĲ */
+static struct am_list_head __g_softimer_wheel[AM_SOFTIMER_WHEEL_LEVELS]
+                                             [__WHEEL_SIZE];
+
+/** \brief ʱֵǰʱ̣Ѵ tick  */
+static unsigned int __g_softimer_jiffies;
+
+/******************************************************************************/
+static void __softimer_list_init (void)
+{
+    int          lvl;
+    unsigned int slot;
+
+    for (lvl = 0; lvl < AM_SOFTIMER_WHEEL_LEVELS; lvl++) {
+        for (slot = 0; slot < __WHEEL_SIZE; slot++) {
+            AM_INIT_LIST_HEAD(&__g_softimer_wheel[lvl][slot]);
+        }
+    }
+    __g_softimer_jiffies = 0;
+}
+
+/******************************************************************************/
+static void __softimer_add (am_softimer_t *p_timer, unsigned int ticks)
+{
+    unsigned int idx = ticks;
+    unsigned int slot;
+    int          lvl;
+
+    p_timer->ticks = __g_softimer_jiffies + ticks;     /* ¼ʱ       */
+
+    if (idx > __WHEEL_MAX_TICKS) {                     /* ΧԶ */
+        idx = __WHEEL_MAX_TICKS;
+    }
+
+    for (lvl = 0; lvl < AM_SOFTIMER_WHEEL_LEVELS - 1; lvl++) {
+        if (idx < __WHEEL_SPAN(lvl)) {
+            break;
+        }
+    }
+
+    slot = ((__g_softimer_jiffies + idx) >> (AM_SOFTIMER_WHEEL_BITS * lvl)) &
+           __WHEEL_MASK;
+
+    am_list_add_tail(&p_timer->node, &__g_softimer_wheel[lvl][slot]);
+}
+
+/******************************************************************************/
+static void __softimer_remove (am_softimer_t *p_timer)
+{
+    am_list_del_init(&p_timer->node);
+}
+
+/******************************************************************************/
+static void __softimer_cascade (int lvl, unsigned int slot)
+{
+    struct am_list_head *p, *n;
+    struct am_list_head *p_head = &__g_softimer_wheel[lvl][slot];
+    am_softimer_t       *p_timer;
+
+    am_list_for_each_safe(p, n, p_head) {
+        p_timer = am_list_entry(p, am_softimer_t, node);
+        am_list_del_init(p);
+        __softimer_add(p_timer, p_timer->ticks - __g_softimer_jiffies);
+    }
+}
+
+/******************************************************************************/
+static void __softimer_advance (unsigned int nticks)
+{
+    unsigned int step;
+    int          lvl;
+
+    /*
+     * nticks  __softimer_next_ticks()Ĳ۾ΪգֻÿͲ
+     * תһȦʱ̼߲Ĳ
+     */
+    while (nticks > 0) {
+
+        step = __WHEEL_SIZE - (__g_softimer_jiffies & __WHEEL_MASK);
+
+        if (nticks < step) {
+            __g_softimer_jiffies += nticks;
+            break;
+        }
+
+        __g_softimer_jiffies += step;
+        nticks               -= step;
+
+        /* ͲתһȦ߲Ĳ */
+        for (lvl = 1; lvl < AM_SOFTIMER_WHEEL_LEVELS; lvl++) {
+            if (__g_softimer_jiffies &
+                ((1ul << (AM_SOFTIMER_WHEEL_BITS * lvl)) - 1)) {
+                break;
+            }
+            __softimer_cascade(lvl,
+                               (__g_softimer_jiffies >>
+                               (AM_SOFTIMER_WHEEL_BITS * lvl)) & __WHEEL_MASK);
+        }
+    }
+}
+
+/******************************************************************************/
+static unsigned int __softimer_next_ticks (void)
+{
+    unsigned int cur, k, dist;
+    unsigned int min_dist = 0;
+    int          lvl;
+
+    /*
+     * ÿҵһǿյĲۣ㴦 0 㣩㣩ò۵ʱ̣
+     * ʱ̼ΪһҪʱ
+     */
+    for (lvl = 0; lvl < AM_SOFTIMER_WHEEL_LEVELS; lvl++) {
+
+        cur = (__g_softimer_jiffies >> (AM_SOFTIMER_WHEEL_BITS * lvl));
+
+        for (k = 1; k <= __WHEEL_SIZE; k++) {
+            if (!am_list_empty(
+                    &__g_softimer_wheel[lvl][(cur + k) & __WHEEL_MASK])) {
+                break;
+            }
+        }
+
+        if (k > __WHEEL_SIZE) {
+            continue;
+        }
+
+        dist = ((cur + k) << (AM_SOFTIMER_WHEEL_BITS * lvl)) -
+               __g_softimer_jiffies;
+
+        if ((min_dist == 0) || (dist < min_dist)) {
+            min_dist = dist;
+        }
+    }
+
+    return min_dist;
+}
+
+/******************************************************************************/
+static am_softimer_t *__softimer_expired_get (void)
+{
+    struct am_list_head *p_head;
+
+    p_head = &__g_softimer_wheel[0][__g_softimer_jiffies & __WHEEL_MASK];
+
+    if (am_list_empty(p_head)) {
+        return NULL;
+    }
+
+    return am_list_entry(p_head->next, am_softimer_t, node);
+}
+
+#else
+
+/*******************************************************************************
+  ʵ
+
+  ʱȺУÿʱ ticks Աǰһʱʱ̵
+  ֵÿ tick ֻ账׸ʱ
+*******************************************************************************/
+
+/** \brief ʱͷ */
+static struct am_list_head g_softimer_head;
+
+/******************************************************************************/
+static void __softimer_list_init (void)
+{
+    AM_INIT_LIST_HEAD(&g_softimer_head);
+}
+
 /******************************************************************************/
 static void __softimer_add (am_softimer_t *p_timer, unsigned int ticks)
 {
@@ -80,65 +289,360 @@ static void __softimer_remove (am_softimer_t *p_timer)
     am_list_del_init(&p_timer->node);
 }
 
-/* ԳʼָƵʵøú  */
-void am_softimer_module_tick (void)
+/******************************************************************************/
+static void __softimer_advance (unsigned int nticks)
 {
-    struct am_list_head *p;
-    am_softimer_t       *p_timer;
-
-    int old = am_int_cpu_lock();
+    am_softimer_t *p_timer;
 
-    /* ׸ڵм1ʱȷ */
+    /* ׸ڵмnticks ׸ڵʣʱ䣩 */
     if ( !am_list_empty( &g_softimer_head ) ) {
 
         /* ָһЧԪؽڵ */
-        p       = (&g_softimer_head)->next;
-        p_timer = am_list_entry(p, am_softimer_t, node);
+        p_timer = am_list_entry(g_softimer_head.next, am_softimer_t, node);
 
         /*
-         * ׽ڵֵ1
+         * ׽ڵֵ nticks
          */
-        if (p_timer->ticks) {
-            p_timer->ticks--;
+        p_timer->ticks -= min(p_timer->ticks, nticks);
+    }
+}
+
+/******************************************************************************/
+static unsigned int __softimer_next_ticks (void)
+{
+    if (am_list_empty(&g_softimer_head)) {
+        return 0;
+    }
+
+    return am_list_entry(g_softimer_head.next, am_softimer_t, node)->ticks;
+}
+
+/******************************************************************************/
+static am_softimer_t *__softimer_expired_get (void)
+{
+    am_softimer_t *p_timer;
+
+    if (am_list_empty(&g_softimer_head)) {
+        return NULL;
+    }
+
+    /*
+     * һЧԪ,ýȻڵһ
+     * (ڵһ㣬ֵҲΪ 0´ɨͻ˳)
+     */
+    p_timer = am_list_entry(g_softimer_head.next, am_softimer_t, node);
+
+    /* ֻҪΪ0Ľ㣬ûеڵĶʱ */
+    return (p_timer->ticks == 0) ? p_timer : NULL;
+}
+
+#endif /* AM_SOFTIMER_WHEEL */
+
+/*******************************************************************************
+  صͳ
+*******************************************************************************/
+
+/** \brief ͳϢ */
+static struct am_softimer_stat __g_softimer_stat;
+
+/** \brief ͳƻصִʱʱΪ NULL ʱͳ */
+static uint32_t (*__g_softimer_pfn_timestamp) (void) = NULL;
+
+/**
+ * \brief öʱĻصͳִʱ䣨жϣ
+ */
+static void __softimer_callback_call (am_softimer_t *p_timer)
+{
+    uint32_t (*pfn_timestamp) (void) = __g_softimer_pfn_timestamp;
+    uint32_t  start = 0;
+    uint32_t  time;
+    int       old;
+
+    if (p_timer->timeout_callback == NULL) {
+        return;
+    }
+
+    if (pfn_timestamp != NULL) {
+        start = pfn_timestamp();
+    }
+
+    p_timer->timeout_callback(p_timer->p_arg);
+
+    if (pfn_timestamp != NULL) {
+        time = pfn_timestamp() - start;
+
+        old = am_int_cpu_lock();
+        if (time > __g_softimer_stat.cb_time_max) {
+            __g_softimer_stat.cb_time_max = time;
         }
+        am_int_cpu_unlock(old);
     }
+}
+
+/**
+ * \brief ӳжӳеöʱĻص
+ */
+static void __softimer_defer_job (void *p_arg)
+{
+    int old = am_int_cpu_lock();
+
+    __g_softimer_stat.defer_pending--;
 
     am_int_cpu_unlock(old);
 
-    old = am_int_cpu_lock();
+    __softimer_callback_call((am_softimer_t *)p_arg);
+}
 
-    /* ׸ڵ㣬Ϊ 0 ȡ  */
-    while (!am_list_empty(&g_softimer_head)) {
+/******************************************************************************/
 
-        p       = (&g_softimer_head)->next;
-        p_timer = am_list_entry(p, am_softimer_t, node);
+/**
+ * \brief ڵĶʱǰرжϣp_old Ϊжϵķֵ
+ */
+static void __softimer_expire (int *p_old)
+{
+    am_softimer_t *p_timer;
 
-        /*
-         * һЧԪ,ýȻڵһ
-         * (ڵһ㣬ֵҲΪ 0´ɨͻ˳)
-         */
-        if (p_timer->ticks == 0) {
+    /* ȡεڵĶʱ */
+    while ((p_timer = __softimer_expired_get()) != NULL) {
 
-            /* ýڵ㱾ζʱʱ䵽ɾýڵ                  */
-            am_list_del_init(&p_timer->node);
+        /* ýڵ㱾ζʱʱ䵽ɾýڵ                  */
+        am_list_del_init(&p_timer->node);
 
-            /* ڻصֹͣȽӽ  */
-            __softimer_add(p_timer, p_timer->repeat_ticks);
+        /* ڻصֹͣȽӽ  */
+        __softimer_add(p_timer, p_timer->repeat_ticks);
 
-            /* صʱ Ϊж */
-            am_int_cpu_unlock(old);
+        /* ӳٴĶʱжֻӳ񣬲ж */
+        if (p_timer->p_job != NULL) {
 
-            if (p_timer->timeout_callback ) {
-                p_timer->timeout_callback(p_timer->p_arg);
+            if (am_isr_defer_job_add(p_timer->p_job) == AM_OK) {
+                if (++__g_softimer_stat.defer_pending >
+                    __g_softimer_stat.defer_pending_max) {
+                    __g_softimer_stat.defer_pending_max =
+                        __g_softimer_stat.defer_pending;
+                }
+            } else {
+
+                /* һεڵĻصδκϲһ */
+                __g_softimer_stat.defer_overrun++;
             }
+            continue;
+        }
 
-            old = am_int_cpu_lock();
+        /* صʱ Ϊж */
+        am_int_cpu_unlock(*p_old);
 
-        /* ֻҪΪ0Ľ㣬˳ѭ */
-        } else {
+        __softimer_callback_call(p_timer);
+
+        *p_old = am_int_cpu_lock();
+    }
+}
+
+/**
+ * \brief ʹʱǰ nticks  tickڼ䵽ڵĶʱرжϣ
+ */
+static void __softimer_process (unsigned int nticks, int *p_old)
+{
+    unsigned int next;
+
+    /*
+     * ͨģʽÿ tick һΣǰһ tick ܲԽڵĶʱֱ
+     * ǰʱ̼ɣһҪʱ̣ʱɨĲۣ
+     */
+    if (nticks == 1) {
+        __softimer_advance(1);
+        __softimer_expire(p_old);
+        return;
+    }
+
+    while (nticks > 0) {
+
+        next = __softimer_next_ticks();
+
+        if ((next == 0) || (next > nticks)) {
+            __softimer_advance(nticks);
             break;
         }
+
+        __softimer_advance(next);
+        nticks -= next;
+
+        __softimer_expire(p_old);
     }
+}
+
+/*******************************************************************************
+  ޵δticklessģʽ
+
+  ʱģռһӲʱͨÿֻʱΪһҪ
+  ʱ̣жвʵʾ tick 
+*******************************************************************************/
+
+/** \brief ޵δģʽʹõӲʱΪ NULL ʱʾͨģʽ */
+static am_timer_handle_t __g_tickless_handle = NULL;
+
+/** \brief ޵δģʽʹõӲʱͨ */
+static uint8_t           __g_tickless_chan;
+
+/** \brief ӲʱǷΪ 64 λʱ */
+static am_bool_t         __g_tickless_64bit;
+
+/** \brief һ tick ӦӲʱֵ */
+static uint32_t          __g_tickless_cpt;
+
+/** \brief Ӳʱһõ tick  */
+static uint32_t          __g_tickless_max;
+
+/** \brief ǰӲʱڶӦ tick Ϊ 0 ʾӲʱδ */
+static uint32_t          __g_tickless_period;
+
+/** \brief ǰӲʱѾ tick  */
+static uint32_t          __g_tickless_done;
+
+/**
+ * \brief õǰӲʱʱһ tick ѾļֵӲֵ
+ *        ϸֵǴӵһ tick ļֵ
+ */
+static uint32_t          __g_tickless_offset;
+
+/** \brief ждʱʱʱӲʱ */
+static am_bool_t         __g_tickless_busy;
+
+/******************************************************************************/
+static uint32_t __tickless_count_get (void)
+{
+    uint32_t count   = 0;
+    uint64_t count64 = 0;
+
+    if (__g_tickless_64bit) {
+        am_timer_count_get64(__g_tickless_handle, __g_tickless_chan, &count64);
+        count = (uint32_t)count64;
+    } else {
+        am_timer_count_get(__g_tickless_handle, __g_tickless_chan, &count);
+    }
+
+    return count;
+}
+
+/**
+ * \brief ǰӲʱѾ tickرжϣ
+ *
+ * \return ǰ tick Ѿļֵ
+ */
+static uint32_t __tickless_sync (int *p_old)
+{
+    uint32_t count;
+    uint32_t elapsed;
+    uint32_t frac;
+
+    if (__g_tickless_period == 0) {
+        return 0;
+    }
+
+    count   = __tickless_count_get() + __g_tickless_offset;
+    elapsed = count / __g_tickless_cpt;
+
+    /* Ѿжϻδжϴʣ tick */
+    if (elapsed >= __g_tickless_period) {
+        elapsed = __g_tickless_period - 1;
+    }
+
+    if (elapsed > __g_tickless_done) {
+
+        uint32_t  nticks = elapsed - __g_tickless_done;
+        am_bool_t busy   = __g_tickless_busy;
+
+        /* ȸѴ tick صʱʱظ */
+        __g_tickless_done = elapsed;
+        __g_tickless_busy = AM_TRUE;
+
+        __softimer_process(nticks, p_old);
+
+        __g_tickless_busy = busy;
+    }
+
+    /* Ѿʱֻһ tick Ĳ֣µڲС 0 */
+    frac = count - elapsed * __g_tickless_cpt;
+    if (frac >= __g_tickless_cpt) {
+        frac = __g_tickless_cpt - 1;
+    }
+
+    return frac;
+}
+
+/**
+ * \brief һҪʱӲʱرжϣ
+ *
+ * \param[in] frac : ǰ tick ѾļֵµڴӸ tick 
+ */
+static void __tickless_program (uint32_t frac)
+{
+    uint32_t next = __softimer_next_ticks();
+
+    if (next == 0) {
+        am_timer_disable(__g_tickless_handle, __g_tickless_chan);
+        __g_tickless_period = 0;
+        return;
+    }
+
+    if (next > __g_tickless_max) {
+        next = __g_tickless_max;
+    }
+
+    __g_tickless_period = next;
+    __g_tickless_done   = 0;
+    __g_tickless_offset = frac;
+
+    if (__g_tickless_64bit) {
+        am_timer_enable64(__g_tickless_handle,
+                          __g_tickless_chan,
+                          (uint64_t)next * __g_tickless_cpt - frac);
+    } else {
+        am_timer_enable(__g_tickless_handle,
+                        __g_tickless_chan,
+                        next * __g_tickless_cpt - frac);
+    }
+}
+
+/**
+ * \brief Ӳʱжϻصڽʱڵ tick Ѿ
+ */
+static void __tickless_callback (void *p_arg)
+{
+    uint32_t frac;
+    int      old = am_int_cpu_lock();
+
+    __g_tickless_busy = AM_TRUE;
+
+    if (__g_tickless_period != 0) {
+        __softimer_process(__g_tickless_period - __g_tickless_done, &old);
+
+        /*
+         * Ӳʱڽtick 㣩 0 ¿ʼ
+         * صڼ侭ʱ
+         */
+        __g_tickless_done   = 0;
+        __g_tickless_offset = 0;
+        frac = __tickless_sync(&old);
+    } else {
+        frac = 0;
+    }
+
+    __tickless_program(frac);
+
+    __g_tickless_busy = AM_FALSE;
+
+    am_int_cpu_unlock(old);
+}
+
+/******************************************************************************/
+
+/* ԳʼָƵʵøú  */
+void am_softimer_module_tick (void)
+{
+    int old = am_int_cpu_lock();
+
+    __softimer_process(1, &old);
+
     am_int_cpu_unlock(old);
 }
 
@@ -149,10 +653,73 @@ int am_softimer_module_init (unsigned int clkrate)
         return -AM_EINVAL;
     }
 
-    AM_INIT_LIST_HEAD(&g_softimer_head);
-    __g_hwtimer_freq = clkrate;
+    __softimer_list_init();
+    __g_tickless_handle = NULL;
+    __g_hwtimer_freq    = clkrate;
     return 0;
 }
+
+/******************************************************************************/
+int am_softimer_module_init_tickless (am_timer_handle_t handle,
+                                      uint8_t           chan,
+                                      unsigned int      clkrate)
+{
+    const am_timer_info_t *p_info;
+    uint32_t               count_freq;
+    uint64_t               max_count;
+
+    if ((handle == NULL) || (clkrate == 0)) {
+        return -AM_EINVAL;
+    }
+
+    p_info = am_timer_info_get(handle);
+
+    if ((p_info == NULL) ||
+        (am_timer_count_freq_get(handle, chan, &count_freq) != AM_OK) ||
+        (count_freq < clkrate)) {
+        return -AM_EINVAL;
+    }
+
+    if (p_info->counter_width >= 32) {
+        max_count = 0xFFFFFFFFul;
+    } else {
+        max_count = (1ul << p_info->counter_width) - 1;
+    }
+
+    am_timer_disable(handle, chan);
+
+    __softimer_list_init();
+
+    __g_tickless_handle = handle;
+    __g_tickless_chan   = chan;
+    __g_tickless_64bit  = (am_bool_t)(p_info->counter_width > 32);
+    __g_tickless_cpt    = count_freq / clkrate;
+    __g_tickless_max    = (uint32_t)(max_count / __g_tickless_cpt);
+    __g_tickless_period = 0;
+    __g_tickless_done   = 0;
+    __g_tickless_offset = 0;
+    __g_tickless_busy   = AM_FALSE;
+    __g_hwtimer_freq    = clkrate;
+
+    return am_timer_callback_set(handle, chan, __tickless_callback, NULL);
+}
+
+/******************************************************************************/
+unsigned int am_softimer_next_expiry_ticks (void)
+{
+    unsigned int ticks;
+    int          old = am_int_cpu_lock();
+
+    if (__g_tickless_handle != NULL) {
+        __tickless_sync(&old);
+    }
+
+    ticks = __softimer_next_ticks();
+
+    am_int_cpu_unlock(old);
+
+    return (ticks == 0) ? AM_SOFTIMER_TICKS_FOREVER : ticks;
+}
  
 /******************************************************************************/
 int am_softimer_init (am_softimer_t *p_timer, 
@@ -171,12 +738,42 @@ int am_softimer_init (am_softimer_t *p_timer,
     
     p_timer->timeout_callback = p_func;
     p_timer->p_arg            = p_arg;
+    p_timer->p_job            = NULL;
     
     am_int_cpu_unlock(old);
     
     return AM_OK;
 }
 
+/******************************************************************************/
+int am_softimer_init_defer (am_softimer_t      *p_timer,
+                            am_isr_defer_job_t *p_job,
+                            am_pfnvoid_t        p_func,
+                            void               *p_arg,
+                            uint16_t            pri)
+{
+    int ret;
+    int old;
+
+    if ((p_timer == NULL) || (p_job == NULL)) {
+        return -AM_EINVAL;
+    }
+
+    ret = am_softimer_init(p_timer, p_func, p_arg);
+
+    if (ret != AM_OK) {
+        return ret;
+    }
+
+    am_isr_defer_job_init(p_job, __softimer_defer_job, p_timer, pri);
+
+    old = am_int_cpu_lock();
+    p_timer->p_job = p_job;
+    am_int_cpu_unlock(old);
+
+    return AM_OK;
+}
+
 /******************************************************************************/
 void am_softimer_start (am_softimer_t *p_timer, unsigned int ms)
 {
@@ -189,8 +786,23 @@ void am_softimer_start (am_softimer_t *p_timer, unsigned int ms)
     
     p_timer->repeat_ticks = ticks;
     
-    __softimer_remove(p_timer);
-    __softimer_add(p_timer, ticks);
+    if ((__g_tickless_handle != NULL) && !__g_tickless_busy) {
+
+        uint32_t frac = __tickless_sync(&old);
+
+        __softimer_remove(p_timer);
+        __softimer_add(p_timer, ticks);
+
+        /* µĶʱȵǰõĻʱ̸絽ڣӲʱ */
+        if ((__g_tickless_period == 0) ||
+            (__softimer_next_ticks() < __g_tickless_period - __g_tickless_done)) {
+            __tickless_program(frac);
+        }
+    } else {
+        __softimer_remove(p_timer);
+        __softimer_add(p_timer, ticks);
+    }
+
     am_int_cpu_unlock(old);
 }
 
@@ -203,4 +815,42 @@ void am_softimer_stop (am_softimer_t *p_timer)
     am_int_cpu_unlock(old);
 }
 
+/******************************************************************************/
+void am_softimer_stat_timestamp_set (uint32_t (*pfn_timestamp) (void))
+{
+    int old = am_int_cpu_lock();
+
+    __g_softimer_pfn_timestamp    = pfn_timestamp;
+    __g_softimer_stat.cb_time_max = 0;
+
+    am_int_cpu_unlock(old);
+}
+
+/******************************************************************************/
+void am_softimer_stat_get (struct am_softimer_stat *p_stat)
+{
+    int old;
+
+    if (p_stat == NULL) {
+        return;
+    }
+
+    old     = am_int_cpu_lock();
+    *p_stat = __g_softimer_stat;
+    am_int_cpu_unlock(old);
+}
+
+/******************************************************************************/
+void am_softimer_stat_reset (void)
+{
+    int old = am_int_cpu_lock();
+
+    /* ǰڶе */
+    __g_softimer_stat.defer_pending_max = __g_softimer_stat.defer_pending;
+    __g_softimer_stat.defer_overrun     = 0;
+    __g_softimer_stat.cb_time_max       = 0;
+
+    am_int_cpu_unlock(old);
+}
+
 /* end of file */
@@ -69,7 +69,7 @@ void am_debug_init (am_uart_handle_t handle, uint32_t baudrate)
 
     g_dbg_handle = handle;
 
-    am_uart_ioctl(handle, AM_UART_BAUD_SET, (void *)baudrate);
+    am_uart_ioctl(handle, AM_UART_BAUD_SET, (void *)(uintptr_t)baudrate);
     
 
 
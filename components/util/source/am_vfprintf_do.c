@@ -16,48 +16,190 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, output literal runs at once, convert integers without
+ *                        division
  * - 1.00 15-12-08  tee, first implementation from AWorks
  * \endinternal
  */
 
 #include "am_vdebug.h"
 #include <stdarg.h>
+#include <stdint.h>
+
+/* size of the buffer used to output literal runs through f_puts */
+#define __LITERAL_BUF_SIZE  32
+
+/* "00" ~ "99" */
+static const char __g_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char __g_hex_digits[2][17] = {
+    "0123456789ABCDEF",
+    "0123456789abcdef",
+};
 
 /**
- * \brief Format a string and output it.
+ * \brief val / 100, using multiplication by the reciprocal for 32-bit values
  *
- * This function do all the vXXXprintf() works, and it take 2 functions as
- * arguments to output the characters.
- * all other vXXXprintf() functions are based on this function.
+ * Cortex-M0 has no hardware divider, a library division costs much more than
+ * a multiplication.
+ */
+static unsigned long __div100 (unsigned long val)
+{
+    if (val <= 0xFFFFFFFFul) {
+        return (unsigned long)(((uint64_t)val * 0x51EB851Fu) >> 37);
+    }
+    return val / 100;
+}
+
+/**
+ * \brief output a run of literal characters
  *
- * \param fil       The handle for f_putc and f_puts functions
- * \param f_putc    Pointer to function to output a char
- * \param f_puts    Pointer to function to output a string
- * \param fmt       The format string
- * \param args      The arguments for the format string
+ * \return number of characters output, the run is stopped when an output
+ *         function fails (*p_fail is set)
+ */
+static int __literal_put (void        *fil,
+                          int        (*f_putc)  (const char  c, void *fil),
+                          int        (*f_puts)  (const char *s, void *fil),
+                          int        (*f_write) (const char *s,
+                                                 size_t      len,
+                                                 void       *fil),
+                          const char  *s,
+                          size_t       len,
+                          int         *p_fail)
+{
+    char   buf[__LITERAL_BUF_SIZE];
+    size_t n, i;
+    int    cc;
+    int    res = 0;
+
+    if (f_write != NULL) {
+        cc = f_write(s, len, fil);
+        if (cc < 0) {
+            *p_fail = 1;
+            return 0;
+        }
+        return cc;
+    }
+
+    if (len == 1) {
+        cc = f_putc(*s, fil);
+        if (cc < 0) {
+            *p_fail = 1;
+            return 0;
+        }
+        return cc;
+    }
+
+    /* copy into a NUL terminated buffer, f_puts outputs it at once */
+    while (len > 0) {
+        n = (len < sizeof(buf)) ? len : sizeof(buf) - 1;
+        for (i = 0; i < n; i++) {
+            buf[i] = s[i];
+        }
+        buf[n] = '\0';
+
+        cc = f_puts(buf, fil);
+        if (cc < 0) {
+            *p_fail = 1;
+            break;
+        }
+        res += cc;
+        s   += n;
+        len -= n;
+    }
+
+    return res;
+}
+
+/**
+ * \brief convert an unsigned number to string, ended at p_end
  *
- * \return The number of characters output
+ * \return start of the string, at most max characters are generated
  */
-int am_vfprintf_do (void       *fil,
-                    int       (*f_putc) (const char  c, void *fil),
-                    int       (*f_puts) (const char *s, void *fil),
-                    const char *fmt,
-                    va_list     args)
+static char *__num_to_str (char *p_end, unsigned long val, int r, int max)
+{
+    const char    *digits;
+    unsigned long  q;
+    char          *p = p_end;
+
+    if (r != 10) {
+        digits = __g_hex_digits[(r & 0x100) ? 1 : 0];
+        do {
+            *--p  = digits[val & 0x0F];
+            val >>= 4;
+        } while ((--max > 0) && val);
+        return p;
+    }
+
+    /* two digits at a time */
+    while ((val >= 100) && (max >= 2)) {
+        q     = __div100(val);
+        digits = &__g_digit_pairs[(val - q * 100) * 2];
+        *--p  = digits[1];
+        *--p  = digits[0];
+        val   = q;
+        max  -= 2;
+    }
+
+    if (max > 0) {
+        if ((val >= 10) && (max >= 2)) {
+            *--p = __g_digit_pairs[val * 2 + 1];
+            *--p = __g_digit_pairs[val * 2];
+        } else {
+            *--p = (char)('0' + val % 10);
+        }
+    }
+
+    return p;
+}
+
+/******************************************************************************/
+int am_vfprintf_do_ex (void       *fil,
+                       int       (*f_putc)  (const char  c, void *fil),
+                       int       (*f_puts)  (const char *s, void *fil),
+                       int       (*f_write) (const char *s,
+                                             size_t      len,
+                                             void       *fil),
+                       const char *fmt,
+                       va_list     args)
 {
     unsigned char   c, f;
     int             r;
     unsigned long   val;
     char            s[16];
+    const char     *p;
     int             i, w, res, cc;
-
+    int             fail = 0;
 
     for (cc = res = 0; cc >= 0; res += cc >= 0 ? cc : 0) {
-        if ((c = *fmt++) == 0) {
-            break;                      /* End of string */
-        } else if (c != '%') {          /* Non escape cahracter */
-            cc = f_putc(c, fil);
+
+        /* output the literal characters before the next '%' at once */
+        if (*fmt != '%') {
+            if (*fmt == 0) {
+                break;                  /* End of string */
+            }
+            for (p = fmt; (*fmt != 0) && (*fmt != '%'); fmt++);
+
+            cc = __literal_put(fil, f_putc, f_puts, f_write,
+                               p, fmt - p, &fail);
+            if (fail) {
+                res += cc;
+                break;
+            }
             continue;
         }
+
+        fmt++;
         w = f = 0;
         c = *fmt++;
         if (c == '0') {                 /* Flag: '0' padding */
@@ -108,20 +250,8 @@ int am_vfprintf_do (void       *fil,
             val = 0 - val;
             f  |= 4;
         }
-        i    = sizeof(s) - 1;
-        s[i] = 0;
-        do {
-            c = (unsigned char)(val % (r & 0xff) + '0');
-            if (c > '9') {
-                if (r & 0x100) {
-                    c += 39;
-                } else {
-                    c += 7;
-                }
-            }
-            s[--i] = c;
-            val   /= (r & 0xff);
-        } while (i && val);
+        s[sizeof(s) - 1] = 0;
+        i = __num_to_str(&s[sizeof(s) - 1], val, r, sizeof(s) - 1) - s;
         if (i && (f & 4)) {
             s[--i] = '-';
         }
@@ -135,5 +265,28 @@ int am_vfprintf_do (void       *fil,
     return res;
 }
 
-/* end of file */
+/**
+ * \brief Format a string and output it.
+ *
+ * This function do all the vXXXprintf() works, and it take 2 functions as
+ * arguments to output the characters.
+ * all other vXXXprintf() functions are based on this function.
+ *
+ * \param fil       The handle for f_putc and f_puts functions
+ * \param f_putc    Pointer to function to output a char
+ * \param f_puts    Pointer to function to output a string
+ * \param fmt       The format string
+ * \param args      The arguments for the format string
+ *
+ * \return The number of characters output
+ */
+int am_vfprintf_do (void       *fil,
+                    int       (*f_putc) (const char  c, void *fil),
+                    int       (*f_puts) (const char *s, void *fil),
+                    const char *fmt,
+                    va_list     args)
+{
+    return am_vfprintf_do_ex(fil, f_putc, f_puts, NULL, fmt, args);
+}
 
+/* end of file */
@@ -16,12 +16,14 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, copy literal runs with memcpy()
  * - 1.00 15-12-08  tee, first implementation from AWorks
  * \endinternal
  */
 
 #include "am_vdebug.h"
 #include <stdarg.h>
+#include <string.h>
 
 /** \brief argument type for output into string buffer */
 struct __str_put_arg {
@@ -72,6 +74,33 @@ static int __str_puts (const char *s, void *fil)
     return p_arg->buf - start;
 }
 
+/**
+ * \brief put a number of chars into a string buffer
+ *
+ * \param s     the chars to put
+ * \param len   number of chars
+ * \param fil   handle of the string buffer
+ *
+ * \return number of char successfully put, -1 for no more space
+ */
+static int __str_write (const char *s, size_t len, void *fil)
+{
+    struct __str_put_arg *p_arg = (struct __str_put_arg *)fil;
+    size_t                room  = p_arg->end - p_arg->buf;
+
+    if (room == 0) {
+        return -1;
+    }
+
+    if (len > room) {
+        len = room;
+    }
+    memcpy(p_arg->buf, s, len);
+    p_arg->buf += len;
+
+    return (int)len;
+}
+
 /**
  * \brief format a string into a string buffer with known size
  *
@@ -98,7 +127,13 @@ int am_vsnprintf (char *buf, size_t sz, const char *fmt, va_list args)
     spa.buf = buf;
     spa.end = buf + sz - 1; /* reserve 1 byte for terminate NUL */
 
-    len = am_vfprintf_do(&spa, __str_putc, __str_puts, fmt, args);
+    /* literal runs are copied into the buffer at once */
+    len = am_vfprintf_do_ex(&spa,
+                            __str_putc,
+                            __str_puts,
+                            __str_write,
+                            fmt,
+                            args);
 
     buf[len] = '\0';        /* add a terminate NUL */
 
@@ -16,10 +16,19 @@
  * 
  * \internal
  * \par Modification history
+ * - 1.03 26-10-16  ljy, add am_wait_async() and am_wait_result().
+ * - 1.02 26-10-16  ljy, add am_wait_any() and am_wait_all().
+ * - 1.01 26-10-16  ljy, add pluggable wait strategy.
  * - 1.00 15-09-01  tee, first implementation.
  * \endinternal
  */
 #include "am_wait.h"
+#include "am_int.h"
+#include "am_isr_defer.h"
+
+#if defined(__ICCARM__)
+#include <intrinsics.h>
+#endif
 
 
 /******************************************************************************/
@@ -33,6 +42,122 @@
 #define __WAIT_STAT_INIT             0   /* ʼ״̬            */
 #define __WAIT_STAT_WAIT_ON          1   /* ȴ״̬            */
 #define __WAIT_STAT_WAIT_ON_TIMEOUT  2   /* ȴ״̬ʱ   */
+#define __WAIT_STAT_ASYNC            3   /* 첽ȴ״̬         */
+
+/******************************************************************************/
+
+/** \brief ǰʹõĵȴԣΪ NULL ʱæȴ */
+static const am_wait_strategy_t *__gp_wait_strategy = NULL;
+
+/******************************************************************************/
+void am_wait_idle_wfi (void *p_arg, uint32_t key)
+{
+    (void)p_arg;
+    (void)key;
+
+    /* жϹرʱжԿɻ CPU */
+#if defined(__CC_ARM)
+    __wfi();
+#elif defined(__ICCARM__)
+    __WFI();
+#elif defined(__GNUC__) && defined(__arm__)
+    __asm volatile ("wfi" : : : "memory");
+#endif
+}
+
+/******************************************************************************/
+void am_wait_idle_isr_defer (void *p_arg, uint32_t key)
+{
+    (void)p_arg;
+
+    am_int_cpu_unlock(key);
+    am_isr_defer_job_process();
+    (void)am_int_cpu_lock();
+}
+
+/******************************************************************************/
+void am_wait_idle_jobq (void *p_arg, uint32_t key)
+{
+    am_int_cpu_unlock(key);
+    am_jobq_process((am_jobq_handle_t)p_arg);
+    (void)am_int_cpu_lock();
+}
+
+/** \brief ˯ߵȴж */
+const am_wait_strategy_t am_wait_strategy_wfi = {
+    am_wait_idle_wfi,
+    NULL,
+    NULL
+};
+
+/** \brief жӳ */
+const am_wait_strategy_t am_wait_strategy_isr_defer = {
+    am_wait_idle_isr_defer,
+    NULL,
+    NULL
+};
+
+/******************************************************************************/
+void am_wait_strategy_set (const am_wait_strategy_t *p_strategy)
+{
+    __gp_wait_strategy = p_strategy;
+}
+
+/**
+ * \brief ȴδʱһ
+ *
+ * üʱжϾѹرաȴ֮رжϣڴڼ䵽
+ * жϴڹ״̬ʹкأѡ
+ */
+static uint32_t __wait_idle (const am_wait_strategy_t *p_strategy, uint32_t key)
+{
+    if ((p_strategy != NULL) && (p_strategy->pfn_idle != NULL)) {
+        p_strategy->pfn_idle(p_strategy->p_arg, key);
+    }
+
+    /* жϣж */
+    am_int_cpu_unlock(key);
+
+    return am_int_cpu_lock();
+}
+
+/**
+ * \brief ȴֵ뿪ʼֵ
+ */
+static void __wait_val_change (am_wait_t *p_wait)
+{
+    const am_wait_strategy_t *p_strategy = __gp_wait_strategy;
+    uint32_t                  key;
+
+    if ((p_strategy == NULL) || (p_strategy->pfn_idle == NULL)) {
+        while (p_wait->val == __WAIT_VAL_INIT);
+        return;
+    }
+
+    key = am_int_cpu_lock();
+
+    while (p_wait->val == __WAIT_VAL_INIT) {
+        key = __wait_idle(p_strategy, key);
+    }
+
+    am_int_cpu_unlock(key);
+}
+
+/* ȴֵѸı䣬ѵȴ */
+static void __wait_wake (void)
+{
+    const am_wait_strategy_t *p_strategy = __gp_wait_strategy;
+
+    if ((p_strategy != NULL) && (p_strategy->pfn_wake != NULL)) {
+        p_strategy->pfn_wake(p_strategy->p_arg);
+    }
+}
+
+/******************************************************************************/
+void am_wait_wake (void)
+{
+    __wait_wake();
+}
 
 /******************************************************************************/
 
@@ -43,6 +168,12 @@ static void __timer_callback (void *p_arg)
     p_wait->val = __WAIT_VAL_TIMEOUT;
     
     am_softimer_stop(&p_wait->timer);
+
+    __wait_wake();
+
+    if (p_wait->pfn_notify != NULL) {
+        p_wait->pfn_notify(p_wait->p_notify_arg);
+    }
 }
 
 /******************************************************************************/
@@ -54,8 +185,10 @@ int am_wait_init (am_wait_t *p_wait)
         return -AM_EINVAL;
     }
     
-    p_wait->val   = __WAIT_VAL_INIT;
-    p_wait->stat  = __WAIT_STAT_INIT;
+    p_wait->val          = __WAIT_VAL_INIT;
+    p_wait->stat         = __WAIT_STAT_INIT;
+    p_wait->pfn_notify   = NULL;
+    p_wait->p_notify_arg = NULL;
     
     am_softimer_init(&p_wait->timer,__timer_callback, p_wait);
     
@@ -70,7 +203,7 @@ int am_wait_on (am_wait_t *p_wait)
     
     p_wait->stat = __WAIT_STAT_WAIT_ON;
     
-    while(p_wait->val == __WAIT_VAL_INIT);
+    __wait_val_change(p_wait);
     
     p_wait->val  = __WAIT_VAL_INIT;
     p_wait->stat = __WAIT_STAT_INIT;
@@ -86,6 +219,12 @@ int am_wait_done(am_wait_t *p_wait)
     
     p_wait->val  = __WAIT_VAL_DONE;
 
+    __wait_wake();
+
+    if (p_wait->pfn_notify != NULL) {
+        p_wait->pfn_notify(p_wait->p_notify_arg);
+    }
+
     return AM_OK;
 }
 
@@ -98,7 +237,7 @@ int am_wait_on_timeout(am_wait_t *p_wait, uint32_t timeout_ms)
     
     p_wait->stat = __WAIT_STAT_WAIT_ON_TIMEOUT;
     
-    while(p_wait->val == __WAIT_VAL_INIT);
+    __wait_val_change(p_wait);
     
     if (p_wait->val == __WAIT_VAL_DONE) {  /* ɹȵź */
         ret = AM_OK;
@@ -114,4 +253,178 @@ int am_wait_on_timeout(am_wait_t *p_wait, uint32_t timeout_ms)
     return ret;
 }
 
+/******************************************************************************/
+int am_wait_async (am_wait_t    *p_wait,
+                   uint32_t      timeout_ms,
+                   am_pfnvoid_t  pfn_notify,
+                   void         *p_arg)
+{
+    if (p_wait == NULL) {
+        return -AM_EINVAL;
+    }
+
+    if (p_wait->stat != __WAIT_STAT_INIT) {
+        return -AM_EBUSY;
+    }
+
+    /* ֪ͨٿʼʱ֤ʱʱܹ֪ͨ */
+    p_wait->pfn_notify   = pfn_notify;
+    p_wait->p_notify_arg = p_arg;
+    p_wait->stat         = __WAIT_STAT_ASYNC;
+
+    if (timeout_ms != (uint32_t)AM_WAIT_FOREVER) {
+        am_softimer_start(&p_wait->timer, timeout_ms);
+    }
+
+    return AM_OK;
+}
+
+/******************************************************************************/
+int am_wait_result (am_wait_t *p_wait)
+{
+    int ret;
+    int key;
+
+    if ((p_wait == NULL) || (p_wait->stat != __WAIT_STAT_ASYNC)) {
+        return -AM_EINVAL;
+    }
+
+    key = am_int_cpu_lock();
+
+    if (p_wait->val == __WAIT_VAL_INIT) {
+        am_int_cpu_unlock(key);
+        return -AM_EINPROGRESS;
+    }
+
+    ret = (p_wait->val == __WAIT_VAL_DONE) ? AM_OK : -AM_ETIME;
+
+    p_wait->val          = __WAIT_VAL_INIT;
+    p_wait->stat         = __WAIT_STAT_INIT;
+    p_wait->pfn_notify   = NULL;
+    p_wait->p_notify_arg = NULL;
+
+    am_int_cpu_unlock(key);
+
+    am_softimer_stop(&p_wait->timer);
+
+    return ret;
+}
+
+/******************************************************************************/
+
+/* Դȴĳʱصp_arg ָʱ־ */
+static void __srcs_timer_callback (void *p_arg)
+{
+    *(volatile am_bool_t *)p_arg = AM_TRUE;
+
+    __wait_wake();
+}
+
+/**
+ * \brief 鲢ȡȴԴʱжѹر
+ *
+ * \return ȴһʱؾĵȴԴȴȫʱ 0
+ *         δʱ -1
+ */
+static int __srcs_take (am_wait_src_t *p_srcs, unsigned int num, am_bool_t all)
+{
+    unsigned int i;
+
+    if (!all) {
+        for (i = 0; i < num; i++) {
+            if (p_srcs[i].pfn_take(&p_srcs[i], AM_TRUE)) {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+
+    /* ȫŻȡ֤ҪôȫȡҪôȡ */
+    for (i = 0; i < num; i++) {
+        if (!p_srcs[i].pfn_take(&p_srcs[i], AM_FALSE)) {
+            return -1;
+        }
+    }
+
+    for (i = 0; i < num; i++) {
+        (void)p_srcs[i].pfn_take(&p_srcs[i], AM_TRUE);
+    }
+
+    return 0;
+}
+
+static int __wait_srcs (am_wait_src_t *p_srcs,
+                        unsigned int   num,
+                        am_bool_t      all,
+                        uint32_t       timeout_ms)
+{
+    const am_wait_strategy_t *p_strategy = __gp_wait_strategy;
+    am_softimer_t             timer;
+    volatile am_bool_t        timeout    = AM_FALSE;
+    am_bool_t                 use_timer;
+    uint32_t                  key;
+    unsigned int              i;
+    int                       ret;
+
+    if ((p_srcs == NULL) || (num == 0)) {
+        return -AM_EINVAL;
+    }
+
+    for (i = 0; i < num; i++) {
+        if (p_srcs[i].pfn_take == NULL) {
+            return -AM_EINVAL;
+        }
+    }
+
+    use_timer = (am_bool_t)((timeout_ms != AM_NO_WAIT) &&
+                            (timeout_ms != (uint32_t)AM_WAIT_FOREVER));
+
+    if (use_timer) {
+        am_softimer_init(&timer, __srcs_timer_callback, (void *)&timeout);
+        am_softimer_start(&timer, timeout_ms);
+    }
+
+    key = am_int_cpu_lock();
+
+    for (;;) {
+
+        ret = __srcs_take(p_srcs, num, all);
+        if (ret >= 0) {
+            break;
+        }
+
+        if (timeout_ms == AM_NO_WAIT) {
+            ret = -AM_EAGAIN;
+            break;
+        }
+
+        if (timeout) {
+            ret = -AM_ETIME;
+            break;
+        }
+
+        key = __wait_idle(p_strategy, key);
+    }
+
+    am_int_cpu_unlock(key);
+
+    if (use_timer) {
+        am_softimer_stop(&timer);
+    }
+
+    return ret;
+}
+
+/******************************************************************************/
+int am_wait_any (am_wait_src_t *p_srcs, unsigned int num, uint32_t timeout_ms)
+{
+    return __wait_srcs(p_srcs, num, AM_FALSE, timeout_ms);
+}
+
+/******************************************************************************/
+int am_wait_all (am_wait_src_t *p_srcs, unsigned int num, uint32_t timeout_ms)
+{
+    return __wait_srcs(p_srcs, num, AM_TRUE, timeout_ms);
+}
+
 /* end of file */
@@ -0,0 +1,62 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ׼̣
+ *
+ * - 裺
+ *   1. ʼ׼Կܣ Cortex-M3/M4 ʹ DWT ڼ
+ *      \code
+ *      amhw_arm_dwt_cyccnt_enable();
+ *      am_bench_init(amhw_arm_dwt_cyccnt_get, SystemCoreClock);
+ *      \endcode
+ *   2. ҪȽʱʹ am_bench_baseline_set() û׼ߣ
+ *   3.  demo_bench_entry()
+ *
+ * - ʵ
+ *   1.  CSV ʽÿĽ am_bench.h
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_bench.h"
+#include "demo_bench_entries.h"
+
+/**
+ * \brief 
+ */
+int demo_bench_entry (const char *p_filter)
+{
+    int ret;
+    int nregress;
+
+    am_bench_header_print();
+
+    nregress = demo_bench_util_entry(p_filter);
+    if (nregress < 0) {
+        return nregress;
+    }
+
+    ret = demo_bench_service_entry(p_filter);
+    if (ret < 0) {
+        return ret;
+    }
+
+    return nregress + ret;
+}
+
+/* end of file */
@@ -0,0 +1,67 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ׼̺
+ * \sa    demo_bench_entries.h
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __DEMO_BENCH_ENTRIES_H
+#define __DEMO_BENCH_ENTRIES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief util rngbufsoftimermemheapvsnprintf׼
+ *
+ * \param[in] p_filter : ֻԸַͷNULLȫ
+ *
+ * \return жΪ˻< 0 ʾδʼ
+ *
+ * \note ǰ am_bench_init() ʼ׼Կܣʼʱ
+ *       ģ
+ */
+int demo_bench_util_entry (const char *p_filter);
+
+/**
+ * \brief service crcftl׼
+ *
+ * \param[in] p_filter : ֻԸַͷNULLȫ
+ *
+ * \return жΪ˻< 0 ʾδʼ
+ */
+int demo_bench_service_entry (const char *p_filter);
+
+/**
+ * \brief л׼ԣȴӡ CSV ͷ
+ *
+ * \param[in] p_filter : ֻԸַͷNULLȫ
+ *
+ * \return жΪ˻< 0 ʾδʼ
+ */
+int demo_bench_entry (const char *p_filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEMO_BENCH_ENTRIES_H */
+
+/* end of file */
@@ -0,0 +1,275 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief service ׼
+ *
+ * - 
+ *   1. crc.crc32      :  CRC-32  size ֽڣ
+ *   2. crc.crc16      :  CRC-16/CCITT  size ֽڣ
+ *   3. ftl.write      : д size ߼еһ־ϲ
+ *   4. ftl.read       : ζ size ߼еһ
+ *
+ * FTL ʹ RAM ģ NOR FLASHΪ 0xFFдֻܽλ㣩
+ * FTL  __ftl_writeunit_find() ĲҺͺϲĿʵ FLASH
+ * ı̺Ͳʱ䡣
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_bench.h"
+#include "am_crc.h"
+#include "am_crc_soft.h"
+#include "am_crc_table_def.h"
+#include "am_mtd.h"
+#include "am_ftl.h"
+#include "demo_bench_entries.h"
+#include <string.h>
+
+/** \brief ģ FLASH  */
+#define __FLASH_SIZE         (128 * 1024)
+
+/** \brief ģ FLASH ĲԪС */
+#define __FLASH_ERASE_SIZE   4096
+
+/** \brief ߼С */
+#define __FTL_BLOCK_SIZE     256
+
+/** \brief ־ */
+#define __FTL_LOG_BLOCK_NUM  4
+
+static uint8_t __g_crc_data[4096];
+
+/** \brief CRC-32 ģ */
+static am_crc_pattern_t __g_crc32_pattern = {
+    32,                /* CRC  */
+    0x04C11DB7,        /* CRC ɶʽ */
+    0xFFFFFFFF,        /* CRC ʼֵ */
+    AM_TRUE,           /* ֽ bit  */
+    AM_TRUE,           /*  CRC bit  */
+    0xFFFFFFFF,        /* ֵ */
+};
+
+/** \brief CRC-16/CCITT ģ */
+static am_crc_pattern_t __g_crc16_pattern = {
+    16,                /* CRC  */
+    0x1021,            /* CRC ɶʽ */
+    0x0000,            /* CRC ʼֵ */
+    AM_TRUE,           /* ֽ bit  */
+    AM_TRUE,           /*  CRC bit  */
+    0x0000,            /* ֵ */
+};
+
+static am_crc_soft_t   __g_crc32_soft;
+static am_crc_soft_t   __g_crc16_soft;
+static am_crc_handle_t __g_crc32_handle;
+static am_crc_handle_t __g_crc16_handle;
+
+static uint8_t         __g_flash_mem[__FLASH_SIZE];
+static am_ftl_serv_t   __g_ftl;
+static am_ftl_handle_t __g_ftl_handle;
+static uint8_t         __g_ftl_blk[__FTL_BLOCK_SIZE];
+
+static uint8_t __g_ftl_buf[AM_FTL_RAM_SIZE_GET(__FLASH_SIZE,
+                                               __FLASH_ERASE_SIZE,
+                                               __FTL_BLOCK_SIZE,
+                                               __FTL_LOG_BLOCK_NUM)];
+
+static const am_ftl_info_t __g_ftl_info = {
+    __g_ftl_buf,               /* RAM  */
+    sizeof(__g_ftl_buf),       /* RAM С */
+    __FTL_BLOCK_SIZE,          /* ߼ĴС */
+    __FTL_LOG_BLOCK_NUM,       /* ־ */
+    0                          /* 飨Ԫ */
+};
+
+/*******************************************************************************
+  RAM ģ NOR FLASH
+*******************************************************************************/
+static int __flash_erase (void *p_drv, struct am_mtd_erase_info *p_info)
+{
+    p_info->fail_addr = AM_MTD_ERASE_FAIL_ADDR_UNKNOWN;
+    memset(&__g_flash_mem[p_info->addr], 0xFF, p_info->len);
+    p_info->state     = AM_MTD_ERASE_DONE;
+
+    if (p_info->pfn_callback) {
+        p_info->pfn_callback(p_info);
+    }
+
+    return AM_OK;
+}
+
+static int __flash_read (void *p_drv, uint32_t addr, void *p_buf, uint32_t len)
+{
+    memcpy(p_buf, &__g_flash_mem[addr], len);
+    return AM_OK;
+}
+
+static int __flash_write (void       *p_drv,
+                          uint32_t    addr,
+                          const void *p_buf,
+                          uint32_t    len)
+{
+    const uint8_t *p_src = (const uint8_t *)p_buf;
+    uint8_t       *p_dst = &__g_flash_mem[addr];
+
+    while (len--) {
+        *p_dst++ &= *p_src++;
+    }
+
+    return AM_OK;
+}
+
+static const struct am_mtd_ops __g_flash_ops = {
+    __flash_erase,
+    __flash_read,
+    __flash_write,
+};
+
+static am_mtd_serv_t __g_flash_mtd = {
+    AM_MTD_TYPE_NOR_FLASH,     /*  */
+    AM_MTD_FLAGS_NOR_FLASH,    /* ־ */
+    __FLASH_SIZE,              /*  */
+    __FLASH_ERASE_SIZE,        /* ԪС */
+    1,                         /* Сд뵥ԪС */
+    __FTL_BLOCK_SIZE,          /* дС */
+    &__g_flash_ops,            /*  */
+    NULL,                      /* ˽ */
+};
+
+/*******************************************************************************
+  crc
+*******************************************************************************/
+static int __crc_setup (void *p_arg, uint32_t size)
+{
+    uint32_t i;
+
+    if (size > sizeof(__g_crc_data)) {
+        return -AM_EINVAL;
+    }
+
+    for (i = 0; i < size; i++) {
+        __g_crc_data[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    __g_crc32_handle = am_crc_soft_init(&__g_crc32_soft,
+                                        &g_crc_table_32_04c11db7_ref);
+    __g_crc16_handle = am_crc_soft_init(&__g_crc16_soft,
+                                        &g_crc_table_16_1021_ref);
+
+    if ((__g_crc32_handle == NULL) || (__g_crc16_handle == NULL)) {
+        return -AM_ENODEV;
+    }
+
+    return AM_OK;
+}
+
+static void __crc_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    int       crc32 = (p_arg != NULL);
+    uint32_t  value;
+
+    am_crc_handle_t   handle    = crc32 ? __g_crc32_handle : __g_crc16_handle;
+    am_crc_pattern_t *p_pattern = crc32 ? &__g_crc32_pattern
+                                        : &__g_crc16_pattern;
+
+    while (nops--) {
+        am_crc_init(handle, p_pattern);
+        am_crc_cal(handle, __g_crc_data, size);
+        am_crc_final(handle, &value);
+    }
+}
+
+/*******************************************************************************
+  ftl
+*******************************************************************************/
+static int __ftl_setup (void *p_arg, uint32_t size)
+{
+    uint32_t lbn;
+
+    memset(__g_flash_mem, 0xFF, sizeof(__g_flash_mem));
+
+    __g_ftl_handle = am_ftl_init(&__g_ftl, &__g_ftl_info, &__g_flash_mtd);
+    if (__g_ftl_handle == NULL) {
+        return -AM_ENODEV;
+    }
+
+    if (size > am_ftl_max_lbn_get(__g_ftl_handle)) {
+        return -AM_EINVAL;
+    }
+
+    /* дһ飬ӳ߼ */
+    for (lbn = 0; lbn < size; lbn++) {
+        memset(__g_ftl_blk, (int)lbn, sizeof(__g_ftl_blk));
+        if (am_ftl_write(__g_ftl_handle, lbn, __g_ftl_blk) < 0) {
+            return -AM_EIO;
+        }
+    }
+
+    return AM_OK;
+}
+
+static void __ftl_write_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    while (nops--) {
+        __g_ftl_blk[0] = (uint8_t)nops;
+        am_ftl_write(__g_ftl_handle, nops % size, __g_ftl_blk);
+    }
+}
+
+static void __ftl_read_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    while (nops--) {
+        am_ftl_read(__g_ftl_handle, nops % size, __g_ftl_blk);
+    }
+}
+
+/*******************************************************************************
+  
+*******************************************************************************/
+#define __CASE(name, size, bytes, setup, run, arg) \
+    {name, size, bytes, setup, run, NULL, arg}
+
+static const am_bench_case_t __g_service_cases[] = {
+    __CASE("crc.crc32", 16,   16,   __crc_setup, __crc_run, (void *)1),
+    __CASE("crc.crc32", 256,  256,  __crc_setup, __crc_run, (void *)1),
+    __CASE("crc.crc32", 4096, 4096, __crc_setup, __crc_run, (void *)1),
+
+    __CASE("crc.crc16", 16,   16,   __crc_setup, __crc_run, NULL),
+    __CASE("crc.crc16", 256,  256,  __crc_setup, __crc_run, NULL),
+    __CASE("crc.crc16", 4096, 4096, __crc_setup, __crc_run, NULL),
+
+    __CASE("ftl.write", 4,   __FTL_BLOCK_SIZE, __ftl_setup, __ftl_write_run, NULL),
+    __CASE("ftl.write", 64,  __FTL_BLOCK_SIZE, __ftl_setup, __ftl_write_run, NULL),
+    __CASE("ftl.write", 256, __FTL_BLOCK_SIZE, __ftl_setup, __ftl_write_run, NULL),
+
+    __CASE("ftl.read", 4,   __FTL_BLOCK_SIZE, __ftl_setup, __ftl_read_run, NULL),
+    __CASE("ftl.read", 64,  __FTL_BLOCK_SIZE, __ftl_setup, __ftl_read_run, NULL),
+    __CASE("ftl.read", 256, __FTL_BLOCK_SIZE, __ftl_setup, __ftl_read_run, NULL),
+};
+
+/**
+ * \brief service ׼
+ */
+int demo_bench_service_entry (const char *p_filter)
+{
+    return am_bench_run_all(__g_service_cases,
+                            AM_NELEMENTS(__g_service_cases),
+                            p_filter);
+}
+
+/* end of file */
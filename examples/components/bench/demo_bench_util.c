@@ -0,0 +1,870 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief util ׼
+ *
+ * - 
+ *   1. rngbuf.put_get        : д size ֽں
+ *   2. rngbuf_spsc.put_get   : ͬϣSPSC λ
+ *   3. rngbuf_spsc.zerocopy  : reserve/commit д size ֽڣpeek/consume 
+ *   4. softimer.start_stop   :  size ʱʱֹͣһʱ
+ *                              ʱжʱ֮䣻
+ *   5. softimer.tick         :  size ʱʱһ tick
+ *   6. memheap.alloc_free    : ƬĶз䲢ͷ size ֽڣ״Ӧ
+ *   7. memheap_tlsf.alloc_free : ͬϣTLSF 㷨
+ *   8. memheap.trace         : ط size ۵ķ켣С
+ *                              alloc/realloc/free ϣÿβΪһ¼
+ *   9. memheap_tlsf.trace    : ͬϣTLSF 㷨
+ *  10. vsnprintf.int         : ʽ size 
+ *  11. vsnprintf.str         : ʽһ size ֽڵַ
+ *  12. vsnprintf_ref.int/str : ͬϣʹøдǰĸʽʵַ֣
+ *                              ıλתΪȽϵĻ׼
+ *
+ * \note softimer ֱӵ am_softimer_module_tick()ƽʱ
+ *       ʱ䣬ǰҪʼʱģ飬ҲӦӦóĶʱС
+ *        AM_SOFTIMER_WHEEL ʱʱʵ֡
+ *
+ * \note ÿ trace ٵطŹ켣һ '#' ͷ
+ *       עͣ׼߱Ƚʱԣÿ ops_per_secβ
+ *       ֵ max_op_countsƬ frag_permilleǧֱȣ
+ *       ʧܴ failures
+ *
+ * \internal
+ * \par Modification history
+ * - 1.03 26-10-16  ljy, add the vsnprintf_ref cases
+ * - 1.02 26-10-16  ljy, add the memheap trace replay cases
+ * - 1.01 26-10-16  ljy, softimer cases use 10/100/1000 timers, start_stop
+ *                   expiries spread over the running timers
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#include "ametal.h"
+#include "am_bench.h"
+#include "am_rngbuf.h"
+#include "am_rngbuf_spsc.h"
+#include "am_softimer.h"
+#include "am_memheap.h"
+#include "am_vdebug.h"
+#include "demo_bench_entries.h"
+#include <stdarg.h>
+#include <string.h>
+
+/** \brief λС2^nSPSC λҪ */
+#define __RNGBUF_SIZE        1024
+
+/** \brief softimer ʱ */
+#define __SOFTIMER_NUM       1000
+
+/** \brief softimer е i жʱĶʱʱΪ BASE + i * STEPms */
+#define __SOFTIMER_BASE      10000
+#define __SOFTIMER_STEP      37
+
+/** \brief ѴС */
+#define __HEAP_SIZE          (32 * 1024)
+
+/** \brief ƬʱԤȷĿ */
+#define __HEAP_FRAG_NUM      64
+
+/** \brief 켣¼ */
+#define __TRACE_LEN          4096
+
+/** \brief 켣ͬʱڵĿ */
+#define __TRACE_SLOT_MAX     64
+
+/** \brief ¼طʱÿٸ¼һƬ */
+#define __TRACE_FRAG_PERIOD  64
+
+/** \brief ¼ʱطŵıȡֵеС˳жϵȸ */
+#define __TRACE_LAT_PASSES   3
+
+/** \brief 켣е¼ */
+struct __trace_evt {
+    uint8_t  op;                            /**< \brief __TRACE_ALLOC  */
+    uint8_t  slot;                          /**< \brief ۺ */
+    uint16_t size;                          /**< \brief С */
+};
+
+#define __TRACE_ALLOC        0
+#define __TRACE_REALLOC      1
+#define __TRACE_FREE         2
+
+static char                  __g_rb_mem[__RNGBUF_SIZE];
+static char                  __g_data[__RNGBUF_SIZE];
+static struct am_rngbuf      __g_rb;
+static struct am_rngbuf_spsc __g_rb_spsc;
+
+static am_softimer_t         __g_timers[__SOFTIMER_NUM + 1];
+static uint32_t              __g_timer_num;
+
+static uint32_t              __g_heap_mem[__HEAP_SIZE / 4];
+static am_memheap_t          __g_heap;
+static void                 *__g_heap_blocks[__HEAP_FRAG_NUM];
+
+static struct __trace_evt    __g_trace[__TRACE_LEN];
+static uint32_t              __g_trace_num;
+static uint32_t              __g_trace_pos;
+static void                 *__g_trace_ptr[__TRACE_SLOT_MAX];
+
+static char                  __g_fmt_buf[256];
+static volatile int          __g_sink;
+
+/*******************************************************************************
+  rngbuf
+*******************************************************************************/
+static int __rngbuf_setup (void *p_arg, uint32_t size)
+{
+    memset(__g_data, 0x5A, sizeof(__g_data));
+    return am_rngbuf_init(&__g_rb, __g_rb_mem, sizeof(__g_rb_mem));
+}
+
+static void __rngbuf_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    while (nops--) {
+        am_rngbuf_put(&__g_rb, __g_data, size);
+        am_rngbuf_get(&__g_rb, __g_data, size);
+    }
+}
+
+static int __spsc_setup (void *p_arg, uint32_t size)
+{
+    memset(__g_data, 0x5A, sizeof(__g_data));
+    return am_rngbuf_spsc_init(&__g_rb_spsc, __g_rb_mem, sizeof(__g_rb_mem));
+}
+
+static void __spsc_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    while (nops--) {
+        am_rngbuf_spsc_put(&__g_rb_spsc, __g_data, size);
+        am_rngbuf_spsc_get(&__g_rb_spsc, __g_data, size);
+    }
+}
+
+static void __spsc_zerocopy_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    char   *p_buf;
+    size_t  len;
+    size_t  left;
+
+    while (nops--) {
+        for (left = size; left > 0; left -= len) {
+            am_rngbuf_spsc_reserve_write(&__g_rb_spsc, &p_buf, &len);
+            len = (len < left) ? len : left;
+            memcpy(p_buf, __g_data, len);
+            am_rngbuf_spsc_commit_write(&__g_rb_spsc, len);
+        }
+        for (left = size; left > 0; left -= len) {
+            am_rngbuf_spsc_peek_read(&__g_rb_spsc, &p_buf, &len);
+            len = (len < left) ? len : left;
+            memcpy(__g_data, p_buf, len);
+            am_rngbuf_spsc_consume(&__g_rb_spsc, len);
+        }
+    }
+}
+
+/*******************************************************************************
+  softimer
+*******************************************************************************/
+static void __softimer_callback (void *p_arg)
+{
+    __g_sink++;
+}
+
+static int __softimer_setup (void *p_arg, uint32_t size)
+{
+    uint32_t i;
+    int      ret;
+
+    if (size > __SOFTIMER_NUM) {
+        return -AM_EINVAL;
+    }
+
+    for (i = 0; i <= size; i++) {
+        ret = am_softimer_init(&__g_timers[i], __softimer_callback, NULL);
+        if (ret != AM_OK) {
+            return ret;
+        }
+    }
+    __g_timer_num = size + 1;
+
+    /* ʱʱ以ͬҽϳtick кٵ */
+    for (i = 0; i < size; i++) {
+        am_softimer_start(&__g_timers[i],
+                          __SOFTIMER_BASE + i * __SOFTIMER_STEP);
+    }
+
+    return AM_OK;
+}
+
+static void __softimer_teardown (void *p_arg)
+{
+    uint32_t i;
+
+    for (i = 0; i < __g_timer_num; i++) {
+        am_softimer_stop(&__g_timers[i]);
+    }
+}
+
+/* ʱжʱ֮ĸλãƽλõĿ */
+static void __softimer_start_stop_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    am_softimer_t *p_timer = &__g_timers[size];
+    uint32_t       pos     = 0;
+
+    while (nops--) {
+        pos = (pos + 7919) % (size + 1);
+        am_softimer_start(p_timer,
+                          __SOFTIMER_BASE + pos * __SOFTIMER_STEP +
+                          __SOFTIMER_STEP / 2);
+        am_softimer_stop(p_timer);
+    }
+}
+
+static void __softimer_tick_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    while (nops--) {
+        am_softimer_module_tick();
+    }
+}
+
+/*******************************************************************************
+  memheap
+*******************************************************************************/
+
+/* һСͬĿ鲢ͷһ룬ʹжƬ */
+static int __memheap_frag (uint32_t size)
+{
+    int i;
+
+    for (i = 0; i < __HEAP_FRAG_NUM; i++) {
+        __g_heap_blocks[i] = am_memheap_alloc(&__g_heap, 16 + (i % 8) * 24);
+        if (__g_heap_blocks[i] == NULL) {
+            return -AM_ENOMEM;
+        }
+    }
+
+    for (i = 0; i < __HEAP_FRAG_NUM; i += 2) {
+        am_memheap_free(__g_heap_blocks[i]);
+        __g_heap_blocks[i] = NULL;
+    }
+
+    return AM_OK;
+}
+
+static int __memheap_setup (void *p_arg, uint32_t size)
+{
+    int ret;
+
+    ret = am_memheap_init(&__g_heap, "bench", __g_heap_mem, sizeof(__g_heap_mem));
+    return (ret != AM_OK) ? ret : __memheap_frag(size);
+}
+
+static int __memheap_tlsf_setup (void *p_arg, uint32_t size)
+{
+    int ret;
+
+    ret = am_memheap_init_tlsf(&__g_heap,
+                               "bench",
+                               __g_heap_mem,
+                               sizeof(__g_heap_mem));
+    return (ret != AM_OK) ? ret : __memheap_frag(size);
+}
+
+static void __memheap_teardown (void *p_arg)
+{
+    int i;
+
+    for (i = 1; i < __HEAP_FRAG_NUM; i += 2) {
+        am_memheap_free(__g_heap_blocks[i]);
+    }
+}
+
+static void __memheap_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    void *p;
+
+    while (nops--) {
+        p = am_memheap_alloc(&__g_heap, size);
+        am_memheap_free(p);
+    }
+}
+
+/*******************************************************************************
+  memheap trace
+*******************************************************************************/
+
+/* ͬÿɵĹ켣ͬ */
+static uint32_t __trace_rand (uint32_t *p_seed)
+{
+    *p_seed = *p_seed * 1103515245u + 12345u;
+    return *p_seed >> 8;
+}
+
+/* Сֲ󲿷ΪС飬Լ 1/8 Ϊ */
+static uint16_t __trace_size_rand (uint32_t *p_seed)
+{
+    uint32_t r = __trace_rand(p_seed);
+
+    if ((r & 7) == 0) {
+        return (uint16_t)(256 + (r >> 3) % 1792);
+    }
+    return (uint16_t)(8 + (r >> 3) % 120);
+}
+
+/*
+ *  size ۵ķ켣ѡһۣʱ䣬 1/3 ĸ
+ * ıС2/3 ĸͷţͷп飬ʹ켣ѭط
+ */
+static int __trace_gen (uint32_t size)
+{
+    uint8_t   live[__TRACE_SLOT_MAX];
+    uint32_t  seed = 1;
+    uint32_t  n    = 0;
+    uint32_t  slot;
+    uint32_t  r;
+
+    if ((size == 0) || (size > __TRACE_SLOT_MAX)) {
+        return -AM_EINVAL;
+    }
+
+    memset(live, 0, sizeof(live));
+
+    while (n < __TRACE_LEN - size) {
+        r    = __trace_rand(&seed);
+        slot = r % size;
+
+        __g_trace[n].slot = (uint8_t)slot;
+
+        if (!live[slot]) {
+            __g_trace[n].op   = __TRACE_ALLOC;
+            __g_trace[n].size = __trace_size_rand(&seed);
+            live[slot]        = 1;
+        } else if (((r >> 8) % 3) == 0) {
+            __g_trace[n].op   = __TRACE_REALLOC;
+            __g_trace[n].size = __trace_size_rand(&seed);
+        } else {
+            __g_trace[n].op   = __TRACE_FREE;
+            __g_trace[n].size = 0;
+            live[slot]        = 0;
+        }
+        n++;
+    }
+
+    for (slot = 0; slot < size; slot++) {
+        if (live[slot]) {
+            __g_trace[n].op   = __TRACE_FREE;
+            __g_trace[n].slot = (uint8_t)slot;
+            __g_trace[n].size = 0;
+            n++;
+        }
+    }
+
+    __g_trace_num = n;
+    __g_trace_pos = 0;
+    memset(__g_trace_ptr, 0, sizeof(__g_trace_ptr));
+
+    return AM_OK;
+}
+
+/* طһ¼ʧܷ AM_FALSE */
+static am_bool_t __trace_step (void)
+{
+    const struct __trace_evt *p_evt = &__g_trace[__g_trace_pos];
+    void                    **pp    = &__g_trace_ptr[p_evt->slot];
+    void                     *p;
+
+    if (++__g_trace_pos >= __g_trace_num) {
+        __g_trace_pos = 0;
+    }
+
+    switch (p_evt->op) {
+
+    case __TRACE_ALLOC:
+        *pp = am_memheap_alloc(&__g_heap, p_evt->size);
+        return (*pp != NULL);
+
+    case __TRACE_REALLOC:
+
+        /* ʧʱԭĿ鱣ֲ䣨֮ǰʧʱ *pp Ϊ NULL൱ڷ䣩 */
+        p = am_memheap_realloc(&__g_heap, *pp, p_evt->size);
+        if (p == NULL) {
+            return AM_FALSE;
+        }
+        *pp = p;
+        return AM_TRUE;
+
+    default:
+        am_memheap_free(*pp);
+        *pp = NULL;
+        return AM_TRUE;
+    }
+}
+
+static int __memheap_trace_setup (void *p_arg, uint32_t size)
+{
+    int ret;
+
+    ret = am_memheap_init(&__g_heap,
+                          "bench",
+                          __g_heap_mem,
+                          sizeof(__g_heap_mem));
+    return (ret != AM_OK) ? ret : __trace_gen(size);
+}
+
+static int __memheap_tlsf_trace_setup (void *p_arg, uint32_t size)
+{
+    int ret;
+
+    ret = am_memheap_init_tlsf(&__g_heap,
+                               "bench",
+                               __g_heap_mem,
+                               sizeof(__g_heap_mem));
+    return (ret != AM_OK) ? ret : __trace_gen(size);
+}
+
+static void __memheap_trace_teardown (void *p_arg)
+{
+    uint32_t i;
+
+    for (i = 0; i < __TRACE_SLOT_MAX; i++) {
+        am_memheap_free(__g_trace_ptr[i]);
+        __g_trace_ptr[i] = NULL;
+    }
+}
+
+static void __memheap_trace_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    while (nops--) {
+        __trace_step();
+    }
+}
+
+/*
+ * 켣ʱпͷţÿطŵĶ״̬ͬ¼ʱط
+ * __TRACE_LAT_PASSES 飬¼βֵƬʣٶ켣
+ * ʱطһ飬õÿ
+ */
+static void __memheap_trace_report (const am_bench_case_t *p_case)
+{
+    struct am_memheap_info info;
+    uint32_t               start;
+    uint32_t               counts;
+    uint32_t               pass_max;
+    uint32_t               max_counts = 0xFFFFFFFF;
+    uint32_t               frag_max   = 0;
+    uint32_t               nfail      = 0;
+    am_bool_t              ok;
+    uint32_t               pass;
+    uint32_t               i;
+
+    if (p_case->pfn_setup(p_case->p_arg, p_case->size) != AM_OK) {
+        return;
+    }
+
+    for (pass = 0; pass < __TRACE_LAT_PASSES; pass++) {
+        for (pass_max = 0, i = 0; i < __g_trace_num; i++) {
+            start  = am_bench_counter_get();
+            ok     = __trace_step();
+            counts = am_bench_counter_get() - start;
+
+            if (counts > pass_max) {
+                pass_max = counts;
+            }
+
+            if (pass > 0) {
+                continue;
+            }
+
+            if (!ok) {
+                nfail++;
+            }
+            if (((i % __TRACE_FRAG_PERIOD) == 0) &&
+                (am_memheap_info_get(&__g_heap, &info) == AM_OK) &&
+                (info.frag_permille > frag_max)) {
+                frag_max = info.frag_permille;
+            }
+        }
+
+        if (pass_max < max_counts) {
+            max_counts = pass_max;
+        }
+    }
+
+    start = am_bench_counter_get();
+    for (i = 0; i < __g_trace_num; i++) {
+        __trace_step();
+    }
+    counts = am_bench_counter_get() - start;
+
+    __memheap_trace_teardown(p_case->p_arg);
+
+    am_kprintf("# %s,%lu: ops_per_sec=%lu max_op_counts=%lu "
+               "frag_permille=%lu failures=%lu\n",
+               p_case->p_name,
+               (unsigned long)p_case->size,
+               (unsigned long)((counts == 0) ? 0 :
+                               (uint64_t)__g_trace_num *
+                               am_bench_counter_hz_get() / counts),
+               (unsigned long)max_counts,
+               (unsigned long)frag_max,
+               (unsigned long)nfail);
+}
+
+/*******************************************************************************
+  vsnprintf
+*******************************************************************************/
+
+/** \brief ĸʽʵ֣Ϊ vsnprintf Ĳ */
+struct __fmt_impl {
+    int (*pfn_snprintf) (char *buf, size_t sz, const char *fmt, ...);
+};
+
+/** \brief ַĲ */
+struct __ref_str_arg {
+    char *buf;
+    char *end;
+};
+
+static int __ref_str_putc (const char c, void *fil)
+{
+    struct __ref_str_arg *p_arg = (struct __ref_str_arg *)fil;
+
+    if (p_arg->buf < p_arg->end) {
+        *p_arg->buf++ = c;
+        return 1;
+    }
+    return -1;
+}
+
+static int __ref_str_puts (const char *s, void *fil)
+{
+    struct __ref_str_arg *p_arg = (struct __ref_str_arg *)fil;
+    char                 *start = p_arg->buf;
+    char                  c;
+
+    if (start >= p_arg->end) {
+        return -1;
+    }
+
+    while (((c = *s++) != '\0') && (p_arg->buf < p_arg->end)) {
+        *p_arg->buf++ = c;
+    }
+    return p_arg->buf - start;
+}
+
+/*
+ * дǰ am_vfprintf_do()1.00 汾ıַ f_putc
+ * λת
+ */
+static int __ref_vfprintf_do (void       *fil,
+                              int       (*f_putc) (const char  c, void *fil),
+                              int       (*f_puts) (const char *s, void *fil),
+                              const char *fmt,
+                              va_list     args)
+{
+    unsigned char   c, f;
+    int             r;
+    unsigned long   val;
+    char            s[16];
+    int             i, w, res, cc;
+
+    for (cc = res = 0; cc >= 0; res += cc >= 0 ? cc : 0) {
+        if ((c = *fmt++) == 0) {
+            break;
+        } else if (c != '%') {
+            cc = f_putc(c, fil);
+            continue;
+        }
+        w = f = 0;
+        c = *fmt++;
+        if (c == '0') {
+            f = 1;
+            c = *fmt++;
+        }
+        while (c >= '0' && c <= '9') {
+            w = w * 10 + (c - '0');
+            c = *fmt++;
+        }
+        if (c == 'l') {
+            f |= 2;
+            c  = *fmt++;
+        }
+        if (c == 's') {
+            cc = f_puts(va_arg(args, char *), fil);
+            continue;
+        }
+        if (c == 'c') {
+            cc = f_putc(va_arg(args, int), fil);
+            continue;
+        }
+        if (c == '%') {
+            cc = f_putc('%', fil);
+            continue;
+        }
+        r = 0;
+        if ((c == 'd') || (c == 'u')) {
+            r = 10;
+        } else if (c == 'X') {
+            r = 16;
+        } else if (c == 'x') {
+            r = 0x100 + 16;
+        } else {
+            break;
+        }
+        if (f & 2) {
+            val = (unsigned long)va_arg(args, long);
+        } else {
+            val = (c == 'd')
+                ? (unsigned long)(long)va_arg(args, int)
+                : (unsigned long)va_arg(args, unsigned int);
+        }
+        if ((c == 'd') && (val & 0x80000000)) {
+            val = 0 - val;
+            f  |= 4;
+        }
+        i    = sizeof(s) - 1;
+        s[i] = 0;
+        do {
+            c = (unsigned char)(val % (r & 0xff) + '0');
+            if (c > '9') {
+                c += (r & 0x100) ? 39 : 7;
+            }
+            s[--i] = c;
+            val   /= (r & 0xff);
+        } while (i && val);
+        if (i && (f & 4)) {
+            s[--i] = '-';
+        }
+        w = sizeof(s) - 1 - w;
+        if (w < 0) {                    /* ȳ s ʱ s */
+            w = 0;
+        }
+        while (i && i > w) {
+            s[--i] = (f & 1) ? '0' : ' ';
+        }
+        cc = f_puts(&s[i], fil);
+    }
+
+    return res;
+}
+
+/* дǰ am_snprintf() */
+static int __ref_snprintf (char *buf, size_t sz, const char *fmt, ...)
+{
+    struct __ref_str_arg spa;
+    va_list              args;
+    int                  len;
+
+    if (sz < 2) {
+        if (sz == 1) {
+            *buf = '\0';
+        }
+        return 0;
+    }
+
+    spa.buf = buf;
+    spa.end = buf + sz - 1;
+
+    va_start(args, fmt);
+    len = __ref_vfprintf_do(&spa, __ref_str_putc, __ref_str_puts, fmt, args);
+    va_end(args);
+
+    buf[len] = '\0';
+
+    return len;
+}
+
+static const struct __fmt_impl __g_fmt_cur = {am_snprintf};
+static const struct __fmt_impl __g_fmt_ref = {__ref_snprintf};
+
+/* ʵֶͬһӦȫͬȽû壬 */
+static int __vsnprintf_ref_check (void)
+{
+    static const int vals[] = {0, 7, -42, 1000000, -2147483647, 65535};
+    char             buf[64];
+    int              len_ref;
+    int              len;
+    size_t           i;
+
+    for (i = 0; i < AM_NELEMENTS(vals); i++) {
+        len     = am_snprintf(__g_fmt_buf, sizeof(__g_fmt_buf),
+                              "v=%d u=%u x=%08x X=%4X [%s] %c%%",
+                              vals[i], vals[i], vals[i], vals[i], "s", 'c');
+        len_ref = __ref_snprintf(buf, sizeof(buf),
+                                 "v=%d u=%u x=%08x X=%4X [%s] %c%%",
+                                 vals[i], vals[i], vals[i], vals[i], "s", 'c');
+        if ((len != len_ref) || (strcmp(__g_fmt_buf, buf) != 0)) {
+            return -AM_EIO;
+        }
+    }
+
+    return AM_OK;
+}
+
+static int __vsnprintf_int_setup (void *p_arg, uint32_t size)
+{
+    return (p_arg == &__g_fmt_ref) ? __vsnprintf_ref_check() : AM_OK;
+}
+
+static void __vsnprintf_int_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    const struct __fmt_impl *p_impl = (const struct __fmt_impl *)p_arg;
+    uint32_t                 i;
+    int                      len;
+
+    while (nops--) {
+        for (len = 0, i = 0; i < size; i++) {
+            len += p_impl->pfn_snprintf(&__g_fmt_buf[len],
+                                        sizeof(__g_fmt_buf) - len,
+                                        "%d,",
+                                        (int)(nops * 2654435761u) >> (i & 15));
+        }
+        __g_sink = len;
+    }
+}
+
+static int __vsnprintf_str_setup (void *p_arg, uint32_t size)
+{
+    if (size >= sizeof(__g_data)) {
+        return -AM_EINVAL;
+    }
+
+    memset(__g_data, 'a', size);
+    __g_data[size] = '\0';
+
+    return __vsnprintf_int_setup(p_arg, size);
+}
+
+static void __vsnprintf_str_run (void *p_arg, uint32_t size, uint32_t nops)
+{
+    const struct __fmt_impl *p_impl = (const struct __fmt_impl *)p_arg;
+
+    while (nops--) {
+        __g_sink = p_impl->pfn_snprintf(__g_fmt_buf,
+                                        sizeof(__g_fmt_buf),
+                                        "[%s] %u\n",
+                                        __g_data,
+                                        (unsigned int)nops);
+    }
+}
+
+/*******************************************************************************
+  
+*******************************************************************************/
+#define __CASE(name, size, bytes, setup, run, teardown) \
+    {name, size, bytes, setup, run, teardown, NULL}
+
+#define __CASE_ARG(name, size, bytes, setup, run, teardown, p_arg) \
+    {name, size, bytes, setup, run, teardown, (void *)(p_arg)}
+
+static const am_bench_case_t __g_util_cases[] = {
+    __CASE("rngbuf.put_get", 1,   1,   __rngbuf_setup, __rngbuf_run, NULL),
+    __CASE("rngbuf.put_get", 16,  16,  __rngbuf_setup, __rngbuf_run, NULL),
+    __CASE("rngbuf.put_get", 256, 256, __rngbuf_setup, __rngbuf_run, NULL),
+
+    __CASE("rngbuf_spsc.put_get", 1,   1,   __spsc_setup, __spsc_run, NULL),
+    __CASE("rngbuf_spsc.put_get", 16,  16,  __spsc_setup, __spsc_run, NULL),
+    __CASE("rngbuf_spsc.put_get", 256, 256, __spsc_setup, __spsc_run, NULL),
+
+    __CASE("rngbuf_spsc.zerocopy", 16,  16,  __spsc_setup, __spsc_zerocopy_run, NULL),
+    __CASE("rngbuf_spsc.zerocopy", 256, 256, __spsc_setup, __spsc_zerocopy_run, NULL),
+
+    __CASE("softimer.start_stop", 10,   0, __softimer_setup,
+           __softimer_start_stop_run, __softimer_teardown),
+    __CASE("softimer.start_stop", 100,  0, __softimer_setup,
+           __softimer_start_stop_run, __softimer_teardown),
+    __CASE("softimer.start_stop", 1000, 0, __softimer_setup,
+           __softimer_start_stop_run, __softimer_teardown),
+
+    __CASE("softimer.tick", 10,   0, __softimer_setup,
+           __softimer_tick_run, __softimer_teardown),
+    __CASE("softimer.tick", 100,  0, __softimer_setup,
+           __softimer_tick_run, __softimer_teardown),
+    __CASE("softimer.tick", 1000, 0, __softimer_setup,
+           __softimer_tick_run, __softimer_teardown),
+
+    __CASE("memheap.alloc_free", 16,   0, __memheap_setup,
+           __memheap_run, __memheap_teardown),
+    __CASE("memheap.alloc_free", 128,  0, __memheap_setup,
+           __memheap_run, __memheap_teardown),
+    __CASE("memheap.alloc_free", 1024, 0, __memheap_setup,
+           __memheap_run, __memheap_teardown),
+
+    __CASE("memheap_tlsf.alloc_free", 16,   0, __memheap_tlsf_setup,
+           __memheap_run, __memheap_teardown),
+    __CASE("memheap_tlsf.alloc_free", 128,  0, __memheap_tlsf_setup,
+           __memheap_run, __memheap_teardown),
+    __CASE("memheap_tlsf.alloc_free", 1024, 0, __memheap_tlsf_setup,
+           __memheap_run, __memheap_teardown),
+
+    __CASE("memheap.trace", 16, 0, __memheap_trace_setup,
+           __memheap_trace_run, __memheap_trace_teardown),
+    __CASE("memheap.trace", 64, 0, __memheap_trace_setup,
+           __memheap_trace_run, __memheap_trace_teardown),
+
+    __CASE("memheap_tlsf.trace", 16, 0, __memheap_tlsf_trace_setup,
+           __memheap_trace_run, __memheap_trace_teardown),
+    __CASE("memheap_tlsf.trace", 64, 0, __memheap_tlsf_trace_setup,
+           __memheap_trace_run, __memheap_trace_teardown),
+
+    __CASE_ARG("vsnprintf.int", 1,  0, __vsnprintf_int_setup,
+               __vsnprintf_int_run, NULL, &__g_fmt_cur),
+    __CASE_ARG("vsnprintf.int", 16, 0, __vsnprintf_int_setup,
+               __vsnprintf_int_run, NULL, &__g_fmt_cur),
+
+    __CASE_ARG("vsnprintf.str", 16,  16,  __vsnprintf_str_setup,
+               __vsnprintf_str_run, NULL, &__g_fmt_cur),
+    __CASE_ARG("vsnprintf.str", 128, 128, __vsnprintf_str_setup,
+               __vsnprintf_str_run, NULL, &__g_fmt_cur),
+
+    __CASE_ARG("vsnprintf_ref.int", 1,  0, __vsnprintf_int_setup,
+               __vsnprintf_int_run, NULL, &__g_fmt_ref),
+    __CASE_ARG("vsnprintf_ref.int", 16, 0, __vsnprintf_int_setup,
+               __vsnprintf_int_run, NULL, &__g_fmt_ref),
+
+    __CASE_ARG("vsnprintf_ref.str", 16,  16,  __vsnprintf_str_setup,
+               __vsnprintf_str_run, NULL, &__g_fmt_ref),
+    __CASE_ARG("vsnprintf_ref.str", 128, 128, __vsnprintf_str_setup,
+               __vsnprintf_str_run, NULL, &__g_fmt_ref),
+};
+
+/**
+ * \brief util ׼
+ */
+int demo_bench_util_entry (const char *p_filter)
+{
+    int    ret;
+    size_t i;
+
+    ret = am_bench_run_all(__g_util_cases,
+                           AM_NELEMENTS(__g_util_cases),
+                           p_filter);
+    if (ret < 0) {
+        return ret;
+    }
+
+    for (i = 0; i < AM_NELEMENTS(__g_util_cases); i++) {
+        if ((__g_util_cases[i].pfn_run == __memheap_trace_run) &&
+            ((p_filter == NULL) ||
+             (strncmp(__g_util_cases[i].p_name,
+                      p_filter,
+                      strlen(p_filter)) == 0))) {
+            __memheap_trace_report(&__g_util_cases[i]);
+        }
+    }
+
+    return ret;
+}
+
+/* end of file */
@@ -42,6 +42,7 @@ extern "C" {
 #include "am_rs200.h"
 #include "zsn603.h"
 #include "am_xmodem.h"
+#include "am_uart_frame.h"
 #include "am_baudrate_detect.h"
 /**
  * \brief EP24CXX 
@@ -267,6 +268,13 @@ void demo_xmodem_rec_entry (am_xmodem_rec_handle_t  handle);
  */
 void  demo_xmodem_tx_entry (am_xmodem_tx_handle_t  handle);
 
+/**
+ * \brief UART ̣֡յ֡ԭ
+ * \param[in] handle  ֡
+ * \return 
+ */
+void demo_uart_frame_entry (am_uart_frame_handle_t handle);
+
 /**
  * \brief ڲʼ
  *
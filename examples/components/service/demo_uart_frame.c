@@ -0,0 +1,107 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Stock Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+* e-mail:      ametal.support@zlg.cn
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief UART ֡ʾ̣ͨ׼ӿʵ
+ *
+ * - :
+ *    1ô demo ֮ǰʼڡUARTring bufferCRC ֡豸
+ *       ʼжӳģ飨am_isr_defer
+ *    2λ֡豸Ϣеı뷽ʽ CRC ģͷ֡ݡ
+ *
+ * - ʵ:
+ *   1յȷ֡ԭ뷢λͨԴڴӡ֡ȣ
+ *   2յ CRC 򳬳֡ʱͨԴڴӡϢ
+ *
+ * \note ӡϢĴҪ֡Ĵڷֿ
+ *
+ * \internal
+ * \par Modification history
+ * - 1.00 26-10-16  ljy, first implementation.
+ * \endinternal
+ */
+
+/**
+ * \addtogroup demo_if_uart_frame
+ * \copydoc demo_uart_frame.c
+ */
+/** [src_uart_frame] */
+#include "ametal.h"
+#include "am_uart_frame.h"
+#include "am_vdebug.h"
+#include <string.h>
+
+/** \brief Ե֡ */
+#define __FRAME_MAX    256
+
+/* յֻ֡֡ڻصЧ */
+static uint8_t      __g_frame[__FRAME_MAX];
+
+/* յ֡Ȼ0 ʾûµ֡ */
+volatile static int __g_frame_len = 0;
+
+/**
+ * \brief ֡ջصжӳִУ
+ */
+static void __frame_rx_callback (void *p_arg, const uint8_t *p_frame, int len)
+{
+    /* һ֡δʱ֡ */
+    if (__g_frame_len != 0) {
+        return;
+    }
+
+    if ((len > 0) && (len <= __FRAME_MAX)) {
+        memcpy(__g_frame, p_frame, len);
+    }
+
+    __g_frame_len = len;
+}
+
+/*  */
+void demo_uart_frame_entry (am_uart_frame_handle_t handle)
+{
+    int len;
+
+    if (handle == NULL) {
+        return;
+    }
+
+    am_uart_frame_rx_cb_reg(handle, __frame_rx_callback, NULL);
+
+    while (1) {
+
+        len = __g_frame_len;
+
+        if (len > __FRAME_MAX) {
+            am_kprintf("frame too long for echo: %d\r\n", len);
+        } else if (len > 0) {
+            am_kprintf("frame received: %d bytes\r\n", len);
+            am_uart_frame_send(handle, __g_frame, len);
+        } else if (len == -AM_EBADMSG) {
+            am_kprintf("frame check error\r\n");
+        } else if (len == -AM_EMSGSIZE) {
+            am_kprintf("frame buffer overflow\r\n");
+        }
+
+        if (len != 0) {
+            __g_frame_len = 0;
+        }
+
+        /* û */
+    }
+}
+
+/** [src_uart_frame] */
+
+/* end of file */
@@ -0,0 +1,223 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ΢׼Կ
+ *
+ * ÿһ̶Ĺأͬһɹģ¸Ϊһ
+ * ʹüΪʱĿΪ DWT ڼȣ
+ *  1.  1 βʼӱֱһβļֵС̲ʱ䣬ȷ
+ *  2. Ըòظ AM_BENCH_REPEAT_DEF ΣȡСֵ
+ *  3. ÿβļֵֽ/룩
+ *
+ * ͨ am_kprintf()  CSV ʽһΪ '#' ͷļƵʣ
+ * ڶΪ
+ * \code
+ * # am_bench counter_hz=1000000000
+ * name,size,ops,counts_per_op,bytes_per_sec,baseline,delta_pct,status
+ * rngbuf.put_get,16,262144,41.25,387878787,40.90,+0.8,ok
+ * \endcode
+ *
+ * ˻׼ߣam_bench_baseline_set()ʱÿ׼ֺ͹ģͬ
+ * ļ¼Ƚϣÿβļֵӳֵʱ status Ϊ "REGRESSION"ûжӦ
+ * ¼ʱΪ "new"׼ͨͬһƽ̨һе
+ * arch/posix/bench/am_posix_bench.c
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-16  ljy, add am_bench_counter_get()/am_bench_counter_hz_get()
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_BENCH_H
+#define __AM_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "am_common.h"
+
+/**
+ * \addtogroup am_if_bench
+ * \copydoc am_bench.h
+ * @{
+ */
+
+/** \brief Ĭϵظ */
+#ifndef AM_BENCH_REPEAT_DEF
+#define AM_BENCH_REPEAT_DEF          5
+#endif
+
+/** \brief Ĭϵ̲ʱ䣨ms */
+#ifndef AM_BENCH_MIN_TIME_MS_DEF
+#define AM_BENCH_MIN_TIME_MS_DEF     5
+#endif
+
+/** \brief һβ */
+#define AM_BENCH_OPS_MAX             (1ul << 24)
+
+/**
+ * \brief 
+ */
+typedef struct am_bench_case {
+
+    /** \brief  "rngbuf.put_get"ܰ ',' */
+    const char *p_name;
+
+    /** \brief عģֽԪظȣ */
+    uint32_t    size;
+
+    /** \brief ÿβֽ0 */
+    uint32_t    bytes_per_op;
+
+    /**
+     * \brief ׼أΪ NULL
+     *
+     * ֵС 0 ʱ
+     */
+    int       (*pfn_setup) (void *p_arg, uint32_t size);
+
+    /**
+     * \brief ִ nops β
+     *
+     * ε֮乤ص״̬Ӧȶд
+     */
+    void      (*pfn_run) (void *p_arg, uint32_t size, uint32_t nops);
+
+    /** \brief ͷŹأΪ NULL */
+    void      (*pfn_teardown) (void *p_arg);
+
+    /** \brief صĲ */
+    void       *p_arg;
+
+} am_bench_case_t;
+
+/**
+ * \brief Խ
+ */
+typedef struct am_bench_result {
+    uint32_t ops;                  /**< \brief һβĲ */
+    uint32_t counts;               /**< \brief һβСֵ */
+    uint32_t counts_per_op_x100;   /**< \brief ÿβļֵ  100 */
+    uint64_t bytes_per_sec;        /**< \brief ֽ/룩 */
+} am_bench_result_t;
+
+/**
+ * \brief ׼߼¼
+ */
+typedef struct am_bench_baseline {
+    const char *p_name;              /**< \brief  */
+    uint32_t    size;                /**< \brief عģ */
+    uint32_t    counts_per_op_x100;  /**< \brief ÿβļֵ  100 */
+} am_bench_baseline_t;
+
+/**
+ * \brief ʼ׼Կ
+ *
+ * \param[in] pfn_counter : ɵ 32 λֵƣ
+ * \param[in] counter_hz  : ƵʣHz
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ *
+ * \note ̲ʱڼֵܻΣƵʽϸʱ 1GHz̲
+ *       ʱ䲻ܳ 4s
+ */
+int am_bench_init (uint32_t (*pfn_counter) (void), uint32_t counter_hz);
+
+/**
+ * \brief ظ̲ʱ
+ *
+ * \param[in] repeat      : ظ0ʹĬֵ
+ * \param[in] min_time_ms : ̲ʱ䣨ms0ʹĬֵ
+ *
+ * \return 
+ */
+void am_bench_config (unsigned int repeat, unsigned int min_time_ms);
+
+/**
+ * \brief ñȽõĻ׼
+ *
+ * \param[in] p_baseline    : ׼߼¼NULLȽ
+ * \param[in] num           : ¼
+ * \param[in] threshold_pct : жΪ˻ֵٷֱȣ
+ *
+ * \return 
+ */
+void am_bench_baseline_set (const am_bench_baseline_t *p_baseline,
+                            size_t                     num,
+                            unsigned int               threshold_pct);
+
+/**
+ * \brief ȡĵǰֵ
+ *
+ * вβĺʱ
+ *
+ * \return ֵδʼʱΪ 0
+ */
+uint32_t am_bench_counter_get (void);
+
+/**
+ * \brief ȡƵ
+ *
+ * \return ƵʣHzδʼʱΪ 0
+ */
+uint32_t am_bench_counter_hz_get (void);
+
+/**
+ * \brief һ
+ *
+ * \param[in]  p_case   : 
+ * \param[out] p_result : Խ
+ *
+ * \retval  AM_OK     : гɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EPERM  : δʼ
+ * \retval  < 0       :  pfn_setup() صĴ
+ */
+int am_bench_run (const am_bench_case_t *p_case, am_bench_result_t *p_result);
+
+/**
+ * \brief ӡ CSV ͷƵʺ
+ *
+ * \return 
+ */
+void am_bench_header_print (void);
+
+/**
+ * \brief һ CSV ʽӡͷ
+ *
+ * \param[in] p_cases  : 
+ * \param[in] num      : 
+ * \param[in] p_filter : ֻԸַͷNULLȫ
+ *
+ * \retval >= 0      : жΪ˻
+ * \retval -AM_EPERM : δʼ
+ */
+int am_bench_run_all (const am_bench_case_t *p_cases,
+                      size_t                 num,
+                      const char            *p_filter);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_BENCH_H */
+
+/* end of file */
@@ -0,0 +1,277 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ӳ־
+ *
+ *     am_kprintf() ڵôʽַַڣʱɴ΢룬
+ * Ըı䱻Դʱ򡣶־ڵôֻ¼ʽַĵַΪ
+ * ʽ IDԭʼд뻷λأеɵȼ
+ * 񣨻 DMA PC ʹ tools/blog/am_blog_decode.py ݱɵ
+ * ELF ļеĸʽַԭΪı
+ *
+ *     ʽַ .am_blog_fmt Уȡǣӽű
+ * öΪأ GCC  (INFO) / (NOLOAD) ARMCC scatter ļе
+ * Ĳ򣩣Խʡ Flash ռ䡣
+ *
+ *     ÿ 32 λ¼˸ʽַֻ֧ %d %i %u %x %X %o %c %p
+ * ַָλ Flash У %sָ֧ 64 λ
+ * 6 
+ *
+ *      AM_VDEBUG_BLOG AM_DBG_INFO()  AM_LOGF() ȵԺʹö־
+ *  am_vdebug.h
+ *
+ * ¼ʽСˣ
+ *  - 1 ֽͷ 4 λΪ 0xAbit3 Ϊ 1 ʾʱbit0 ~ bit2 Ϊ
+ *    Ϊ 7 ʾʧ¼Ϊ 4 ֽڵĶʧĿûиʽ ID
+ *  - 4 ֽʱУ
+ *  - 4 ֽڸʽ ID
+ *  - ÿ 4 ֽڡ
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_blog.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ * static char __g_blog_buf[1024];       // СΪ 2^n
+ *
+ * static size_t __blog_write (void *p_arg, const void *p_data, size_t len)
+ * {
+ *     return am_uart_poll_send((am_uart_handle_t)p_arg, p_data, len);
+ * }
+ *
+ * am_blog_init(__g_blog_buf, sizeof(__g_blog_buf), __blog_write, uart_handle);
+ *
+ * AM_BLOG("adc %d: %u mV\r\n", chan, mv);
+ *
+ * // ѭʱ
+ * am_blog_process();
+ * \endcode
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_BLOG_H
+#define __AM_BLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_blog
+ * \copydoc am_blog.h
+ * @{
+ */
+#include "am_common.h"
+#include "am_jobq.h"
+
+/** \brief ¼ */
+#define AM_BLOG_ARGS_MAX     6
+
+/** \brief ¼ֽ */
+#define AM_BLOG_RECORD_MAX   (1 + 4 + 4 + 4 * AM_BLOG_ARGS_MAX)
+
+/**
+ * \brief ʽַ .am_blog_fmt 
+ */
+#if defined(__ICCARM__)
+#define AM_BLOG_FMT_SECTION  @ ".am_blog_fmt"
+#elif defined(__CC_ARM) || defined(__GNUC__)
+#define AM_BLOG_FMT_SECTION  __attribute__((section(".am_blog_fmt")))
+#else
+#define AM_BLOG_FMT_SECTION
+#endif
+
+/**
+ * \brief ¼һ־
+ *
+ * ÷ am_kprintf() ͬfmt Ϊַ AM_BLOG_ARGS_MAX 
+ *
+ * \note же
+ */
+#define AM_BLOG(...)                                                         \
+    __AM_BLOG_CAT(__AM_BLOG_, __AM_BLOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+/** \cond */
+#define __AM_BLOG_CAT(a, b)      __AM_BLOG_CAT_(a, b)
+#define __AM_BLOG_CAT_(a, b)     a##b
+
+#define __AM_BLOG_NARGS(...)                                                 \
+    __AM_BLOG_NARGS_(__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0, ~)
+#define __AM_BLOG_NARGS_(fmt, a1, a2, a3, a4, a5, a6, n, ...)   n
+
+#define __AM_BLOG_DO(fmt, n, args)                                           \
+    do {                                                                     \
+        static const char __blog_fmt[] AM_BLOG_FMT_SECTION = fmt;           \
+        am_blog_write(__blog_fmt, n, args);                                  \
+    } while (0)
+
+#define __AM_BLOG_U32(a)         ((uint32_t)(uintptr_t)(a))
+
+#define __AM_BLOG_0(fmt)                                                     \
+    __AM_BLOG_DO(fmt, 0, NULL)
+#define __AM_BLOG_1(fmt, a1)                                                 \
+    __AM_BLOG_DO(fmt, 1, ((const uint32_t []){__AM_BLOG_U32(a1)}))
+#define __AM_BLOG_2(fmt, a1, a2)                                             \
+    __AM_BLOG_DO(fmt, 2, ((const uint32_t []){__AM_BLOG_U32(a1),            \
+                                              __AM_BLOG_U32(a2)}))
+#define __AM_BLOG_3(fmt, a1, a2, a3)                                         \
+    __AM_BLOG_DO(fmt, 3, ((const uint32_t []){__AM_BLOG_U32(a1),            \
+                                              __AM_BLOG_U32(a2),            \
+                                              __AM_BLOG_U32(a3)}))
+#define __AM_BLOG_4(fmt, a1, a2, a3, a4)                                     \
+    __AM_BLOG_DO(fmt, 4, ((const uint32_t []){__AM_BLOG_U32(a1),            \
+                                              __AM_BLOG_U32(a2),            \
+                                              __AM_BLOG_U32(a3),            \
+                                              __AM_BLOG_U32(a4)}))
+#define __AM_BLOG_5(fmt, a1, a2, a3, a4, a5)                                 \
+    __AM_BLOG_DO(fmt, 5, ((const uint32_t []){__AM_BLOG_U32(a1),            \
+                                              __AM_BLOG_U32(a2),            \
+                                              __AM_BLOG_U32(a3),            \
+                                              __AM_BLOG_U32(a4),            \
+                                              __AM_BLOG_U32(a5)}))
+#define __AM_BLOG_6(fmt, a1, a2, a3, a4, a5, a6)                             \
+    __AM_BLOG_DO(fmt, 6, ((const uint32_t []){__AM_BLOG_U32(a1),            \
+                                              __AM_BLOG_U32(a2),            \
+                                              __AM_BLOG_U32(a3),            \
+                                              __AM_BLOG_U32(a4),            \
+                                              __AM_BLOG_U32(a5),            \
+                                              __AM_BLOG_U32(a6)}))
+/** \endcond */
+
+/**
+ * \brief 
+ *
+ * \param[in] p_arg  : û
+ * \param[in] p_data : Ҫ
+ * \param[in] len    : ݳ
+ *
+ * \return ֽʣ´
+ */
+typedef size_t (*am_blog_write_t) (void *p_arg, const void *p_data, size_t len);
+
+/**
+ * \brief ־ͳϢ
+ */
+struct am_blog_stat {
+    uint32_t  records;      /**< \brief д뻺ļ¼           */
+    uint32_t  lost;         /**< \brief ʧļ¼       */
+    uint32_t  used_max;     /**< \brief ֽʷֵ   */
+};
+
+/**
+ * \brief ʼ־
+ *
+ * \param[in] p_buf     : λСΪ 2^nҲС AM_BLOG_RECORD_MAX
+ * \param[in] size      : С
+ * \param[in] pfn_write : Ϊ NULLʱʹ am_blog_peek() 
+ *                        am_blog_consume() ʹ DMA
+ * \param[in] p_arg     : Ĳ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_blog_init (char           *p_buf,
+                  size_t          size,
+                  am_blog_write_t pfn_write,
+                  void           *p_arg);
+
+/**
+ * \brief ʱ
+ *
+ * \param[in] pfn_timestamp : ʱΪ NULL ʱ¼вʱĬϣ
+ *
+ * \return 
+ */
+void am_blog_timestamp_set (uint32_t (*pfn_timestamp) (void));
+
+/**
+ * \brief ʹõ
+ *
+ * úÿдһ¼ὫУڶʱظ룩
+ * ִʱ am_blog_process()ͨʹȼ͵
+ *
+ * \param[in] handle : оΪ NULL ʱʹУĬϣ
+ * \param[in] pri    : ȼ
+ *
+ * \return 
+ */
+void am_blog_jobq_set (am_jobq_handle_t handle, uint16_t pri);
+
+/**
+ * \brief дһ¼ͨʹ AM_BLOG() 
+ *
+ * \param[in] p_fmt  : ʽַλ .am_blog_fmt Σ
+ * \param[in] nargs  : 
+ * \param[in] p_args : 
+ *
+ * \retval  AM_OK     : дɹ
+ * \retval -AM_EFULL  : ¼ʧ
+ * \retval -AM_EPERM  : ûгʼ
+ * \retval -AM_EINVAL : 
+ */
+int am_blog_write (const char *p_fmt, uint32_t nargs, const uint32_t *p_args);
+
+/**
+ * \brief еʹֱΪջٽ
+ *
+ * \return ֽ
+ *
+ * \note ڶദͬʱ
+ */
+size_t am_blog_process (void);
+
+/**
+ * \brief ȡһݣ DMA ȷʽ
+ *
+ * \param[out] pp_data : ȡݵ׵ַ
+ * \param[out] p_len   : ȡݵĳ
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EEMPTY : Ϊ
+ */
+int am_blog_peek (const char **pp_data, size_t *p_len);
+
+/**
+ * \brief ͷѾ
+ *
+ * \param[in] len : Ѿֽ
+ *
+ * \return 
+ */
+void am_blog_consume (size_t len);
+
+/**
+ * \brief ȡͳϢ
+ *
+ * \param[out] p_stat : ڻȡͳϢ
+ *
+ * \return 
+ */
+void am_blog_stat_get (struct am_blog_stat *p_stat);
+
+/** @}  am_if_blog */
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus  */
+
+#endif  /* __AM_BLOG_H */
+
+/* end of file */
@@ -25,8 +25,35 @@
  * 2. ¼־ AM_EVENT_PROC_FLAG_CAT_ONLY event typeе
  *    event handler Ҳִһ顣
  *
+ * ӳٷַ
+ * am_event_raise() ڹжϵִ¼ʱϳʱ
+ * жӳ١ʹ am_event_defer_init() ʼӳٷַк
+ * am_event_raise_defer() ֻ¼ݣƵУУ¼
+ * жӳ٣am_isr_deferСжϵִСʱֻ
+ * ȡһʱݹжϣִڼһջϵαڵ¼
+ * λáڴִڼ䱻޸ģעᡢעʱѾִйĴ
+ * ظִУעĴִУעĴһ¼ʼִУ
+ * am_event_raise() ͬ
+ *
+ * 룺
+ * ¼עᵽ¼ʱ˳һ0 ~ 31am_event_mask_get() ȡ
+ * Ӧλʹ am_event_category_handler_register_mask() עദֻ
+ * е¼¼¼дĲûдĵ¼
+ * ദӳٷַʱҲУ 33 Ժע¼
+ * û벻Ϊ 0 ദᴦ
+ *
+ * ¼ϲ
+ * am_event_coalesce_set() ¼ĺϲԺ¼ڶеȴַڼٴ
+ * ʹ am_event_raise_defer() ʱռµĶпռ䣬е¼
+ * ϲ»ݣпʹ am_event_coalesced_get() ȡ
+ * ϲĴڰͻ¼ֻ״̬Ĵ
+ *
  * \internal
  * \par modification history:
+ * - 1.04 26-10-16 ljy, the coalesced count is kept with the dispatch.
+ * - 1.03 26-10-16 ljy, remove the dispatch sequence number from the handler.
+ * - 1.02 26-10-16 ljy, add subscription masks and coalescing.
+ * - 1.01 26-10-16 ljy, add deferred dispatch.
  * - 1.00 17-05-12 tee, first implementation.
  * \endinternal
  */
@@ -66,6 +93,28 @@ extern "C" {
 
 /** @} */
 
+/** \brief û¼ am_event_mask_get() */
+#define AM_EVENT_INDEX_NONE                 0xFF
+
+/** \brief ¼е¼ */
+#define AM_EVENT_MASK_ALL                   0xFFFFFFFFu
+
+/**
+ * \name ¼ϲԣ am_event_coalesce_set()
+ * @{
+ */
+
+/** \brief ϲÿδУĬϣ */
+#define AM_EVENT_COALESCE_NONE              0
+
+/** \brief ϲһδݺͱ־ */
+#define AM_EVENT_COALESCE_LATEST            1
+
+/** \brief ϲһδݺͱ־ */
+#define AM_EVENT_COALESCE_FIRST             2
+
+/** @} */
+
 /** \breif event_category ṹ */
 struct am_event_category;
 typedef struct am_event_category am_event_category_t;
@@ -96,6 +145,7 @@ typedef void am_event_function_t (am_event_type_t   *p_evt_type,
  */
 struct am_event_handler {
     uint16_t                 flags;     /**< \brief ־AM_EVENT_HANDLER_FLAG_*  */
+    uint32_t                 mask;      /**< \brief ദĵ¼ */
     am_event_function_t     *pfn_proc;  /**< \brief   */
     void                    *p_data;    /**< \brief ¼˽      */
     struct am_event_handler *p_next;    /**< \brief ָһ¼  */
@@ -109,6 +159,7 @@ void am_event_handler_init (am_event_handler_t  *p_handler,
                             uint16_t             flags)
 {
     p_handler->flags    = flags;
+    p_handler->mask     = AM_EVENT_MASK_ALL;
     p_handler->pfn_proc = pfn_proc;
     p_handler->p_data   = p_data;
     p_handler->p_next   = NULL;
@@ -120,6 +171,11 @@ struct am_event_type {
     am_event_handler_t  *p_handler;   /**< \brief ¼д */
     am_event_category_t *p_category;  /**< \brief ¼¼  */
     am_event_type_t     *p_next;      /**< \brief ָһ¼  */
+    uint8_t              index;       /**< \brief ¼е */
+    uint8_t              coalesce;    /**< \brief ϲԣAM_EVENT_COALESCE_* */
+
+    /** \brief еȴַԺϲ¼ڲʹã */
+    struct am_event_defer_msg *p_pending;
 };
 
 
@@ -130,8 +186,50 @@ void am_event_init (am_event_type_t *p_event)
     p_event->p_category = NULL;
     p_event->p_handler  = NULL;
     p_event->p_next     = NULL;
+    p_event->index      = AM_EVENT_INDEX_NONE;
+    p_event->coalesce   = AM_EVENT_COALESCE_NONE;
+    p_event->p_pending  = NULL;
 }
 
+/**
+ * \brief ȡ¼¼жӦλ
+ *
+ * \param[in] p_event : עᵽ¼е¼
+ *
+ * \return λ¼ûʱ AM_EVENT_MASK_ALL
+ */
+am_static_inline
+uint32_t am_event_mask_get (am_event_type_t *p_event)
+{
+    return (p_event->index == AM_EVENT_INDEX_NONE) ? AM_EVENT_MASK_ALL
+                                                   : (1u << p_event->index);
+}
+
+/**
+ * \brief ¼ĺϲ
+ *
+ * ֻӰ am_event_raise_defer()am_event_raise() 
+ *
+ * \param[in] p_event : ¼
+ * \param[in] policy  : AM_EVENT_COALESCE_*
+ *
+ * \retval  AM_OK     : óɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_event_coalesce_set (am_event_type_t *p_event, uint8_t policy);
+
+/**
+ * \brief ȡηַϲĴֻڸ¼Ĵе
+ *
+ * ַ棨¼Ужͬһ¼Ӱ
+ * ִеӳٷַĴȡֵ
+ *
+ * \param[in] p_event : ¼
+ *
+ * \return δϲڸ¼ķַʱΪ 1
+ */
+uint16_t am_event_coalesced_get (am_event_type_t *p_event);
+
 /** \brief ע¼¼ */
 int am_event_handler_register (am_event_type_t     *p_event,
                                am_event_handler_t  *p_handler);
@@ -163,6 +261,8 @@ int am_event_raise (am_event_type_t *p_event, void *p_evt_data, int flags);
 struct am_event_category {
     am_event_type_t    *p_event;    /**< \brief ¼  */
     am_event_handler_t *p_handler;  /**< \brief ¼ */
+    uint32_t            idx_used;   /**< \brief ѷ¼ */
+    uint32_t            sub_mask;   /**< \brief дĲ */
 };
 
 
@@ -172,12 +272,28 @@ void am_event_category_init (am_event_category_t *p_category)
 {
     p_category->p_event   = NULL;
     p_category->p_handler = NULL;
+    p_category->idx_used  = 0;
+    p_category->sub_mask  = 0;
 }
 
 /** \brief ע¼¼ */
 int am_event_category_handler_register (am_event_category_t *p_category,
                                         am_event_handler_t  *p_handler);
 
+/**
+ * \brief עֻ¼¼¼
+ *
+ * \param[in] p_category : ¼
+ * \param[in] p_handler  : ¼
+ * \param[in] mask       : ĵ¼am_event_mask_get() ķֵ
+ *                         AM_EVENT_MASK_ALL Ϊ¼
+ *
+ * \return ׼
+ */
+int am_event_category_handler_register_mask (am_event_category_t *p_category,
+                                             am_event_handler_t  *p_handler,
+                                             uint32_t             mask);
+
 /** \brief ¼ע¼ */
 int am_event_category_handler_unregister (am_event_category_t *p_category,
                                           am_event_handler_t  *p_handler);
@@ -190,6 +306,125 @@ int am_event_category_event_register (am_event_category_t *p_category,
 int am_event_category_event_unregister (am_event_category_t *p_category,
                                         am_event_type_t     *p_event);
 
+/**
+ * \name ӳٷַ
+ * @{
+ */
+
+/** \brief ӳٷַʱ¼Ƶݵֽڹ¶壩 */
+#ifndef AM_EVENT_DEFER_DATA_SIZE
+#define AM_EVENT_DEFER_DATA_SIZE    16
+#endif
+
+/**
+ * \brief ӳٷַе¼ûֻ趨飬ҪֱӲԱ
+ */
+typedef struct am_event_defer_msg {
+    am_event_type_t *p_event;   /**< \brief ¼ */
+    void            *p_data;    /**< \brief ݣδʱ */
+    uint32_t         time;      /**< \brief еʱ */
+    uint8_t          flags;     /**< \brief ־ */
+    uint8_t          size;      /**< \brief Ƶֽ */
+    uint16_t         count;     /**< \brief ϲĴ */
+
+    /** \brief Ƶ */
+    union {
+        void        *p_align;
+        uint64_t     u64_align;
+        uint8_t      buf[AM_EVENT_DEFER_DATA_SIZE];
+    } data;
+} am_event_defer_msg_t;
+
+/**
+ * \brief ӳٷַͳϢ
+ */
+struct am_event_defer_stat {
+    uint32_t raised;        /**< \brief е¼ */
+    uint32_t dispatched;    /**< \brief ѷַ¼ */
+    uint32_t dropped;       /**< \brief ¼ */
+    uint32_t pending_max;   /**< \brief ¼ʷֵ */
+    uint32_t relocate;      /**< \brief ִдڼ޸ĵĴ */
+    uint32_t coalesced;     /**< \brief е¼ϲĴ */
+    uint32_t filtered;      /**< \brief ûдġδе¼ */
+
+    /**
+     * \brief  am_event_raise_defer() ʼִдӳ٣λ
+     *        am_event_defer_timestamp_set() õʱ
+     */
+    uint32_t latency_last;  /**< \brief һεӳ */
+    uint32_t latency_max;   /**< \brief ӳ */
+    uint64_t latency_sum;   /**< \brief ӳܺͣ dispatched Ϊƽӳ */
+};
+
+/**
+ * \brief ʼӳٷַ
+ *
+ * \param[in] p_msgs : ʹõ¼飬ȫֻ̬
+ * \param[in] num    : Ԫظɻ¼
+ * \param[in] pri    : ַʹõжӳȼ
+ *                      AM_ISR_DEFER_PRIORITY_NUM_DEF()
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ *
+ * \note ʹǰʼжӳģ飨am_isr_defer_init()
+ */
+int am_event_defer_init (am_event_defer_msg_t *p_msgs,
+                         unsigned int          num,
+                         uint16_t              pri);
+
+/**
+ * \brief һ¼¼жӳִ
+ *
+ * жеásize Ϊ 0 ʱp_evt_data ָ size ֽݱƵ
+ * УյǸĵַ˿Դֲĵַsize Ϊ 0 ʱֱ
+ *  p_evt_data ָ룬豣ַ֤ǰЧ
+ *
+ * ӳٷַδʼʱͬ am_event_raise()˺ϲԵ¼
+ * и¼ȴַ֮ϲռµĶпռ䡣
+ *
+ * \param[in] p_event    : ¼
+ * \param[in] p_evt_data : ¼
+ * \param[in] size       : Ƶֽܳ AM_EVENT_DEFER_DATA_SIZE
+ * \param[in] flags      : ־, 0  AM_EVENT_PROC_FLAG_*
+ *
+ * \retval  AM_OK     : гɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EFULL  : ¼
+ */
+int am_event_raise_defer (am_event_type_t *p_event,
+                          const void      *p_evt_data,
+                          size_t           size,
+                          int              flags);
+
+/**
+ * \brief ͳƷַӳʹõʱ
+ *
+ * \param[in] pfn_timestamp : һɵļֵ DWT ڼΪ
+ *                            NULL ʱͳӳ
+ *
+ * \return 
+ */
+void am_event_defer_timestamp_set (uint32_t (*pfn_timestamp) (void));
+
+/**
+ * \brief ȡӳٷַͳϢ
+ *
+ * \param[out] p_stat : ڻȡͳϢ
+ *
+ * \return 
+ */
+void am_event_defer_stat_get (struct am_event_defer_stat *p_stat);
+
+/**
+ * \brief ӳٷַͳϢ
+ *
+ * \return 
+ */
+void am_event_defer_stat_reset (void);
+
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,189 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ¼
+ *
+ *     ¼ 32 ¼λÿһλʾһ¼硰յݡCAN յ
+ * ֡жϻģͨ am_evgroup_set() ¼λӦóͨ
+ * am_evgroup_wait() ȴһȫ¼ȴڼ䰴յǰĵȴ
+ *  am_wait_strategy_set()Уѯ־
+ *
+ *     ¼黹ΪȴԴ am_evgroup_src_init()źȴԴ
+ * һʹ am_wait_any() / am_wait_all() ȴ
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_evgroup.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ * #define __EV_UART_RX  (1u << 0)
+ * #define __EV_CAN_RX   (1u << 1)
+ *
+ * static am_evgroup_t __g_evgroup;
+ *
+ * am_evgroup_init(&__g_evgroup, 0);
+ *
+ * // ڡCAN ж
+ * am_evgroup_set(&__g_evgroup, __EV_UART_RX);
+ *
+ * // ѭ
+ * uint32_t bits;
+ * if (am_evgroup_wait(&__g_evgroup,
+ *                     __EV_UART_RX | __EV_CAN_RX,
+ *                     AM_EVGROUP_CLEAR,
+ *                     100,
+ *                     &bits) == AM_OK) {
+ *     if (bits & __EV_UART_RX) {
+ *         ...
+ *     }
+ * }
+ * \endcode
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_EVGROUP_H
+#define __AM_EVGROUP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_evgroup
+ * \copydoc am_evgroup.h
+ * @{
+ */
+#include "am_common.h"
+#include "am_wait.h"
+
+/**
+ * \name ȴѡ
+ * @{
+ */
+
+/** \brief ȴȫ¼λĬϵȴһ */
+#define AM_EVGROUP_WAIT_ALL    0x01u
+
+/** \brief ȴɹȴ¼λ */
+#define AM_EVGROUP_CLEAR       0x02u
+
+/** @} */
+
+/**
+ * \brief ¼ṹ壬ӦóӦֱӲṹԱ
+ */
+typedef struct am_evgroup {
+    volatile uint32_t bits;        /**< \brief ǰ¼λ */
+} am_evgroup_t;
+
+/**
+ * \brief ʼ¼
+ *
+ * \param[in] p_evgroup : ָ¼
+ * \param[in] bits      : ʼ¼λ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_evgroup_init (am_evgroup_t *p_evgroup, uint32_t bits);
+
+/**
+ * \brief ¼λѵȴ
+ *
+ * \param[in] p_evgroup : ָ¼
+ * \param[in] bits      : Ҫõ¼λ
+ *
+ * \return ֮ǰ¼λ
+ *
+ * \note же
+ */
+uint32_t am_evgroup_set (am_evgroup_t *p_evgroup, uint32_t bits);
+
+/**
+ * \brief ¼λ
+ *
+ * \param[in] p_evgroup : ָ¼
+ * \param[in] bits      : Ҫ¼λ
+ *
+ * \return ֮ǰ¼λ
+ *
+ * \note же
+ */
+uint32_t am_evgroup_clear (am_evgroup_t *p_evgroup, uint32_t bits);
+
+/**
+ * \brief ȡǰ¼λ
+ *
+ * \param[in] p_evgroup : ָ¼
+ *
+ * \return ǰ¼λ
+ */
+uint32_t am_evgroup_get (am_evgroup_t *p_evgroup);
+
+/**
+ * \brief ȴ¼
+ *
+ * \param[in]  p_evgroup  : ָ¼
+ * \param[in]  bits       : ȴ¼λΪ 0
+ * \param[in]  opt        : ȴѡAM_EVGROUP_WAIT_ALLAM_EVGROUP_CLEAR 
+ *                          ϣΪ 0 ʱȴһ¼Ҳ¼λ
+ * \param[in]  timeout_ms : ʱʱ䣨λmsAM_NO_WAIT ʾȴ
+ *                          AM_WAIT_FOREVER ʾһֱȴ
+ * \param[out] p_bits     : ȡȴ¼λbits õλ
+ *                          Ϊ NULL
+ *
+ * \retval  AM_OK     : ȴɹ
+ * \retval -AM_EAGAIN : ʱʱΪ AM_NO_WAITδ
+ * \retval -AM_ETIME  : ȴʱ
+ * \retval -AM_EINVAL : 
+ */
+int am_evgroup_wait (am_evgroup_t *p_evgroup,
+                     uint32_t      bits,
+                     uint32_t      opt,
+                     uint32_t      timeout_ms,
+                     uint32_t     *p_bits);
+
+/**
+ * \brief ¼ʼΪȴԴ am_wait_any() / am_wait_all()
+ *
+ * ȴɹ󣬵ȴ¼λڵȴԴ val ԱС
+ *
+ * \param[in] p_src     : ָȴԴ
+ * \param[in] p_evgroup : ָ¼
+ * \param[in] bits      : ȴ¼λΪ 0
+ * \param[in] opt       : ȴѡͬ am_evgroup_wait()
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_evgroup_src_init (am_wait_src_t *p_src,
+                         am_evgroup_t  *p_evgroup,
+                         uint32_t       bits,
+                         uint32_t       opt);
+
+/** @}  am_if_evgroup */
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus  */
+
+#endif  /* __AM_EVGROUP_H */
+
+/* end of file */
@@ -37,6 +37,7 @@
  *
  * \internal
  * \par Modification History
+ * - 1.04 26-10-16  ljy, add asynchronous read/write and priority scheduler.
  * - 1.03 15-12-08  cyl, delete the am_i2c_connect.
  * - 1.02 15-10-27  tee, add the concept of message.
  * - 1.01 15-08-19  tee, modified some interface.
@@ -52,6 +53,7 @@ extern "C" {
 #endif
 
 #include "am_common.h"
+#include "am_list.h"
 
 /**
  * @addtogroup am_if_i2c
@@ -454,6 +456,154 @@ int am_i2c_read(am_i2c_device_t *p_dev,
                 uint32_t         sub_addr,
                 uint8_t         *p_buf, 
                 uint32_t         nbytes);
+
+/**
+ * \name I2C Ϣȼ am_i2c_mkasync()  am_i2c_sched_msg_start()
+ * @{
+ * ֻͨ I2C am_i2c_sched_init()صľϢʱȼЧ
+ * ֱʹÿʱϢύ˳
+ */
+
+#define AM_I2C_PRIO_HIGH      0    /**< \brief ȼ RTCȫ */
+#define AM_I2C_PRIO_NORMAL    1    /**< \brief ͨȼĬϣ */
+#define AM_I2C_PRIO_LOW       2    /**< \brief ȼ */
+#define AM_I2C_PRIO_NUM       3    /**< \brief ȼ */
+
+/** @} */
+
+/**
+ * \brief I2C 첽дɻص
+ *
+ * \param[in] p_arg  : û
+ * \param[in] status : Ϣ am_i2c_msg_start()  status ˵
+ *
+ * \return 
+ *
+ * \note ص I2C жִС
+ */
+typedef void (*am_i2c_async_cb_t) (void *p_arg, int status);
+
+/**
+ * \brief I2C 첽дƼʹ am_i2c_mkasync() ñݽṹ
+ *
+ * ɵṩ洢ռ䣬ɣصã֮ǰͷŻظʹá
+ */
+typedef struct am_i2c_async {
+    am_i2c_message_t   msg;          /**< \brief ӦϢ       */
+    am_i2c_transfer_t  trans[2];     /**< \brief ӵַݴ     */
+    uint8_t            subaddr[2];   /**< \brief ӵַ               */
+    uint8_t            prio;         /**< \brief ȼ AM_I2C_PRIO_* */
+    am_i2c_async_cb_t  pfn_complete; /**< \brief ɻص         */
+    void              *p_arg;        /**< \brief ɻص     */
+} am_i2c_async_t;
+
+/**
+ * \brief  I2C 첽д
+ *
+ * \param[in] p_req        : 첽д
+ * \param[in] pfn_complete : ɻصΪ NULL
+ * \param[in] p_arg        : ɻص
+ * \param[in] prio         : ȼ AM_I2C_PRIO_*
+ *
+ * \return 
+ */
+am_static_inline
+void am_i2c_mkasync (am_i2c_async_t    *p_req,
+                     am_i2c_async_cb_t  pfn_complete,
+                     void              *p_arg,
+                     uint8_t            prio)
+{
+    p_req->pfn_complete = pfn_complete;
+    p_req->p_arg        = p_arg;
+    p_req->prio         = prio;
+}
+
+/**
+ * \brief I2C 첽дݣȴ
+ *
+ * \param[in] p_dev    : ָӻ豸ϢĽṹָ
+ * \param[in] sub_addr : ӻ豸ӵַ
+ * \param[in] p_buf    : ָݻ棬֮ǰ޸
+ * \param[in] nbytes   : ݻ泤
+ * \param[in] p_req    :  am_i2c_mkasync() õ첽д
+ *
+ * \retval  AM_OK      : Ŷӣʱûص
+ * \retval -AM_EINVAL  : 
+ * \retval -AM_ENOTSUP : ӵַȲ֧
+ */
+int am_i2c_write_async (am_i2c_device_t *p_dev,
+                        uint32_t         sub_addr,
+                        const uint8_t   *p_buf,
+                        uint32_t         nbytes,
+                        am_i2c_async_t  *p_req);
+
+/**
+ * \brief I2C 첽ݣȴ
+ *
+ * \param[in] p_dev    : ָӻ豸ϢĽṹָ
+ * \param[in] sub_addr : ӻ豸ӵַ
+ * \param[in] p_buf    : ָݻ棬ɻصЧ
+ * \param[in] nbytes   : ݻ泤
+ * \param[in] p_req    :  am_i2c_mkasync() õ첽д
+ *
+ * \retval  AM_OK      : Ŷӣʱûص
+ * \retval -AM_EINVAL  : 
+ * \retval -AM_ENOTSUP : ӵַȲ֧
+ */
+int am_i2c_read_async (am_i2c_device_t *p_dev,
+                       uint32_t         sub_addr,
+                       uint8_t         *p_buf,
+                       uint32_t         nbytes,
+                       am_i2c_async_t  *p_req);
+
+/**
+ * \brief I2C ߵ
+ *
+ * Ҳһ I2C ׼λӦú I2C ֮䣺Ϣȼ
+ * ŶӣͬһȼȽȳÿֻһϢϢʱж
+ * УһȼϢȻٵøϢɻص
+ * ʹõĴӻ豸ͬ첽д
+ */
+typedef struct am_i2c_sched {
+    am_i2c_serv_t        serv;      /**< \brief ṩ I2C ׼ */
+    am_i2c_handle_t      bus;       /**< \brief I2C             */
+
+    /** \brief ȼϢ */
+    struct am_list_head  queue[AM_I2C_PRIO_NUM];
+
+    am_i2c_message_t    *p_cur_msg; /**< \brief ڴϢ      */
+    am_pfnvoid_t         pfn_cur;   /**< \brief ǰϢɻص    */
+    void                *p_cur_arg; /**< \brief ǰϢɻص    */
+    am_bool_t            starting;  /**< \brief ύϢ      */
+} am_i2c_sched_t;
+
+/**
+ * \brief ʼ I2C ߵ
+ *
+ * \param[in] p_sched : I2C ߵ
+ * \param[in] bus     : I2C ÿֻӦͨʹ
+ *
+ * \return  I2C ׼NULL ʾ
+ */
+am_i2c_handle_t am_i2c_sched_init (am_i2c_sched_t  *p_sched,
+                                   am_i2c_handle_t  bus);
+
+/**
+ * \brief ָȼһϢ
+ *
+ *  am_i2c_msg_start() ͬʹõ am_i2c_msg_start() ʱȼΪ
+ * AM_I2C_PRIO_NORMAL
+ *
+ * \param[in]     p_sched : I2C ߵ
+ * \param[in,out] p_msg   : ҪϢ
+ * \param[in]     prio    : ȼ AM_I2C_PRIO_*
+ *
+ * \retval  AM_OK     : ϢŶӳɹȴ
+ * \retval -AM_EINVAL : 
+ */
+int am_i2c_sched_msg_start (am_i2c_sched_t   *p_sched,
+                            am_i2c_message_t *p_msg,
+                            uint8_t           prio);
 /** 
  * @}
  */
@@ -32,6 +32,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, size the bitmap with AM_JOBQ_BITMAP_SIZE()
  * - 1.00 15-09-17  tee, first implementation
  * \endinternal
  */
@@ -39,6 +40,10 @@
 #ifndef __AM_ISR_DEFER_H
 #define __AM_ISR_DEFER_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * \addtogroup am_if_isr_defer
  * \copydoc am_isr_defer.h
@@ -77,7 +82,8 @@ struct am_isr_defer_info {
         unsigned int          priority_num;                         \
         unsigned int         *p_bitmap_job;                         \
         struct am_list_head   pri_heads[pri_num];                   \
-        unsigned int          bitmap_job[((pri_num) + 31) >> 5];    \
+        unsigned int          bitmap_job[                           \
+                                  AM_JOBQ_BITMAP_SIZE(pri_num)];    \
     };                                                              \
     static struct __isr_defer_jobqinfo __isr_defer_jobq_info;       \
     static struct __isr_defer_jobqinfo __isr_defer_jobq_info =      \
@@ -22,6 +22,10 @@
  *      رأʱָȼȼߵ񽫻
  *  дʱֵעǣֻȴȼߵ
  *  񣬲ܴȼ͵
+ *      ʱʱͳеӳٺִʱ䡣ڹж
+ *  AM_JOBQ_JOB_RUN_TIME ʱͳÿִʱ䣬ʱĴ
+ *  غ豣ЧвͷŸڵڴ棩δʱ
+ *  Ĵʼִквٷʸ
  *
  * ʹñҪͷļ:
  * \code
@@ -30,6 +34,9 @@
  *
  * \internal
  * \par modification history:
+ * - 1.03 26-10-16  ljy, per-job run time only with AM_JOBQ_JOB_RUN_TIME
+ * - 1.02 26-10-16  ljy, add deadline jobs, time budget and job run time
+ * - 1.01 26-10-16  ljy, support 32768 priorities, add statistics
  * - 1.00 15-09-17  tee, first implementation
  * \endinternal
  */
@@ -37,6 +44,10 @@
 #ifndef __AM_JOBQ_H
 #define __AM_JOBQ_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * \addtogroup am_if_jobq
  * \copydoc am_jobq.h
@@ -45,6 +56,53 @@
 #include "am_list.h"
 #include <string.h>
 
+/**
+ * \brief ȼĿΪ pri_num ʱλͼҪunsigned int
+ *
+ * ȼĿ 1024 ʱΪ (pri_num + 31) / 32 1024 ʱʹλͼ
+ * Ҫ (pri_num + 1023) / 1024 
+ */
+#define AM_JOBQ_BITMAP_SIZE(pri_num)                                   \
+            ((((pri_num) + 31) >> 5) +                                 \
+             (((pri_num) > 1024) ? (((pri_num) + 1023) >> 10) : 0))
+
+/**
+ * \brief ͳϢ
+ */
+struct am_jobq_stat {
+    uint32_t  posts;        /**< \brief ɹеĴ                   */
+    uint32_t  busy;         /**< \brief ڶе¼ʧܵĴ     */
+    uint32_t  runs;         /**< \brief ִĴ                       */
+
+    /**
+     * \brief Ӽеʼִеӳ٣λΪʱļλ
+     *        δʱʱΪ 0
+     */
+    uint32_t  latency_max;
+
+    /** \brief ִʱ䣬λͬ latency_max */
+    uint32_t  run_time_max;
+
+    /** \brief нֹʱʼִʱѳֹʱĴ */
+    uint32_t  deadline_miss;
+
+    /** \brief am_jobq_process_budget() ʱԤصĴ */
+    uint32_t  budget_exhausted;
+};
+
+/**
+ * \brief ִͳϢ
+ */
+struct am_jobq_job_stat {
+    uint32_t  run_count;    /**< \brief ִд                             */
+
+    /**
+     * \brief ִʱ䣬λΪʱļλδʱδ
+     *         AM_JOBQ_JOB_RUN_TIME ʱΪ 0
+     */
+    uint32_t  run_time_max;
+};
+
 
 /**
  * \brief нṹ
@@ -54,7 +112,7 @@ typedef struct am_jobq_queue {
     /** \brief ÿȼӦһͷ    */
     struct am_list_head  *p_heads;
     
-    /** \brief еȼĿȼĿΪ1024   */
+    /** \brief еȼĿȼĿΪ32768  */
     unsigned int          pri_num;
     
      /** \brief ÿλʾһ飬Ϊ 1 ʾ       */
@@ -62,9 +120,21 @@ typedef struct am_jobq_queue {
     
     /** \brief һ32λΪ 1 ʾȼ */
     unsigned int         *p_bitmap_job;
+
+    /** \brief λͼм伶ȼĿ 1024 ʱΪ NULL */
+    unsigned int         *p_bitmap_mid;
  
     /** \brief еһЩ״̬־      */
     uint32_t              flags;
+
+    /** \brief ͳӳʹõʱ    */
+    uint32_t            (*pfn_timestamp) (void);
+
+    /** \brief нֹʱ񣬰ֹʱȺ */
+    struct am_list_head   edf_head;
+
+    /** \brief ͳϢ                    */
+    struct am_jobq_stat   stat;
 } am_jobq_queue_t;
 
 /**
@@ -78,11 +148,17 @@ typedef struct am_jobq_queue *am_jobq_handle_t;
  * ʹøͶһjobӦam_jobq_mkjob()еĸԱ
  */
 typedef struct am_jobq_job {
-    am_pfnvoid_t        func;   /**< \brief ӦĴ */
-    void               *p_arg;  /**< \brief ӦĲ   */
-    uint16_t            pri;    /**< \brief ȼ               */
-    uint16_t            flags;  /**< \brief һЩ־             */
-    struct am_list_head node;   /**< \brief ڵ             */
+    am_pfnvoid_t        func;         /**< \brief ӦĴ */
+    void               *p_arg;        /**< \brief ӦĲ   */
+    uint16_t            pri;          /**< \brief ȼ               */
+    uint16_t            flags;        /**< \brief һЩ־             */
+    struct am_list_head node;         /**< \brief ڵ             */
+    uint32_t            time;         /**< \brief ʱʱ   */
+    uint32_t            deadline;     /**< \brief ֹʱ䣨ʱ   */
+    uint32_t            run_count;    /**< \brief ִд             */
+#ifdef AM_JOBQ_JOB_RUN_TIME
+    uint32_t            run_time_max; /**< \brief ִʱ         */
+#endif
 } am_jobq_job_t;
 
 /**
@@ -93,8 +169,9 @@ typedef struct am_jobq_job {
  *                             - ʵЧȼΪ0 ~ priority_num - 1
                                - ֵԽȼԽͣ0Ϊȼ
  * \param[in] p_heads      : ڴ䣬СΪ priority_num 
- * \param[in] p_bitmap_job : ڴ䣬СΪ priority_num / 32 ȡ
- *                           (priority_num + 31) / 32
+ * \param[in] p_bitmap_job : ڴ䣬СΪ
+ *                           AM_JOBQ_BITMAP_SIZE(priority_num)ȼĿ
+ *                           1024 ʱ(priority_num + 31) / 32
  *
  * \return еĲʼʧܣֵΪNULL
  *
@@ -105,7 +182,7 @@ typedef struct am_jobq_job {
  *
  *  am_jobq_queue_t      myqjob_queue;
  *  struct am_list_head  myqjob_head[MY_QJOB_NUM_PRI];
- *  unsigned int         myqjob_pri_active[(MY_QJOB_NUM_PRI + 31) / 32];
+ *  unsigned int         myqjob_pri_active[AM_JOBQ_BITMAP_SIZE(MY_QJOB_NUM_PRI)];
  *
  *  am_jobq_queue_init(&myqjob_queue,
  *                     MY_QJOB_NUM_PRI,
@@ -158,6 +235,29 @@ void am_jobq_job_init (am_jobq_job_t  *p_job,
  */
 int am_jobq_post (am_jobq_handle_t handle, am_jobq_job_t *p_job);
 
+/**
+ * \brief һнֹʱӵ
+ *
+ * нֹʱֻȼִУ໥֮䰴ֹʱȺִУ
+ * ֹʱȣEDFȼáֹʱʹеʱ
+ *  am_jobq_stat_timestamp_set()㣬ʹ DWT ڼ am_timer
+ * ļֵ
+ *
+ * \param[in] handle   : еı׼
+ * \param[in] p_job    : ָָ
+ * \param[in] deadline : ڵǰʱĽֹʱ䣬λΪʱļλ
+ *
+ * \retval AM_OK      ɹ
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EBUSY  : ǰѾڶУ޷ظ
+ * \retval -AM_EPERM  : ûʱ
+ *
+ * \note ʱֹʱʱнֹʱĿ
+ */
+int am_jobq_post_deadline (am_jobq_handle_t  handle,
+                           am_jobq_job_t    *p_job,
+                           uint32_t          deadline);
+
 /**
  * \brief һУϺ󷵻
  *
@@ -172,6 +272,73 @@ int am_jobq_post (am_jobq_handle_t handle, am_jobq_job_t *p_job);
  */
 int am_jobq_process (am_jobq_handle_t handle);
 
+/**
+ * \brief ʱԤڴ
+ *
+ *  am_jobq_process() ͬʱﵽ budget ٿʼµʣ
+ * ڶУ´δʱִСִе񲻻ᱻϣʵʱ
+ *  budget һִʱ䡣ԵĿ֮䴦ͨŵ
+ *
+ * \param[in] handle : еı׼
+ * \param[in] budget : ʱԤ㣬λΪʱļλ
+ *
+ * \retval AM_OK      
+ * \retval -AM_ETIME  : ʱԤ꣬л
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EBUSY  : ǰڴ
+ * \retval -AM_EPERM  : ûʱ
+ */
+int am_jobq_process_budget (am_jobq_handle_t handle, uint32_t budget);
+
+/**
+ * \brief ȡִͳϢ
+ *
+ *  AM_JOBQ_JOB_RUN_TIME ʱʱÿִ񶼻
+ * ִʱ䣬ʱĴغ豣Ч
+ *
+ * \param[in]  p_job  : ָָ
+ * \param[out] p_stat : ڻȡͳϢ
+ *
+ * \retval AM_OK      : ȡɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_jobq_job_stat_get (am_jobq_job_t *p_job, struct am_jobq_job_stat *p_stat);
+
+/**
+ * \brief ͳӳʹõʱ
+ *
+ * úÿСʼִкִнʱȡһʱͳ
+ * ӳٺִʱ䡣ֹʱʱԤҲʹøʱ
+ * ʱӦصļֵ綨ʱֵơ
+ *
+ * \param[in] handle        : еı׼
+ * \param[in] pfn_timestamp : ʱΪ NULL ʱͳӳ٣Ĭϣ
+ *
+ * \return 
+ */
+void am_jobq_stat_timestamp_set (am_jobq_handle_t   handle,
+                                 uint32_t         (*pfn_timestamp) (void));
+
+/**
+ * \brief ȡеͳϢ
+ *
+ * \param[in]  handle : еı׼
+ * \param[out] p_stat : ڻȡͳϢ
+ *
+ * \retval AM_OK      : ȡɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_jobq_stat_get (am_jobq_handle_t handle, struct am_jobq_stat *p_stat);
+
+/**
+ * \brief еͳϢ
+ *
+ * \param[in] handle : еı׼
+ *
+ * \return 
+ */
+void am_jobq_stat_reset (am_jobq_handle_t handle);
+
 /**
  * \brief ʵָʹõȼ
  *
@@ -188,7 +355,8 @@ int am_jobq_process (am_jobq_handle_t handle);
             struct __jobqinfo_##queue_name {                                \
                 am_jobq_queue_t      jobq_queue;                            \
                 struct am_list_head  pri_heads[priority_num];               \
-                unsigned int         bitmap_job[(priority_num + 31) >> 5];  \
+                unsigned int         bitmap_job[                            \
+                                         AM_JOBQ_BITMAP_SIZE(priority_num)];\
             } queue_name;
 
 /**
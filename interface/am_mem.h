@@ -20,10 +20,13 @@
  * \endcode
  * ṩ˶̬ڴĽӿ
  *
- * // ݴӡ
+ * ϵͳѿɶڴɣоƬĶ SRAM 飩ÿвͬ
+ * AM_MEM_ATTR_*ʹ am_mem_alloc_attr() ԴҪз䣬
+ *  DMA Ҫٷʵݵȡ
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, add memory attributes and am_mem_alloc_attr()
  * - 1.00 16-10-27  tee, first implementation
  * \endinternal
  */
@@ -43,6 +46,17 @@ extern "C" {
  * @{
  */
 
+/**
+ * \name ڴԣʹû|
+ * @{
+ */
+
+#define AM_MEM_ATTR_DMA     (1u << 0)  /**< \brief Ա DMA               */
+#define AM_MEM_ATTR_FAST    (1u << 1)  /**< \brief ڴ棨ڴ棩     */
+#define AM_MEM_ATTR_RETAIN  (1u << 2)  /**< \brief ͹ģʽݱ         */
+
+/** @} */
+
 /**
  * \brief һalignֽڶڴռ
  *
@@ -60,6 +74,22 @@ void *am_mem_align(size_t size, size_t align);
  */
 void *am_mem_alloc(size_t size);
 
+/**
+ * \brief ӾָԵڴзһڴռ
+ *
+ * ֻ԰ flags Եз䡣Ҫʱʹö
+ * ٵͨռ DMAڴϡȱ򣩣ռ䲻
+ * ʱγҪ
+ *
+ * \param[in] size  ռĴС
+ * \param[in] flags : ҪڴԣAM_MEM_ATTR_*Ϊ 0 ʱͬ am_mem_alloc()
+ *
+ * \return ռ׵ַNULLʧ
+ *
+ * \note Ŀռʹ am_mem_free() ͷ
+ */
+void *am_mem_alloc_attr(size_t size, uint32_t flags);
+
 /**
  * \brief һڴռ䣨ڴռᱻʼΪ0
  *
@@ -14,8 +14,28 @@
  * \file
  * \brief ѹ
  *
+ * ѹַ㷨ڳʼʱѡ
+ *  - am_memheap_init()      : ״䣨first-fitڵ˳ң
+ *                             ռöռ䣬ʱƬ
+ *  - am_memheap_init_tlsf() : 䣨TLSFп鰴Сֱӣͨ
+ *                             λͼң䡢ͷžΪʱ䣬ƬҲ١
+ *                             ƿռڴռʼһ֣32 λƽ̨ϣ
+ *                             16KB ĶԼ 400 ֽڣ
+ *
+ * TLSF ÿ 2 ݴϸĿΪ 2^AM_MEMHEAP_TLSF_SL_LOG2ĬΪ 8
+ * ¶塣
+ *
+ * ϵĽӿڣam_memheap_walk() Уڴ飬am_memheap_info_get()
+ * ȡп顢пĿСֲƬϢam_memheap_dump() ӡѵ
+ * ״̬ЩӿڲӰ䡢ͷŵܡڹж AM_MEMHEAP_TRACEÿ
+ * ڴ¼ߣ am_memheap_alloc() ķصַ
+ * am_memheap_alloc_tag() ָıǣʹ am_memheap_caller_stat_get() 
+ * ͳʹõڴ棬ڲڴй©δúʱûκζ⿪
+ *
  * \internal
  * \par modification history:
+ * - 1.02 26-10-16  ljy, add walk/info/dump and AM_MEMHEAP_TRACE
+ * - 1.01 26-10-16  ljy, add am_memheap_init_tlsf()
  * - 1.00 16-10-27  tee, copy from amorks
  * \endinternal
  */
@@ -35,6 +55,8 @@ extern "C" {
  * @{
  */
 
+struct am_memheap_tlsf;
+
 /**
  * \brief memory item on the memory heap
  */
@@ -48,6 +70,10 @@ typedef struct am_memheap_item
 
     struct am_memheap_item *next_free;       /**< next free memheap item   */
     struct am_memheap_item *prev_free;       /**< prev free memheap item   */
+
+#ifdef AM_MEMHEAP_TRACE
+    const void             *caller;          /**< caller of used item      */
+#endif
 } am_memheap_item_t;
 
 /**
@@ -66,6 +92,8 @@ typedef struct am_memheap
 
     struct am_memheap_item *free_list;          /**< free block list */
     struct am_memheap_item  free_header;        /**< free block list header */
+
+    struct am_memheap_tlsf *p_tlsf;             /**< TLSF control block, NULL: first-fit */
  
 } am_memheap_t;
 
@@ -84,6 +112,24 @@ am_err_t am_memheap_init(struct am_memheap *memheap,
                          const char        *name,
                          void              *start_addr,
                          uint32_t           size);
+
+/**
+ * \brief ʼһʹ TLSF 㷨Ķѹ
+ *
+ *  am_memheap_init() ͬӿڵʹ÷䡣
+ *
+ * \param[in] memheap    ָʼĶѹ
+ * \param[in] name       : ѹ
+ * \param[in] start_addr : öѹڴռʼַ
+ * \param[in] size       : öѹڴռĴСֽ
+ *
+ * \retval AM_OK       : ʼɹ
+ * \retval -AM_ENOMEM  : ڴռ̫СԴſƿ
+ */
+am_err_t am_memheap_init_tlsf(struct am_memheap *memheap,
+                              const char        *name,
+                              void              *start_addr,
+                              uint32_t           size);
  
 /**
  * \brief Ӷзռ
@@ -128,6 +174,159 @@ void *am_memheap_realloc(struct am_memheap *heap, void *ptr, size_t newsize);
  */
 void am_memheap_free(void *ptr);
 
+/** \brief am_memheap_info пСֲ */
+#define AM_MEMHEAP_HIST_NUM    16
+
+/**
+ * \brief һڴϢ am_memheap_walk()
+ */
+struct am_memheap_block_info {
+    void       *ptr;     /**< \brief ׵ַ                           */
+    uint32_t    size;    /**< \brief С                             */
+    am_bool_t   used;    /**< \brief Ƿѷ                             */
+    const void *caller;  /**< \brief ߣδ AM_MEMHEAP_TRACE ʱΪ NULL */
+};
+
+/**
+ * \brief ڴĻص
+ *
+ * \param[in] p_arg  : û
+ * \param[in] p_info : ڴϢ
+ *
+ * \return ط 0 ֵʱֹͣ
+ */
+typedef int (*am_memheap_walk_cb_t) (void                               *p_arg,
+                                     const struct am_memheap_block_info *p_info);
+
+/**
+ * \brief ѵƬϢ
+ */
+struct am_memheap_info {
+    uint32_t free_size;     /**< \brief ппС֮         */
+    uint32_t free_largest;  /**< \brief ĿпС           */
+    uint32_t free_blocks;   /**< \brief пĿ                       */
+    uint32_t used_size;     /**< \brief ѷС֮       */
+    uint32_t used_blocks;   /**< \brief ѷĿ                     */
+
+    /**
+     * \brief Ƭʣǧֱȣ1000  (1 - free_largest / free_size)
+     *        Ϊ 0 ʾпռ䶼
+     */
+    uint32_t frag_permille;
+
+    /**
+     * \brief пСֲ i ΪС [2^(i+3), 2^(i+4)) ֮Ŀ
+     *         0 СĿ飬һĿ
+     */
+    uint32_t hist_free[AM_MEMHEAP_HIST_NUM];
+
+    /** \brief ѷСֲͬ hist_free */
+    uint32_t hist_used[AM_MEMHEAP_HIST_NUM];
+};
+
+/**
+ * \brief Уеڴ飨ַ˳
+ *
+ * Уÿ magicѡǰӺ͵ַΧִʱء
+ *
+ * \param[in] heap  : ָѹ
+ * \param[in] pfn   : صΪ NULLֻУ飩
+ * \param[in] p_arg : صû
+ *
+ * \retval  AM_OK     : ɣ򱻻صֹͣ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EFAULT : ѱƻ
+ *
+ * \note ڼ䲻ܷ䡢ͷŸöѵڴ
+ */
+int am_memheap_walk(struct am_memheap    *heap,
+                    am_memheap_walk_cb_t  pfn,
+                    void                 *p_arg);
+
+/**
+ * \brief ȡѵƬϢ
+ *
+ * \param[in]  heap   : ָѹ
+ * \param[out] p_info : ڻȡƬϢ
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EFAULT : ѱƻ
+ */
+int am_memheap_info_get(struct am_memheap *heap, struct am_memheap_info *p_info);
+
+/**
+ * \brief ʹ am_kprintf() ӡڴ鼰ƬϢ
+ *
+ * \param[in] heap : ָѹ
+ *
+ * \retval  AM_OK     : ӡ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EFAULT : ѱƻ
+ */
+int am_memheap_dump(struct am_memheap *heap);
+
+#ifdef AM_MEMHEAP_TRACE
+
+/**
+ * \brief ȡߵķصַ am_memheap_alloc_tag() ķ߱
+ */
+#if defined(__CC_ARM)
+#define AM_MEMHEAP_CALLER()    ((const void *)__return_address())
+#elif defined(__GNUC__)
+#define AM_MEMHEAP_CALLER()    ((const void *)__builtin_return_address(0))
+#else
+#define AM_MEMHEAP_CALLER()    ((const void *)NULL)
+#endif
+
+/**
+ * \brief ͳƵʹõڴ
+ */
+struct am_memheap_caller_stat {
+    const void *caller;       /**< \brief                */
+    uint32_t    live_size;    /**< \brief ʹõС */
+    uint32_t    live_blocks;  /**< \brief ʹõĿĿ     */
+};
+
+/**
+ * \brief Ӷзռ䣬ָ߱
+ *
+ *  am_memheap_alloc() зװĺ am_mem_alloc()Խ
+ * AM_MEMHEAP_CALLER() Ϊǣʹͳƽָʵʵĵλá
+ *
+ * \param[in] heap   : ָѹ
+ * \param[in] size   : ռĴС
+ * \param[in] caller : ߱
+ *
+ * \return ռ׵ַNULLʧ
+ */
+void *am_memheap_alloc_tag(struct am_memheap *heap,
+                           uint32_t           size,
+                           const void        *caller);
+
+/**
+ * \brief ͳʹõڴ
+ *
+ * \param[in]  heap   : ָѹ
+ * \param[out] p_stat : ͳƽ
+ * \param[in]  num    : 
+ *
+ * \retval >=0        : ͳƵķĿߵĿ鲻ͳ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EFAULT : ѱƻ
+ */
+int am_memheap_caller_stat_get(struct am_memheap             *heap,
+                               struct am_memheap_caller_stat *p_stat,
+                               unsigned int                   num);
+
+#else
+
+#define AM_MEMHEAP_CALLER()    ((const void *)NULL)
+
+#define am_memheap_alloc_tag(heap, size, caller)  am_memheap_alloc((heap), (size))
+
+#endif /* AM_MEMHEAP_TRACE */
+
 /** @}  am_if_memheap */
 
 #ifdef __cplusplus
@@ -0,0 +1,258 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ̶Сڴ
+ *
+ *     ЭջоҪƵ䡢ͷŴСͬСϢ
+ * Ӷз䣬ÿ鶼пͷĿʱҲȷڴؽһξ̬
+ * ڴ滮Ϊ N СͬĿ飬пͨڵָһ𣬷䡢ͷžΪ
+ * ʱ䣬ûжĿռ俪䡢ͷʱرжϣжʹá
+ *
+ *     ͬСڴؿһСּķam_mempool_class
+ * ʱѡССĿأ̫ʱָĶѹ
+ * з䡣
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_mempool.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ * AM_MEMPOOL_MEM_DEF(__g_msg_mem, sizeof(struct msg), 16);
+ *
+ * static am_mempool_t        __g_msg_pool;
+ * static am_mempool_handle_t __g_msg_handle;
+ *
+ * __g_msg_handle = am_mempool_init(&__g_msg_pool,
+ *                                  __g_msg_mem,
+ *                                  sizeof(__g_msg_mem),
+ *                                  sizeof(struct msg));
+ *
+ * struct msg *p_msg = am_mempool_alloc(__g_msg_handle);
+ * ...
+ * am_mempool_free(__g_msg_handle, p_msg);
+ * \endcode
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_MEMPOOL_H
+#define __AM_MEMPOOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_mempool
+ * \copydoc am_mempool.h
+ * @{
+ */
+#include "am_common.h"
+#include "am_memheap.h"
+
+/**
+ * \brief СΪ size ʱʵÿռõָֽС룩
+ */
+#define AM_MEMPOOL_BLOCK_SIZE(size) \
+    AM_ROUND_UP(((size) < sizeof(void *)) ? sizeof(void *) : (size), \
+                sizeof(void *))
+
+/**
+ * \brief ڴʹõڴռ䣨ָС룩
+ *
+ * \param[in] name : ڴռ
+ * \param[in] size : С
+ * \param[in] num  : Ŀ
+ *
+ * \note Ϊ̬ڴռĴСʹ sizeof(name) ȡ
+ */
+#define AM_MEMPOOL_MEM_DEF(name, size, num)                               \
+    static void *name[(AM_MEMPOOL_BLOCK_SIZE(size) / sizeof(void *)) * (num)]
+
+/**
+ * \brief ڴؽṹ壬ӦóӦֱӲṹԱ
+ */
+typedef struct am_mempool {
+
+    /** \brief пÿп׸ָָһп */
+    void          *p_free;
+
+    /** \brief ڴռʼַ */
+    uint8_t       *p_start;
+
+    /** \brief ڴռַ */
+    uint8_t       *p_end;
+
+    /** \brief ÿռõֽ */
+    size_t         block_size;
+
+    /** \brief Ŀ */
+    unsigned int   block_num;
+
+    /** \brief ǰпĿ */
+    unsigned int   nfree;
+
+    /** \brief пĿʷСֵ */
+    unsigned int   nfree_min;
+
+    /** \brief ûпп鵼·ʧܵĴ */
+    unsigned int   nfail;
+} am_mempool_t;
+
+/** \brief ڴؾ */
+typedef am_mempool_t *am_mempool_handle_t;
+
+/**
+ * \brief ڴͳϢ
+ */
+struct am_mempool_stat {
+    size_t         block_size;  /**< \brief ÿռõֽ             */
+    unsigned int   block_num;   /**< \brief Ŀ                       */
+    unsigned int   nfree;       /**< \brief ǰпĿ               */
+    unsigned int   used_max;    /**< \brief ͬʱʹõĿĿʷֵ */
+    unsigned int   nfail;       /**< \brief ʧܵĴ               */
+};
+
+/**
+ * \brief Сּķ
+ */
+typedef struct am_mempool_class {
+
+    /** \brief ڴ飬밴СС */
+    am_mempool_handle_t *p_pools;
+
+    /** \brief ڴĿ */
+    unsigned int         pool_num;
+
+    /** \brief ̫ʱʹõĶѹNULL ʾʹ */
+    am_memheap_t        *p_heap;
+} am_mempool_class_t;
+
+/**
+ * \brief ʼһڴ
+ *
+ * \param[in] p_pool     : ָڴ
+ * \param[in] p_mem      : ڴռ䣬밴ָС룬ʹ
+ *                         AM_MEMPOOL_MEM_DEF() 
+ * \param[in] mem_size   : ڴռĴСֽ
+ * \param[in] block_size : Сʵռ AM_MEMPOOL_BLOCK_SIZE(block_size)
+ *                         ֽ
+ *
+ * \return ڴؾΪ NULL Чڴռ䲻һ
+ */
+am_mempool_handle_t am_mempool_init (am_mempool_t *p_pool,
+                                     void         *p_mem,
+                                     size_t        mem_size,
+                                     size_t        block_size);
+
+/**
+ * \brief ڴзһ
+ *
+ * \param[in] handle : ڴؾ
+ *
+ * \return ׵ַNULL ûпп
+ *
+ * \note же
+ */
+void *am_mempool_alloc (am_mempool_handle_t handle);
+
+/**
+ * \brief һͷŻڴ
+ *
+ * \param[in] handle  : ڴؾ
+ * \param[in] p_block : ׵ַ
+ *
+ * \retval  AM_OK     : ͷųɹ
+ * \retval -AM_EINVAL : Чp_block ǸڴеĿ飩
+ *
+ * \note же
+ */
+int am_mempool_free (am_mempool_handle_t handle, void *p_block);
+
+/**
+ * \brief жһڴǷڸڴ
+ *
+ * \param[in] handle  : ڴؾ
+ * \param[in] p_block : ڴַ
+ *
+ * \return ڸڴط AM_TRUE򷵻 AM_FALSE
+ */
+am_bool_t am_mempool_contains (am_mempool_handle_t handle, const void *p_block);
+
+/**
+ * \brief ȡڴصͳϢ
+ *
+ * \param[in]  handle : ڴؾ
+ * \param[out] p_stat : ڻȡͳϢ
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_mempool_stat_get (am_mempool_handle_t     handle,
+                         struct am_mempool_stat *p_stat);
+
+/**
+ * \brief ʼСּķ
+ *
+ * \param[in] p_class  : ָּ
+ * \param[in] p_pools  : Ѿʼڴ飬밴СС
+ * \param[in] pool_num : ڴĿ
+ * \param[in] p_heap   : ̫ʱʹõĶѹNULL ʾʹ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : Ч
+ */
+int am_mempool_class_init (am_mempool_class_t  *p_class,
+                           am_mempool_handle_t *p_pools,
+                           unsigned int         pool_num,
+                           am_memheap_t        *p_heap);
+
+/**
+ * \brief ӷּзڴ
+ *
+ *  size ֽڵĿγԣС󣩣ʧʱӶѹз䡣
+ *
+ * \param[in] p_class : ָּ
+ * \param[in] size    : ռĴС
+ *
+ * \return ռ׵ַNULL ʧ
+ *
+ * \note ӶѹзʱǷжеȡڶѹʹ÷ʽ
+ */
+void *am_mempool_class_alloc (am_mempool_class_t *p_class, size_t size);
+
+/**
+ * \brief ͷŴӷּзڴ
+ *
+ * \param[in] p_class : ָּ
+ * \param[in] ptr     : ռ׵ַ
+ *
+ * \return 
+ */
+void am_mempool_class_free (am_mempool_class_t *p_class, void *ptr);
+
+/** @}  am_if_mempool */
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus  */
+
+#endif  /* __AM_MEMPOOL_H */
+
+/* end of file */
@@ -0,0 +1,361 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief Э̣protothread
+ *
+ *     Эûжջ̣߳ʹ switch ¼ִλãҪȴ
+ * ĵطȴߴɡʱʱأԭλüִС
+ * 豸Ĳ̣緢ȴӦʱٷȻ԰
+ * ˳д CPU豸Ĳ̿ͬһѭвִС
+ *
+ *     Эam_pt_task_tУam_jobqȣ񱻻ʱ
+ * УʱִһЭ̺ԵȴĶУ
+ *  - ʱAM_PT_TASK_DELAY()
+ *  - ȴźţam_wait_tAM_PT_TASK_WAIT_ON()
+ *  - Ϣ첽 am_pt_task_wake() Ϊɻصʹ
+ *    AM_PT_TASK_AWAIT() ȴ
+ *
+ * \attention Э̺غ󣬾ֲֵᱣҪԽȴı
+ *            ھ̬豸ṹУЭ̺вʹ switch 
+ *            ȴ㡣
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_pt.h"
+ * \endcode
+ *
+ * \par 
+ * \code
+ * static am_pt_task_t      __g_sensor_task;
+ * static am_i2c_message_t  __g_sensor_msg;
+ * static int               __g_sensor_ret;
+ *
+ * static int __sensor_thread (am_pt_task_t *p_task, void *p_arg)
+ * {
+ *     AM_PT_BEGIN(&p_task->pt);
+ *
+ *     for (;;) {
+ *         __sensor_msg_build(&__g_sensor_msg, am_pt_task_wake, p_task);
+ *
+ *         // 䣬ȴɣڼ CPU ִ
+ *         AM_PT_TASK_AWAIT(p_task,
+ *                          __g_sensor_ret,
+ *                          am_i2c_msg_start(__g_i2c_handle, &__g_sensor_msg));
+ *
+ *         if (__g_sensor_msg.status == AM_OK) {
+ *             ...
+ *         }
+ *
+ *         AM_PT_TASK_DELAY(p_task, 100);
+ *     }
+ *
+ *     AM_PT_END(&p_task->pt);
+ * }
+ *
+ * AM_JOBQ_QUEUE_DECL_STATIC(__g_app_jobq, 8);
+ *
+ * am_jobq_handle_t handle = AM_JOBQ_QUEUE_INIT(__g_app_jobq);
+ *
+ * am_pt_task_init(&__g_sensor_task, handle, __sensor_thread, NULL, 0);
+ * am_pt_task_start(&__g_sensor_task);
+ *
+ * while (1) {
+ *     am_jobq_process(handle);
+ * }
+ * \endcode
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_PT_H
+#define __AM_PT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_pt
+ * \copydoc am_pt.h
+ * @{
+ */
+#include "am_common.h"
+#include "am_jobq.h"
+#include "am_softimer.h"
+#include "am_wait.h"
+
+/**
+ * \name Э̺ķֵ
+ * @{
+ */
+
+#define AM_PT_WAITING    0     /**< \brief ȴУѺִ */
+#define AM_PT_YIELDED    1     /**< \brief ó CPUԺִ   */
+#define AM_PT_EXITED     2     /**< \brief ˳AM_PT_EXIT()   */
+#define AM_PT_ENDED      3     /**< \brief ִе AM_PT_END()     */
+
+/** @} */
+
+/**
+ * \brief Э̿ƿ飬¼ִλ
+ */
+typedef struct am_pt {
+    uint16_t lc;               /**< \brief ִλãкţ0 ʾͷʼ */
+} am_pt_t;
+
+/**
+ * \name Э̻
+ *
+ * ЩֻЭ̺ʹãЭ̺ķֵΪ涨ķֵ
+ * @{
+ */
+
+/** \brief ʼЭ̣´ִʱͷʼ */
+#define AM_PT_INIT(p_pt)            ((p_pt)->lc = 0)
+
+/** \brief Э̿ʼλЭ̺Ŀͷ */
+#define AM_PT_BEGIN(p_pt)           { char __pt_yielded = 1;                 \
+                                      (void)__pt_yielded;                    \
+                                      switch ((p_pt)->lc) { case 0:
+
+/** \brief Э̽λЭ̺Ľβ */
+#define AM_PT_END(p_pt)             } __pt_yielded = 0;                      \
+                                      AM_PT_INIT(p_pt);                      \
+                                      return AM_PT_ENDED; }
+
+/** \brief ȴֱ */
+#define AM_PT_WAIT_UNTIL(p_pt, cond)                                         \
+    do {                                                                     \
+        (p_pt)->lc = __LINE__; case __LINE__:                                \
+        if (!(cond)) {                                                       \
+            return AM_PT_WAITING;                                            \
+        }                                                                    \
+    } while (0)
+
+/** \brief ȴֱ */
+#define AM_PT_WAIT_WHILE(p_pt, cond)  AM_PT_WAIT_UNTIL(p_pt, !(cond))
+
+/** \brief ó CPUԺӴ˴ִ */
+#define AM_PT_YIELD(p_pt)                                                    \
+    do {                                                                     \
+        __pt_yielded = 0;                                                    \
+        (p_pt)->lc = __LINE__; case __LINE__:                                \
+        if (__pt_yielded == 0) {                                             \
+            return AM_PT_YIELDED;                                            \
+        }                                                                    \
+    } while (0)
+
+/** \brief ˳Э̣´ִʱͷʼ */
+#define AM_PT_EXIT(p_pt)                                                     \
+    do {                                                                     \
+        AM_PT_INIT(p_pt);                                                    \
+        return AM_PT_EXITED;                                                 \
+    } while (0)
+
+/** \brief ¿ʼЭ̣´ִʱͷʼ */
+#define AM_PT_RESTART(p_pt)                                                  \
+    do {                                                                     \
+        AM_PT_INIT(p_pt);                                                    \
+        return AM_PT_WAITING;                                                \
+    } while (0)
+
+/** @} */
+
+/** \brief Эṹ */
+struct am_pt_task;
+
+/**
+ * \brief Э̺
+ *
+ * \param[in] p_task : Э
+ * \param[in] p_arg  : ʼʱָĲ
+ *
+ * \return AM_PT_WAITING Э̺ķֵ
+ */
+typedef int (*am_pt_thread_t) (struct am_pt_task *p_task, void *p_arg);
+
+/**
+ * \brief ЭӦóֻʹ pt ԱӦֱӲԱ
+ */
+typedef struct am_pt_task {
+    am_pt_t            pt;          /**< \brief Э̿ƿ           */
+    volatile uint8_t   signal;      /**< \brief ź             */
+    uint8_t            stat;        /**< \brief ״̬             */
+    am_pt_thread_t     pfn_thread;  /**< \brief Э̺             */
+    void              *p_arg;       /**< \brief Э̺Ĳ       */
+    am_jobq_handle_t   jobq;        /**< \brief ʹõ   */
+    am_jobq_job_t      job;         /**< \brief е     */
+    am_softimer_t      timer;       /**< \brief ʱʹõʱ */
+} am_pt_task_t;
+
+/**
+ * \brief ʼЭ
+ *
+ * \param[in] p_task     : ָЭ
+ * \param[in] jobq       : Э
+ * \param[in] pfn_thread : Э̺
+ * \param[in] p_arg      : Э̺Ĳ
+ * \param[in] pri        : Эеȼ
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_pt_task_init (am_pt_task_t     *p_task,
+                     am_jobq_handle_t  jobq,
+                     am_pt_thread_t    pfn_thread,
+                     void             *p_arg,
+                     uint16_t          pri);
+
+/**
+ * \brief ЭЭ̺ͷʼִ
+ *
+ * \param[in] p_task : ָЭ
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EBUSY  : Э
+ */
+int am_pt_task_start (am_pt_task_t *p_task);
+
+/**
+ * \brief ֹͣЭ
+ *
+ * \param[in] p_task : ָЭ
+ *
+ * \return 
+ *
+ * \note ѾеЭԻᱻһΣִЭ̺
+ */
+void am_pt_task_stop (am_pt_task_t *p_task);
+
+/**
+ * \brief жЭǷУЭ̺δ
+ *
+ * \param[in] p_task : ָЭ
+ *
+ * \return з AM_TRUE򷵻 AM_FALSE
+ */
+am_bool_t am_pt_task_is_running (am_pt_task_t *p_task);
+
+/**
+ * \brief Э
+ *
+ * ûźţЭС am_pfnvoid_t ͬ
+ * ֱΪϢȵɻصp_arg ΪЭ
+ *
+ * \param[in] p_arg : ָЭ
+ *
+ * \return 
+ *
+ * \note же
+ */
+void am_pt_task_wake (void *p_arg);
+
+/**
+ * \brief ȡźţȴʹ
+ *
+ * \param[in] p_task : ָЭ
+ *
+ * \return лźŷ AM_TRUE򷵻 AM_FALSE
+ */
+am_bool_t am_pt_task_signal_take (am_pt_task_t *p_task);
+
+/**
+ * \brief źţȴʹ
+ *
+ * \param[in] p_task : ָЭ
+ *
+ * \return 
+ */
+void am_pt_task_signal_clear (am_pt_task_t *p_task);
+
+/**
+ * \brief ʱʱʱЭ񣬹 AM_PT_TASK_DELAY() ʹ
+ *
+ * \param[in] p_task : ָЭ
+ * \param[in] ms     : ʱʱ䣨λms
+ *
+ * \return 
+ */
+void am_pt_task_timer_start (am_pt_task_t *p_task, unsigned int ms);
+
+/**
+ * \name Эĵȴ
+ *
+ * ЩֻЭЭ̺ʹ
+ * @{
+ */
+
+/** \brief ȴźţam_pt_task_wake() */
+#define AM_PT_TASK_WAIT_SIGNAL(p_task)                                       \
+    AM_PT_WAIT_UNTIL(&(p_task)->pt, am_pt_task_signal_take(p_task))
+
+/** \brief ʱ ms  */
+#define AM_PT_TASK_DELAY(p_task, ms)                                         \
+    do {                                                                     \
+        am_pt_task_signal_clear(p_task);                                     \
+        am_pt_task_timer_start(p_task, ms);                                  \
+        AM_PT_TASK_WAIT_SIGNAL(p_task);                                      \
+    } while (0)
+
+/**
+ * \brief 첽ȴɻص am_pt_task_wake()
+ *
+ * \param[in]  p_task : ָЭ
+ * \param[out] ret    :  start ʽķֵıǾֲ
+ * \param[in]  start  : 첽ıʽ AM_OK ʾʱȴ
+ *                      ɣ򲻵ȴ
+ */
+#define AM_PT_TASK_AWAIT(p_task, ret, start)                                 \
+    do {                                                                     \
+        am_pt_task_signal_clear(p_task);                                     \
+        (ret) = (start);                                                     \
+        if ((ret) == AM_OK) {                                                \
+            AM_PT_TASK_WAIT_SIGNAL(p_task);                                  \
+        }                                                                    \
+    } while (0)
+
+/**
+ * \brief ȴ am_wait_t ȴź
+ *
+ * \param[in]  p_task     : ָЭ
+ * \param[in]  p_wait     : ָȴź
+ * \param[in]  timeout_ms : ʱʱ䣨λmsAM_WAIT_FOREVER ʾһֱȴ
+ * \param[out] ret        : ȴıǾֲ
+ *                          am_wait_result()
+ */
+#define AM_PT_TASK_WAIT_ON(p_task, p_wait, timeout_ms, ret)                  \
+    do {                                                                     \
+        (ret) = am_wait_async(p_wait, timeout_ms, am_pt_task_wake, p_task);  \
+        if ((ret) == AM_OK) {                                                \
+            AM_PT_WAIT_UNTIL(&(p_task)->pt,                                  \
+                             ((ret) = am_wait_result(p_wait)) !=             \
+                                                         -AM_EINPROGRESS);   \
+        }                                                                    \
+    } while (0)
+
+/** @} */
+
+/** @}  am_if_pt */
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus  */
+
+#endif  /* __AM_PT_H */
+
+/* end of file */
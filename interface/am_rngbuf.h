@@ -154,6 +154,30 @@ size_t am_rngbuf_freebytes (am_rngbuf_t rb);
  */
 size_t am_rngbuf_nbytes (am_rngbuf_t rb);
 
+/**
+ * \brief дλָ֮ƫƴдһֽڣƶдλ
+ *
+ * \param[in] rb     : ҪдĻλ
+ * \param[in] byte   : д
+ * \param[in] offset : дλõƫ
+ *
+ * \return 
+ */
+void am_rngbuf_put_ahead (am_rngbuf_t rb, char byte, size_t offset);
+
+/**
+ * \brief дλƶ n ֽڣύֱд뻺 DMA д룩
+ *        
+ *
+ * \param[in] rb : ҪĻλ
+ * \param[in] n  : ƶֽܳС
+ *
+ * \return 
+ *
+ * \note пռ䣬жǷ񸲸δ
+ */
+void am_rngbuf_move_ahead (am_rngbuf_t rb, size_t n);
+
 /**
  * @} 
  */
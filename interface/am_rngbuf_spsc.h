@@ -0,0 +1,253 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+/**
+ * \file
+ * \brief /ߣSPSCλ
+ *
+ *  am_rngbuf.h ͬĴСΪ 2^nдλʹɵ޷
+ * ֵͨȡʵ±ꡣȡԷĶдλʹ acquire 壬Լ
+ * дλʹ release 塣ֻҪд뷽жϻ DMA жϣͶ
+ * ѭеЭֻһرжϼɰȫʹãд뷽Ͷ
+ * Ҳڲͬ CPU ϡ
+ *
+ * ˿ʽĶдӿ⣬ṩ㿽ӿڣ
+ *  - д뷽am_rngbuf_spsc_reserve_write() ȡһĿпռ䣬ֱ䣨
+ *    Ϊ DMA Ŀַʹ am_rngbuf_spsc_commit_write() ύ
+ *  - am_rngbuf_spsc_peek_read() ȡһЧݣֱӽʹ
+ *    am_rngbuf_spsc_consume() ͷš
+ *
+ * \par 
+ * \code
+ * static char                  __g_rx_buf[256];  // СΪ 2^n
+ * static struct am_rngbuf_spsc __g_rx_rb;
+ *
+ * am_rngbuf_spsc_init(&__g_rx_rb, __g_rx_buf, sizeof(__g_rx_buf));
+ *
+ * // ֱڻн
+ * char   *p_data;
+ * size_t  len;
+ *
+ * while (am_rngbuf_spsc_peek_read(&__g_rx_rb, &p_data, &len) == AM_OK) {
+ *     len = parse(p_data, len);               // Ѿֽ
+ *     am_rngbuf_spsc_consume(&__g_rx_rb, len);
+ * }
+ * \endcode
+ *
+ * \internal
+ * \par Modification history
+ * - 1.01 26-10-16  ljy, use acquire/release ordering
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+#ifndef __AM_RNGBUF_SPSC_H
+#define __AM_RNGBUF_SPSC_H
+
+#include "am_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_rngbuf_spsc
+ * \copydoc am_rngbuf_spsc.h
+ * @{
+ */
+
+/**
+ * \brief SPSC λṹ
+ * \note ҪֱӲṹĳԱ
+ */
+struct am_rngbuf_spsc {
+    volatile uint32_t  head;  /**< \brief дֽڼд뷽޸ģ */
+    volatile uint32_t  tail;  /**< \brief Ѷֽڼ޸ģ */
+    uint32_t           mask;  /**< \brief ±룬С - 1       */
+    char              *buf;   /**< \brief                            */
+};
+
+/** \brief SPSC λ */
+typedef struct am_rngbuf_spsc *am_rngbuf_spsc_t;
+
+/**
+ * \brief ʼ SPSC λ
+ *
+ * \param[in] p_rb  : ҪʼĻλ
+ * \param[in] p_buf : λʹõĻռ
+ * \param[in] size  : СΪ 2^nռȫʹ
+ *
+ * \retval  AM_OK     : ʼ
+ * \retval -AM_EINVAL : ʼʧܣЧ size  2^n
+ */
+int am_rngbuf_spsc_init (struct am_rngbuf_spsc *p_rb, char *p_buf, size_t size);
+
+/**
+ * \brief һֽڵλд뷽ã
+ *
+ * \param[in] rb   : ҪĻλ
+ * \param[in] data : Ҫŵֽ
+ *
+ * \retval 0 : ݴʧܣ
+ * \retval 1 : ݳɹ
+ */
+int am_rngbuf_spsc_putchar (am_rngbuf_spsc_t rb, const char data);
+
+/**
+ * \brief ӻλȡһֽݣã
+ *
+ * \param[in]  rb     : ҪĻλ
+ * \param[out] p_data : ֽڵָ
+ *
+ * \retval 0 : ȡʧܣ
+ * \retval 1 : ݳɹȡ
+ */
+int am_rngbuf_spsc_getchar (am_rngbuf_spsc_t rb, char *p_data);
+
+/**
+ * \brief ֽڵλд뷽ã
+ *
+ * \param[in] rb     : ҪĻλ
+ * \param[in] p_buf  : Ҫŵλݻ
+ * \param[in] nbytes : Ҫŵλݸ
+ *
+ * \return ɹŵݸ
+ */
+size_t am_rngbuf_spsc_put (am_rngbuf_spsc_t rb, const char *p_buf, size_t nbytes);
+
+/**
+ * \brief ӻλȡݣã
+ *
+ * \param[in]  rb     : ҪĻλ
+ * \param[out] p_buf  : ŻȡݵĻ
+ * \param[in]  nbytes : Ҫȡݸ
+ *
+ * \return ɹȡݸ
+ */
+size_t am_rngbuf_spsc_get (am_rngbuf_spsc_t rb, char *p_buf, size_t nbytes);
+
+/**
+ * \brief ȡһĿпռ䣬ֱдݣд뷽ã
+ *
+ * пռԽĩβʱصĩβΪֹĲ֣ʣಿύٴε
+ * ɻȡ
+ *
+ * \param[in]  rb      : ҪĻλ
+ * \param[out] pp_buf  : ȡпռ׵ַ
+ * \param[out] p_len   : ȡпռĴС
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EFULL  : ûппռ
+ *
+ * \note дɺ󣬱 am_rngbuf_spsc_commit_write() ύʵдֽ
+ *       ܿЩ
+ */
+int am_rngbuf_spsc_reserve_write (am_rngbuf_spsc_t   rb,
+                                  char             **pp_buf,
+                                  size_t            *p_len);
+
+/**
+ * \brief ύֱдݣд뷽ã
+ *
+ * \param[in] rb : ҪĻλ
+ * \param[in] n  : ύֽпռСĲֱ
+ *
+ * \return 
+ */
+void am_rngbuf_spsc_commit_write (am_rngbuf_spsc_t rb, size_t n);
+
+/**
+ * \brief ȡһЧݣֱӶȡã
+ *
+ * ЧݿԽĩβʱصĩβΪֹĲ֣ʣಿͷźٴε
+ * ɻȡ
+ *
+ * \param[in]  rb      : ҪĻλ
+ * \param[out] pp_buf  : ȡЧݵ׵ַ
+ * \param[out] p_len   : ȡЧݵֽ
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EEMPTY : գûЧ
+ *
+ * \note ݴɺ󣬱 am_rngbuf_spsc_consume() ͷѾֽڣ
+ *       д뷽ʹⲿֿռ
+ */
+int am_rngbuf_spsc_peek_read (am_rngbuf_spsc_t   rb,
+                              char             **pp_buf,
+                              size_t            *p_len);
+
+/**
+ * \brief ͷѾֱӶȡݣã
+ *
+ * \param[in] rb : ҪĻλ
+ * \param[in] n  : ͷŵֽЧݸĲֱ
+ *
+ * \return 
+ */
+void am_rngbuf_spsc_consume (am_rngbuf_spsc_t rb, size_t n);
+
+/**
+ * \brief ջλã
+ *
+ * еǰеЧ
+ *
+ * \param[in] rb : ҪĻλ
+ *
+ * \return 
+ */
+void am_rngbuf_spsc_flush (am_rngbuf_spsc_t rb);
+
+/**
+ * \brief ԻλǷΪ
+ *
+ * \param[in] rb : ҪԵĻλ
+ *
+ * \return λշAM_TRUE, 򷵻AM_FALSE
+ */
+am_bool_t am_rngbuf_spsc_isempty (am_rngbuf_spsc_t rb);
+
+/**
+ * \brief ԻλǷ
+ *
+ * \param[in] rb : ҪԵĻλ
+ *
+ * \return λAM_TRUE, 򷵻AM_FALSE
+ */
+am_bool_t am_rngbuf_spsc_isfull (am_rngbuf_spsc_t rb);
+
+/**
+ * \brief ȡλпռС
+ *
+ * \param[in] rb : ҪжϵĻλ
+ *
+ * \return λпռС
+ */
+size_t am_rngbuf_spsc_freebytes (am_rngbuf_spsc_t rb);
+
+/**
+ * \brief ȡλֽڸ
+ *
+ * \param[in] rb : ҪжϵĻλ
+ *
+ * \return λֽڸ
+ */
+size_t am_rngbuf_spsc_nbytes (am_rngbuf_spsc_t rb);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AM_RNGBUF_SPSC_H */
+
+/* end of file */
@@ -0,0 +1,129 @@
+/*******************************************************************************
+*                                 AMetal
+*                       ----------------------------
+*                       innovating embedded platform
+*
+* Copyright (c) 2001-2018 Guangzhou ZHIYUAN Electronics Co., Ltd.
+* All rights reserved.
+*
+* Contact information:
+* web site:    http://www.zlg.cn/
+*******************************************************************************/
+
+/**
+ * \file
+ * \brief ź
+ *
+ *     жÿһҪĶյһ֡ݣͷһź
+ * am_sem_give()Ӧóÿȡһźam_sem_take()һ
+ * 񵥸־ʧη¼ȴڼ䰴յǰĵȴԿС
+ *
+ *     źΪȴԴ am_sem_src_init()¼ȴԴһ
+ * ʹ am_wait_any() / am_wait_all() ȴ
+ *
+ * ʹñҪͷļ:
+ * \code
+ * #include "am_sem.h"
+ * \endcode
+ *
+ * \internal
+ * \par modification history:
+ * - 1.00 26-10-16  ljy, first implementation
+ * \endinternal
+ */
+
+#ifndef __AM_SEM_H
+#define __AM_SEM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup am_if_sem
+ * \copydoc am_sem.h
+ * @{
+ */
+#include "am_common.h"
+#include "am_wait.h"
+
+/**
+ * \brief źṹ壬ӦóӦֱӲṹԱ
+ */
+typedef struct am_sem {
+    volatile uint32_t count;       /**< \brief ǰ */
+    uint32_t          max;         /**< \brief  */
+} am_sem_t;
+
+/**
+ * \brief ʼź
+ *
+ * \param[in] p_sem : ָź
+ * \param[in] init  : ʼ
+ * \param[in] max   : Ϊ 0Ϊ 1 ʱֵź
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_sem_init (am_sem_t *p_sem, uint32_t init, uint32_t max);
+
+/**
+ * \brief ͷźһѵȴ
+ *
+ * \param[in] p_sem : ָź
+ *
+ * \retval  AM_OK     : ͷųɹ
+ * \retval -AM_EFULL  : Ѵﵽֵ
+ * \retval -AM_EINVAL : 
+ *
+ * \note же
+ */
+int am_sem_give (am_sem_t *p_sem);
+
+/**
+ * \brief ȡźһ
+ *
+ * \param[in] p_sem      : ָź
+ * \param[in] timeout_ms : ʱʱ䣨λmsAM_NO_WAIT ʾȴ
+ *                         AM_WAIT_FOREVER ʾһֱȴ
+ *
+ * \retval  AM_OK     : ȡɹ
+ * \retval -AM_EAGAIN : ʱʱΪ AM_NO_WAITҼΪ 0
+ * \retval -AM_ETIME  : ȴʱ
+ * \retval -AM_EINVAL : 
+ *
+ * \note ʱʱΪ AM_NO_WAIT ʱже
+ */
+int am_sem_take (am_sem_t *p_sem, uint32_t timeout_ms);
+
+/**
+ * \brief ȡźĵǰ
+ *
+ * \param[in] p_sem : ָź
+ *
+ * \return ǰ
+ */
+uint32_t am_sem_count_get (am_sem_t *p_sem);
+
+/**
+ * \brief źʼΪȴԴ am_wait_any() / am_wait_all()
+ *
+ * ȴɹźһȴԴ val ԱΪȡ֮ǰļ
+ *
+ * \param[in] p_src : ָȴԴ
+ * \param[in] p_sem : ָź
+ *
+ * \retval  AM_OK     : ʼɹ
+ * \retval -AM_EINVAL : 
+ */
+int am_sem_src_init (am_wait_src_t *p_src, am_sem_t *p_sem);
+
+/** @}  am_if_sem */
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus  */
+
+#endif  /* __AM_SEM_H */
+
+/* end of file */
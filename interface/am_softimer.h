@@ -15,9 +15,35 @@
  * \brief  ʱ׼ӿ
  *
  * ʱʹһӲʱԴṩʱ
- * 
+ *
+ * ĬʹòʱʱʱĶʱĿȡʱ
+ * Ŀ϶ʱڹж AM_SOFTIMER_WHEELʹ÷ֲʱֹʱ
+ * ֹͣʱΪʱ䡣ʱֵĹģºڹ¶壩
+ *  - AM_SOFTIMER_WHEEL_BITS   : ÿĿλĬΪ 4ÿ 16 ۣ
+ *  - AM_SOFTIMER_WHEEL_LEVELS : ĬΪ 4
+ *
+ * ʱռ 2^AM_SOFTIMER_WHEEL_BITS  AM_SOFTIMER_WHEEL_LEVELS ͷ RAM
+ * ռ䡣ʱַΧ2^(BITS  LEVELS)  tickĶʱʱȻЧֻǻ
+ * мμ
+ *
+ * ʹ am_softimer_module_init() ʼʱ밴չ̶Ƶʵ
+ * am_softimer_module_tick()عȶԹеĳϣʹ
+ * am_softimer_module_init_tickless() ʼΪ޵δģʽʱģռһ
+ * Ӳʱֻͨһʱʱжϣʱʹ
+ * am_softimer_next_expiry_ticks() ȡ´λѵʱ䣬Ƿ͹ġ
+ *
+ * ʱĻصĬ tick жֱӵãʱϳĻص
+ * ɨ衢ɨ裩жϵӦӳ١ʹ am_softimer_init_defer() ʼ
+ * Ķʱʱֻжһжӳ񣨼 am_isr_defer.hص
+ * жӳаָȼãtick жϵִʱͬʱڵĶʱĿ
+ * ޹أʣǹam_softimer_stat_get() ɻȡӳٶȡص
+ * ִʱͳϢ
+ *
  * \internal
  * \par Modification history
+ * - 1.03 26-10-16  ljy,  add deferred callbacks and statistics.
+ * - 1.02 26-10-16  ljy,  add tickless mode.
+ * - 1.01 26-10-16  ljy,  add AM_SOFTIMER_WHEEL option.
  * - 1.00 15-07-31  tee,  first implementation.
  * \endinternal
  */
@@ -32,6 +58,7 @@ extern "C" {
 #include "am_common.h"
 #include "am_list.h"
 #include "am_timer.h"
+#include "am_isr_defer.h"
 
 
 /**
@@ -45,14 +72,39 @@ extern "C" {
  */
 struct am_softimer {
     struct am_list_head node;          /**< \brief γṹ           */
-    unsigned int        ticks;         /**< \brief ʣʱtickֵ             */
+    unsigned int        ticks;         /**< \brief ʣʱtickֵʱ֣ʱ̣ */
     unsigned int        repeat_ticks;  /**< \brief ظʱtick     */
     void (*timeout_callback)( void *); /**< \brief ʱʱ䵽ص         */
     void               *p_arg;         /**< \brief صĲ             */
+    am_isr_defer_job_t *p_job;         /**< \brief ӳNULLже */
 };
 
 typedef struct am_softimer am_softimer_t;
 
+/**
+ * \brief ʱͳϢ
+ */
+struct am_softimer_stat {
+
+    /** \brief ǰӵӳٶСδĻصĿ */
+    uint32_t defer_pending;
+
+    /** \brief defer_pending ʷֵ */
+    uint32_t defer_pending_max;
+
+    /** \brief ʱһεĻصδεڱϲĴ */
+    uint32_t defer_overrun;
+
+    /**
+     * \brief صִʱ䣨жֱӵõĻصλ
+     *        am_softimer_stat_timestamp_set() õʱ
+     */
+    uint32_t cb_time_max;
+};
+
+/** \brief ûʱʱam_softimer_next_expiry_ticks() ķֵ */
+#define AM_SOFTIMER_TICKS_FOREVER    ((unsigned int)-1)
+
 /**
  * \brief ʱģʼ
  *
@@ -65,8 +117,41 @@ int am_softimer_module_init (unsigned int clkrate);
 
 /**
  * \brief ʱ밴ճʼʱģʱָƵʵøú
+ *
+ * \note ʹ am_softimer_module_init_tickless() ʼʱܵøú
  */
 void am_softimer_module_tick (void);
+
+/**
+ * \brief ʱģʼ޵δģʽ
+ *
+ * ʱģռָӲʱͨصÿֻӲʱ
+ * ΪһҪʱ̣жвʵʾ tick û
+ * ʱʱӲʱرաˣtick Ƶʿõýϸߣ 10KHz
+ * жϴ
+ *
+ * \param[in] handle  : Ӳʱ׼ֵ 0 ʼ
+ * \param[in] chan    : ʹõӲʱͨ
+ * \param[in] clkrate : tick ƵʣܸӲʱļƵ
+ *
+ * \retval AM_OK     : ģʼɹʹ
+ * \retval -AM_EINVAL: Ч
+ *
+ * \note ӦóʹøöʱͨҲܵ am_softimer_module_tick()
+ */
+int am_softimer_module_init_tickless (am_timer_handle_t handle,
+                                      uint8_t           chan,
+                                      unsigned int      clkrate);
+
+/**
+ * \brief ȡһҪʱ tick 
+ *
+ * ͨڿѭеãԾǷԼã͹ģʽʹʱʵʱ
+ * ֵһڲʱ̣ʵʵʱ̡
+ *
+ * \return tick ûʱʱ #AM_SOFTIMER_TICKS_FOREVER
+ */
+unsigned int am_softimer_next_expiry_ticks (void);
     
 /**
  * \brief ʼһʱ
@@ -81,6 +166,33 @@ void am_softimer_module_tick (void);
  */
 int am_softimer_init(am_softimer_t *p_timer, am_pfnvoid_t p_func, void *p_arg);
 
+/**
+ * \brief ʼһصӳٴʱ
+ *
+ * ʱʱtick жֻ p_job ӵжӳٶУص
+ * am_isr_defer_job_process() еáһεڵĻصδε֮ϲ
+ * ͳϢе defer_overrun  1
+ *
+ * \param[in] p_timer  : ָһʱָ
+ * \param[in] p_job    : ʱʹõӳ񣬱ȫֻ̬
+ *                       ʱģ鹲
+ * \param[in] p_func   : ʱʱ䵽Ļص
+ * \param[in] p_arg    : ص
+ * \param[in] pri      : ӳȼ AM_ISR_DEFER_PRIORITY_NUM_DEF()
+ *
+ * \retval AM_OK      : ʱʼɹ
+ * \retval -AM_EINVAL : Ч
+ * \retval -AM_EPERM  : ʱģ黹δʼ
+ *
+ * \note ʹǰʼжӳģ飨am_isr_defer_init()ֹͣʱʱѾ
+ *       ӵӳٶеĻصԻᱻһΡ
+ */
+int am_softimer_init_defer (am_softimer_t      *p_timer,
+                            am_isr_defer_job_t *p_job,
+                            am_pfnvoid_t        p_func,
+                            void               *p_arg,
+                            uint16_t            pri);
+
 
 /**
  * \brief һʱ
@@ -97,6 +209,32 @@ void am_softimer_start(am_softimer_t *p_timer, unsigned int ms);
  */
 void am_softimer_stop(am_softimer_t *p_timer);
 
+/**
+ * \brief ͳƻصִʱʹõʱ
+ *
+ * \param[in] pfn_timestamp : һɵļֵ DWT ڼΪ
+ *                            NULL ʱͳƻصִʱ
+ *
+ * \return 
+ */
+void am_softimer_stat_timestamp_set (uint32_t (*pfn_timestamp) (void));
+
+/**
+ * \brief ȡʱͳϢ
+ *
+ * \param[out] p_stat : ڻȡͳϢ
+ *
+ * \return 
+ */
+void am_softimer_stat_get (struct am_softimer_stat *p_stat);
+
+/**
+ * \brief ʱͳϢdefer_pending ⣩
+ *
+ * \return 
+ */
+void am_softimer_stat_reset (void);
+
 /** 
  * @}
  */
@@ -16,6 +16,8 @@
  *
  * \internal
  * \par Modification History
+ * - 1.02 26-10-16  ljy, add chunked TX callback.
+ * - 1.01 26-10-16  ljy, add DMA receive mode.
  * - 1.00 14-11-01  tee, first implementation.
  * \endinternal
  */
@@ -44,6 +46,16 @@ extern "C" {
 #define AM_UART_MODE_POLL         1    /**< \brief UART ѯģʽ */
 #define AM_UART_MODE_INT          2    /**< \brief UART жģʽ */
 
+/**
+ * \brief UART DMA ģʽ
+ *
+ *  DMA ѭд AM_UART_RXBUF_SET ָĻڽտ
+ * ʱDMA дһĩβʱͨ AM_UART_CALLBACK_RXBUF_UPDATE ص
+ * ύµдλãֽڵ AM_UART_CALLBACK_RXCHAR_PUT ص
+ * жģʽͬøģʽǰýջдλø»ص
+ */
+#define AM_UART_MODE_DMA          4
+
 /** @} */
 
 /**
@@ -68,6 +80,8 @@ extern "C" {
 #define AM_UART_RS485_SET         11  /**< \brief RS485ģʽ(ʹ  ) */
 #define AM_UART_RS485_GET         12  /**< \brief ȡǰRS485ģʽ״̬     */
 
+#define AM_UART_RXBUF_SET         13  /**< \brief DMAջ           */
+
 /** @} */
 
 /**
@@ -109,6 +123,8 @@ extern "C" {
 #define AM_UART_CALLBACK_TXCHAR_GET   0  /**< \brief ȡһַ      */
 #define AM_UART_CALLBACK_RXCHAR_PUT   1  /**< \brief ύһյַ  */
 #define AM_UART_CALLBACK_ERROR        2  /**< \brief ص          */
+#define AM_UART_CALLBACK_RXBUF_UPDATE 3  /**< \brief ύDMAջдλ */
+#define AM_UART_CALLBACK_TXCHARS_GET  4  /**< \brief ȡַ      */
 
 /** @} */
 
@@ -143,6 +159,21 @@ extern "C" {
  */
 typedef int (*am_uart_txchar_get_t)(void *p_arg, char *p_char);
 
+/**
+ * \brief ȡַ
+ *
+ * ѡĻصһ FIFO һη DMA 䣬ֽ
+ *  am_uart_txchar_get_tָ֧ûصʱ -AM_ENOTSUP
+ * øûصͬʱ AM_UART_CALLBACK_TXCHAR_GET ص
+ *
+ * \param[in]  p_arg ûصʱָԶ
+ * \param[out] p_buf ŴݵĻ
+ * \param[in]  max   ȡַ 0
+ * \retval -AM_EEMPTY ȡʧܣ޸Ҫ
+ * \retval  > 0       ȡַ
+ */
+typedef int (*am_uart_txchars_get_t)(void *p_arg, char *p_buf, uint32_t max);
+
 /**
  * \brief ύһյַ
  *
@@ -166,8 +197,30 @@ typedef int (*am_uart_rxchar_put_t)(void *p_arg, char  ch);
  */
 typedef int (*am_uart_err_t)(void *p_arg, int code, void *p_data, int size);
 
+/**
+ * \brief ύ DMA ջдλãDMA ģʽ
+ *
+ * дλ֮ǰһύдλ֮󣩵ݾ DMA д뻺DMA д
+ * ĩβʱύдλΪС 0Ա֡ûݡ
+ * պдһȦ
+ *
+ * \param[in] p_arg  ûصʱָԶ
+ * \param[in] wr_idx DMA дλãΧΪ 0 ~ С
+ * \retval -AM_EINVAL  дλЧ
+ * \retval  AM_OK      ɹ
+ */
+typedef int (*am_uart_rxbuf_update_t)(void *p_arg, uint32_t wr_idx);
+
 /** @} */
 
+/**
+ * \brief DMA ջAM_UART_RXBUF_SET ָĲ
+ */
+typedef struct am_uart_rxbuf {
+    uint8_t  *p_buf;        /**< \brief ջNULL ʾʹ */
+    uint32_t  size;         /**< \brief ջС */
+} am_uart_rxbuf_t;
+
 
 /**
  * \brief UARTṹ
@@ -218,7 +271,8 @@ typedef am_uart_serv_t *am_uart_handle_t;
  *   - AM_UART_BAUD_GET : ȡ, p_argΪ uint32_tָ
  *   - AM_UART_OPTS_SET Ӳp_arg Ϊ uint32_tͣ#AM_UART_CS8
  *   - AM_UART_OPTS_GET ȡǰӲãp_argΪ uint32_tָ
- *   - AM_UART_MODE_SET : ģʽ, p_argֵΪ AM_UART_MODE_POLL AM_UART_MODE_INT
+ *   - AM_UART_MODE_SET : ģʽ, p_argֵΪ AM_UART_MODE_POLLAM_UART_MODE_INT
+ *                                         AM_UART_MODE_DMA
  *   - AM_UART_MODE_GET : ȡǰģʽ, p_argΪ uint32_tָ
  *   - AM_UART_AVAIL_MODES_GET : ȡǰõģʽ, p_argΪ uint32_tָ
  *   - AM_UART_FLOWMODE_SET    : ģʽ, p_arg Ϊ AM_UART_FLOWCTL_NO
@@ -230,6 +284,8 @@ typedef am_uart_serv_t *am_uart_handle_t;
  *
  *   - AM_UART_RS485_SET : RS485ģʽp_argΪbool_tͣTUREʹܣFALSEܣ
  *   - AM_UART_RS485_GET ȡǰRS485ģʽ״̬Ϊ bool_t ָ
+ *   - AM_UART_RXBUF_SET DMAջp_argΪ am_uart_rxbuf_t ָͣ
+ *                         ֧ AM_UART_MODE_DMA ģʽʵ
  *
  * \param[in,out] p_arg : ָӦĲ
  *
@@ -262,11 +318,14 @@ int am_uart_tx_startup (am_uart_handle_t handle)
  *            - AM_UART_CALLBACK_GET_TX_CHAR  : ȡһַ
  *            - AM_UART_CALLBACK_PUT_RCV_CHAR : ύһյַӦó
  *            - AM_UART_CALLBACK_ERROR        : ص
+ *            - AM_UART_CALLBACK_RXBUF_UPDATE : ύDMAջдλ
+ *            - AM_UART_CALLBACK_TXCHARS_GET  : ȡַѡ
  * \param[in] pfn_callback   : ָصָ
  * \param[in] p_arg          : صû
  *
  * \retval  AM_OK      : صóɹ
  * \retval -AM_EINVAL  : ʧܣ
+ * \retval -AM_ENOTSUP : ָ֧ûص
  */
 am_static_inline
 int am_uart_callback_set (am_uart_handle_t  handle,
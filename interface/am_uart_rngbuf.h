@@ -17,8 +17,17 @@
  * ļӿڵʵֻUART׼ӿڣΪûʹƣΪUARTӿں
  * ʹ÷
  *
+ * շʹ am_rngbuf am_rngbuf_spscDMA ģʽ DMA ֱ
+ * ѭдջϱдλþ am_rngbuf д±ꣻλҪ
+ * ɶȡдλ¶λջҲڹж½Уǵд뷽/
+ * ķʷʽд뷽ΪжϡΪĵ˳ϣжϵĽ˳Ѿ
+ * ֤˷˳
+ *
  * \internal
  * \par Modification History
+ * - 1.03 26-10-16  ljy, add zero-copy receive.
+ * - 1.02 26-10-16  ljy, add TX timeout and non-blocking mode.
+ * - 1.01 26-10-16  ljy, add DMA receive mode.
  * - 1.00 14-11-01  tee, first implementation.
  * \endinternal
  */
@@ -70,6 +79,44 @@ extern "C" {
  */
 #define AM_UART_RNGBUF_RX_FLOW_ON_THR     0x0800
 
+/**
+ * \brief ʹܻ DMA ģʽ
+ *
+ * Ϊ AM_TRUEʹܣ AM_FALSEܣ֧ AM_UART_MODE_DMA ģʽ
+ * ʹܺ DMA ֱѭдջλڽտСDMA дһ
+ * ĩβʱһύдλãءյȴѺͽմص
+ * ǰֽڴʹʱջա
+ *
+ * DMA 򻺳ֹͣд룬Ӧδʱȡʱݽǣʧֽ
+ * ͨ AM_UART_RNGBUF_RX_LOST ȡ
+ */
+#define AM_UART_RNGBUF_RX_DMA_SET         0x0900
+
+/** \brief ȡ DMA ģʽ򻺳ʧֽΪuint32_tָ */
+#define AM_UART_RNGBUF_RX_LOST            0x0A00
+
+/**
+ * \brief дȴʱms
+ *
+ * ͻʱam_uart_rngbuf_send() ȴжȡݣʱû
+ * пռʱдֽAM_NO_WAIT ʾȴAM_WAIT_FOREVERĬϣ
+ * ʾһֱȴ
+ */
+#define AM_UART_RNGBUF_TX_TIMEOUT         0x0B00
+
+/**
+ * \brief ʹܻܷģʽ
+ *
+ * Ϊ AM_TRUEʹܣ AM_FALSEܣĬϣģʽ¶дȴ
+ * am_uart_rngbuf_send() ֻд뻺ǰɵݣam_uart_rngbuf_receive()
+ * ֻȡеݣʵдȡֽΪ 0Ϸ
+ * صڻппռʱд롣
+ */
+#define AM_UART_RNGBUF_NONBLOCK           0x0C00
+
+/** \brief ͻĿֽΪuint32_tָ */
+#define AM_UART_RNGBUF_NFREE              0x0D00
+
 /** @} */
 
 /**
@@ -94,6 +141,12 @@ typedef struct am_uart_rngbuf_dev {
     
     /** \brief ʱ                 */
     uint32_t          timeout_ms;
+
+    /** \brief дʱ                 */
+    uint32_t          tx_timeout_ms;
+
+    /** \brief Ƿڷģʽ    */
+    am_bool_t         nonblock;
     
     /** \brief ǰ״̬ TRUE-򿪣FALSE-ر */
     am_bool_t         flow_stat;
@@ -101,6 +154,9 @@ typedef struct am_uart_rngbuf_dev {
     /** \brief ڽյȴ           */
     am_wait_t         rx_wait;
 
+    /** \brief ڷ͵ȴ           */
+    am_wait_t         tx_wait;
+
     /** \brief մʹ */
     am_bool_t         rx_trigger_enable;
 
@@ -125,6 +181,15 @@ typedef struct am_uart_rngbuf_dev {
     /** \brief ͻص */
     void             *p_tx_arg;
 
+    /** \brief Ƿ DMA ģʽ */
+    am_bool_t         rx_dma;
+
+    /** \brief DMA ȡʱ¶λλ */
+    volatile am_bool_t rx_overrun;
+
+    /** \brief DMA ģʽ¶ʧֽ */
+    uint32_t          rx_lost;
+
 } am_uart_rngbuf_dev_t;
 
 /** \brief UARTring bufferжģʽ׼Ͷ */
@@ -175,6 +240,16 @@ am_uart_rngbuf_handle_t am_uart_rngbuf_init(am_uart_rngbuf_dev_t *p_dev,
  *                                               - AM_RNGBUF_UART_FLOWCTL_SW
  *            - AM_UART_RNGBUF_RX_FLOW_OFF_THR صֵֽ
  *            - AM_UART_RNGBUF_RX_FLOW_ON_THR  ֵֽ
+ *            - AM_UART_RNGBUF_RX_DMA_SET      ʹܻ DMA ģʽ
+ *                                                Ϊ AM_TRUE  AM_FALSE
+ *            - AM_UART_RNGBUF_RX_LOST         ȡ DMA ģʽ¶ʧֽ
+ *                                                Ϊuint32_tָ
+ *            - AM_UART_RNGBUF_TX_TIMEOUT      дĳʱʱ(ms)Ϊ
+ *                                                uint32_t
+ *            - AM_UART_RNGBUF_NONBLOCK        ʹܻܷģʽ
+ *                                                Ϊ AM_TRUE  AM_FALSE
+ *            - AM_UART_RNGBUF_NFREE           ͻĿֽ
+ *                                                Ϊuint32_tָ
  *
  * \param[in,out] p_arg : ָӦĲ
  *
@@ -193,9 +268,13 @@ int am_uart_rngbuf_ioctl(am_uart_rngbuf_handle_t   handle,
  * \param[in] p_txbuf : ݻ
  * \param[in] nbytes  : ݵĸ
  * 
- * \retval    >0      ɹݵĸ
+ * \retval    >=0     ɹд뷢ͻݸ
  * \retval -AM_EINVAL : ȡʧܣ
  * \retval -AM_EIO    : ݴ
+ *
+ * \note ͻʱȴжȡݡģʽ²ȴдʱ
+ *       ʱʱ仺ûппռ򷵻ءֵͨжʵд
+ *       ֽδдɵԺ·͡
  */
 int am_uart_rngbuf_send(am_uart_rngbuf_handle_t  handle,
                         const uint8_t           *p_txbuf,
@@ -218,6 +297,35 @@ int am_uart_rngbuf_receive(am_uart_rngbuf_handle_t  handle,
                            uint8_t                 *p_rxbuf,
                            uint32_t                 nbytes);
 
+/**
+ * \brief ȡջпֱӷʵݣ
+ *
+ * ؽջλдӶλÿʼдλû򻺳ĩβΪֹݣλ
+ * 䡣ݴʹ am_uart_rngbuf_rx_consume() ͷţٴεñȡ
+ * Ƶʼλõʣݡȴ
+ *
+ * \param[in]  handle  : UARTring bufferжģʽ׼
+ * \param[out] pp_data : ݵʼַ
+ *
+ * \return ݵֽ0 ʾû
+ */
+uint32_t am_uart_rngbuf_rx_peek (am_uart_rngbuf_handle_t   handle,
+                                 const uint8_t           **pp_data);
+
+/**
+ * \brief ͷ am_uart_rngbuf_rx_peek() ȡ
+ *
+ * \param[in] handle : UARTring bufferжģʽ׼
+ * \param[in] nbytes : ͷŵֽܳ am_uart_rngbuf_rx_peek() ķֵ
+ *
+ * \retval AM_OK      : ͷųɹ
+ * \retval -AM_EINVAL : 
+ *
+ * \note DMA ģʽ£ȡ֮ݿѱǣʱƶ
+ *       λã´λȡʱδǵݿʼ
+ */
+int am_uart_rngbuf_rx_consume (am_uart_rngbuf_handle_t handle, uint32_t nbytes);
+
 /**
  * \brief UARTմ
  *
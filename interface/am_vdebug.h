@@ -27,6 +27,7 @@
  *
  * \internal
  * \par modification history:
+ * - 1.01 26-10-16  ljy, add binary log mode (AM_VDEBUG_BLOG)
  * - 1.00 15-01-16  tee, first implementation
  * \endinternal
  */
@@ -51,15 +52,23 @@ extern "C" {
 /**
  * \brief AM_VDEBUG, AM_DBG_INFO() 꽫Ϣ
  *        AM_DBG_INFO()ʵΪ
+ *
+ * ͬʱ AM_VDEBUG_BLOG ʱʹö־ am_blog.h¼Ϣ
+ * ʱʽַĲܳ 6 Ҳָ֧ͱַ
  */
-#ifdef AM_VDEBUG
+#if defined(AM_VDEBUG) && defined(AM_VDEBUG_BLOG)
+#include "am_blog.h"
+#define AM_DBG_INFO(...)    AM_BLOG(__VA_ARGS__)
+#elif defined(AM_VDEBUG)
 #define AM_DBG_INFO(...)    (void)am_kprintf(__VA_ARGS__)
 #else
 #define AM_DBG_INFO(...)
 #endif
 
 /** \brief format log message and output */
-#ifdef AM_VDEBUG
+#if defined(AM_VDEBUG) && defined(AM_VDEBUG_BLOG)
+#define AM_LOGF(msg)    AM_BLOG msg
+#elif defined(AM_VDEBUG)
 #define AM_LOGF(msg)    (void)am_kprintf msg
 #else
 #define AM_LOGF(msg)
@@ -121,6 +130,32 @@ int am_vfprintf_do (void       *fil,
                     const char *str,
                     va_list     arp);
 
+/**
+ * \brief ʽַָĺ
+ *
+ *  am_vfprintf_do() ͬʽַַͨ f_write һ
+ * ܹдַf_write Ϊ NULL ʱͨ
+ * ֶַθƵջϵĻ f_puts 
+ *
+ * \param[in] fil     :  Ϊ f_putcf_puts  f_write һ
+ * \param[in] f_putc  :  ָ룬ָĺһַ
+ * \param[in] f_puts  :  ָ룬ָĺһַ
+ * \param[in] f_write :  ָ룬ָĺָȵַʵ
+ *                        ַ-1 ʾ޷Ϊ NULL
+ * \param[in] str     :  ʽַ
+ * \param[in] arp     :  ʽַĲ
+ *
+ * \return ʵַ
+ */
+int am_vfprintf_do_ex (void       *fil,
+                       int       (*f_putc)  (const char  c, void *fil),
+                       int       (*f_puts)  (const char *s, void *fil),
+                       int       (*f_write) (const char *s,
+                                             size_t      len,
+                                             void       *fil),
+                       const char *str,
+                       va_list     arp);
+
 /**
  * \brief ʽַһָȵַ
  *
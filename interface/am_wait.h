@@ -18,9 +18,20 @@
  * Ҫȴĵط:am_wait_on(&wait);
  * Ҫ֮ǰȴĵطãam_wait_done(&wait);
  *
+ * Ĭ£ȴڼ CPU һֱѯȴ״̬ʹ am_wait_strategy_set()
+ * õȴԣڵȴڼ˯ߣam_wait_strategy_wfiжӳ
+ * am_wait_strategy_isr_deferȡȴԶеȴЧͨϵͳʼ
+ * ʱһΡ
+ *
+ * ȴź⣬ʹ am_wait_any() / am_wait_all() ͬʱȴȴԴ
+ * ¼ am_evgroupź am_semһȫʱء
+ *
  *
  * \internal
  * \par Modification History
+ * - 1.04 26-10-16  ljy, add asynchronous wait.
+ * - 1.03 26-10-16  ljy, add multi-source wait.
+ * - 1.02 26-10-16  ljy, add wait strategy.
  * - 1.01 15-09-07  tee, add am_wait_on_timeout() interface.
  * - 1.00 15-06-12  tee, first implementation.
  * \endinternal
@@ -57,7 +68,140 @@ typedef struct am_wait {
     /** \brief ־ǰĵȴ״̬       */
     uint8_t           stat;
 
+    /** \brief 첽ȴɻʱʱ֪ͨ */
+    am_pfnvoid_t      pfn_notify;
+
+    /** \brief ֪ͨĲ           */
+    void             *p_notify_arg;
+
 } am_wait_t;
+
+/**
+ * \brief ȴ
+ */
+typedef struct am_wait_strategy {
+
+    /**
+     * \brief ȴδʱõĿк
+     *
+     * ʱ CPU жѹرգkey ΪжϵķֵʱжҲ봦ڹر
+     * ״̬غ󣬻һжʹжϵõټȴ
+     * ˣڿк˯ֱжϹ WFIѣҪ
+     * жִʹ am_int_cpu_unlock(key)ɺٹرжϡ
+     */
+    void (*pfn_idle) (void *p_arg, uint32_t key);
+
+    /** \brief ȴɻʱʱãжУΪ NULL */
+    void (*pfn_wake) (void *p_arg);
+
+    /** \brief Ĳ */
+    void  *p_arg;
+} am_wait_strategy_t;
+
+/** \brief ȴԣ˯ߣWFIֱжϷ */
+extern const am_wait_strategy_t am_wait_strategy_wfi;
+
+/**
+ * \brief ȴԣжӳam_isr_defer_job_process()ж
+ *        ӳѭд
+ */
+extern const am_wait_strategy_t am_wait_strategy_isr_defer;
+
+/**
+ * \brief к˯ߣWFIֱжϷp_arg δʹ
+ */
+void am_wait_idle_wfi (void *p_arg, uint32_t key);
+
+/**
+ * \brief кжϣжӳp_arg δʹ
+ */
+void am_wait_idle_isr_defer (void *p_arg, uint32_t key);
+
+/**
+ * \brief кжϣһУp_arg Ϊо
+ *        am_jobq_handle_t
+ */
+void am_wait_idle_jobq (void *p_arg, uint32_t key);
+
+/**
+ * \brief õȴ
+ *
+ * \param[in] p_strategy : ȴԣΪ NULL ʱѯȴĬϣ
+ *
+ * \return 
+ *
+ * \note еȴڽʱĵȴ
+ */
+void am_wait_strategy_set (const am_wait_strategy_t *p_strategy);
+
+/**
+ * \brief ѵȴ
+ *
+ * ȴԴ״̬ı䣨¼־ͷźãʹȴԵĿк
+ * 췵ز¼ȴжеá
+ *
+ * \return 
+ */
+void am_wait_wake (void);
+
+/**
+ * \brief ȴԴ¼顢źģṩʼӦóӦֱӲ
+ *        ýṹԱ
+ */
+typedef struct am_wait_src {
+
+    /**
+     * \brief ȴԴǷ
+     *
+     * ʱ CPU жѹرաtake Ϊ AM_TRUE ʱͬʱȡȴԴ
+     * ¼־źһ val С
+     *
+     * \return  AM_TRUE򷵻 AM_FALSE
+     */
+    am_bool_t (*pfn_take) (struct am_wait_src *p_src, am_bool_t take);
+
+    void      *p_obj;      /**< \brief ȴĶ               */
+    uint32_t   arg;        /**< \brief ȴȴ¼λ */
+    uint32_t   opt;        /**< \brief ȴѡ                 */
+    uint32_t   val;        /**< \brief ȡȴԴõĽ     */
+} am_wait_src_t;
+
+/**
+ * \brief ȴȴԴеһ
+ *
+ * ˳ȴԴȡһĵȴԴ󷵻أȴԴӰ졣
+ *
+ * \param[in] p_srcs     : ȴԴ
+ * \param[in] num        : ȴԴĿ
+ * \param[in] timeout_ms : ʱʱ䣨λmsAM_NO_WAIT ʾȴ
+ *                         AM_WAIT_FOREVER ʾһֱȴ
+ *
+ * \retval >=0        : ĵȴԴе
+ * \retval -AM_EAGAIN : ʱʱΪ AM_NO_WAITûеȴԴ
+ * \retval -AM_ETIME  : ȴʱ
+ * \retval -AM_EINVAL : 
+ *
+ * \note ʱĵȴʹʱʱҪʱ
+ */
+int am_wait_any (am_wait_src_t *p_srcs, unsigned int num, uint32_t timeout_ms);
+
+/**
+ * \brief ȴȴԴȫ
+ *
+ * еȴԴͬʱʱͬһٽڻȡȫȴԴֻȡ˲
+ * ȴԴ
+ *
+ * \param[in] p_srcs     : ȴԴ
+ * \param[in] num        : ȴԴĿ
+ * \param[in] timeout_ms : ʱʱ䣨λmsAM_NO_WAIT ʾȴ
+ *                         AM_WAIT_FOREVER ʾһֱȴ
+ *
+ * \retval  AM_OK     : ȫȴԴѾȡ
+ * \retval -AM_EAGAIN : ʱʱΪ AM_NO_WAITҵȴԴûȫ
+ * \retval -AM_ETIME  : ȴʱ
+ * \retval -AM_EINVAL : 
+ */
+int am_wait_all (am_wait_src_t *p_srcs, unsigned int num, uint32_t timeout_ms);
     
  
 /** 
@@ -110,6 +254,41 @@ int am_wait_on_timeout(am_wait_t *p_wait, uint32_t timeout_ms);
  * \retval -AM_EINVAL ȴʧܣ
  */
 int am_wait_done(am_wait_t *p_wait);
+
+/**
+ * \brief 첽ȴ
+ *
+ *  am_wait_done() ʱ󣬵 pfn_notify ֪ͨȴߣжУ
+ * ȴʹ am_wait_result() ȡȴСЭ̣am_pt
+ * ĳϡ
+ *
+ * \param[in] p_wait     : ָȴźŵָ
+ * \param[in] timeout_ms : ʱʱ䣨λmsAM_WAIT_FOREVER ʾһֱȴ
+ * \param[in] pfn_notify : ֪ͨΪ NULLʱѯȴ
+ * \param[in] p_arg      : ֪ͨĲ
+ *
+ * \retval  AM_OK     : ɹ
+ * \retval -AM_EINVAL : 
+ * \retval -AM_EBUSY  : õȴźڵȴ
+ */
+int am_wait_async (am_wait_t    *p_wait,
+                   uint32_t      timeout_ms,
+                   am_pfnvoid_t  pfn_notify,
+                   void         *p_arg);
+
+/**
+ * \brief ȡ첽ȴĽ
+ *
+ * ȴɻʱʱȴźŻصʼ״̬ٴȴ
+ *
+ * \param[in] p_wait : ָȴźŵָ
+ *
+ * \retval  AM_OK          : ȴɹ
+ * \retval -AM_ETIME       : ȴʱ
+ * \retval -AM_EINPROGRESS : ȴδ
+ * \retval -AM_EINVAL      : 󣬻û첽ȴ
+ */
+int am_wait_result (am_wait_t *p_wait);
  
 
 /** 
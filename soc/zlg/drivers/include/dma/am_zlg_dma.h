@@ -16,6 +16,7 @@
  *
  * \internal
  * \par Modification History
+ * - 1.01 26-10-16  ljy, report half transfer interrupt
  * - 1.00 17-04-11  ari, first implementation
  * \endinternal
  */
@@ -48,6 +49,13 @@ extern "C" {
 /** \brief жϱʶ */
 #define AM_ZLG_DMA_INT_ERROR          1
 
+/**
+ * \brief жϱʶ
+ *
+ * ͨʹ AMHW_ZLG_DMA_CHAN_INT_TX_HALF_ENABLE ʱϱ
+ */
+#define AM_ZLG_DMA_INT_HALF           2
+
 /** @} */
 
 /** \brief DMAжϻص */
@@ -147,7 +155,7 @@ int am_zlg_dma_xfer_desc_chan_cfg (amhw_zlg_dma_xfer_desc_t    *p_desc,
  * \brief DMAص
  *
  * \attention ûصĵڶɴãòȡֵΧ AM_ZLG_DMA_INT*
- *            (#AM_ZLG_DMA_INT_ERROR)(#AM_ZLG_DMA_INT_NORMAL)
+ *            (#AM_ZLG_DMA_INT_ERROR)(#AM_ZLG_DMA_INT_NORMAL)(#AM_ZLG_DMA_INT_HALF)
  *
  * \param[in] chan    : DMA ͨţֵΪDMA_CHAN_* (#DMA_CHAN_1)  (#DMA_CHAN_UART1_TX)
  * \param[in] pfn_isr : صָ
@@ -165,7 +173,7 @@ int am_zlg_dma_isr_connect (int                       chan,
  * \brief ɾDMAص
  *
  * \attention ûصĵڶɴãòȡֵΧ AM_ZLG_DMA_INT*
- *            (#AM_ZLG_DMA_INT_ERROR)(#AM_ZLG_DMA_INT_NORMAL)
+ *            (#AM_ZLG_DMA_INT_ERROR)(#AM_ZLG_DMA_INT_NORMAL)(#AM_ZLG_DMA_INT_HALF)
  *            ûصĵǲжϵͨȡֵΧDMA_CHAN_* (#DMA_CHAN_1)
  *
  * \param[in] chan    : DMA ͨţֵΪDMA_CHAN_* (#DMA_CHAN_1)  (#DMA_CHAN_UART1_TX)
@@ -16,6 +16,9 @@
  *
  * \internal
  * \par Modification History
+ * - 1.03 26-10-16  ljy, publish DMA write index on half transfer
+ * - 1.02 26-10-16  ljy, fill TX FIFO with chunked TX callback
+ * - 1.01 26-10-16  ljy, add DMA receive mode
  * - 1.00 17-04-10  ari, first implementation
  * \endinternal
  */
@@ -54,6 +57,15 @@ extern "C" {
 
 /** @} */
 
+/**
+ * \brief ʹ AM_UART_CALLBACK_TXCHARS_GET صʱÿλȡֽ
+ *
+ * ȡݴ豸ṹУ FIFO пʱд롣
+ */
+#ifndef AM_ZLG_UART_TX_CHUNK_SIZE
+#define AM_ZLG_UART_TX_CHUNK_SIZE  16
+#endif
+
 /**
  * \brief 豸Ϣṹ壬豸Ϣڴڳʼ
  */
@@ -107,9 +119,22 @@ typedef struct am_zlg_uart_dev {
     /** \brief ָûעĴص */
     int (*pfn_err)(void *, int, void *, int);
 
+    /** \brief ָûעrxbuf_update */
+    int (*pfn_rxbuf_update)(void *, uint32_t);
+
+    /** \brief ָûעtxchars_get */
+    int (*pfn_txchars_get)(void *, char *, uint32_t);
+
     void     *txget_arg;                    /**< \brief txchar_get */
     void     *rxput_arg;                    /**< \brief rxchar_put */
     void     *err_arg;                      /**< \brief صû */
+    void     *rxbuf_arg;                    /**< \brief rxbuf_update */
+    void     *txchars_arg;                  /**< \brief txchars_get */
+
+    /** \brief ȡδд뷢 FIFO  */
+    char      tx_chunk[AM_ZLG_UART_TX_CHUNK_SIZE];
+    uint8_t   tx_chunk_pos;                 /**< \brief һдλ */
+    uint8_t   tx_chunk_len;                 /**< \brief ݴݸ */
 
     uint8_t   channel_mode;                 /**< \brief ģʽ ж/ѯ */
     uint32_t  baud_rate;                    /**< \brief ڲ */
@@ -119,6 +144,10 @@ typedef struct am_zlg_uart_dev {
 
     am_bool_t rs485_en;                     /**< \brief Ƿʹ 485 ģʽ */
 
+    int       rx_dma_chan;                  /**< \brief DMAͨ-1Ϊʹ */
+    uint8_t  *p_rx_dma_buf;                 /**< \brief DMAջ */
+    uint32_t  rx_dma_size;                  /**< \brief DMAջС */
+
     const am_zlg_uart_devinfo_t *p_devinfo; /**< \brief ָ豸Ϣָ */
 
 } am_zlg_uart_dev_t;
@@ -134,6 +163,22 @@ typedef struct am_zlg_uart_dev {
 am_uart_handle_t am_zlg_uart_init(am_zlg_uart_dev_t              *p_dev,
                                      const am_zlg_uart_devinfo_t *p_devinfo);
 
+/**
+ * \brief ָUARTʹõDMAͨʹ AM_UART_MODE_DMA ģʽ
+ *
+ * Ӧ am_zlg_uart_init() ֮Ϊ DMA ģʽ֮ǰãDMA ѳʼ
+ * ͨΪôڽӦͨDMA ģʽ´ڽճʱDMA 
+ * ʹʱύдλãʱÿջύһΣDMA жϵ
+ * Ӧӳٲܳհʱ䡣
+ *
+ * \param[in] p_dev    : ָ򴮿豸ָ
+ * \param[in] dma_chan : DMAͨţ-1 ʾʹ DMA 
+ *
+ * \retval  AM_OK     : óɹ
+ * \retval -AM_EBUSY  : ǰ DMA ģʽ
+ */
+int am_zlg_uart_rx_dma_chan_set (am_zlg_uart_dev_t *p_dev, int dma_chan);
+
 /**
  * \brief ʹUARTʱʼUARTͷԴ
  *
@@ -185,6 +185,9 @@ am_bool_t amhw_zlg_uart_status_flag_check (amhw_zlg_uart_t    *p_hw_uart,
 /** \brief Receive overflow error interrupt flag */
 #define AMHW_ZLG_UART_INT_RXOERR_FLAG     AM_BIT(3)
 
+/** \brief Receive timeout interrupt flag */
+#define AMHW_ZLG_UART_INT_TIME_OUT_FLAG   AM_BIT(2)
+
 /** \brief Receive valid interrupt flag */
 #define AMHW_ZLG_UART_INT_RX_VAL_FLAG     AM_BIT(1)
 
@@ -16,6 +16,7 @@
  *
  * \internal
  * \par Modification history
+ * - 1.01 26-10-16  ljy, report half transfer interrupt
  * - 1.00 17-04-11  ari, first implementation
  * \endinternal
  */
@@ -220,6 +221,15 @@ static void __dma_int_handler (void *p_arg)
             amhw_zlg_dma_chan_flag_clear(p_hw_dma, AMHW_ZLG_DMA_CHAN_TX_COMP_FLAG(i));
             break;
         }
+
+        /* ֻϱʹ˴жϵͨ */
+        if (amhw_zlg_dma_chan_stat_check(p_hw_dma , AMHW_ZLG_DMA_CHAN_TX_HALF_FLAG(i)) &&
+            (p_hw_dma->chcfg[i].dma_ccr & AMHW_ZLG_DMA_CHAN_INT_TX_HALF_MASK)) {
+            amhw_zlg_dma_chan_flag_clear(p_hw_dma, AMHW_ZLG_DMA_CHAN_TX_HALF_FLAG(i));
+            chan = i;
+            flag = AM_ZLG_DMA_INT_HALF;
+            break;
+        }
     }
 
     if (0xFF != chan) {
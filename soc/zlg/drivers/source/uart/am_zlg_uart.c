@@ -16,10 +16,15 @@
  *
  * \internal
  * \par Modification history
+ * - 1.04 26-10-16  ljy, clear RX flag in DMA mode, check TX on its own
+ * - 1.03 26-10-16  ljy, publish DMA write index on half transfer
+ * - 1.02 26-10-16  ljy, fill TX FIFO with chunked TX callback
+ * - 1.01 26-10-16  ljy, add DMA receive mode
  * - 1.00 17-04-10  ari, first implementation
  * \endinternal
  */
 #include "am_zlg_uart.h"
+#include "am_zlg_dma.h"
 #include "am_clk.h"
 #include "am_int.h"
 
@@ -121,6 +126,9 @@ static int __uart_ioctl (void *p_drv, int request, void *p_arg)
     /* ȡڿõģʽ */
     case AM_UART_AVAIL_MODES_GET:
         *(int *)p_arg = AM_UART_MODE_INT | AM_UART_MODE_POLL;
+        if (p_dev->rx_dma_chan >= 0) {
+            *(int *)p_arg |= AM_UART_MODE_DMA;
+        }
         break;
 
     /* ѡ */
@@ -143,6 +151,19 @@ static int __uart_ioctl (void *p_drv, int request, void *p_arg)
         *(int *)p_arg = p_dev->rs485_en;
         break;
 
+    /* DMA ջ */
+    case AM_UART_RXBUF_SET:
+        if (p_dev->channel_mode == AM_UART_MODE_DMA) {
+            status = -AM_EBUSY;
+        } else if ((p_arg == NULL) ||
+                   (((am_uart_rxbuf_t *)p_arg)->size > 0xFFFF)) {
+            status = -AM_EINVAL;
+        } else {
+            p_dev->p_rx_dma_buf = ((am_uart_rxbuf_t *)p_arg)->p_buf;
+            p_dev->rx_dma_size  = ((am_uart_rxbuf_t *)p_arg)->size;
+        }
+        break;
+
     default:
         status = -AM_EIO;
         break;
@@ -151,16 +172,57 @@ static int __uart_ioctl (void *p_drv, int request, void *p_arg)
     return (status);
 }
 
+/**
+ * \brief  FIFO дݣֱ FIFO ݿɷ
+ *
+ * \return дֽ
+ */
+static int __uart_tx_fill (am_zlg_uart_dev_t *p_dev)
+{
+    amhw_zlg_uart_t *p_hw_uart = (amhw_zlg_uart_t *)p_dev->p_devinfo->uart_reg_base;
+
+    char data;
+    int  ret;
+    int  n = 0;
+
+    while (amhw_zlg_uart_status_flag_check(p_hw_uart, AMHW_ZLG_UART_TX_FULL_FLAG) == AM_FALSE) {
+
+        if (p_dev->pfn_txchars_get != NULL) {
+
+            /* ݴд꣬һȡһ */
+            if (p_dev->tx_chunk_pos == p_dev->tx_chunk_len) {
+                ret = p_dev->pfn_txchars_get(p_dev->txchars_arg,
+                                             p_dev->tx_chunk,
+                                             sizeof(p_dev->tx_chunk));
+                if (ret <= 0) {
+                    break;
+                }
+                p_dev->tx_chunk_pos = 0;
+                p_dev->tx_chunk_len = (uint8_t)ret;
+            }
+            data = p_dev->tx_chunk[p_dev->tx_chunk_pos++];
+
+        } else if ((p_dev->pfn_txchar_get(p_dev->txget_arg, &data)) != AM_OK) {
+            break;
+        }
+
+        amhw_zlg_uart_data_write(p_hw_uart, data);
+        n++;
+    }
+
+    return n;
+}
+
 /**
  * \brief ڷ(жģʽ)
  */
 int __uart_tx_startup (void *p_drv)
 {
-    char data  = 0;
-
     am_zlg_uart_dev_t *p_dev     = (am_zlg_uart_dev_t *)p_drv;
     amhw_zlg_uart_t   *p_hw_uart = (amhw_zlg_uart_t *)p_dev->p_devinfo->uart_reg_base;
 
+    int key;
+
     /* ʹ 485 Ϳ */
     if (p_dev->rs485_en && p_dev->p_devinfo->pfn_rs485_dir) {
         p_dev->p_devinfo->pfn_rs485_dir(AM_TRUE);
@@ -169,10 +231,10 @@ int __uart_tx_startup (void *p_drv)
     /* ȴһδ */
     while (amhw_zlg_uart_status_flag_check(p_hw_uart, AMHW_ZLG_UART_TX_COMPLETE_FALG) == AM_FALSE);
 
-    /* ȡݲ */
-    if ((p_dev->pfn_txchar_get(p_dev->txget_arg, &data)) == AM_OK) {
-        amhw_zlg_uart_data_write(p_hw_uart, data);
-    }
+    /* ȡݲ䷢ FIFOݴ뷢жϹ */
+    key = am_int_cpu_lock();
+    __uart_tx_fill(p_dev);
+    am_int_cpu_unlock(key);
 
     /* ʹܷж */
     amhw_zlg_uart_int_enable(p_hw_uart, AMHW_ZLG_UART_INT_TX_EMPTY_ENABLE);
@@ -209,6 +271,20 @@ static int __uart_callback_set (void  *p_drv,
         p_dev->err_arg = p_arg;
         return (AM_OK);
 
+    /* ûȡַص */
+    case AM_UART_CALLBACK_TXCHARS_GET:
+        p_dev->pfn_txchars_get = (am_uart_txchars_get_t)pfn_callback;
+        p_dev->txchars_arg     = p_arg;
+        p_dev->tx_chunk_pos    = 0;
+        p_dev->tx_chunk_len    = 0;
+        return (AM_OK);
+
+    /* DMAջдλύص */
+    case AM_UART_CALLBACK_RXBUF_UPDATE:
+        p_dev->pfn_rxbuf_update = (am_uart_rxbuf_update_t)pfn_callback;
+        p_dev->rxbuf_arg        = p_arg;
+        return (AM_OK);
+
     default:
         return (-AM_ENOTSUP);
     }
@@ -269,6 +345,109 @@ static int __uart_poll_getchar (void *p_drv, char *p_char)
     return (AM_OK);
 }
 
+/**
+ * \brief ύDMAջдλ
+ */
+static void __uart_rx_dma_publish (am_zlg_uart_dev_t *p_dev)
+{
+    uint32_t wr_idx;
+    int      key;
+
+    /* ճʱжDMAжϿǶףύ̲ɴ */
+    key = am_int_cpu_lock();
+
+    wr_idx = p_dev->rx_dma_size - am_zlg_dma_tran_data_get(p_dev->rx_dma_chan);
+
+    if (p_dev->pfn_rxbuf_update != NULL) {
+        p_dev->pfn_rxbuf_update(p_dev->rxbuf_arg, wr_idx);
+    }
+
+    am_int_cpu_unlock(key);
+}
+
+/**
+ * \brief DMAжϷÿȦύһдλ
+ */
+static void __uart_rx_dma_isr (void *p_arg, uint32_t flag)
+{
+    am_zlg_uart_dev_t *p_dev = (am_zlg_uart_dev_t *)p_arg;
+
+    if ((flag == AM_ZLG_DMA_INT_NORMAL) || (flag == AM_ZLG_DMA_INT_HALF)) {
+        __uart_rx_dma_publish(p_dev);
+    } else if (p_dev->pfn_err != NULL) {
+        p_dev->pfn_err(p_dev->err_arg, AW_UART_ERR_CODE_OFLOW, NULL, 0);
+    }
+}
+
+/**
+ * \brief DMAѭдջ
+ */
+static int __uart_rx_dma_start (am_zlg_uart_dev_t *p_dev)
+{
+    amhw_zlg_uart_t          *p_hw_uart = (amhw_zlg_uart_t *)p_dev->p_devinfo->uart_reg_base;
+    amhw_zlg_dma_xfer_desc_t  desc;
+    uint32_t                  flags;
+
+    if ((p_dev->rx_dma_chan < 0) ||
+        (p_dev->p_rx_dma_buf == NULL) ||
+        (p_dev->rx_dma_size == 0) ||
+        (p_dev->pfn_rxbuf_update == NULL)) {
+        return AM_ERROR;
+    }
+
+    flags = AMHW_ZLG_DMA_CHAN_PRIORITY_HIGH        |  /* ͨȼ */
+            AMHW_ZLG_DMA_CHAN_MEM_SIZE_8BIT        |  /* ڴݿ1ֽ */
+            AMHW_ZLG_DMA_CHAN_PER_SIZE_8BIT        |  /* ݿ1ֽ */
+            AMHW_ZLG_DMA_CHAN_MEM_ADD_INC_ENABLE   |  /* ڴַ */
+            AMHW_ZLG_DMA_CHAN_PER_ADD_INC_DISABLE  |  /* ַ */
+            AMHW_ZLG_DMA_CHAN_INT_TX_HALF_ENABLE   |  /* ж */
+            AMHW_ZLG_DMA_CHAN_CIRCULAR_MODE_ENABLE;   /* ѭģʽ */
+
+    if (am_zlg_dma_isr_connect(p_dev->rx_dma_chan,
+                               __uart_rx_dma_isr,
+                               (void *)p_dev) != AM_OK) {
+        return AM_ERROR;
+    }
+
+    am_zlg_dma_xfer_desc_build(&desc,
+                               (uint32_t)(&(p_hw_uart->rdr)),
+                               (uint32_t)(p_dev->p_rx_dma_buf),
+                               p_dev->rx_dma_size,
+                               flags);
+
+    if (am_zlg_dma_xfer_desc_chan_cfg(&desc,
+                                      AMHW_ZLG_DMA_PER_TO_MER,
+                                      (uint8_t)p_dev->rx_dma_chan) != AM_OK) {
+        am_zlg_dma_isr_disconnect(p_dev->rx_dma_chan,
+                                  __uart_rx_dma_isr,
+                                  (void *)p_dev);
+        return AM_ERROR;
+    }
+
+    amhw_zlg_uart_dma_mode_enable(p_hw_uart, AM_TRUE);
+    am_zlg_dma_chan_start(p_dev->rx_dma_chan);
+
+    return AM_OK;
+}
+
+/**
+ * \brief ֹͣDMAύдλ
+ */
+static void __uart_rx_dma_stop (am_zlg_uart_dev_t *p_dev)
+{
+    amhw_zlg_uart_t *p_hw_uart = (amhw_zlg_uart_t *)p_dev->p_devinfo->uart_reg_base;
+
+    amhw_zlg_uart_int_disable(p_hw_uart, AMHW_ZLG_UART_INT_TIME_OUT_ENABLE);
+    amhw_zlg_uart_dma_mode_enable(p_hw_uart, AM_FALSE);
+
+    __uart_rx_dma_publish(p_dev);
+
+    am_zlg_dma_chan_stop(p_dev->rx_dma_chan);
+    am_zlg_dma_isr_disconnect(p_dev->rx_dma_chan,
+                              __uart_rx_dma_isr,
+                              (void *)p_dev);
+}
+
 /**
  * \brief ôģʽ
  */
@@ -277,11 +456,38 @@ int __uart_mode_set (am_zlg_uart_dev_t *p_dev, uint32_t new_mode)
     amhw_zlg_uart_t *p_hw_uart = (amhw_zlg_uart_t *)p_dev->p_devinfo->uart_reg_base;
 
     /* ֧ģʽ */
-    if ((new_mode != AM_UART_MODE_POLL) && (new_mode != AM_UART_MODE_INT)) {
+    if ((new_mode != AM_UART_MODE_POLL) &&
+        (new_mode != AM_UART_MODE_INT)  &&
+        (new_mode != AM_UART_MODE_DMA)) {
         return (AM_ERROR);
     }
 
-    if (new_mode == AM_UART_MODE_INT) {
+    if ((new_mode == AM_UART_MODE_DMA) &&
+        (p_dev->channel_mode == AM_UART_MODE_DMA)) {
+        return (AM_OK);
+    }
+
+    /* ˳DMAģʽ */
+    if (p_dev->channel_mode == AM_UART_MODE_DMA) {
+        __uart_rx_dma_stop(p_dev);
+    }
+
+    if (new_mode == AM_UART_MODE_DMA) {
+
+        if (__uart_rx_dma_start(p_dev) != AM_OK) {
+            return (AM_ERROR);
+        }
+
+        am_int_connect(p_dev->p_devinfo->inum,
+                       __uart_irq_handler,
+                       (void *)p_dev);
+        am_int_enable(p_dev->p_devinfo->inum);
+
+        /* DMAˣʹܽճʱж */
+        amhw_zlg_uart_int_disable(p_hw_uart, AMHW_ZLG_UART_INT_RX_VAL_ENABLE);
+        amhw_zlg_uart_int_enable(p_hw_uart, AMHW_ZLG_UART_INT_TIME_OUT_ENABLE);
+
+    } else if (new_mode == AM_UART_MODE_INT) {
 
         am_int_connect(p_dev->p_devinfo->inum,
                        __uart_irq_handler,
@@ -386,8 +592,19 @@ void __uart_irq_rx_handler (am_zlg_uart_dev_t *p_dev)
     amhw_zlg_uart_t *p_hw_uart = (amhw_zlg_uart_t *)p_dev->p_devinfo->uart_reg_base;
     char data;
 
-    /* ǷΪRxж */
-    if (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_RX_VAL_FLAG) == AM_TRUE) {
+    /* ճʱ·УύDMAջдλ */
+    if (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_TIME_OUT_FLAG) == AM_TRUE) {
+
+        amhw_zlg_uart_int_flag_clr(p_hw_uart, AMHW_ZLG_UART_INT_TIME_OUT_FLAG_CLR);
+
+        if (p_dev->channel_mode == AM_UART_MODE_DMA) {
+            __uart_rx_dma_publish(p_dev);
+        }
+    }
+
+    /* ǷΪRxжϣDMAģʽ½DMAȡ */
+    if ((p_dev->channel_mode != AM_UART_MODE_DMA) &&
+        (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_RX_VAL_FLAG) == AM_TRUE)) {
 
         amhw_zlg_uart_int_flag_clr(p_hw_uart, AMHW_ZLG_UART_INT_RX_VAL_FLAG_CLR);
 
@@ -406,16 +623,12 @@ void __uart_irq_tx_handler (am_zlg_uart_dev_t *p_dev)
 {
     amhw_zlg_uart_t *p_hw_uart = (amhw_zlg_uart_t *)p_dev->p_devinfo->uart_reg_base;
 
-    char data;
-
     if (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_TX_EMPTY_FLAG) == AM_TRUE) {
 
         amhw_zlg_uart_int_flag_clr(p_hw_uart, AMHW_ZLG_UART_INT_TX_EMPTY_FLAG_CLR);
 
-        /* ȡݲ */
-        if ((p_dev->pfn_txchar_get(p_dev->txget_arg, &data)) == AM_OK) {
-            amhw_zlg_uart_data_write(p_hw_uart, data);
-        } else {
+        /* ȡݲ䷢ FIFO */
+        if (__uart_tx_fill(p_dev) == 0) {
 
             /* ûݴ;͹رշж */
             amhw_zlg_uart_int_disable(p_hw_uart, AMHW_ZLG_UART_INT_TX_EMPTY_ENABLE);
@@ -440,12 +653,24 @@ void __uart_irq_handler (void *p_arg)
 
     uint32_t uart_int_stat        = amhw_zlg_uart_int_flag_get(p_hw_uart);
 
-    if (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_RX_VAL_FLAG) == AM_TRUE) {
+    /*
+     * DMAģʽ½DMAȡжδʹܣж״̬ĴеĽձ־
+     * Իλⷢжϱжϴ
+     */
+    if ((p_dev->channel_mode == AM_UART_MODE_DMA) &&
+        (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_RX_VAL_FLAG) == AM_TRUE)) {
+        amhw_zlg_uart_int_flag_clr(p_hw_uart, AMHW_ZLG_UART_INT_RX_VAL_FLAG_CLR);
+    }
+
+    if ((amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_RX_VAL_FLAG) == AM_TRUE) ||
+        (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_TIME_OUT_FLAG) == AM_TRUE)) {
          __uart_irq_rx_handler(p_dev);
-    } else if (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_TX_EMPTY_FLAG) == AM_TRUE) {
-        __uart_irq_tx_handler(p_dev);
-    } else {
+    }
 
+    /* жжϿͬʱڷжʹʱ */
+    if ((p_hw_uart->ier & AMHW_ZLG_UART_INT_TX_EMPTY_ENABLE) &&
+        (amhw_zlg_uart_int_flag_check(p_hw_uart,AMHW_ZLG_UART_INT_TX_EMPTY_FLAG) == AM_TRUE)) {
+        __uart_irq_tx_handler(p_dev);
     }
 
     /* ж */
@@ -521,10 +746,21 @@ am_uart_handle_t am_zlg_uart_init (am_zlg_uart_dev_t           *p_dev,
                      (int (*) (void *, int, void*, int))__uart_dummy_callback;
 
     p_dev->err_arg           = NULL;
+    p_dev->pfn_rxbuf_update  = NULL;
+    p_dev->rxbuf_arg         = NULL;
+    p_dev->pfn_txchars_get   = NULL;
+    p_dev->txchars_arg       = NULL;
+    p_dev->tx_chunk_pos      = 0;
+    p_dev->tx_chunk_len      = 0;
+
+    p_dev->rx_dma_chan       = -1;
+    p_dev->p_rx_dma_buf      = NULL;
+    p_dev->rx_dma_size       = 0;
 
     p_dev->other_int_enable  = p_devinfo->other_int_enable  &
                                ~(AMHW_ZLG_UART_INT_TX_EMPTY_ENABLE |
-                                 AMHW_ZLG_UART_INT_RX_VAL_ENABLE);
+                                 AMHW_ZLG_UART_INT_RX_VAL_ENABLE   |
+                                 AMHW_ZLG_UART_INT_TIME_OUT_ENABLE);
     p_dev->rs485_en          = AM_FALSE;
 
     /* ȡݳѡ */
@@ -582,6 +818,7 @@ am_uart_handle_t am_zlg_uart_init (am_zlg_uart_dev_t           *p_dev,
                                      am_clk_rate_get(p_dev->p_devinfo->clk_num),
                                      p_devinfo->baud_rate);
     /* Ĭѯģʽ */
+    p_dev->channel_mode      = 0;
     __uart_mode_set(p_dev, AM_UART_MODE_POLL);
 
     /* uartʹ */
@@ -603,6 +840,20 @@ am_uart_handle_t am_zlg_uart_init (am_zlg_uart_dev_t           *p_dev,
     return &(p_dev->uart_serv);
 }
 
+/**
+ * \brief ָUARTʹõDMAͨ
+ */
+int am_zlg_uart_rx_dma_chan_set (am_zlg_uart_dev_t *p_dev, int dma_chan)
+{
+    if (p_dev->channel_mode == AM_UART_MODE_DMA) {
+        return -AM_EBUSY;
+    }
+
+    p_dev->rx_dma_chan = (dma_chan < 0) ? -1 : dma_chan;
+
+    return AM_OK;
+}
+
 /**
  * \brief ȥʼ
  */
@@ -612,7 +863,8 @@ void am_zlg_uart_deinit (am_zlg_uart_dev_t *p_dev)
     p_dev->uart_serv.p_funcs   = NULL;
     p_dev->uart_serv.p_drv     = NULL;
 
-    if (p_dev->channel_mode == AM_UART_MODE_INT) {
+    if ((p_dev->channel_mode == AM_UART_MODE_INT) ||
+        (p_dev->channel_mode == AM_UART_MODE_DMA)) {
 
         /* ĬΪѯģʽ */
         __uart_mode_set(p_dev, AM_UART_MODE_POLL);
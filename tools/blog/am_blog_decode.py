@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# AMetal binary log (am_blog) decoder
+#
+# Decodes the record stream written by am_blog into text, using the format
+# strings kept in the .am_blog_fmt section of the ELF file from the build.
+#
+# usage: am_blog_decode.py [-t TICK_HZ] [-e ENCODING] elf [input]
+#
+#   elf   : the ELF file of the firmware (.axf / .elf / .out)
+#   input : captured raw log data or a serial device (already configured, e.g.
+#           with stty), standard input if omitted
+#
+
+import argparse
+import re
+import struct
+import sys
+
+FMT_SECTION = '.am_blog_fmt'
+
+HDR_MAGIC   = 0xA0
+HDR_TS      = 0x08
+HDR_LOST    = 0x07
+
+SHF_ALLOC   = 0x2
+SHT_NOBITS  = 8
+
+
+class Elf(object):
+    """minimal ELF reader, only section headers are used"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF file' % path)
+
+        is64   = self.data[4] == 2
+        endian = '<' if self.data[5] == 1 else '>'
+
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH',
+                                                            self.data, 0x3A)
+            shfmt = endian + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH',
+                                                            self.data, 0x2E)
+            shfmt = endian + 'IIIIIIIIII'
+
+        self.endian   = endian
+        self.sections = []
+
+        headers = [struct.unpack_from(shfmt, self.data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        strtab  = headers[shstrndx]
+
+        for h in headers:
+            name_off = strtab[4] + h[0]
+            name     = self.data[name_off:self.data.index(b'\0', name_off)]
+            self.sections.append({
+                'name'  : name.decode('ascii', 'replace'),
+                'type'  : h[1],
+                'flags' : h[2],
+                'addr'  : h[3],
+                'data'  : b'' if h[1] == SHT_NOBITS else
+                          self.data[h[4]:h[4] + h[5]],
+            })
+
+    def section(self, name):
+        for s in self.sections:
+            if s['name'] == name:
+                return s
+        return None
+
+    def cstring(self, addr):
+        """read a C string at the address from the loadable sections"""
+        for s in self.sections:
+            if ((s['flags'] & SHF_ALLOC) and s['data'] and
+                    s['addr'] <= addr < s['addr'] + len(s['data'])):
+                off = addr - s['addr']
+                end = s['data'].find(b'\0', off)
+                if end < 0:
+                    end = len(s['data'])
+                return s['data'][off:end]
+        return None
+
+
+# %[flags][width][.precision][length]conversion
+SPEC_RE = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|t|j)?([diuxXocsp%])')
+
+
+def to_signed(v):
+    return v - 0x100000000 if v & 0x80000000 else v
+
+
+def format_record(elf, fmt, args, encoding):
+    """format a record like printf, every argument is a 32 bit value"""
+    out  = []
+    pos  = 0
+    argi = 0
+
+    for m in SPEC_RE.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+
+        flags, width, prec, _, conv = m.groups()
+
+        if conv == '%':
+            out.append('%')
+            continue
+
+        v     = args[argi] if argi < len(args) else 0
+        argi += 1
+
+        spec = '%' + flags + width + ('.' + prec if prec else '')
+
+        if conv in 'di':
+            out.append((spec + 'd') % to_signed(v))
+        elif conv == 'u':
+            out.append((spec + 'd') % v)
+        elif conv in 'xXo':
+            out.append((spec + conv) % v)
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(v & 0xFF))
+        elif conv == 'p':
+            out.append('0x%08x' % v)
+        elif conv == 's':
+            s = elf.cstring(v)
+            s = '<0x%08x>' % v if s is None else s.decode(encoding, 'replace')
+            out.append((spec + 's') % s)
+
+    out.append(fmt[pos:])
+
+    return ''.join(out)
+
+
+def decode(elf, stream, tick_hz, encoding, write):
+    sec = elf.section(FMT_SECTION)
+    if sec is None:
+        raise ValueError('no %s section in the ELF file' % FMT_SECTION)
+
+    fmt_start = sec['addr']
+    fmt_data  = sec['data']
+    endian    = elf.endian
+
+    def fmt_get(fid):
+        off = fid - (fmt_start & 0xFFFFFFFF)
+        if off < 0 or off >= len(fmt_data):
+            return None
+        end = fmt_data.find(b'\0', off)
+        return fmt_data[off:end].decode(encoding, 'replace')
+
+    buf = b''
+
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        buf += chunk
+
+        while buf:
+            hdr = buf[0]
+
+            # resynchronize on a valid header
+            if (hdr & 0xF0) != HDR_MAGIC:
+                buf = buf[1:]
+                continue
+
+            nargs = hdr & 0x07
+
+            if nargs == HDR_LOST:
+                if len(buf) < 5:
+                    break
+                lost, = struct.unpack_from(endian + 'I', buf, 1)
+                write('<%u record(s) lost>\n' % lost)
+                buf = buf[5:]
+                continue
+
+            size = 1 + (4 if hdr & HDR_TS else 0) + 4 + 4 * nargs
+            if len(buf) < size:
+                break
+
+            off = 1
+            ts  = None
+            if hdr & HDR_TS:
+                ts,  = struct.unpack_from(endian + 'I', buf, off)
+                off += 4
+
+            fid, = struct.unpack_from(endian + 'I', buf, off)
+            fmt  = fmt_get(fid)
+            if fmt is None:
+                buf = buf[1:]
+                continue
+
+            args = struct.unpack_from(endian + 'I' * nargs, buf, off + 4)
+            buf  = buf[size:]
+
+            text = format_record(elf, fmt, args, encoding)
+
+            if ts is not None:
+                if tick_hz:
+                    text = '[%12.6f] %s' % (float(ts) / tick_hz, text)
+                else:
+                    text = '[%10u] %s' % (ts, text)
+
+            write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='AMetal binary log decoder')
+    parser.add_argument('elf', help='ELF file of the firmware')
+    parser.add_argument('input', nargs='?', help='log data, default stdin')
+    parser.add_argument('-t', '--tick-hz', type=float, default=0,
+                        help='timestamp frequency, show seconds if given')
+    parser.add_argument('-e', '--encoding', default='gbk',
+                        help='encoding of the format strings (default gbk)')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+
+    if args.input:
+        stream = open(args.input, 'rb', buffering=0)
+    else:
+        stream = sys.stdin.buffer
+
+    def write(text):
+        sys.stdout.write(text)
+        sys.stdout.flush()
+
+    try:
+        decode(elf, stream, args.tick_hz, args.encoding, write)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()